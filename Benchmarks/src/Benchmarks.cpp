@@ -26,6 +26,15 @@
 #include <immintrin.h>
 
 #include "linalgBenchmarks.h"
+#include "threadPoolBenchmarks.h"
+#include "queueBenchmarks.h"
+#include "listBenchmarks.h"
+#include "timerBenchmarks.h"
+#include "lockBenchmarks.h"
+#include "bitVectorBenchmarks.h"
+#include "bitwiseBenchmarks.h"
+#include "compressedBitmapBenchmarks.h"
+#include "packedIntVectorBenchmarks.h"
 
 
 using namespace std::string_literals;
@@ -0,0 +1,243 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    bitVectorBenchmarks.h
+ * @brief   bulk operations of bws::BitVectorT against the same operation through the bit proxies,
+ *          set bit iteration and rank / select queries
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef BITVECTORBENCHMARKS_H_56473829105647382910564738291056473829105
+#define BITVECTORBENCHMARKS_H_56473829105647382910564738291056473829105
+
+
+// includes
+#include <Bitwise/BitVector.h>
+#include <Bitwise/RankSelectIndex.h>
+
+#include <cstdint>
+#include <random>
+
+
+using BenchBitVector = bws::BitVectorT<std::uint64_t>;
+
+/// a mask of size bits, of which roughly one in density is set
+inline auto makeBitMask(std::size_t size, double density) -> BenchBitVector
+{
+  std::mt19937 gen(1);
+  std::bernoulli_distribution dis(density);
+
+  BenchBitVector b(size);
+  for(std::size_t i = 0ULL; i < size; ++i)
+  {
+    b[i] = dis(gen);
+  }
+  return b;
+}
+
+static void BM_bitVectorAndProxies(benchmark::State& state)
+{
+  const auto size = static_cast<std::size_t>(state.range(0));
+  auto       a    = makeBitMask(size, 0.5);
+  const auto b    = makeBitMask(size, 0.5);
+
+  for(auto _ : state)
+  {
+    for(std::size_t i = 0ULL; i < size; ++i)
+    {
+      a[i] = a[i] && b[i];
+    }
+    benchmark::DoNotOptimize(a.front());
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(size / 8ULL));
+}
+
+static void BM_bitVectorAnd(benchmark::State& state)
+{
+  const auto size = static_cast<std::size_t>(state.range(0));
+  auto       a    = makeBitMask(size, 0.5);
+  const auto b    = makeBitMask(size, 0.5);
+
+  for(auto _ : state)
+  {
+    a &= b;
+    benchmark::DoNotOptimize(a.front());
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(size / 8ULL));
+}
+
+static void BM_bitVectorCountProxies(benchmark::State& state)
+{
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto a    = makeBitMask(size, 0.5);
+
+  for(auto _ : state)
+  {
+    std::size_t n = 0ULL;
+    for(const auto bit : a)
+    {
+      n += bit ? 1ULL : 0ULL;
+    }
+    benchmark::DoNotOptimize(n);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(size / 8ULL));
+}
+
+static void BM_bitVectorCount(benchmark::State& state)
+{
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto a    = makeBitMask(size, 0.5);
+
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(a.count());
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(size / 8ULL));
+}
+
+/// visits the set bits of a sparse mask, one in 1000 bits is set
+static void BM_bitVectorFindNext(benchmark::State& state)
+{
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto a    = makeBitMask(size, 0.001);
+
+  for(auto _ : state)
+  {
+    std::size_t n = 0ULL;
+    for(auto pos = a.findFirst(); pos != a.npos; pos = a.findNext(pos))
+    {
+      ++n;
+    }
+    benchmark::DoNotOptimize(n);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(size / 8ULL));
+}
+
+/// visits the set bits of a sparse mask through the proxies
+static void BM_bitVectorSetBitsProxies(benchmark::State& state)
+{
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto a    = makeBitMask(size, 0.001);
+
+  for(auto _ : state)
+  {
+    std::size_t sum = 0ULL;
+    for(std::size_t i = 0ULL; i < size; ++i)
+    {
+      if(a[i])
+      {
+        sum += i;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(size / 8ULL));
+}
+
+static void BM_bitVectorSetBitIterator(benchmark::State& state)
+{
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto a    = makeBitMask(size, 0.001);
+
+  for(auto _ : state)
+  {
+    std::size_t sum = 0ULL;
+    for(const auto pos : a.setBits())
+    {
+      sum += pos;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(size / 8ULL));
+}
+
+static void BM_bitVectorForEachSetBit(benchmark::State& state)
+{
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto a    = makeBitMask(size, 0.001);
+
+  for(auto _ : state)
+  {
+    std::size_t sum = 0ULL;
+    a.forEachSetBit([&sum](std::size_t pos) { sum += pos; });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(size / 8ULL));
+}
+
+/// the k-th bit set by counting set bits from the beginning
+static void BM_bitVectorSelectLinear(benchmark::State& state)
+{
+  const auto size  = static_cast<std::size_t>(state.range(0));
+  const auto a     = makeBitMask(size, 0.5);
+  const auto count = a.count();
+
+  std::mt19937 gen(2);
+  std::uniform_int_distribution<std::size_t> dis(0ULL, count - 1ULL);
+
+  for(auto _ : state)
+  {
+    auto k   = dis(gen);
+    auto pos = a.findFirst();
+    for(; k > 0ULL; --k)
+    {
+      pos = a.findNext(pos);
+    }
+    benchmark::DoNotOptimize(pos);
+  }
+}
+
+static void BM_rankSelectIndexSelect(benchmark::State& state)
+{
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto a    = makeBitMask(size, 0.5);
+  const bws::RankSelectIndex<std::uint64_t> index(a);
+
+  std::mt19937 gen(2);
+  std::uniform_int_distribution<std::size_t> dis(0ULL, index.count() - 1ULL);
+
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(index.select(dis(gen)));
+  }
+}
+
+static void BM_rankSelectIndexRank(benchmark::State& state)
+{
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto a    = makeBitMask(size, 0.5);
+  const bws::RankSelectIndex<std::uint64_t> index(a);
+
+  std::mt19937 gen(2);
+  std::uniform_int_distribution<std::size_t> dis(0ULL, size);
+
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(index.rank(dis(gen)));
+  }
+}
+
+BENCHMARK(BM_bitVectorAndProxies)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_bitVectorAnd)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_bitVectorCountProxies)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_bitVectorCount)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_bitVectorFindNext)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_bitVectorSetBitsProxies)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_bitVectorSetBitIterator)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_bitVectorForEachSetBit)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_bitVectorSelectLinear)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_rankSelectIndexSelect)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_rankSelectIndexRank)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // BITVECTORBENCHMARKS_H_56473829105647382910564738291056473829105
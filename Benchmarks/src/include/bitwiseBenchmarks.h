@@ -0,0 +1,105 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    bitwiseBenchmarks.h
+ * @brief   bws::countBits, firstBitSet and lastBitSet against their portable fallbacks
+ *          and the functions of <bit>
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef BITWISEBENCHMARKS_H_83746501928374650192837465019283746501928
+#define BITWISEBENCHMARKS_H_83746501928374650192837465019283746501928
+
+
+// includes
+#include <Bitwise/Bitwise.h>
+
+#include <bit>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+inline constexpr std::size_t numBitwiseWords = 4096ULL;
+
+/// random words, shifted by a random amount so the lowest and highest set bit vary
+template <typename T>
+auto makeRandomWords() -> std::vector<T>
+{
+  std::mt19937_64 gen(1);
+  std::uniform_int_distribution<std::uint64_t> dis;
+  std::uniform_int_distribution<int>           shiftDis(0, static_cast<int>(sizeof(T)) * 8 - 1);
+
+  std::vector<T> words(numBitwiseWords);
+  for(auto& w : words)
+  {
+    w = static_cast<T>(static_cast<T>(dis(gen)) << shiftDis(gen));
+  }
+  return words;
+}
+
+struct CountBits            { template <typename T> static auto apply(T v) { return bws::countBits(v); } };
+struct CountBitsFallback    { template <typename T> static auto apply(T v) { return bws::details::countBitsFallback(v); } };
+struct CountBitsStd         { template <typename T> static auto apply(T v) { return static_cast<std::size_t>(std::popcount(v)); } };
+
+struct FirstBitSet          { template <typename T> static auto apply(T v) { return bws::firstBitSet(v); } };
+struct FirstBitSetFallback  { template <typename T> static auto apply(T v) { return bws::details::firstBitSetFallback(v); } };
+struct FirstBitSetStd       { template <typename T> static auto apply(T v) { return static_cast<std::size_t>(std::countr_zero(v)); } };
+
+struct LastBitSet           { template <typename T> static auto apply(T v) { return bws::lastBitSet(v); } };
+struct LastBitSetFallback   { template <typename T> static auto apply(T v) { return bws::details::lastBitSetFallback(v); } };
+struct LastBitSetStd        { template <typename T> static auto apply(T v) { return sizeof(T) * 8ULL - 1ULL - static_cast<std::size_t>(std::countl_zero(v)); } };
+
+/**
+ * @brief Sums up Op::apply over numBitwiseWords random words of type T.
+ */
+template <typename Op, typename T>
+static void BM_bitwise(benchmark::State& state)
+{
+  const auto words = makeRandomWords<T>();
+
+  for(auto _ : state)
+  {
+    std::size_t sum = 0ULL;
+    for(const auto w : words)
+    {
+      sum += Op::apply(w);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(numBitwiseWords));
+}
+
+BENCHMARK_TEMPLATE(BM_bitwise, CountBits, std::uint32_t);
+BENCHMARK_TEMPLATE(BM_bitwise, CountBitsFallback, std::uint32_t);
+BENCHMARK_TEMPLATE(BM_bitwise, CountBitsStd, std::uint32_t);
+BENCHMARK_TEMPLATE(BM_bitwise, CountBits, std::uint64_t);
+BENCHMARK_TEMPLATE(BM_bitwise, CountBitsFallback, std::uint64_t);
+BENCHMARK_TEMPLATE(BM_bitwise, CountBitsStd, std::uint64_t);
+
+BENCHMARK_TEMPLATE(BM_bitwise, FirstBitSet, std::uint32_t);
+BENCHMARK_TEMPLATE(BM_bitwise, FirstBitSetFallback, std::uint32_t);
+BENCHMARK_TEMPLATE(BM_bitwise, FirstBitSetStd, std::uint32_t);
+BENCHMARK_TEMPLATE(BM_bitwise, FirstBitSet, std::uint64_t);
+BENCHMARK_TEMPLATE(BM_bitwise, FirstBitSetFallback, std::uint64_t);
+BENCHMARK_TEMPLATE(BM_bitwise, FirstBitSetStd, std::uint64_t);
+
+BENCHMARK_TEMPLATE(BM_bitwise, LastBitSet, std::uint32_t);
+BENCHMARK_TEMPLATE(BM_bitwise, LastBitSetFallback, std::uint32_t);
+BENCHMARK_TEMPLATE(BM_bitwise, LastBitSetStd, std::uint32_t);
+BENCHMARK_TEMPLATE(BM_bitwise, LastBitSet, std::uint64_t);
+BENCHMARK_TEMPLATE(BM_bitwise, LastBitSetFallback, std::uint64_t);
+BENCHMARK_TEMPLATE(BM_bitwise, LastBitSetStd, std::uint64_t);
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // BITWISEBENCHMARKS_H_83746501928374650192837465019283746501928
@@ -0,0 +1,121 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    compressedBitmapBenchmarks.h
+ * @brief   bws::CompressedBitmap against the dense bws::BitVectorT at several densities and
+ *          for masks made up of long runs
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef COMPRESSEDBITMAPBENCHMARKS_H_56102938475610293847561029384756102938
+#define COMPRESSEDBITMAPBENCHMARKS_H_56102938475610293847561029384756102938
+
+
+// includes
+#include <Bitwise/BitVector.h>
+#include <Bitwise/CompressedBitmap.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+
+inline constexpr std::size_t compressedMaskSize = 1ULL << 24;
+
+/**
+ * @brief The masks of the benchmarks: state.range(0) = 0, 1 and 2 are random bits with a density
+ *        of 0.01 %, 1 % and 50 %, 3 are runs with an average length and gap of 5000 bits.
+ */
+inline auto makeCompressedBenchMask(std::int64_t kind, std::mt19937::result_type seed) -> bws::BitVectorT<std::uint64_t>
+{
+  std::mt19937 gen(seed);
+  bws::BitVectorT<std::uint64_t> b(compressedMaskSize);
+
+  if(kind == 3)
+  {
+    std::uniform_int_distribution<std::size_t> lengths(1ULL, 10000ULL);
+    for(std::size_t i = lengths(gen); i < compressedMaskSize; i += lengths(gen))
+    {
+      for(const auto last = std::min(compressedMaskSize, i + lengths(gen)); i < last; ++i)
+      {
+        b[i] = true;
+      }
+    }
+    return b;
+  }
+
+  const double density = kind == 0 ? 0.0001 : kind == 1 ? 0.01 : 0.5;
+  std::bernoulli_distribution dis(density);
+  for(std::size_t i = 0ULL; i < compressedMaskSize; ++i)
+  {
+    b[i] = dis(gen);
+  }
+  return b;
+}
+
+inline void setCompressedBenchLabel(benchmark::State& state)
+{
+  static const std::string labels[] = {"density 0.01%", "density 1%", "density 50%", "runs"};
+  state.SetLabel(labels[state.range(0)]);
+}
+
+template <typename Op>
+static void BM_denseMask(benchmark::State& state)
+{
+  const auto a = makeCompressedBenchMask(state.range(0), 1U);
+  const auto b = makeCompressedBenchMask(state.range(0), 2U);
+
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(Op::apply(a, b));
+  }
+  setCompressedBenchLabel(state);
+  state.counters["bytes"] = static_cast<double>(a.capacity() / 8ULL);
+}
+
+template <typename Op>
+static void BM_compressedMask(benchmark::State& state)
+{
+  bws::CompressedBitmap a(makeCompressedBenchMask(state.range(0), 1U));
+  bws::CompressedBitmap b(makeCompressedBenchMask(state.range(0), 2U));
+
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(Op::apply(a, b));
+  }
+  setCompressedBenchLabel(state);
+  state.counters["bytes"] = static_cast<double>(a.memoryUsage());
+}
+
+/// dense vectors have no andnot of their own
+inline auto andNot(bws::BitVectorT<std::uint64_t> const& a, bws::BitVectorT<std::uint64_t> const& b) -> bws::BitVectorT<std::uint64_t>
+{
+  return a & ~b;
+}
+
+struct MaskAnd    { template <typename T> static auto apply(T const& a, T const& b) { return a & b; } };
+struct MaskOr     { template <typename T> static auto apply(T const& a, T const& b) { return a | b; } };
+struct MaskAndNot { template <typename T> static auto apply(T const& a, T const& b) { return andNot(a, b); } };
+struct MaskVisit  { template <typename T> static auto apply(T const& a, T const&)   { std::size_t sum = 0ULL; a.forEachSetBit([&sum](std::size_t pos) { sum += pos; }); return sum; } };
+
+BENCHMARK_TEMPLATE(BM_denseMask, MaskAnd)->DenseRange(0, 3);
+BENCHMARK_TEMPLATE(BM_compressedMask, MaskAnd)->DenseRange(0, 3);
+BENCHMARK_TEMPLATE(BM_denseMask, MaskOr)->DenseRange(0, 3);
+BENCHMARK_TEMPLATE(BM_compressedMask, MaskOr)->DenseRange(0, 3);
+BENCHMARK_TEMPLATE(BM_denseMask, MaskAndNot)->DenseRange(0, 3);
+BENCHMARK_TEMPLATE(BM_compressedMask, MaskAndNot)->DenseRange(0, 3);
+BENCHMARK_TEMPLATE(BM_denseMask, MaskVisit)->DenseRange(0, 3);
+BENCHMARK_TEMPLATE(BM_compressedMask, MaskVisit)->DenseRange(0, 3);
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // COMPRESSEDBITMAPBENCHMARKS_H_56102938475610293847561029384756102938
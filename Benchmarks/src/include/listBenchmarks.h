@@ -0,0 +1,120 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    listBenchmarks.h
+ * @brief   concurrent insertions and removals on cctools::ThreadsafeList compared to
+ *          a std::list guarded by a single mutex
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef LISTBENCHMARKS_H_82736450192837465019283746501928374650192
+#define LISTBENCHMARKS_H_82736450192837465019283746501928374650192
+
+
+// includes
+#include <ConcurrencyTools/List.h>
+
+#include <cstddef>
+#include <future>
+#include <list>
+#include <mutex>
+#include <vector>
+
+
+inline constexpr int numListOperations  = 1 << 14;
+inline constexpr int listRemovalPeriod  = 256;
+inline constexpr int listInitialSize    = 256;
+
+/**
+ * @brief std::list with the interface of cctools::ListT used by the benchmark,
+ *        every call locks the whole list.
+ */
+template <typename T>
+class MutexList {
+
+public:
+
+  void push_front (T const& value) { std::lock_guard lck(mutex); data.push_front(value); }
+  void push_back  (T const& value) { std::lock_guard lck(mutex); data.push_back(value); }
+
+  template <typename Predicate>
+  auto remove_if (Predicate&& pred) -> std::size_t
+  {
+    std::lock_guard lck(mutex);
+    auto const sizeBefore = data.size();
+    data.remove_if(std::forward<Predicate>(pred));
+    return sizeBefore - data.size();
+  }
+
+private:
+
+  std::mutex   mutex;
+  std::list<T> data;
+};
+
+/**
+ * @brief state.range(0) threads insert numListOperations integers at both ends of a list.
+ *        Every thread periodically removes the elements it inserted since its last removal,
+ *        which traverses the whole list while the other threads keep inserting.
+ */
+template <typename ListType>
+static void BM_listInsertRemove(benchmark::State& state)
+{
+  const int numThreads     = static_cast<int>(state.range(0));
+  const int itemsPerThread = numListOperations / numThreads;
+
+  for(auto _ : state)
+  {
+    ListType list;
+    for(int i = 0; i < listInitialSize; ++i)
+    {
+      list.push_back(-1);
+    }
+
+    std::vector<std::future<std::size_t>> workers;
+    for(int t = 0; t < numThreads; ++t)
+    {
+      workers.push_back(std::async(std::launch::async, [&list, t, itemsPerThread] {
+        std::size_t numRemoved = 0ULL;
+        for(int i = 0; i < itemsPerThread; ++i)
+        {
+          if(i % 2 == 0)
+          {
+            list.push_back(t);
+          }
+          else
+          {
+            list.push_front(t);
+          }
+          if(i % listRemovalPeriod == listRemovalPeriod - 1)
+          {
+            numRemoved += list.remove_if([t](int v) { return v == t; });
+          }
+        }
+        return numRemoved;
+      }));
+    }
+
+    for(auto& worker : workers)
+    {
+      benchmark::DoNotOptimize(worker.get());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * itemsPerThread * numThreads);
+}
+
+BENCHMARK_TEMPLATE(BM_listInsertRemove, cctools::ThreadsafeList<int>)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_listInsertRemove, MutexList<int>)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // LISTBENCHMARKS_H_82736450192837465019283746501928374650192
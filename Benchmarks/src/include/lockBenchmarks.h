@@ -0,0 +1,146 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    lockBenchmarks.h
+ * @brief   contention matrix of the mutex types in Locks.h against std::mutex and
+ *          std::shared_mutex: number of threads x share of reads
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef LOCKBENCHMARKS_H_29384756102938475610293847561029384756102
+#define LOCKBENCHMARKS_H_29384756102938475610293847561029384756102
+
+
+// includes
+#include <ConcurrencyTools/HashMap.h>
+#include <ConcurrencyTools/Locks.h>
+
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+
+inline constexpr int numLockOperations = 1 << 16;
+inline constexpr int lockedMapSize     = 1024;
+
+/**
+ * @brief state.range(0) threads increment a shared counter numLockOperations times in total.
+ *        The critical section is a single increment, so the result is the pure lock overhead
+ *        under contention.
+ */
+template <typename Mutex>
+static void BM_lockCounter(benchmark::State& state)
+{
+  const int numThreads     = static_cast<int>(state.range(0));
+  const int itemsPerThread = numLockOperations / numThreads;
+
+  for(auto _ : state)
+  {
+    Mutex         mutex;
+    std::uint64_t counter = 0ULL;
+
+    std::vector<std::future<void>> workers;
+    for(int t = 0; t < numThreads; ++t)
+    {
+      workers.push_back(std::async(std::launch::async, [&mutex, &counter, itemsPerThread] {
+        for(int i = 0; i < itemsPerThread; ++i)
+        {
+          std::lock_guard lck(mutex);
+          ++counter;
+        }
+      }));
+    }
+    for(auto& worker : workers)
+    {
+      worker.get();
+    }
+    benchmark::DoNotOptimize(counter);
+  }
+  state.SetItemsProcessed(state.iterations() * itemsPerThread * numThreads);
+}
+
+/**
+ * @brief state.range(0) threads access a ThreadsafeHashMap guarded by Mutex, state.range(1)
+ *        percent of the accesses are lookups, the others replace a value.
+ */
+template <typename Mutex>
+static void BM_lockedHashMap(benchmark::State& state)
+{
+  const int numThreads     = static_cast<int>(state.range(0));
+  const int readPercent    = static_cast<int>(state.range(1));
+  const int itemsPerThread = numLockOperations / numThreads;
+
+  cctools::ThreadsafeHashMap<int, int, std::hash<int>, Mutex> map(127ULL);
+  for(int i = 0; i < lockedMapSize; ++i)
+  {
+    map.insertOrReplace(i, i);
+  }
+
+  for(auto _ : state)
+  {
+    std::vector<std::future<int>> workers;
+    for(int t = 0; t < numThreads; ++t)
+    {
+      workers.push_back(std::async(std::launch::async, [&map, t, readPercent, itemsPerThread] {
+        int numFound = 0;
+        for(int i = 0; i < itemsPerThread; ++i)
+        {
+          const int key = (i * 7 + t) % lockedMapSize;
+          if(i % 100 < readPercent)
+          {
+            numFound += map.contains(key) ? 1 : 0;
+          }
+          else
+          {
+            map.insertOrReplace(key, i);
+          }
+        }
+        return numFound;
+      }));
+    }
+    for(auto& worker : workers)
+    {
+      benchmark::DoNotOptimize(worker.get());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * itemsPerThread * numThreads);
+}
+
+/// threads x share of reads in percent
+static void lockContentionMatrix(benchmark::internal::Benchmark* b)
+{
+  for(const int numThreads : {1, 2, 4, 8, 16})
+  {
+    for(const int readPercent : {0, 90, 99})
+    {
+      b->Args({numThreads, readPercent});
+    }
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_lockCounter, std::mutex)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_lockCounter, std::shared_mutex)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_lockCounter, cctools::SpinLock)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_lockCounter, cctools::SharedSpinLock)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_lockCounter, cctools::HybridMutex)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_lockedHashMap, std::mutex)->Apply(lockContentionMatrix)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_lockedHashMap, std::shared_mutex)->Apply(lockContentionMatrix)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_lockedHashMap, cctools::SpinLock)->Apply(lockContentionMatrix)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_lockedHashMap, cctools::SharedSpinLock)->Apply(lockContentionMatrix)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_lockedHashMap, cctools::HybridMutex)->Apply(lockContentionMatrix)->UseRealTime();
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // LOCKBENCHMARKS_H_29384756102938475610293847561029384756102
@@ -0,0 +1,136 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    packedIntVectorBenchmarks.h
+ * @brief   sequential decoding of a bws::PackedIntVector by blocks and value by value, against
+ *          copying an unpacked std::vector<std::uint32_t>
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef PACKEDINTVECTORBENCHMARKS_H_10293847561029384756102938475610293847
+#define PACKEDINTVECTORBENCHMARKS_H_10293847561029384756102938475610293847
+
+
+// includes
+#include <Bitwise/PackedIntVector.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+inline constexpr std::size_t packedBenchSize = 1ULL << 20;
+
+template <typename Vector>
+inline void fillPackedBenchVector(Vector& v)
+{
+  std::mt19937 gen(1U);
+  std::uniform_int_distribution<std::uint32_t> dis(0U, v.maxValue());
+  for(std::size_t i = 0ULL; i < v.size(); ++i)
+  {
+    v[i] = dis(gen);
+  }
+}
+
+inline void setPackedBenchCounters(benchmark::State& state, std::size_t numBytes)
+{
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * packedBenchSize));
+  state.counters["bytes"] = static_cast<double>(numBytes);
+}
+
+template <std::size_t Bits>
+static void BM_packedDecode(benchmark::State& state)
+{
+  bws::PackedIntVector<Bits> v(packedBenchSize);
+  fillPackedBenchVector(v);
+  std::vector<std::uint32_t> out(packedBenchSize);
+
+  for(auto _ : state)
+  {
+    v.decode(out.data());
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  setPackedBenchCounters(state, v.capacity() * Bits / 8ULL);
+}
+
+template <std::size_t Bits>
+static void BM_packedDecodeRuntimeWidth(benchmark::State& state)
+{
+  bws::PackedIntVector<> v(Bits, packedBenchSize);
+  fillPackedBenchVector(v);
+  std::vector<std::uint32_t> out(packedBenchSize);
+
+  for(auto _ : state)
+  {
+    v.decode(out.data());
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  setPackedBenchCounters(state, v.capacity() * Bits / 8ULL);
+}
+
+template <std::size_t Bits>
+static void BM_packedGet(benchmark::State& state)
+{
+  bws::PackedIntVector<Bits> v(packedBenchSize);
+  fillPackedBenchVector(v);
+  std::vector<std::uint32_t> out(packedBenchSize);
+
+  for(auto _ : state)
+  {
+    for(std::size_t i = 0ULL; i < packedBenchSize; ++i)
+    {
+      out[i] = v.get(i);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  setPackedBenchCounters(state, v.capacity() * Bits / 8ULL);
+}
+
+template <std::size_t Bits>
+static void BM_unpackedCopy(benchmark::State& state)
+{
+  bws::PackedIntVector<Bits> v(packedBenchSize);
+  fillPackedBenchVector(v);
+  std::vector<std::uint32_t> in(packedBenchSize);
+  v.decode(in.data());
+  std::vector<std::uint32_t> out(packedBenchSize);
+
+  for(auto _ : state)
+  {
+    std::copy(in.begin(), in.end(), out.begin());
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  setPackedBenchCounters(state, in.size() * sizeof(std::uint32_t));
+}
+
+BENCHMARK_TEMPLATE(BM_packedDecode, 3);
+BENCHMARK_TEMPLATE(BM_packedDecodeRuntimeWidth, 3);
+BENCHMARK_TEMPLATE(BM_packedGet, 3);
+BENCHMARK_TEMPLATE(BM_packedDecode, 7);
+BENCHMARK_TEMPLATE(BM_packedDecodeRuntimeWidth, 7);
+BENCHMARK_TEMPLATE(BM_packedGet, 7);
+BENCHMARK_TEMPLATE(BM_packedDecode, 12);
+BENCHMARK_TEMPLATE(BM_packedDecodeRuntimeWidth, 12);
+BENCHMARK_TEMPLATE(BM_packedGet, 12);
+BENCHMARK_TEMPLATE(BM_packedDecode, 20);
+BENCHMARK_TEMPLATE(BM_packedDecodeRuntimeWidth, 20);
+BENCHMARK_TEMPLATE(BM_packedGet, 20);
+BENCHMARK_TEMPLATE(BM_unpackedCopy, 20);
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // PACKEDINTVECTORBENCHMARKS_H_10293847561029384756102938475610293847
@@ -0,0 +1,244 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    queueBenchmarks.h
+ * @brief   throughput of the threadsafe queues of cctools, the single-producer single-consumer
+ *          channel against cctools::Queue and the cost of prioritized insertion against the backlog depth
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef QUEUEBENCHMARKS_H_19283746501928374650192837465019283746501
+#define QUEUEBENCHMARKS_H_19283746501928374650192837465019283746501
+
+
+// includes
+#include <ConcurrencyTools/BoundedMPMCQueue.h>
+#include <ConcurrencyTools/BoundedSPSCQueue.h>
+#include <ConcurrencyTools/ThreadsafeQueue.h>
+
+#include <algorithm>
+#include <future>
+#include <iterator>
+#include <random>
+#include <vector>
+
+
+inline constexpr int numQueueItems      = 1 << 16;
+inline constexpr int queueBenchCapacity = 1024;
+
+/**
+ * @brief Moves numQueueItems integers through a queue of fixed capacity using
+ *        state.range(0) producers and the same number of consumers.
+ */
+template <typename QueueType>
+static void BM_queueProducersConsumers(benchmark::State& state)
+{
+  const int numThreads      = static_cast<int>(state.range(0));
+  const int itemsPerThread  = numQueueItems / numThreads;
+
+  for(auto _ : state)
+  {
+    QueueType queue(queueBenchCapacity);
+
+    std::vector<std::future<long long>> consumers;
+    std::vector<std::future<void>>      producers;
+    for(int t = 0; t < numThreads; ++t)
+    {
+      consumers.push_back(std::async(std::launch::async, [&queue, itemsPerThread] {
+        long long sum = 0;
+        for(int i = 0; i < itemsPerThread; ++i)
+        {
+          int v;
+          queue.waitAndPop(v);
+          sum += v;
+        }
+        return sum;
+      }));
+      producers.push_back(std::async(std::launch::async, [&queue, itemsPerThread] {
+        for(int i = 0; i < itemsPerThread; ++i)
+        {
+          queue.push(i);
+        }
+      }));
+    }
+
+    for(auto& producer : producers)
+    {
+      producer.get();
+    }
+    for(auto& consumer : consumers)
+    {
+      benchmark::DoNotOptimize(consumer.get());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * itemsPerThread * numThreads);
+}
+
+BENCHMARK_TEMPLATE(BM_queueProducersConsumers, cctools::Queue<int>)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_queueProducersConsumers, cctools::BoundedMPMCQueue<int>)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_queueProducersConsumers, cctools::BoundedSPSCQueue<int>)->Arg(1)->UseRealTime();
+
+
+/**
+ * @brief One producer pushes numQueueItems integers in batches of state.range(0) elements
+ *        into the queue, while one consumer drains it in batches of the same size.
+ *        A batch size of one uses the single element push and waitAndPop.
+ */
+template <typename QueueType>
+static void BM_queueBulkIngest(benchmark::State& state)
+{
+  const auto batchSize  = static_cast<std::size_t>(state.range(0));
+  const auto numBatches = numQueueItems / static_cast<int>(batchSize);
+
+  std::vector<int> batch(batchSize, 1);
+
+  for(auto _ : state)
+  {
+    QueueType queue(queueBenchCapacity);
+
+    auto consumer = std::async(std::launch::async, [&queue, batchSize, numBatches] {
+      std::vector<int> popped;
+      popped.reserve(batchSize);
+      long long sum = 0;
+      for(long long numPopped = 0; numPopped < static_cast<long long>(numBatches) * batchSize;)
+      {
+        popped.clear();
+        if(batchSize == 1ULL)
+        {
+          int v;
+          queue.waitAndPop(v);
+          popped.push_back(v);
+        }
+        else
+        {
+          queue.waitAndPopBulk(std::back_inserter(popped), batchSize);
+        }
+        numPopped += static_cast<long long>(popped.size());
+        for(const int v : popped)
+        {
+          sum += v;
+        }
+      }
+      return sum;
+    });
+
+    for(int b = 0; b < numBatches; ++b)
+    {
+      if(batchSize == 1ULL)
+      {
+        queue.push(batch.front());
+      }
+      else
+      {
+        queue.pushBulk(batch);
+      }
+    }
+    benchmark::DoNotOptimize(consumer.get());
+  }
+  state.SetItemsProcessed(state.iterations() * numBatches * static_cast<long long>(batchSize));
+}
+
+BENCHMARK_TEMPLATE(BM_queueBulkIngest, cctools::Queue<int>)->RangeMultiplier(4)->Range(1, 256)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_queueBulkIngest, cctools::BoundedSPSCQueue<int>)->RangeMultiplier(4)->Range(1, 256)->UseRealTime();
+
+
+/**
+ * @brief Like BM_queueBulkIngest, but the producer writes and the consumer reads up to state.range(0)
+ *        elements in place through the write and read spans of a BoundedSPSCQueue.
+ */
+static void BM_spscQueueSpans(benchmark::State& state)
+{
+  const auto batchSize = static_cast<std::size_t>(state.range(0));
+
+  for(auto _ : state)
+  {
+    cctools::BoundedSPSCQueue<int> queue(queueBenchCapacity);
+
+    auto consumer = std::async(std::launch::async, [&queue] {
+      long long sum = 0;
+      for(int numPopped = 0; numPopped < numQueueItems;)
+      {
+        auto filled = queue.readSpan();
+        if(filled.empty())
+        {
+          int v;
+          queue.waitAndPop(v);
+          sum += v;
+          ++numPopped;
+          continue;
+        }
+        for(const int v : filled)
+        {
+          sum += v;
+        }
+        numPopped += static_cast<int>(filled.size());
+        queue.commitRead(filled.size());
+      }
+      return sum;
+    });
+
+    for(int numPushed = 0; numPushed < numQueueItems;)
+    {
+      auto free = queue.writeSpan();
+      const auto n = (std::min)({free.size(), batchSize, static_cast<std::size_t>(numQueueItems - numPushed)});
+      if(n == 0ULL)
+      {
+        queue.push(1);
+        ++numPushed;
+        continue;
+      }
+      std::fill_n(free.begin(), n, 1);
+      queue.commitWrite(n);
+      numPushed += static_cast<int>(n);
+    }
+    benchmark::DoNotOptimize(consumer.get());
+  }
+  state.SetItemsProcessed(state.iterations() * numQueueItems);
+}
+
+BENCHMARK(BM_spscQueueSpans)->RangeMultiplier(4)->Range(1, 256)->UseRealTime();
+
+
+/**
+ * @brief Pushes one element into and pops one element from a prioritized queue
+ *        that already holds state.range(0) elements of random priority.
+ */
+template <typename QueueType>
+static void BM_priorityQueuePushPopBacklog(benchmark::State& state)
+{
+  const auto backlog = static_cast<int>(state.range(0));
+
+  std::mt19937                       gen(42);
+  std::uniform_int_distribution<int> dist(0, 1 << 20);
+
+  QueueType queue;
+  for(int i = 0; i < backlog; ++i)
+  {
+    queue.push(dist(gen));
+  }
+
+  int v;
+  for(auto _ : state)
+  {
+    queue.push(dist(gen));
+    queue.tryPop(v);
+    benchmark::DoNotOptimize(v);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_priorityQueuePushPopBacklog, cctools::PriorityQueue<int>)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK_TEMPLATE(BM_priorityQueuePushPopBacklog, cctools::HeapPriorityQueue<int>)->RangeMultiplier(8)->Range(8, 1 << 15);
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // QUEUEBENCHMARKS_H_19283746501928374650192837465019283746501
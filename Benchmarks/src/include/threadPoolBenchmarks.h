@@ -0,0 +1,242 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    threadPoolBenchmarks.h
+ * @brief   throughput of the different queueing policies of cctools::ThreadPool,
+ *          submit-to-start latency of the wait strategies, the overhead of metrics
+ *          and the cost of wrapping tasks into a cctools::FunctionWrapper
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef THREADPOOLBENCHMARKS_H_80517263940182736451029384756102938475610
+#define THREADPOOLBENCHMARKS_H_80517263940182736451029384756102938475610
+
+
+// includes
+#include <ConcurrencyTools/ThreadPool.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+
+inline constexpr int numPoolTasks = 10000;
+
+/**
+ * @brief Submits many small tasks from the main thread and waits for all results.
+ */
+template <cctools::queuePolicy QueuePolicy>
+static void BM_threadPoolSubmitAndWait(benchmark::State& state)
+{
+  cctools::WaitableThreadPool<QueuePolicy> pool(static_cast<std::size_t>(state.range(0)));
+
+  std::vector<std::future<int>> results;
+  results.reserve(numPoolTasks);
+
+  for(auto _ : state)
+  {
+    results.clear();
+    for(int t = 0; t < numPoolTasks; ++t)
+    {
+      results.push_back(pool.submit([t] { return t * 2; }));
+    }
+    for(auto& result : results)
+    {
+      benchmark::DoNotOptimize(result.get());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * numPoolTasks);
+}
+
+BENCHMARK_TEMPLATE(BM_threadPoolSubmitAndWait, cctools::queuePolicy::fifo)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_threadPoolSubmitAndWait, cctools::queuePolicy::prioritized)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_threadPoolSubmitAndWait, cctools::queuePolicy::heapPrioritized)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_threadPoolSubmitAndWait, cctools::queuePolicy::workStealing)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+
+/**
+ * @brief Submits tasks which in turn submit subtasks from within the working threads.
+ */
+template <cctools::queuePolicy QueuePolicy>
+static void BM_threadPoolNestedSubmit(benchmark::State& state)
+{
+  constexpr int numOuterTasks = 100;
+  constexpr int numInnerTasks = numPoolTasks / numOuterTasks;
+
+  cctools::NonWaitableThreadPool<QueuePolicy> pool(static_cast<std::size_t>(state.range(0)));
+
+  for(auto _ : state)
+  {
+    std::atomic<int>   counter {0};
+    std::promise<void> allDone;
+
+    for(int t = 0; t < numOuterTasks; ++t)
+    {
+      pool.submit([&pool, &counter, &allDone] {
+        for(int s = 0; s < numInnerTasks; ++s)
+        {
+          pool.submit([&counter, &allDone] {
+            if(++counter == numOuterTasks * numInnerTasks)
+            {
+              allDone.set_value();
+            }
+          });
+        }
+      });
+    }
+    allDone.get_future().wait();
+  }
+  state.SetItemsProcessed(state.iterations() * numPoolTasks);
+}
+
+BENCHMARK_TEMPLATE(BM_threadPoolNestedSubmit, cctools::queuePolicy::fifo)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_threadPoolNestedSubmit, cctools::queuePolicy::prioritized)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_threadPoolNestedSubmit, cctools::queuePolicy::heapPrioritized)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_threadPoolNestedSubmit, cctools::queuePolicy::workStealing)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+
+/**
+ * @brief Measures the time from submitting a task to its start. Bursts of state.range(0) tasks are
+ *        submitted into a pool of four threads, separated by a busy waiting gap of state.range(1)
+ *        microseconds, i.e. the load decreases with the gap. During longer gaps the threads become
+ *        idle and the first tasks of a burst have to wake up a waiting thread. The mean latency is
+ *        reported in the counter latency_ns.
+ */
+template <cctools::queuePolicy QueuePolicy, bool Spinning>
+static void BM_threadPoolSubmitToStartLatency(benchmark::State& state)
+{
+  using clock = std::chrono::steady_clock;
+
+  const auto burstSize = static_cast<int>(state.range(0));
+  const auto gap       = std::chrono::microseconds{state.range(1)};
+  cctools::NonWaitableThreadPool<QueuePolicy> pool(4ULL);
+  pool.setWaitStrategy(Spinning ? cctools::WaitStrategy::adaptive() : cctools::WaitStrategy::blocking());
+
+  std::atomic<long long> totalLatency {0LL};
+  long long              numTasks {0LL};
+  for(auto _ : state)
+  {
+    for(const auto gapEnd = clock::now() + gap; clock::now() < gapEnd;)
+    {
+    }
+
+    std::atomic<int> numStarted {0};
+    for(int t = 0; t < burstSize; ++t)
+    {
+      pool.submit([&totalLatency, &numStarted, submitted = clock::now()] {
+        totalLatency += std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - submitted).count();
+        ++numStarted;
+      });
+    }
+    while(numStarted.load() < burstSize)
+    {
+      std::this_thread::yield();
+    }
+    numTasks += burstSize;
+  }
+
+  state.counters["latency_ns"] = benchmark::Counter(static_cast<double>(totalLatency.load()) / static_cast<double>(numTasks));
+}
+
+BENCHMARK_TEMPLATE(BM_threadPoolSubmitToStartLatency, cctools::queuePolicy::fifo, false)->ArgsProduct({{1, 64}, {0, 5, 50, 500}})->UseRealTime();
+BENCHMARK_TEMPLATE(BM_threadPoolSubmitToStartLatency, cctools::queuePolicy::fifo, true)->ArgsProduct({{1, 64}, {0, 5, 50, 500}})->UseRealTime();
+BENCHMARK_TEMPLATE(BM_threadPoolSubmitToStartLatency, cctools::queuePolicy::workStealing, false)->ArgsProduct({{1, 64}, {0, 5, 50, 500}})->UseRealTime();
+BENCHMARK_TEMPLATE(BM_threadPoolSubmitToStartLatency, cctools::queuePolicy::workStealing, true)->ArgsProduct({{1, 64}, {0, 5, 50, 500}})->UseRealTime();
+BENCHMARK_TEMPLATE(BM_threadPoolSubmitToStartLatency, cctools::queuePolicy::boundedLockFree, false)->ArgsProduct({{1, 64}, {0, 5, 50, 500}})->UseRealTime();
+BENCHMARK_TEMPLATE(BM_threadPoolSubmitToStartLatency, cctools::queuePolicy::boundedLockFree, true)->ArgsProduct({{1, 64}, {0, 5, 50, 500}})->UseRealTime();
+
+
+/**
+ * @brief Cost of collecting metrics: submits small fire and forget tasks into pools with and
+ *        without metrics.
+ */
+template <cctools::queuePolicy QueuePolicy, cctools::metricsPolicy Metrics>
+static void BM_threadPoolMetricsOverhead(benchmark::State& state)
+{
+  cctools::NonWaitableThreadPool<QueuePolicy, Metrics> pool(static_cast<std::size_t>(state.range(0)));
+
+  for(auto _ : state)
+  {
+    std::atomic<int> counter {0};
+    for(int t = 0; t < numPoolTasks; ++t)
+    {
+      pool.submit([&counter] { ++counter; });
+    }
+    while(counter.load() < numPoolTasks)
+    {
+      std::this_thread::yield();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * numPoolTasks);
+}
+
+BENCHMARK_TEMPLATE(BM_threadPoolMetricsOverhead, cctools::queuePolicy::fifo, cctools::metricsPolicy::disabled)->Arg(4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_threadPoolMetricsOverhead, cctools::queuePolicy::fifo, cctools::metricsPolicy::enabled)->Arg(4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_threadPoolMetricsOverhead, cctools::queuePolicy::workStealing, cctools::metricsPolicy::disabled)->Arg(4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_threadPoolMetricsOverhead, cctools::queuePolicy::workStealing, cctools::metricsPolicy::enabled)->Arg(4)->UseRealTime();
+
+
+/**
+ * @brief Wraps a callable of state.range(0) bytes into a FunctionWrapper, moves it once
+ *        and calls it. Callables beyond FunctionWrapper::inlineSize are allocated on the heap.
+ */
+template <std::size_t CaptureSize>
+static void BM_functionWrapperConstructMoveCall(benchmark::State& state)
+{
+  std::array<char, CaptureSize> capture {};
+  int result = 0;
+
+  for(auto _ : state)
+  {
+    cctools::FunctionWrapper f1([&result, capture] { result += capture.back(); });
+    cctools::FunctionWrapper f2(std::move(f1));
+    f2();
+  }
+  benchmark::DoNotOptimize(result);
+}
+
+BENCHMARK_TEMPLATE(BM_functionWrapperConstructMoveCall, 8);
+BENCHMARK_TEMPLATE(BM_functionWrapperConstructMoveCall, 32);
+BENCHMARK_TEMPLATE(BM_functionWrapperConstructMoveCall, 128);
+
+
+/**
+ * @brief Submits small fire and forget tasks into a non-waitable pool, whose queue does not
+ *        allocate either, i.e. the submission is free of heap allocations.
+ */
+static void BM_nonWaitableThreadPoolSubmitSmallTasks(benchmark::State& state)
+{
+  cctools::NonWaitableThreadPool<cctools::queuePolicy::boundedLockFree> pool(static_cast<std::size_t>(state.range(0)));
+
+  for(auto _ : state)
+  {
+    std::atomic<int> counter {0};
+    for(int t = 0; t < numPoolTasks; ++t)
+    {
+      pool.submit([&counter] { ++counter; });
+    }
+    while(counter.load() < numPoolTasks)
+    {
+      std::this_thread::yield();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * numPoolTasks);
+}
+
+BENCHMARK(BM_nonWaitableThreadPoolSubmitSmallTasks)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // THREADPOOLBENCHMARKS_H_80517263940182736451029384756102938475610
@@ -0,0 +1,95 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timerBenchmarks.h
+ * @brief   cost of scheduling and cancelling timers of a cctools::TimerWheel
+ *          and its firing jitter under many active timers
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef TIMERBENCHMARKS_H_30192837465019283746501928374650192837465019
+#define TIMERBENCHMARKS_H_30192837465019283746501928374650192837465019
+
+
+// includes
+#include <ConcurrencyTools/TimerWheel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <vector>
+
+
+/**
+ * @brief Keeps state.range(0) timers active and schedules and cancels one more timer per iteration.
+ */
+static void BM_timerWheelScheduleCancel(benchmark::State& state)
+{
+  cctools::TimerWheel wheel;
+  for(long long i = 0LL; i < state.range(0); ++i)
+  {
+    wheel.scheduleAfter(std::chrono::seconds(60) + std::chrono::milliseconds(i), [] {});
+  }
+
+  for(auto _ : state)
+  {
+    const auto id = wheel.scheduleAfter(std::chrono::milliseconds(100), [] {});
+    benchmark::DoNotOptimize(wheel.cancel(id));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_timerWheelScheduleCancel)->Arg(0)->Arg(1000)->Arg(100000);
+
+
+/**
+ * @brief Measures how late a probe timer fires while state.range(0) background timers are active.
+ *        The background timers are spread over one second and re-armed periodically, so the
+ *        wheel thread keeps firing and cascading timers during the measurement.
+ */
+static void BM_timerWheelJitter(benchmark::State& state)
+{
+  using clock = std::chrono::steady_clock;
+
+  cctools::TimerWheel wheel;
+  std::vector<cctools::TimerWheel::TimerId> background;
+  for(long long i = 0LL; i < state.range(0); ++i)
+  {
+    background.push_back(wheel.schedulePeriodic(std::chrono::milliseconds(1 + i % 1000), [] {}));
+  }
+
+  long long totalLateness = 0LL;
+  long long maxLateness   = 0LL;
+  for(auto _ : state)
+  {
+    std::promise<clock::time_point> fired;
+    const auto due = clock::now() + std::chrono::milliseconds(5);
+    wheel.scheduleAfter(std::chrono::milliseconds(5), [&fired] { fired.set_value(clock::now()); });
+    const long long lateness = std::chrono::duration_cast<std::chrono::microseconds>(fired.get_future().get() - due).count();
+    totalLateness += lateness;
+    maxLateness    = (std::max)(maxLateness, lateness);
+  }
+
+  for(auto const id : background)
+  {
+    wheel.cancel(id);
+  }
+  state.counters["mean_lateness_us"] = benchmark::Counter(static_cast<double>(totalLateness) / static_cast<double>(state.iterations()));
+  state.counters["max_lateness_us"]  = benchmark::Counter(static_cast<double>(maxLateness));
+}
+
+BENCHMARK(BM_timerWheelJitter)->Arg(0)->Arg(10000)->Arg(100000)->Iterations(100)->UseRealTime();
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // TIMERBENCHMARKS_H_30192837465019283746501928374650192837465019
@@ -24,6 +24,9 @@
 #include "BitProxyTest.h"
 #include "BitFieldIteratorTest.h"
 #include "BitVectorTest.h"
+#include "RankSelectIndexTest.h"
+#include "CompressedBitmapTest.h"
+#include "PackedIntVectorTest.h"
 #include "BitFieldTest.h"
 
 // Benchmark
@@ -64,10 +67,23 @@
 // ConcurrencyTools
 #include "ThreadsafeQueueTest.h"
 #include "ThreadsafePriorityQueueTest.h"
+#include "ThreadsafeHeapPriorityQueueTest.h"
 #include "HashMapTest.h"
+#include "ConcurrentHashMapTest.h"
 #include "ThreadPoolTest.h"
+#include "ThreadPlacementTest.h"
+#include "FunctionWrapperTest.h"
 #include "OneShotEventTest.h"
+#include "FutureTest.h"
+#include "ParallelAlgorithmsTest.h"
+#include "TimerWheelTest.h"
+#include "WatchdogTest.h"
+#include "MetricsTest.h"
 #include "ListTest.h"
+#include "BoundedMPMCQueueTest.h"
+#include "BoundedSPSCQueueTest.h"
+#include "LocksTest.h"
+#include "TaskTest.h"
 #endif
 // XercesUtils
 //#include "XercesUtilsTest.h"
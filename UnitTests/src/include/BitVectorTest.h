@@ -19,7 +19,11 @@
 // includes
 #include <Bitwise/BitVector.h>
 
+#include <algorithm>
+#include <numeric>
 #include <random>
+#include <stdexcept>
+#include <utility>
 #include <vector>
  
 using BitVector8 = bws::BitVectorT<std::uint8_t>;
@@ -534,6 +538,242 @@ TEST(BitVector, accessOutOfBounds)
   );
 }
 
+
+TEST(BitVector, assignBelowOneRegion)
+{
+  BitVector8 b(5);
+  EXPECT_FALSE(b.any());
+
+  b.assign(5, true);
+  EXPECT_EQ(b.count(), 5ULL);
+
+  bws::BitVectorT<std::uint64_t> b64;
+  b64.assign(64, true);
+  EXPECT_EQ(b64.size(), 64ULL);
+  EXPECT_TRUE(b64.all());
+}
+
+namespace {
+
+template <typename IntType>
+auto makeRandomBits(std::size_t size, double density, std::mt19937& gen) -> std::pair<bws::BitVectorT<IntType>, std::vector<bool>>
+{
+  std::bernoulli_distribution distrib(density);
+  bws::BitVectorT<IntType> b(size);
+  std::vector<bool> vb(size);
+  for(std::size_t i{}; i < size; ++i)
+  {
+    const bool val = distrib(gen);
+    b[i]  = val;
+    vb[i] = val;
+  }
+
+  return {std::move(b), std::move(vb)};
+}
+
+template <typename IntType>
+void expectSameBits(bws::BitVectorT<IntType> const& b, std::vector<bool> const& vb)
+{
+  ASSERT_EQ(b.size(), vb.size());
+  for(std::size_t i{}; i < vb.size(); ++i)
+  {
+    ASSERT_EQ(static_cast<bool>(b[i]), static_cast<bool>(vb[i])) << "at index " << i;
+  }
+}
+
+template <typename IntType>
+void expectBitwiseOperatorsMatch(std::size_t size)
+{
+  std::mt19937 gen(static_cast<std::mt19937::result_type>(size));
+  auto [a, va] = makeRandomBits<IntType>(size, 0.5, gen);
+  auto [b, vb] = makeRandomBits<IntType>(size, 0.3, gen);
+
+  std::vector<bool> vAnd(size), vOr(size), vXor(size), vNot(size);
+  for(std::size_t i{}; i < size; ++i)
+  {
+    vAnd[i] = va[i] && vb[i];
+    vOr[i]  = va[i] || vb[i];
+    vXor[i] = va[i] != vb[i];
+    vNot[i] = !va[i];
+  }
+
+  expectSameBits(a & b, vAnd);
+  expectSameBits(a | b, vOr);
+  expectSameBits(a ^ b, vXor);
+  expectSameBits(~a, vNot);
+
+  EXPECT_EQ(a.count(), static_cast<std::size_t>(std::count(va.begin(), va.end(), true)));
+  EXPECT_EQ((~a).count(), size - a.count());
+}
+
+template <typename IntType>
+void expectFindMatches(std::size_t size, double density)
+{
+  std::mt19937 gen(static_cast<std::mt19937::result_type>(size));
+  auto [b, vb] = makeRandomBits<IntType>(size, density, gen);
+
+  std::vector<std::size_t> expected;
+  for(std::size_t i{}; i < size; ++i)
+  {
+    if(vb[i])
+    {
+      expected.push_back(i);
+    }
+  }
+
+  std::vector<std::size_t> found;
+  for(auto pos = b.findFirst(); pos != b.npos; pos = b.findNext(pos))
+  {
+    found.push_back(pos);
+  }
+  EXPECT_EQ(found, expected);
+  EXPECT_EQ(b.any(), !expected.empty());
+
+  const auto setBits = b.setBits();
+  EXPECT_EQ(std::vector<std::size_t>(setBits.begin(), setBits.end()), expected);
+
+  std::vector<std::size_t> visited;
+  b.forEachSetBit([&visited](std::size_t pos) { visited.push_back(pos); });
+  EXPECT_EQ(visited, expected);
+}
+
+template <typename IntType>
+void expectShiftsMatch(std::size_t size)
+{
+  std::mt19937 gen(static_cast<std::mt19937::result_type>(size));
+  auto [b, vb] = makeRandomBits<IntType>(size, 0.5, gen);
+
+  for(const auto n : std::initializer_list<std::size_t>{0ULL, 1ULL, 7ULL, 8ULL, 63ULL, 64ULL, 65ULL, 200ULL, size - 1ULL, size, size + 5ULL})
+  {
+    std::vector<bool> left(size), right(size);
+    for(std::size_t i{}; i < size; ++i)
+    {
+      left[i]  = i >= n && vb[i - n];
+      right[i] = i + n < size && vb[i + n];
+    }
+    expectSameBits(b << n, left);
+    expectSameBits(b >> n, right);
+  }
+}
+
+}   // namespace
+
+TEST(BitVector, bitwiseOperatorsMatchReference)
+{
+  expectBitwiseOperatorsMatch<std::uint8_t>(1ULL);
+  expectBitwiseOperatorsMatch<std::uint8_t>(10007ULL);
+  expectBitwiseOperatorsMatch<std::uint16_t>(4099ULL);
+  expectBitwiseOperatorsMatch<std::uint32_t>(2048ULL);
+  expectBitwiseOperatorsMatch<std::uint64_t>(100003ULL);
+}
+
+TEST(BitVector, findFirstAndNextMatchReference)
+{
+  expectFindMatches<std::uint8_t>(10007ULL, 0.5);
+  expectFindMatches<std::uint16_t>(10007ULL, 0.001);
+  expectFindMatches<std::uint64_t>(100003ULL, 0.0005);
+  expectFindMatches<std::uint64_t>(1000ULL, 0.0);
+  expectFindMatches<std::uint32_t>(4099ULL, 0.95);
+}
+
+TEST(BitVector, shiftsMatchReference)
+{
+  expectShiftsMatch<std::uint8_t>(1001ULL);
+  expectShiftsMatch<std::uint32_t>(777ULL);
+  expectShiftsMatch<std::uint64_t>(1000ULL);
+}
+
+TEST(BitVector, bitsBeyondSizeAreIgnored)
+{
+  bws::BitVectorT<std::uint64_t> b(70ULL, true);
+  b.pop_back();
+  b.pop_back();
+
+  // the popped bits are still set in the last region
+  EXPECT_EQ(b.count(), 68ULL);
+  EXPECT_TRUE(b.all());
+  EXPECT_EQ(b, bws::BitVectorT<std::uint64_t>(68ULL, true));
+
+  b >>= 67ULL;
+  EXPECT_EQ(b.count(), 1ULL);
+  EXPECT_EQ(b.findFirst(), 0ULL);
+  EXPECT_EQ(b.findNext(0ULL), b.npos);
+
+  b.flip();
+  EXPECT_EQ(b.count(), 67ULL);
+  EXPECT_FALSE(b.all());
+  EXPECT_EQ(b.findFirst(), 1ULL);
+}
+
+TEST(BitVector, comparisonIsWordParallel)
+{
+  std::mt19937 gen(17);
+  auto [a, va] = makeRandomBits<std::uint8_t>(100003ULL, 0.5, gen);
+  auto b = a;
+  EXPECT_EQ(a, b);
+
+  b[99999] = !b[99999];
+  EXPECT_NE(a, b);
+  b[99999] = !b[99999];
+  b.push_back(true);
+  EXPECT_NE(a, b);
+}
+
+TEST(BitVector, emptyVector)
+{
+  BitVector8 b;
+  EXPECT_EQ(b.count(), 0ULL);
+  EXPECT_TRUE(b.all());
+  EXPECT_TRUE(b.none());
+  EXPECT_EQ(b.findFirst(), b.npos);
+  EXPECT_EQ((b << 3ULL).size(), 0ULL);
+  EXPECT_EQ(b, ~b);
+}
+
+TEST(BitVector, bitwiseOperatorsSizeMismatchThrows)
+{
+  BitVector16 a(10ULL);
+  BitVector16 b(11ULL);
+  EXPECT_THROW(a &= b, std::invalid_argument);
+  EXPECT_THROW(a | b, std::invalid_argument);
+  EXPECT_THROW(a ^ b, std::invalid_argument);
+}
+
+TEST(BitVector, wordIgnoresUnusedBits)
+{
+  bws::BitVectorT<std::uint16_t> b(70ULL);
+  b.flip();
+  b[3] = false;
+
+  ASSERT_EQ(b.numWords(), 2ULL);
+  EXPECT_EQ(b.word(0ULL), ~std::uint64_t{0b1000});
+  EXPECT_EQ(b.word(1ULL), 0b111111ULL);
+}
+
+TEST(BitVector, setBitsIgnoreUnusedBits)
+{
+  BitVector8 b(10ULL);
+  b.flip();
+
+  std::vector<std::size_t> expected(10ULL);
+  std::iota(expected.begin(), expected.end(), 0ULL);
+
+  const auto setBits = b.setBits();
+  EXPECT_EQ(std::vector<std::size_t>(setBits.begin(), setBits.end()), expected);
+
+  std::size_t numVisited = 0ULL;
+  b.forEachSetBit([&numVisited](std::size_t) { ++numVisited; });
+  EXPECT_EQ(numVisited, 10ULL);
+}
+
+TEST(BitVector, setBitsOfEmptyVector)
+{
+  const BitVector16 empty;
+  EXPECT_TRUE(empty.setBits().begin() == empty.setBits().end());
+
+  const BitVector16 zeros(1000ULL);
+  EXPECT_TRUE(zeros.setBits().begin() == zeros.setBits().end());
+}
  
  
 // *************************************************************************** // 
@@ -19,8 +19,11 @@
 // includes
 #include <Bitwise/Bitwise.h>
 
+#include <bit>
+#include <random>
 #include <string>
 #include <sstream>
+#include <type_traits>
 
 using namespace std::string_literals;
  
@@ -194,7 +197,6 @@ TEST(Bitwise, firstBitSetExpectZero)
   const auto c = bws::firstBitSet(v);
   EXPECT_EQ(c, expected);
 }
-#if 0
 
 TEST(Bitwise, firstBitSetExpect63)
 {
@@ -215,11 +217,75 @@ TEST(Bitwise, firstBitSet)
 TEST(Bitwise, firstBitSetNonOneIsSet)
 {
   constexpr std::int32_t v = 0b00000000'00000000'00000000'00000000;
-  constexpr std::size_t expected = 64ULL;
+  constexpr std::size_t expected = 32ULL;
   const auto c = bws::firstBitSet(v);
   EXPECT_EQ(c, expected);
 }
-#endif
+
+TEST(Bitwise, countBitsNegativeSignedInt)
+{
+  constexpr std::int64_t v = -1;
+  EXPECT_EQ(bws::countBits(v), 64ULL);
+  EXPECT_EQ(bws::countBits(std::int8_t{-128}), 1ULL);
+}
+
+TEST(Bitwise, lastBitSet)
+{
+  EXPECT_EQ(bws::lastBitSet(std::uint8_t{0b0010'0110}), 5ULL);
+  EXPECT_EQ(bws::lastBitSet(std::uint16_t{1}), 0ULL);
+  EXPECT_EQ(bws::lastBitSet(std::uint64_t{1} << 63), 63ULL);
+  EXPECT_EQ(bws::lastBitSet(std::int32_t{-1}), 31ULL);
+  EXPECT_EQ(bws::lastBitSet(std::uint16_t{0}), 16ULL);
+}
+
+TEST(Bitwise, bitFunctionsInConstantExpressions)
+{
+  static_assert(bws::countBits(std::uint64_t{0xF0F0'0000'0000'0001}) == 9ULL);
+  static_assert(bws::firstBitSet(std::uint64_t{1} << 40) == 40ULL);
+  static_assert(bws::firstBitSet(std::uint8_t{0}) == 8ULL);
+  static_assert(bws::lastBitSet(std::uint32_t{0x00F0'0000}) == 23ULL);
+  SUCCEED();
+}
+
+namespace {
+
+template <typename T>
+void expectBitFunctionsMatchStd()
+{
+  using U = std::make_unsigned_t<T>;
+
+  std::mt19937_64 gen(sizeof(T));
+  std::uniform_int_distribution<std::uint64_t> dis;
+  std::uniform_int_distribution<std::size_t>   shiftDis(0ULL, sizeof(T) * 8ULL - 1ULL);
+  for(int i = 0; i < 10000; ++i)
+  {
+    // shifted random values spread the lowest and highest bit over all positions
+    const auto u = static_cast<U>(static_cast<U>(dis(gen)) << shiftDis(gen));
+    const auto v = static_cast<T>(u);
+
+    ASSERT_EQ(bws::countBits(v), static_cast<std::size_t>(std::popcount(u)));
+    ASSERT_EQ(bws::firstBitSet(v), static_cast<std::size_t>(std::countr_zero(u)));
+    ASSERT_EQ(bws::details::countBitsFallback(u), bws::countBits(v));
+    ASSERT_EQ(bws::details::firstBitSetFallback(u), bws::firstBitSet(v));
+    ASSERT_EQ(bws::details::lastBitSetFallback(u), bws::lastBitSet(v));
+    if(u != U{})
+    {
+      ASSERT_EQ(bws::lastBitSet(v), sizeof(T) * 8ULL - 1ULL - static_cast<std::size_t>(std::countl_zero(u)));
+    }
+  }
+}
+
+}   // namespace
+
+TEST(Bitwise, bitFunctionsMatchStdAllWidths)
+{
+  expectBitFunctionsMatchStd<std::uint8_t>();
+  expectBitFunctionsMatchStd<std::uint16_t>();
+  expectBitFunctionsMatchStd<std::uint32_t>();
+  expectBitFunctionsMatchStd<std::uint64_t>();
+  expectBitFunctionsMatchStd<std::int16_t>();
+  expectBitFunctionsMatchStd<std::int64_t>();
+}
  
  
 // *************************************************************************** // 
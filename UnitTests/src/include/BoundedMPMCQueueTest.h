@@ -0,0 +1,270 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    BoundedMPMCQueueTest.h
+ * @brief
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef BOUNDEDMPMCQUEUETEST_H_81726354019283746501928374650192837465019
+#define BOUNDEDMPMCQUEUETEST_H_81726354019283746501928374650192837465019
+
+
+// includes
+#include "Person.h"
+#include <ConcurrencyTools/BoundedMPMCQueue.h>
+#include <ConcurrencyTools/ThreadPool.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+using namespace std::chrono_literals;
+using namespace std::string_literals;
+
+
+TEST(BoundedMPMCQueue, capacityIsRoundedUpToPowerOfTwo)
+{
+  cctools::BoundedMPMCQueue<int> queue(5);
+  EXPECT_EQ(queue.capacity(), 8ULL);
+}
+
+TEST(BoundedMPMCQueue, capacityIsAtLeastTwo)
+{
+  cctools::BoundedMPMCQueue<int> queue(1);
+  EXPECT_EQ(queue.capacity(), 2ULL);
+}
+
+TEST(BoundedMPMCQueue, zeroCapacityThrows)
+{
+  EXPECT_THROW(cctools::BoundedMPMCQueue<int>(0), std::invalid_argument);
+}
+
+TEST(BoundedMPMCQueue, emptyQueue)
+{
+  cctools::BoundedMPMCQueue<int> queue(4);
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.size(), 0ULL);
+}
+
+TEST(BoundedMPMCQueue, fifoOrder)
+{
+  cctools::BoundedMPMCQueue<int> queue(4);
+  queue.push(23);
+  queue.push(42);
+  queue.push(7);
+  EXPECT_EQ(queue.size(), 3ULL);
+
+  int v = 0;
+  queue.waitAndPop(v);
+  EXPECT_EQ(v, 23);
+  EXPECT_TRUE(queue.tryPop(v));
+  EXPECT_EQ(v, 42);
+  EXPECT_TRUE(queue.tryPop(v));
+  EXPECT_EQ(v, 7);
+  EXPECT_FALSE(queue.tryPop(v));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(BoundedMPMCQueue, tryPushCapacityExceeded)
+{
+  cctools::BoundedMPMCQueue<int> queue(2);
+  EXPECT_TRUE(queue.tryPush(1));
+  EXPECT_TRUE(queue.tryPush(2));
+  EXPECT_FALSE(queue.tryPush(3));
+
+  int v = 0;
+  EXPECT_TRUE(queue.tryPop(v));
+  EXPECT_TRUE(queue.tryPush(3));
+}
+
+TEST(BoundedMPMCQueue, failedTryPushDoesNotMoveFromValue)
+{
+  cctools::BoundedMPMCQueue<std::unique_ptr<int>> queue(2);
+  EXPECT_TRUE(queue.tryPush(std::make_unique<int>(1)));
+  EXPECT_TRUE(queue.tryPush(std::make_unique<int>(1)));
+
+  auto p = std::make_unique<int>(2);
+  EXPECT_FALSE(queue.tryPush(std::move(p)));
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(*p, 2);
+}
+
+TEST(BoundedMPMCQueue, destructorDestroysRemainingElements)
+{
+  auto shared = std::make_shared<int>(3);
+  {
+    cctools::BoundedMPMCQueue<std::shared_ptr<int>> queue(4);
+    queue.push(shared);
+    queue.push(shared);
+    EXPECT_EQ(shared.use_count(), 3);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(BoundedMPMCQueue, tryPopForExpectSuccess)
+{
+  cctools::BoundedMPMCQueue<test::Person> queue(4);
+
+  auto producer = std::async(std::launch::async,
+    [&](){ std::this_thread::sleep_for(1s); queue.push(test::Person(78, "Bob"s));}
+  );
+
+  test::Person p;
+  const bool success = queue.tryPopFor(p, 4s);
+
+  producer.get();
+
+  EXPECT_TRUE(success);
+  EXPECT_EQ(p.getAge(), 78);
+  EXPECT_EQ(p.getName(), "Bob"s);
+}
+
+TEST(BoundedMPMCQueue, tryPopForExpectFailure)
+{
+  cctools::BoundedMPMCQueue<int> queue(4);
+
+  int v = 14;
+  EXPECT_FALSE(queue.tryPopFor(v, 200ms));
+  EXPECT_EQ(v, 14);
+}
+
+TEST(BoundedMPMCQueue, tryPushForCapacityExceededRemoveElementInBetween)
+{
+  cctools::BoundedMPMCQueue<int> queue(2);
+  queue.push(23);
+  queue.push(97);
+
+  auto removeThread = std::async(std::launch::async,
+    [&] {
+      std::this_thread::sleep_for(1s);
+      int i;
+      queue.waitAndPop(i);
+    }
+  );
+
+  const bool success = queue.tryPushFor(24, 5s);
+  removeThread.get();
+
+  EXPECT_TRUE(success);
+}
+
+TEST(BoundedMPMCQueue, waitAndPopEmptyQueueStopped)
+{
+  cctools::BoundedMPMCQueue<int> queue(4);
+
+  auto stopThread = std::async(std::launch::async,
+    [&](){ std::this_thread::sleep_for(1s); queue.stopQueue();}
+  );
+
+  int val = 14;
+  queue.waitAndPop(val);
+
+  stopThread.get();
+
+  EXPECT_EQ(val, 14);
+}
+
+TEST(BoundedMPMCQueue, pushCapacityExceededStopQueueDuringPush)
+{
+  cctools::BoundedMPMCQueue<int> queue(2);
+  queue.push(1);
+  queue.push(2);
+
+  auto stopThread = std::async(std::launch::async,
+    [&](){ std::this_thread::sleep_for(1s); queue.stopQueue();}
+  );
+
+  queue.push(24);
+
+  stopThread.get();
+
+  EXPECT_EQ(queue.size(), 2ULL);
+}
+
+TEST(BoundedMPMCQueue, multipleProducersMultipleConsumers)
+{
+  constexpr int numProducers        = 4;
+  constexpr int numConsumers        = 4;
+  constexpr int numValuesPerThread  = 10000;
+
+  cctools::BoundedMPMCQueue<int> queue(64);
+
+  std::vector<std::future<long long>> consumers;
+  for(int c = 0; c < numConsumers; ++c)
+  {
+    consumers.push_back(std::async(std::launch::async, [&queue] {
+      long long sum = 0;
+      for(int i = 0; i < numProducers * numValuesPerThread / numConsumers; ++i)
+      {
+        int v;
+        queue.waitAndPop(v);
+        sum += v;
+      }
+      return sum;
+    }));
+  }
+
+  std::vector<std::future<void>> producers;
+  for(int p = 0; p < numProducers; ++p)
+  {
+    producers.push_back(std::async(std::launch::async, [&queue] {
+      for(int i = 1; i <= numValuesPerThread; ++i)
+      {
+        queue.push(i);
+      }
+    }));
+  }
+
+  for(auto& producer : producers)
+  {
+    producer.get();
+  }
+
+  long long sum = 0;
+  for(auto& consumer : consumers)
+  {
+    sum += consumer.get();
+  }
+
+  const long long expectedSum = numProducers * (static_cast<long long>(numValuesPerThread) * (numValuesPerThread + 1) / 2);
+  EXPECT_EQ(sum, expectedSum);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(BoundedMPMCQueue, threadPoolSubmitSeveralTasksCheckResult)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::boundedLockFree> pool(4, 16);
+
+  const int nrTasks = 500;
+  std::vector<std::future<int>> results;
+  results.reserve(nrTasks);
+  for(int t = 0; t < nrTasks; ++t)
+  {
+    results.push_back(pool.submit([t] { return 2 * t; }));
+  }
+
+  for(int t = 0; t < nrTasks; ++t)
+  {
+    EXPECT_EQ(results[t].get(), 2 * t);
+  }
+}
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // BOUNDEDMPMCQUEUETEST_H_81726354019283746501928374650192837465019
@@ -0,0 +1,292 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    BoundedSPSCQueueTest.h
+ * @brief
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef BOUNDEDSPSCQUEUETEST_H_72819364501928374650192837465019283746501
+#define BOUNDEDSPSCQUEUETEST_H_72819364501928374650192837465019283746501
+
+
+// includes
+#include "Person.h"
+#include <ConcurrencyTools/BoundedSPSCQueue.h>
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+using namespace std::chrono_literals;
+using namespace std::string_literals;
+
+
+TEST(BoundedSPSCQueue, capacityIsRoundedUpToPowerOfTwo)
+{
+  cctools::BoundedSPSCQueue<int> queue(5);
+  EXPECT_EQ(queue.capacity(), 8ULL);
+
+  cctools::BoundedSPSCQueue<int> single(1);
+  EXPECT_EQ(single.capacity(), 1ULL);
+}
+
+TEST(BoundedSPSCQueue, zeroCapacityThrows)
+{
+  EXPECT_THROW(cctools::BoundedSPSCQueue<int>(0), std::invalid_argument);
+}
+
+TEST(BoundedSPSCQueue, fifoOrder)
+{
+  cctools::BoundedSPSCQueue<int> queue(4);
+  EXPECT_TRUE(queue.empty());
+  queue.push(23);
+  queue.push(42);
+  queue.push(7);
+  EXPECT_EQ(queue.size(), 3ULL);
+
+  int v = 0;
+  queue.waitAndPop(v);
+  EXPECT_EQ(v, 23);
+  EXPECT_TRUE(queue.tryPop(v));
+  EXPECT_EQ(v, 42);
+  EXPECT_TRUE(queue.tryPop(v));
+  EXPECT_EQ(v, 7);
+  EXPECT_FALSE(queue.tryPop(v));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(BoundedSPSCQueue, tryPushCapacityExceeded)
+{
+  cctools::BoundedSPSCQueue<int> queue(2);
+  EXPECT_TRUE(queue.tryPush(1));
+  EXPECT_TRUE(queue.tryPush(2));
+  EXPECT_FALSE(queue.tryPush(3));
+
+  int v = 0;
+  EXPECT_TRUE(queue.tryPop(v));
+  EXPECT_TRUE(queue.tryPush(3));
+}
+
+TEST(BoundedSPSCQueue, failedTryPushDoesNotMoveFromValue)
+{
+  cctools::BoundedSPSCQueue<std::unique_ptr<int>> queue(1);
+  EXPECT_TRUE(queue.tryPush(std::make_unique<int>(1)));
+
+  auto p = std::make_unique<int>(2);
+  EXPECT_FALSE(queue.tryPush(std::move(p)));
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(*p, 2);
+}
+
+TEST(BoundedSPSCQueue, bulkPushAndPopWrapAround)
+{
+  cctools::BoundedSPSCQueue<int> queue(8);
+  std::vector<int> values(12);
+  std::iota(values.begin(), values.end(), 0);
+
+  // the first batch only fits partially
+  EXPECT_EQ(queue.tryPushBulk(values.begin(), values.end()), 8ULL);
+  std::vector<int> popped;
+  EXPECT_EQ(queue.tryPopBulk(std::back_inserter(popped), 5ULL), 5ULL);
+  EXPECT_EQ(queue.tryPushBulk(values.begin() + 8, values.end()), 4ULL);
+  EXPECT_EQ(queue.tryPopBulk(std::back_inserter(popped), 100ULL), 7ULL);
+
+  EXPECT_EQ(popped, values);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(BoundedSPSCQueue, spansWrapAround)
+{
+  cctools::BoundedSPSCQueue<int> queue(8);
+  queue.pushBulk(std::vector<int>{0, 1, 2, 3, 4, 5});
+  int v = 0;
+  for(int i = 0; i < 6; ++i)
+  {
+    EXPECT_TRUE(queue.tryPop(v));
+  }
+
+  // the write span ends at the end of the ring buffer
+  auto free = queue.writeSpan();
+  ASSERT_EQ(free.size(), 2ULL);
+  free[0] = 6;
+  free[1] = 7;
+  queue.commitWrite(2ULL);
+  free = queue.writeSpan();
+  ASSERT_EQ(free.size(), 6ULL);
+  free[0] = 8;
+  queue.commitWrite(1ULL);
+  EXPECT_EQ(queue.size(), 3ULL);
+
+  auto filled = queue.readSpan();
+  ASSERT_EQ(filled.size(), 2ULL);
+  EXPECT_EQ(filled[0], 6);
+  EXPECT_EQ(filled[1], 7);
+  queue.commitRead(2ULL);
+  filled = queue.readSpan();
+  ASSERT_EQ(filled.size(), 1ULL);
+  EXPECT_EQ(filled[0], 8);
+  queue.commitRead(1ULL);
+
+  EXPECT_TRUE(queue.readSpan().empty());
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(BoundedSPSCQueue, tryPopForExpectSuccess)
+{
+  cctools::BoundedSPSCQueue<test::Person> queue(4);
+
+  auto producer = std::async(std::launch::async,
+    [&](){ std::this_thread::sleep_for(200ms); queue.push(test::Person(78, "Bob"s));}
+  );
+
+  test::Person p;
+  const bool success = queue.tryPopFor(p, 4s);
+
+  producer.get();
+
+  EXPECT_TRUE(success);
+  EXPECT_EQ(p.getAge(), 78);
+  EXPECT_EQ(p.getName(), "Bob"s);
+}
+
+TEST(BoundedSPSCQueue, tryPopForExpectFailure)
+{
+  cctools::BoundedSPSCQueue<int> queue(4);
+
+  int v = 14;
+  EXPECT_FALSE(queue.tryPopFor(v, 100ms));
+  EXPECT_EQ(v, 14);
+}
+
+TEST(BoundedSPSCQueue, tryPushForCapacityExceededRemoveElementInBetween)
+{
+  cctools::BoundedSPSCQueue<int> queue(2);
+  queue.push(23);
+  queue.push(97);
+
+  auto removeThread = std::async(std::launch::async,
+    [&] {
+      std::this_thread::sleep_for(200ms);
+      int i;
+      queue.waitAndPop(i);
+    }
+  );
+
+  const bool success = queue.tryPushFor(24, 5s);
+  removeThread.get();
+
+  EXPECT_TRUE(success);
+  EXPECT_FALSE(queue.tryPushFor(25, 50ms));
+}
+
+TEST(BoundedSPSCQueue, waitAndPopEmptyQueueStopped)
+{
+  cctools::BoundedSPSCQueue<int> queue(4);
+
+  auto stopThread = std::async(std::launch::async,
+    [&](){ std::this_thread::sleep_for(200ms); queue.stopQueue();}
+  );
+
+  int val = 14;
+  queue.waitAndPop(val);
+
+  stopThread.get();
+
+  EXPECT_EQ(val, 14);
+}
+
+TEST(BoundedSPSCQueue, pushBulkCapacityExceededStopQueueDuringPush)
+{
+  cctools::BoundedSPSCQueue<int> queue(2);
+
+  auto stopThread = std::async(std::launch::async,
+    [&](){ std::this_thread::sleep_for(200ms); queue.stopQueue();}
+  );
+
+  EXPECT_EQ(queue.pushBulk(std::vector<int>{1, 2, 3, 4}), 2ULL);
+
+  stopThread.get();
+
+  EXPECT_EQ(queue.size(), 2ULL);
+}
+
+TEST(BoundedSPSCQueue, producerConsumerKeepOrder)
+{
+  constexpr int numValues = 200000;
+
+  for(auto const strategy : {cctools::WaitStrategy::blocking(), cctools::WaitStrategy::adaptive()})
+  {
+    cctools::BoundedSPSCQueue<int> queue(64);
+    queue.setWaitStrategy(strategy);
+
+    auto consumer = std::async(std::launch::async, [&queue] {
+      int expected = 0;
+      bool ordered = true;
+      while(expected < numValues)
+      {
+        int v;
+        queue.waitAndPop(v);
+        ordered = ordered && v == expected;
+        ++expected;
+      }
+      return ordered;
+    });
+
+    for(int i = 0; i < numValues; ++i)
+    {
+      queue.push(i);
+    }
+
+    EXPECT_TRUE(consumer.get());
+    EXPECT_TRUE(queue.empty());
+  }
+}
+
+TEST(BoundedSPSCQueue, producerConsumerBatchesKeepOrder)
+{
+  constexpr int         numValues = 200000;
+  constexpr std::size_t batchSize = 37ULL;
+
+  cctools::BoundedSPSCQueue<int> queue(64);
+
+  auto consumer = std::async(std::launch::async, [&queue] {
+    std::vector<int> popped;
+    popped.reserve(numValues);
+    while(popped.size() < static_cast<std::size_t>(numValues))
+    {
+      queue.waitAndPopBulk(std::back_inserter(popped), batchSize);
+    }
+    return popped;
+  });
+
+  std::vector<int> values(numValues);
+  std::iota(values.begin(), values.end(), 0);
+  for(std::size_t i = 0ULL; i < values.size(); i += batchSize)
+  {
+    const auto last = values.begin() + static_cast<std::ptrdiff_t>((std::min)(i + batchSize, values.size()));
+    queue.pushBulk(values.begin() + static_cast<std::ptrdiff_t>(i), last);
+  }
+
+  EXPECT_EQ(consumer.get(), values);
+}
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // BOUNDEDSPSCQUEUETEST_H_72819364501928374650192837465019283746501
@@ -0,0 +1,261 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    CompressedBitmapTest.h
+ * @brief
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef COMPRESSEDBITMAPTEST_H_47561029384756102938475610293847561029384
+#define COMPRESSEDBITMAPTEST_H_47561029384756102938475610293847561029384
+
+
+// includes
+#include <Bitwise/BitVector.h>
+#include <Bitwise/CompressedBitmap.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+namespace {
+
+using DenseMask = bws::BitVectorT<std::uint64_t>;
+
+constexpr std::size_t maskSize = 5ULL * 65536ULL + 1234ULL;
+
+/// random bits of the given density
+auto makeRandomMask(std::size_t size, double density, std::mt19937::result_type seed) -> DenseMask
+{
+  std::mt19937 gen(seed);
+  std::bernoulli_distribution distrib(density);
+
+  DenseMask b(size);
+  for(std::size_t i{}; i < size; ++i)
+  {
+    b[i] = distrib(gen);
+  }
+  return b;
+}
+
+/// runs of random length between 1 and maxRunLength, separated by gaps of random length
+auto makeRunMask(std::size_t size, std::size_t maxRunLength, std::mt19937::result_type seed) -> DenseMask
+{
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<std::size_t> lengths(1ULL, maxRunLength);
+
+  DenseMask b(size);
+  for(std::size_t i = lengths(gen); i < size; i += lengths(gen))
+  {
+    for(const auto last = std::min(size, i + lengths(gen)); i < last; ++i)
+    {
+      b[i] = true;
+    }
+  }
+  return b;
+}
+
+auto makeTestMasks(std::mt19937::result_type seed) -> std::vector<DenseMask>
+{
+  auto chunked = makeRandomMask(maskSize, 0.5, seed);
+  // leave out some chunks entirely
+  for(std::size_t i = 65536ULL; i < 2ULL * 65536ULL; ++i)
+  {
+    chunked[i] = false;
+  }
+
+  return {makeRandomMask(maskSize, 0.0005, seed),
+          makeRandomMask(maskSize, 0.05, seed),
+          makeRandomMask(maskSize, 0.9, seed),
+          makeRunMask(maskSize, 2000ULL, seed),
+          makeRunMask(maskSize, 20ULL, seed),
+          std::move(chunked),
+          DenseMask(maskSize)};
+}
+
+void expectSameBits(bws::CompressedBitmap const& c, DenseMask const& b)
+{
+  ASSERT_EQ(c.toBitVector<std::uint64_t>(b.size()), b);
+  ASSERT_EQ(c.cardinality(), b.count());
+
+  const auto setBits = b.setBits();
+  ASSERT_EQ(std::vector<std::size_t>(c.begin(), c.end()), std::vector<std::size_t>(setBits.begin(), setBits.end()));
+}
+
+}   // namespace
+
+
+TEST(CompressedBitmap, defaultConstructedIsEmpty)
+{
+  const bws::CompressedBitmap c;
+  EXPECT_TRUE(c.empty());
+  EXPECT_EQ(c.cardinality(), 0ULL);
+  EXPECT_EQ(c.minimum(), c.npos);
+  EXPECT_EQ(c.maximum(), c.npos);
+  EXPECT_TRUE(c.begin() == c.end());
+}
+
+TEST(CompressedBitmap, addContainsRemove)
+{
+  bws::CompressedBitmap c{3ULL, 70000ULL, 5ULL};
+  EXPECT_EQ(c.cardinality(), 3ULL);
+  EXPECT_TRUE(c.contains(70000ULL));
+  EXPECT_FALSE(c.contains(4ULL));
+  EXPECT_FALSE(c.add(5ULL));
+  EXPECT_TRUE(c.add(1ULL << 40));
+  EXPECT_EQ(c.minimum(), 3ULL);
+  EXPECT_EQ(c.maximum(), 1ULL << 40);
+
+  EXPECT_TRUE(c.remove(70000ULL));
+  EXPECT_FALSE(c.remove(70000ULL));
+  EXPECT_FALSE(c.remove(123456789ULL));
+  EXPECT_EQ(std::vector<std::size_t>(c.begin(), c.end()), (std::vector<std::size_t>{3ULL, 5ULL, 1ULL << 40}));
+
+  c.clear();
+  EXPECT_TRUE(c.empty());
+}
+
+TEST(CompressedBitmap, arrayBecomesBitmapAndBack)
+{
+  bws::CompressedBitmap c;
+  for(std::size_t i = 0ULL; i < 5000ULL; ++i)
+  {
+    c.add(i * 13ULL);
+  }
+  EXPECT_EQ(c.cardinality(), 5000ULL);
+  EXPECT_GT(c.memoryUsage(), 8192ULL);
+
+  for(std::size_t i = 0ULL; i < 5000ULL; i += 2ULL)
+  {
+    EXPECT_TRUE(c.remove(i * 13ULL));
+  }
+  EXPECT_EQ(c.cardinality(), 2500ULL);
+  EXPECT_TRUE(c.contains(13ULL));
+  EXPECT_FALSE(c.contains(26ULL));
+
+  c.runOptimize();
+  EXPECT_LT(c.memoryUsage(), 8192ULL);
+}
+
+TEST(CompressedBitmap, runsAreCompact)
+{
+  DenseMask b(3ULL * 65536ULL);
+  for(std::size_t i = 1000ULL; i < 150000ULL; ++i)
+  {
+    b[i] = true;
+  }
+
+  bws::CompressedBitmap c(b);
+  expectSameBits(c, b);
+  EXPECT_LT(c.memoryUsage(), 256ULL);
+
+  // adding and removing inside, at the borders and next to the runs
+  for(const auto pos : {999ULL, 150000ULL, 150002ULL, 150001ULL, 65536ULL + 7ULL, 1ULL})
+  {
+    c.add(pos);
+    b[pos] = true;
+  }
+  for(const auto pos : {999ULL, 70000ULL, 65535ULL, 65536ULL, 150002ULL, 2ULL})
+  {
+    c.remove(pos);
+    b[pos] = false;
+  }
+  expectSameBits(c, b);
+}
+
+TEST(CompressedBitmap, roundTripThroughBitVector)
+{
+  for(const auto& b : makeTestMasks(1U))
+  {
+    const bws::CompressedBitmap c(b);
+    expectSameBits(c, b);
+
+    auto copy = c;
+    copy.runOptimize();
+    EXPECT_EQ(copy, c);
+    EXPECT_LE(copy.memoryUsage(), c.memoryUsage());
+  }
+}
+
+TEST(CompressedBitmap, setOperationsMatchBitVector)
+{
+  const auto lhsMasks = makeTestMasks(1U);
+  const auto rhsMasks = makeTestMasks(2U);
+
+  for(const auto& a : lhsMasks)
+  {
+    for(const auto& b : rhsMasks)
+    {
+      const bws::CompressedBitmap ca(a);
+      const bws::CompressedBitmap cb(b);
+
+      expectSameBits(ca & cb, a & b);
+      expectSameBits(ca | cb, a | b);
+      expectSameBits(ca ^ cb, a ^ b);
+      expectSameBits(bws::andNot(ca, cb), a & ~b);
+      expectSameBits(bws::andNot(cb, ca), b & ~a);
+    }
+  }
+}
+
+TEST(CompressedBitmap, setOperationsWithItself)
+{
+  const auto b = makeRunMask(maskSize, 500ULL, 3U);
+  bws::CompressedBitmap c(b);
+
+  c |= c;
+  expectSameBits(c, b);
+  c &= c;
+  expectSameBits(c, b);
+  c ^= c;
+  EXPECT_TRUE(c.empty());
+}
+
+TEST(CompressedBitmap, equalityIgnoresRepresentation)
+{
+  const auto b = makeRunMask(maskSize, 3000ULL, 4U);
+  const bws::CompressedBitmap runs(b);
+
+  bws::CompressedBitmap added;
+  b.forEachSetBit([&added](std::size_t pos) { added.add(pos); });
+
+  EXPECT_EQ(runs, added);
+  EXPECT_LT(runs.memoryUsage(), added.memoryUsage());
+
+  added.remove(b.findFirst());
+  EXPECT_NE(runs, added);
+}
+
+TEST(CompressedBitmap, forEachSetBitMatchesIterator)
+{
+  for(const auto& b : makeTestMasks(5U))
+  {
+    const bws::CompressedBitmap c(b);
+    std::vector<std::size_t> visited;
+    c.forEachSetBit([&visited](std::size_t pos) { visited.push_back(pos); });
+    EXPECT_EQ(visited, std::vector<std::size_t>(c.begin(), c.end()));
+  }
+}
+
+TEST(CompressedBitmap, toSmallerBitVectorDropsBits)
+{
+  const bws::CompressedBitmap c{1ULL, 100ULL, 65537ULL, 200000ULL};
+  const auto b = c.toBitVector(70000ULL);
+  EXPECT_EQ(b.size(), 70000ULL);
+  EXPECT_EQ(b.count(), 3ULL);
+  EXPECT_TRUE(b[65537ULL]);
+}
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // COMPRESSEDBITMAPTEST_H_47561029384756102938475610293847561029384
@@ -0,0 +1,282 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ConcurrentHashMapTest.h
+ * @brief
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef CONCURRENTHASHMAPTEST_H_61029384756102938475610293847561029384
+#define CONCURRENTHASHMAPTEST_H_61029384756102938475610293847561029384
+
+
+// includes
+#include "Person.h"
+
+#include <ConcurrencyTools/ConcurrentHashMap.h>
+
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+using namespace std::string_literals;
+
+
+namespace test {
+
+/// hash putting every key into the same probe sequence
+struct CollidingHash {
+  auto operator()(int) const noexcept -> std::size_t { return 42ULL; }
+};
+
+}   // namespace test
+
+
+TEST(ConcurrentHashMap, defaultConstructor)
+{
+  cctools::ConcurrentHashMap<std::string, int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.size(), 0ULL);
+  EXPECT_GE(map.capacity(), (cctools::ConcurrentHashMap<std::string, int>::defaultCapacity));
+}
+
+TEST(ConcurrentHashMap, invalidMaxLoadFactorThrows)
+{
+  EXPECT_THROW((cctools::ConcurrentHashMap<int, int>(64ULL, 0.F)), std::invalid_argument);
+  EXPECT_THROW((cctools::FlatHashMap<int, int>(64ULL, 1.F)), std::invalid_argument);
+}
+
+TEST(ConcurrentHashMap, sequentialConstructor)
+{
+  cctools::ConcurrentHashMap<std::string, int> map {{"Bill"s, 36}, {"Judy"s, 23}, {"Lasse"s, 39}};
+  EXPECT_EQ(map.size(), 3ULL);
+  EXPECT_TRUE(map.contains("Judy"s));
+  EXPECT_FALSE(map.contains("Joe"s));
+}
+
+TEST(ConcurrentHashMap, insertOrReplace)
+{
+  cctools::ConcurrentHashMap<std::string, int> map;
+  EXPECT_EQ(map.insertOrReplace("Bill"s, 38), 1ULL);
+  EXPECT_EQ(map.insertOrReplace("Bill"s, 39), 0ULL);
+
+  EXPECT_EQ(map.size(), 1ULL);
+  EXPECT_EQ(map.invoke("Bill"s, [](int i) { return i; }), 39);
+}
+
+TEST(ConcurrentHashMap, emplace)
+{
+  cctools::ConcurrentHashMap<int, test::Person> map {{1, {8, "Elena"s}}};
+
+  EXPECT_EQ(map.emplace(2, 8, "Tabea"s), 1ULL);
+  EXPECT_EQ(map.emplace(1, 9, "Theodor"s), 0ULL);
+  EXPECT_EQ(map.size(), 2ULL);
+  EXPECT_EQ(map.invoke(1, [](test::Person const& p) { return p.getName(); }), "Theodor"s);
+}
+
+TEST(ConcurrentHashMap, invoke)
+{
+  cctools::FlatHashMap<int, test::Person> map {{1, {8, "Elena"s}}};
+
+  map.invoke(1, [](test::Person& p) { p.setAge(11); });
+  auto age = map.invoke(1, [](test::Person const& p) { return p.getAge(); });
+
+  EXPECT_TRUE((std::is_same_v<decltype(age), int>));
+  EXPECT_EQ(age, 11);
+}
+
+TEST(ConcurrentHashMap, invokeExpectException)
+{
+  cctools::ConcurrentHashMap<int, test::Person> map {{1, {8, "Elena"s}}};
+
+  EXPECT_THROW(
+    map.invoke(2, [](test::Person& p) { p.setAge(9); }),
+    std::out_of_range
+  );
+}
+
+TEST(ConcurrentHashMap, erase)
+{
+  cctools::ConcurrentHashMap<std::string, int> map {{"Bill"s, 36}, {"Judy"s, 23}, {"Lasse"s, 39}};
+
+  EXPECT_EQ(map.erase("Judy"s), 1ULL);
+  EXPECT_EQ(map.erase("Judy"s), 0ULL);
+  EXPECT_EQ(map.size(), 2ULL);
+  EXPECT_FALSE(map.contains("Judy"s));
+  EXPECT_TRUE(map.contains("Bill"s));
+  EXPECT_TRUE(map.contains("Lasse"s));
+}
+
+TEST(ConcurrentHashMap, eraseKeepsCollidingKeysReachable)
+{
+  cctools::FlatHashMap<int, int, test::CollidingHash> map;
+  for(int i = 0; i < 6; ++i)
+  {
+    map.insertOrReplace(i, i);
+  }
+
+  EXPECT_EQ(map.erase(2), 1ULL);
+  EXPECT_EQ(map.erase(0), 1ULL);
+  for(int i = 0; i < 6; ++i)
+  {
+    EXPECT_EQ(map.contains(i), i != 0 && i != 2);
+  }
+}
+
+TEST(ConcurrentHashMap, growsAndKeepsAllElements)
+{
+  cctools::ConcurrentHashMap<int, int, std::hash<int>, std::shared_mutex, 4ULL> map(16ULL, 0.5F);
+  const auto initialCapacity = map.capacity();
+
+  constexpr int numElements = 10000;
+  for(int i = 0; i < numElements; ++i)
+  {
+    map.insertOrReplace(i, 2 * i);
+  }
+
+  EXPECT_EQ(map.size(), static_cast<std::size_t>(numElements));
+  EXPECT_GT(map.capacity(), initialCapacity);
+  EXPECT_LE(map.loadFactor(), 0.5F);
+  for(int i = 0; i < numElements; ++i)
+  {
+    ASSERT_EQ(map.invoke(i, [](int v) { return v; }), 2 * i);
+  }
+}
+
+TEST(ConcurrentHashMap, eraseDuringMigration)
+{
+  constexpr int numElements = 49;
+
+  // the last insertion grows the table, only a few slots are migrated by each erasure
+  cctools::FlatHashMap<int, int> map(64ULL, 0.75F);
+  for(int i = 0; i < numElements; ++i)
+  {
+    map.insertOrReplace(i, i);
+  }
+  EXPECT_EQ(map.capacity(), 128ULL);
+
+  for(int i = 0; i < numElements; i += 2)
+  {
+    EXPECT_EQ(map.erase(i), 1ULL);
+  }
+
+  EXPECT_EQ(map.size(), static_cast<std::size_t>(numElements / 2));
+  for(int i = 0; i < numElements; ++i)
+  {
+    EXPECT_EQ(map.contains(i), i % 2 == 1);
+  }
+}
+
+TEST(ConcurrentHashMap, forEach)
+{
+  cctools::ConcurrentHashMap<int, int> map;
+  for(int i = 1; i <= 100; ++i)
+  {
+    map.insertOrReplace(i, i);
+  }
+
+  map.forEach([](int& v) { v *= 2; });
+
+  int sum = 0;
+  map.forEach([&sum](int v) { sum += v; });
+  EXPECT_EQ(sum, 10100);
+}
+
+TEST(ConcurrentHashMap, forEachValue)
+{
+  const cctools::ConcurrentHashMap<int, test::Person> map {{1, {9, "Elena"s}}, {2, {8, "Tabea"s}}};
+
+  std::vector<int> ages(map.size());
+
+  map.forEachValue([&ages](const auto& entry) {
+    const auto& [key, person] = entry;
+    ages[key - 1] = person.getAge();
+  });
+
+  EXPECT_EQ(ages[0], 9);
+  EXPECT_EQ(ages[1], 8);
+}
+
+TEST(ConcurrentHashMap, moveAssignment)
+{
+  cctools::ConcurrentHashMap<std::string, int> map;
+  map.insertOrReplace("Bill"s, 38);
+
+  cctools::ConcurrentHashMap<std::string, int> mapCopy;
+  mapCopy = std::move(map);
+
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(mapCopy.size(), 1ULL);
+  EXPECT_TRUE(mapCopy.contains("Bill"s));
+}
+
+TEST(ConcurrentHashMap, movedFromMapStaysUsable)
+{
+  cctools::ConcurrentHashMap<std::string, int> map({{"Bill"s, 38}, {"Jane"s, 42}});
+  cctools::ConcurrentHashMap<std::string, int> moved(std::move(map));
+
+  EXPECT_EQ(map.size(), 0ULL);
+  EXPECT_FALSE(map.contains("Bill"s));
+  EXPECT_EQ(map.erase("Jane"s), 0ULL);
+  for(int i = 0; i < 100; ++i)
+  {
+    map.insertOrReplace(std::to_string(i), i);
+  }
+  EXPECT_EQ(map.size(), 100ULL);
+  EXPECT_TRUE(map.contains("99"s));
+  EXPECT_EQ(moved.size(), 2ULL);
+
+  cctools::ConcurrentHashMap<std::string, int> assigned;
+  assigned = std::move(map);
+  map.insertOrReplace("Bill"s, 39);
+  EXPECT_EQ(map.size(), 1ULL);
+  EXPECT_EQ(assigned.size(), 100ULL);
+}
+
+TEST(ConcurrentHashMap, concurrentInsertEraseInvoke)
+{
+  constexpr int numThreads   = 4;
+  constexpr int numPerThread = 5000;
+
+  cctools::ConcurrentHashMap<int, int> map(16ULL);
+
+  std::vector<std::future<void>> writers;
+  for(int t = 0; t < numThreads; ++t)
+  {
+    writers.push_back(std::async(std::launch::async, [&map, t] {
+      for(int i = t * numPerThread; i < (t + 1) * numPerThread; ++i)
+      {
+        map.insertOrReplace(i, 1);
+        map.invoke(i, [](int& v) { ++v; });
+        if(i % 2 == 0)
+        {
+          map.erase(i);
+        }
+      }
+    }));
+  }
+  for(auto& writer : writers)
+  {
+    writer.get();
+  }
+
+  EXPECT_EQ(map.size(), static_cast<std::size_t>(numThreads * numPerThread / 2));
+  int sum = 0;
+  map.forEach([&sum](int v) { sum += v; });
+  EXPECT_EQ(sum, numThreads * numPerThread);
+}
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // CONCURRENTHASHMAPTEST_H_61029384756102938475610293847561029384
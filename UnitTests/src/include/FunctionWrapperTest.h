@@ -0,0 +1,246 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    FunctionWrapperTest.h
+ * @brief
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef FUNCTIONWRAPPERTEST_H_73019283746501928374650192837465019283746
+#define FUNCTIONWRAPPERTEST_H_73019283746501928374650192837465019283746
+
+
+// includes
+#include <ConcurrencyTools/FunctionWrapper.h>
+#include <ConcurrencyTools/ThreadPool.h>
+
+#include <array>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <thread>
+
+
+namespace test {
+
+/// number of heap allocations of CountingCallable objects
+inline std::atomic<std::size_t> numCallableAllocations {0ULL};
+
+/**
+ * @brief Callable of at least PaddingSize bytes, which counts its heap allocations by a class
+ *        specific operator new instead of replacing the global one.
+ */
+template <std::size_t PaddingSize>
+struct CountingCallable {
+  std::atomic<int>*             counter;
+  std::array<char, PaddingSize> padding {};
+
+  void operator()() const { ++*counter; }
+
+  static auto operator new(std::size_t size) -> void*
+  {
+    ++numCallableAllocations;
+    return ::operator new(size);
+  }
+
+  static void operator delete(void* p) noexcept
+  {
+    ::operator delete(p);
+  }
+};
+
+using SmallCallable = CountingCallable<8ULL>;
+using LargeCallable = CountingCallable<2ULL * cctools::FunctionWrapper::inlineSize>;
+
+/**
+ * @brief Callable counting how often it is moved once it has been queued. Moving a FunctionWrapper
+ *        moves an inline callable along, whereas a callable on the heap stays where it is.
+ */
+struct QueueProbe {
+  std::atomic<int>*  counter;
+  std::atomic<bool>* queued;
+  std::atomic<int>*  movesAfterQueued;
+
+  QueueProbe(std::atomic<int>* c, std::atomic<bool>* q, std::atomic<int>* m) noexcept
+    : counter{c}, queued{q}, movesAfterQueued{m}
+  {}
+
+  QueueProbe(QueueProbe&& src) noexcept
+    : counter{src.counter}, queued{src.queued}, movesAfterQueued{src.movesAfterQueued}
+  {
+    if(*queued)
+    {
+      ++*movesAfterQueued;
+    }
+  }
+
+  void operator()() const { ++*counter; }
+
+  static auto operator new(std::size_t size) -> void*
+  {
+    ++numCallableAllocations;
+    return ::operator new(size);
+  }
+
+  static void operator delete(void* p) noexcept
+  {
+    ::operator delete(p);
+  }
+};
+
+/**
+ * @brief Submits a QueueProbe while the only worker is busy, so it is popped by the worker
+ *        after submit has returned.
+ */
+template <cctools::queuePolicy QueuePolicy>
+void expectSubmittedCallableStoredInline()
+{
+  cctools::NonWaitableThreadPool<QueuePolicy> pool(1);
+
+  std::promise<void> started;
+  std::promise<void> release;
+  pool.submit([&started, released = release.get_future().share()] {
+    started.set_value();
+    released.wait();
+  });
+  started.get_future().wait();
+
+  std::atomic<int>  counter {0};
+  std::atomic<bool> queued {false};
+  std::atomic<int>  movesAfterQueued {0};
+  const auto allocationsBefore = numCallableAllocations.load();
+  pool.submit(QueueProbe{&counter, &queued, &movesAfterQueued});
+  queued = true;
+  release.set_value();
+
+  while(counter.load() < 1)
+  {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(numCallableAllocations.load(), allocationsBefore);
+  EXPECT_GT(movesAfterQueued.load(), 0);
+}
+
+}   // namespace test
+
+
+TEST(FunctionWrapper, smallCallableDoesNotAllocate)
+{
+  std::atomic<int> counter {0};
+  EXPECT_TRUE(cctools::FunctionWrapper::storesInline<test::SmallCallable>());
+
+  const auto allocationsBefore = test::numCallableAllocations.load();
+  {
+    cctools::FunctionWrapper f1(test::SmallCallable{&counter});
+    cctools::FunctionWrapper f2(std::move(f1));
+    cctools::FunctionWrapper f3;
+    f3 = std::move(f2);
+    f3();
+  }
+  EXPECT_EQ(test::numCallableAllocations.load(), allocationsBefore);
+  EXPECT_EQ(counter.load(), 1);
+}
+
+TEST(FunctionWrapper, largeCallableAllocatesOnce)
+{
+  std::atomic<int> counter {0};
+  EXPECT_FALSE(cctools::FunctionWrapper::storesInline<test::LargeCallable>());
+
+  const auto allocationsBefore = test::numCallableAllocations.load();
+  {
+    cctools::FunctionWrapper f1(test::LargeCallable{&counter});
+    cctools::FunctionWrapper f2(std::move(f1));
+    f2();
+  }
+  EXPECT_EQ(test::numCallableAllocations.load(), allocationsBefore + 1ULL);
+  EXPECT_EQ(counter.load(), 1);
+}
+
+TEST(FunctionWrapper, lambdaStorage)
+{
+  int  i     = 0;
+  auto small = [&i, j = 3] { i += j; };
+  auto large = [&i, data = std::array<char, 2ULL * cctools::FunctionWrapper::inlineSize>{}] { i += data.back(); };
+  EXPECT_TRUE(cctools::FunctionWrapper::storesInline<decltype(small)>());
+  EXPECT_FALSE(cctools::FunctionWrapper::storesInline<decltype(large)>());
+
+  cctools::FunctionWrapper f1(small);
+  cctools::FunctionWrapper f2(std::move(f1));
+  f2();
+  EXPECT_EQ(i, 3);
+}
+
+TEST(FunctionWrapper, moveLeavesSourceEmpty)
+{
+  cctools::FunctionWrapper f1([] {});
+  EXPECT_TRUE(f1);
+
+  cctools::FunctionWrapper f2(std::move(f1));
+  EXPECT_FALSE(f1);
+  EXPECT_TRUE(f2);
+}
+
+TEST(FunctionWrapper, destructorDestroysCallable)
+{
+  auto shared = std::make_shared<int>(3);
+  {
+    cctools::FunctionWrapper f1([shared] {});
+    cctools::FunctionWrapper f2([shared, padding = std::array<char, 64>{}] {});
+    EXPECT_EQ(shared.use_count(), 3);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(FunctionWrapper, moveAssignmentDestroysPreviousCallable)
+{
+  auto shared = std::make_shared<int>(3);
+  cctools::FunctionWrapper f1([shared] {});
+  EXPECT_EQ(shared.use_count(), 2);
+
+  f1 = cctools::FunctionWrapper([] {});
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(FunctionWrapper, moveOnlyCallable)
+{
+  auto p   = std::make_unique<int>(5);
+  int  res = 0;
+  cctools::FunctionWrapper f([&res, p = std::move(p)] { res = *p; });
+  f();
+  EXPECT_EQ(res, 5);
+}
+
+TEST(FunctionWrapper, priorityComparison)
+{
+  cctools::FunctionWrapper low([] {}, 1);
+  cctools::FunctionWrapper high([] {}, 4);
+  EXPECT_TRUE(low < high);
+  EXPECT_FALSE(high < low);
+}
+
+TEST(NonWaitableThreadPool, submitStoresSmallCallableInline)
+{
+  EXPECT_TRUE(cctools::FunctionWrapper::storesInline<test::QueueProbe>());
+
+  // the queued FunctionWrapper holds the callable inline for every policy. Submitting allocates
+  // nothing at all with boundedLockFree, whose ring buffer is allocated up front, and with
+  // heapPrioritized once its vector has grown. fifo and prioritized allocate a list node per
+  // task, as does workStealing for tasks submitted from outside its workers.
+  test::expectSubmittedCallableStoredInline<cctools::queuePolicy::fifo>();
+  test::expectSubmittedCallableStoredInline<cctools::queuePolicy::prioritized>();
+  test::expectSubmittedCallableStoredInline<cctools::queuePolicy::heapPrioritized>();
+  test::expectSubmittedCallableStoredInline<cctools::queuePolicy::workStealing>();
+  test::expectSubmittedCallableStoredInline<cctools::queuePolicy::boundedLockFree>();
+}
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // FUNCTIONWRAPPERTEST_H_73019283746501928374650192837465019283746
@@ -0,0 +1,283 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    FutureTest.h
+ * @brief
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef FUTURETEST_H_64019283746501928374650192837465019283746501
+#define FUTURETEST_H_64019283746501928374650192837465019283746501
+
+
+// includes
+#include "Person.h"
+
+#include <ConcurrencyTools/Future.h>
+#include <ConcurrencyTools/OneShotEvent.h>
+#include <ConcurrencyTools/ThreadPool.h>
+
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+TEST(Future, setValueThenGet)
+{
+  cctools::Promise<test::Person> promise;
+  auto future = promise.getFuture();
+  EXPECT_TRUE(future.valid());
+  EXPECT_FALSE(future.isReady());
+
+  promise.setValue(45, "Jill");
+  EXPECT_TRUE(future.isReady());
+  EXPECT_EQ(future.get().getName(), "Jill");
+  EXPECT_FALSE(future.valid());
+}
+
+TEST(Future, getRethrowsException)
+{
+  cctools::Promise<void> promise;
+  auto future = promise.getFuture();
+  promise.setException(std::make_exception_ptr(std::runtime_error("failed")));
+  EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(Future, brokenPromise)
+{
+  cctools::Future<int> future;
+  {
+    cctools::Promise<int> promise;
+    future = promise.getFuture();
+    EXPECT_THROW(promise.getFuture(), std::future_error);
+  }
+  EXPECT_THROW(future.get(), std::future_error);
+}
+
+TEST(Future, thenRunsInlineWithoutPool)
+{
+  cctools::Promise<int> promise;
+  auto future = promise.getFuture().then([](int i) { return std::to_string(i); });
+
+  promise.setValue(12);
+  EXPECT_TRUE(future.isReady());
+  EXPECT_EQ(future.get(), "12");
+}
+
+TEST(Future, thenChainOnPool)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::fifo> pool(2);
+
+  auto future = pool.async([] { return 12; })
+                  .then([](int i) { return i + 13; })
+                  .then([](int i) { return test::Person(i, "Jill"); });
+
+  const auto result = future.get();
+  EXPECT_EQ(result.getAge(), 25);
+  EXPECT_EQ(result.getName(), "Jill");
+}
+
+TEST(Future, thenSkipsContinuationOnException)
+{
+  cctools::NonWaitableThreadPool<cctools::queuePolicy::fifo> pool(2);
+
+  bool called = false;
+  auto future = pool.async([]() -> int { throw std::invalid_argument("failed"); })
+                  .then([&called](int i) { called = true; return i; });
+
+  EXPECT_THROW(future.get(), std::invalid_argument);
+  EXPECT_FALSE(called);
+}
+
+TEST(Future, thenUnwrapsReturnedFuture)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::fifo> pool(1);
+
+  auto future = pool.async([] { return 3; })
+                  .then([&pool](int i) { return pool.async([i] { return 2 * i; }); });
+
+  EXPECT_TRUE((std::is_same_v<decltype(future), cctools::Future<int>>));
+  EXPECT_EQ(future.get(), 6);
+}
+
+TEST(Future, whenAllCollectsValuesInOrder)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::fifo> pool(4);
+
+  std::vector<cctools::Future<int>> futures;
+  for(int i = 0; i < 10; ++i)
+  {
+    futures.push_back(pool.async([i] { return i * i; }));
+  }
+
+  auto sum = cctools::whenAll(std::move(futures)).then(pool, [](std::vector<int> values) {
+    int result = 0;
+    for(std::size_t i = 0ULL; i < values.size(); ++i)
+    {
+      EXPECT_EQ(values[i], static_cast<int>(i * i));
+      result += values[i];
+    }
+    return result;
+  });
+
+  EXPECT_EQ(sum.get(), 285);
+}
+
+TEST(Future, whenAllPassesException)
+{
+  std::vector<cctools::Promise<void>> promises(3);
+  std::vector<cctools::Future<void>>  futures;
+  for(auto& promise : promises)
+  {
+    futures.push_back(promise.getFuture());
+  }
+
+  auto all = cctools::whenAll(std::move(futures));
+  promises[0].setValue();
+  promises[2].setException(std::make_exception_ptr(std::runtime_error("failed")));
+  EXPECT_FALSE(all.isReady());
+
+  promises[1].setValue();
+  EXPECT_THROW(all.get(), std::runtime_error);
+}
+
+TEST(Future, whenAnyReturnsFirstReady)
+{
+  std::vector<cctools::Promise<std::string>> promises(3);
+  std::vector<cctools::Future<std::string>>  futures;
+  for(auto& promise : promises)
+  {
+    futures.push_back(promise.getFuture());
+  }
+
+  auto any = cctools::whenAny(std::move(futures));
+  promises[1].setValue("second");
+  promises[0].setValue("first");
+
+  const auto [index, value] = any.get();
+  EXPECT_EQ(index, 1ULL);
+  EXPECT_EQ(value, "second");
+  EXPECT_THROW(cctools::whenAny(std::vector<cctools::Future<int>>{}), std::invalid_argument);
+}
+
+TEST(Future, oneShotEventCompletesFuture)
+{
+  cctools::NonWaitableThreadPool<cctools::queuePolicy::fifo> pool(1);
+
+  cctools::NonSharedOneShotEvent<int> event;
+  auto future = event.getFuture().then(pool, [](int i) { return i + 1; });
+
+  // the continuation doesn't occupy the only working thread while waiting for the event
+  auto other = pool.async([] { return 5; });
+  EXPECT_EQ(other.get(), 5);
+
+  event.notify(41);
+  EXPECT_EQ(future.get(), 42);
+  EXPECT_EQ(event.get(), 41);
+}
+
+TEST(Future, oneShotEventLinkedAfterNotify)
+{
+  cctools::NonSharedOneShotEvent<int> event;
+  event.notify(7);
+
+  auto future = event.getFuture();
+  EXPECT_TRUE(future.isReady());
+  EXPECT_EQ(future.get(), 7);
+  EXPECT_EQ(event.get(), 7);
+  EXPECT_THROW(event.getFuture(), std::future_error);
+
+  cctools::SharedOneShotEvent<void> start;
+  start.notify();
+  EXPECT_TRUE(start.getFuture().isReady());
+
+  cctools::NonSharedOneShotEvent<int> failed;
+  failed.setException(std::make_exception_ptr(std::runtime_error("failed")));
+  EXPECT_THROW(failed.getFuture().get(), std::runtime_error);
+}
+
+TEST(Future, oneShotEventLinkedConcurrentlyWithNotify)
+{
+  for(int i = 0; i < 200; ++i)
+  {
+    cctools::NonSharedOneShotEvent<int> event;
+    auto producer = std::async(std::launch::async, [&event, i] { event.notify(i); });
+
+    auto future = event.getFuture();
+    EXPECT_EQ(future.get(), i);
+    producer.get();
+  }
+}
+
+TEST(Future, oneShotEventCopiesOnlyForRetrievedFuture)
+{
+  struct CopyCounting {
+    int* numCopies;
+    CopyCounting(int* n) : numCopies{n} {}
+    CopyCounting(CopyCounting const& src) : numCopies{src.numCopies} { ++*numCopies; }
+    CopyCounting(CopyCounting&&) = default;
+  };
+
+  int numCopies = 0;
+  cctools::NonSharedOneShotEvent<CopyCounting> unlinked;
+  unlinked.notify(CopyCounting{&numCopies});
+  EXPECT_EQ(unlinked.get().numCopies, &numCopies);
+  EXPECT_EQ(numCopies, 0);
+
+  cctools::NonSharedOneShotEvent<CopyCounting> linked;
+  auto future = linked.getFuture();
+  linked.notify(CopyCounting{&numCopies});
+  EXPECT_EQ(numCopies, 1);
+  EXPECT_EQ(future.get().numCopies, &numCopies);
+  EXPECT_EQ(numCopies, 1);
+
+  cctools::NonSharedOneShotEvent<std::unique_ptr<int>> moveOnly;
+  moveOnly.notify(std::make_unique<int>(3));
+  EXPECT_EQ(*moveOnly.get(), 3);
+}
+
+TEST(Future, dagOnSingleThreadedPool)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::fifo> pool(1);
+
+  cctools::SharedOneShotEvent<void> start;
+  auto root = start.getFuture();
+
+  std::vector<cctools::Future<int>> branches;
+  auto shared = root.then(pool, [] { return 10; });
+  for(int i = 1; i <= 3; ++i)
+  {
+    cctools::Promise<int> branch;
+    branches.push_back(branch.getFuture());
+    pool.post([i, branch = std::move(branch)]() mutable { branch.setValue(i); });
+  }
+  branches.push_back(std::move(shared));
+
+  auto total = cctools::whenAll(std::move(branches)).then(pool, [](std::vector<int> values) {
+    int sum = 0;
+    for(const int v : values)
+    {
+      sum += v;
+    }
+    return sum;
+  });
+
+  start.notify();
+  EXPECT_EQ(total.get(), 16);
+}
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // FUTURETEST_H_64019283746501928374650192837465019283746501
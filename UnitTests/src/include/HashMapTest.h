@@ -21,7 +21,11 @@
 
 #include <ConcurrencyTools/HashMap.h>
 
+#include <atomic>
+#include <future>
+#include <memory>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 using namespace std::string_literals;
@@ -352,6 +356,165 @@ TEST(HashMap, invokeExpectException)
   );
 }
 
+TEST(HashMap, sizeCountsInsertionsViaSubscript)
+{
+  hashMap<std::string, int> map;
+  map["Bill"s] = 38;
+  map["Bill"s] = 39;
+  map["Judy"s] = 23;
+
+  EXPECT_EQ(map.size(), 2ULL);
+  map.erase("Bill"s);
+  map.erase("Bill"s);
+  EXPECT_EQ(map.size(), 1ULL);
+}
+
+TEST(StripedHashMap, insertOrReplaceEraseEmplace)
+{
+  cctools::StripedHashMap<int, test::Person> map{{1, {8, "Elena"s}}, {2, {9, "Tabea"s}}};
+  map.insertOrReplace(3, test::Person{11, "Theodor"s});
+  EXPECT_EQ(map.emplace(1, 10, "Elena"s), 0ULL);
+  EXPECT_EQ(map.size(), 3ULL);
+
+  EXPECT_EQ(map.erase(2), 1ULL);
+  EXPECT_FALSE(map.contains(2));
+  EXPECT_EQ(map.size(), 2ULL);
+  EXPECT_EQ(map.invoke(1, [](test::Person const& p) { return p.getAge(); }), 10);
+}
+
+TEST(StripedHashMap, concurrentInsertErase)
+{
+  constexpr int numThreads   = 4;
+  constexpr int numPerThread = 2000;
+
+  cctools::StripedHashMap<int, int, std::hash<int>, std::shared_mutex, 4ULL> map(31ULL);
+
+  std::vector<std::future<void>> writers;
+  for(int t = 0; t < numThreads; ++t)
+  {
+    writers.push_back(std::async(std::launch::async, [&map, t] {
+      for(int i = t * numPerThread; i < (t + 1) * numPerThread; ++i)
+      {
+        map.insertOrReplace(i, i);
+        map.invoke(i, [](int& v) { ++v; });
+        if(i % 4 == 0)
+        {
+          map.erase(i);
+        }
+      }
+    }));
+  }
+  for(auto& writer : writers)
+  {
+    writer.get();
+  }
+
+  EXPECT_EQ(map.size(), static_cast<std::size_t>(numThreads * numPerThread * 3 / 4));
+  std::size_t n = 0ULL;
+  map.forEach([&n](int) { ++n; });
+  EXPECT_EQ(n, map.size());
+}
+
+TEST(ReadMostlyHashMap, insertOrReplaceEraseEmplace)
+{
+  cctools::ReadMostlyHashMap<int, test::Person> map{{1, {8, "Elena"s}}, {2, {9, "Tabea"s}}};
+  map.insertOrReplace(3, test::Person{11, "Theodor"s});
+  EXPECT_EQ(map.emplace(1, 10, "Elena"s), 0ULL);
+  EXPECT_EQ(map.size(), 3ULL);
+
+  EXPECT_EQ(map.erase(2), 1ULL);
+  EXPECT_EQ(map.erase(2), 0ULL);
+  EXPECT_FALSE(map.contains(2));
+  EXPECT_EQ(map.size(), 2ULL);
+
+  map.invoke(3, [](test::Person& p) { p.setAge(12); });
+  EXPECT_EQ(map.invoke(3, [](test::Person const& p) { return p.getAge(); }), 12);
+}
+
+TEST(ReadMostlyHashMap, constInvokeAndForEachValue)
+{
+  const cctools::ReadMostlyHashMap<int, test::Person> map{{1, {9, "Elena"s}}, {2, {8, "Tabea"s}}};
+
+  EXPECT_EQ(map.invoke(2, [](test::Person const& p) { return p.getName(); }), "Tabea"s);
+  EXPECT_THROW(map.invoke(3, [](test::Person const& p) { return p.getAge(); }), std::out_of_range);
+
+  std::vector<int> ages(map.size());
+  map.forEachValue([&ages](auto const& entry) {
+    auto const& [key, person] = entry;
+    ages[key - 1] = person.getAge();
+  });
+  EXPECT_EQ(ages[0], 9);
+  EXPECT_EQ(ages[1], 8);
+}
+
+TEST(ReadMostlyHashMap, replacedVersionsAreReclaimed)
+{
+  auto shared = std::make_shared<int>(3);
+  {
+    cctools::ReadMostlyHashMap<int, std::shared_ptr<int>> map(1ULL);
+    for(int i = 0; i < 100; ++i)
+    {
+      map.insertOrReplace(0, shared);
+    }
+  }
+
+  cctools::detail::EpochDomain::instance().reclaim();
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(ReadMostlyHashMap, epochDomainIsProcessWide)
+{
+  // the thread local records of the readers belong to the one domain returned by instance
+  static_assert(!std::is_default_constructible_v<cctools::detail::EpochDomain>);
+  EXPECT_EQ(&cctools::detail::EpochDomain::instance(), &cctools::detail::EpochDomain::instance());
+}
+
+TEST(ReadMostlyHashMap, concurrentReadersAndWriters)
+{
+  constexpr int numReaders = 4;
+  constexpr int numKeys    = 64;
+  constexpr int numWrites  = 2000;
+
+  cctools::ReadMostlyHashMap<int, std::string> map(7ULL);
+  for(int k = 0; k < numKeys; ++k)
+  {
+    map.insertOrReplace(k, std::to_string(k));
+  }
+
+  std::atomic<bool> done {false};
+  std::vector<std::future<int>> readers;
+  for(int t = 0; t < numReaders; ++t)
+  {
+    readers.push_back(std::async(std::launch::async, [&map, &done] {
+      auto const& reader = map;
+      int errors = 0;
+      while(!done.load())
+      {
+        for(int k = 0; k < numKeys; ++k)
+        {
+          // every version of a value starts with the key it belongs to
+          auto const value = reader.invoke(k, [](std::string const& s) { return s; });
+          errors += value.rfind(std::to_string(k), 0ULL) == 0ULL ? 0 : 1;
+        }
+      }
+      return errors;
+    }));
+  }
+
+  for(int i = 0; i < numWrites; ++i)
+  {
+    auto const k = i % numKeys;
+    map.insertOrReplace(k, std::to_string(k) + "/" + std::to_string(i));
+  }
+  done.store(true);
+
+  for(auto& reader : readers)
+  {
+    EXPECT_EQ(reader.get(), 0);
+  }
+  EXPECT_EQ(map.size(), static_cast<std::size_t>(numKeys));
+}
+
 
  
 // *************************************************************************** // 
@@ -20,8 +20,14 @@
 #include <ConcurrencyTools/List.h>
 #include "Person.h"
 
+#include <future>
+#include <memory>
+#include <string>
 #include <vector>
 
+
+using namespace std::string_literals;
+
  
 TEST(List, DefaultConstructor)
 {
@@ -124,6 +130,108 @@ TEST(ThreadsafeList, removeIf)
 
   EXPECT_EQ(vals, (std::vector{ 9,8,3 }));
 }
+
+TEST(List, removeIfLastElementThenPushBack)
+{
+  cctools::List<int> myList;
+  myList.push_back(3);
+  myList.push_back(5);
+  myList.push_back(7);
+
+  EXPECT_EQ(myList.remove_if([](int v) { return v == 7; }), 1ULL);
+  myList.push_back(9);
+
+  std::vector<int> vals;
+  myList.for_each([&vals](int v) { vals.push_back(v); });
+  EXPECT_EQ(vals, (std::vector{ 3,5,9 }));
+
+  EXPECT_EQ(myList.remove_if([](int) { return true; }), 3ULL);
+  EXPECT_TRUE(myList.empty());
+  myList.push_back(4);
+  myList.push_front(2);
+
+  vals.clear();
+  myList.for_each([&vals](int v) { vals.push_back(v); });
+  EXPECT_EQ(vals, (std::vector{ 2,4 }));
+}
+
+TEST(ThreadsafeList, emplaceAndFindFirstIf)
+{
+  cctools::ThreadsafeList<test::Person> myList;
+  myList.emplace_back(8, "Elena"s);
+  myList.emplace_front(9, "Tabea"s);
+  myList.emplace_back(11, "Theodor"s);
+
+  auto const person = myList.find_first_if([](test::Person const& p) { return p.getAge() > 8; });
+  ASSERT_TRUE(person.has_value());
+  EXPECT_EQ(person->getName(), "Tabea"s);
+  EXPECT_FALSE(myList.find_first_if([](test::Person const& p) { return p.getAge() > 11; }).has_value());
+}
+
+TEST(ThreadsafeList, destroysRemovedAndRemainingElements)
+{
+  auto shared = std::make_shared<int>(3);
+  {
+    cctools::ThreadsafeList<std::shared_ptr<int>> myList(4ULL);
+    for(int i = 0; i < 10; ++i)
+    {
+      myList.push_back(shared);
+    }
+    EXPECT_EQ(shared.use_count(), 11);
+
+    int i = 0;
+    EXPECT_EQ(myList.remove_if([&i](auto const&) { return i++ % 2 == 0; }), 5ULL);
+    EXPECT_EQ(shared.use_count(), 6);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(ThreadsafeList, concurrentPushAndRemove)
+{
+  constexpr int numThreads   = 4;
+  constexpr int numPerThread = 2000;
+
+  cctools::ThreadsafeList<int> myList;
+
+  std::vector<std::future<void>> workers;
+  for(int t = 0; t < numThreads; ++t)
+  {
+    workers.push_back(std::async(std::launch::async, [&myList, t] {
+      for(int i = t * numPerThread; i < (t + 1) * numPerThread; ++i)
+      {
+        if(i % 2 == 0)
+        {
+          myList.push_back(i);
+        }
+        else
+        {
+          myList.push_front(i);
+        }
+        if(i % 64 == 0)
+        {
+          myList.remove_if([](int v) { return v % 4 == 0; });
+        }
+      }
+    }));
+  }
+  for(auto& worker : workers)
+  {
+    worker.get();
+  }
+  myList.remove_if([](int v) { return v % 4 == 0; });
+
+  long long sum = 0;
+  int       num = 0;
+  myList.for_each([&sum, &num](int v) { sum += v; ++num; });
+
+  long long expectedSum = 0;
+  for(int i = 0; i < numThreads * numPerThread; ++i)
+  {
+    expectedSum += i % 4 == 0 ? 0 : i;
+  }
+  EXPECT_EQ(num, numThreads * numPerThread * 3 / 4);
+  EXPECT_EQ(sum, expectedSum);
+}
  
 // *************************************************************************** // 
 // ******************************* END OF FILE ******************************* // 
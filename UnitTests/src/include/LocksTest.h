@@ -0,0 +1,282 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    LocksTest.h
+ * @brief
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef LOCKSTEST_H_38475610293847561029384756102938475610293847
+#define LOCKSTEST_H_38475610293847561029384756102938475610293847
+
+
+// includes
+#include <ConcurrencyTools/HashMap.h>
+#include <ConcurrencyTools/List.h>
+#include <ConcurrencyTools/Locks.h>
+#include <ConcurrencyTools/TMPUtils.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+
+using namespace std::chrono_literals;
+
+
+namespace {
+
+template <typename Mutex>
+void expectTryLockFailsWhileLocked()
+{
+  Mutex mutex;
+  EXPECT_TRUE(mutex.try_lock());
+
+  auto other = std::async(std::launch::async, [&mutex] { return mutex.try_lock(); });
+  EXPECT_FALSE(other.get());
+
+  mutex.unlock();
+  EXPECT_TRUE(mutex.try_lock());
+  mutex.unlock();
+}
+
+template <typename Mutex>
+void expectMutualExclusion()
+{
+  constexpr int numThreads    = 4;
+  constexpr int numIncrements = 20000;
+
+  Mutex mutex;
+  int   counter = 0;
+
+  std::vector<std::future<void>> workers;
+  for(int t = 0; t < numThreads; ++t)
+  {
+    workers.push_back(std::async(std::launch::async, [&] {
+      for(int i = 0; i < numIncrements; ++i)
+      {
+        std::lock_guard lck(mutex);
+        ++counter;
+      }
+    }));
+  }
+  for(auto& worker : workers)
+  {
+    worker.get();
+  }
+
+  EXPECT_EQ(counter, numThreads * numIncrements);
+}
+
+template <typename Mutex>
+void expectWorksWithThreadsafeList()
+{
+  cctools::ThreadsafeList<int, Mutex> list;
+
+  auto producer = std::async(std::launch::async, [&list] {
+    for(int i = 0; i < 1000; ++i)
+    {
+      list.push_back(i);
+    }
+  });
+  for(int i = 0; i < 1000; ++i)
+  {
+    list.push_front(-i - 1);
+  }
+  producer.get();
+
+  EXPECT_EQ(list.remove_if([](int v) { return v >= 0; }), 1000ULL);
+  EXPECT_EQ(list.remove_if([](int v) { return v < 0; }), 1000ULL);
+  EXPECT_TRUE(list.empty());
+}
+
+template <typename Mutex>
+void expectWorksWithThreadsafeHashMap()
+{
+  cctools::ThreadsafeHashMap<int, int, std::hash<int>, Mutex> map;
+  cctools::StripedHashMap<int, int, std::hash<int>, Mutex, 4ULL> stripedMap;
+
+  auto writer = std::async(std::launch::async, [&] {
+    for(int i = 0; i < 1000; ++i)
+    {
+      map.insertOrReplace(i, i);
+      stripedMap.insertOrReplace(i, i);
+    }
+  });
+  int numFound = 0;
+  for(int i = 0; i < 1000; ++i)
+  {
+    numFound += map.contains(i) ? 1 : 0;
+    numFound += stripedMap.contains(i) ? 1 : 0;
+  }
+  writer.get();
+
+  EXPECT_LE(numFound, 2000);
+  EXPECT_EQ(map.size(), 1000ULL);
+  EXPECT_EQ(stripedMap.size(), 1000ULL);
+  EXPECT_EQ(map.at(500), 500);
+  EXPECT_EQ(stripedMap.at(999), 999);
+}
+
+}   // namespace
+
+
+TEST(SpinLock, tryLockFailsWhileLocked)
+{
+  expectTryLockFailsWhileLocked<cctools::SpinLock>();
+}
+
+TEST(SpinLock, mutualExclusion)
+{
+  expectMutualExclusion<cctools::SpinLock>();
+}
+
+TEST(SpinLock, threadsafeList)
+{
+  expectWorksWithThreadsafeList<cctools::SpinLock>();
+}
+
+TEST(SpinLock, threadsafeHashMap)
+{
+  expectWorksWithThreadsafeHashMap<cctools::SpinLock>();
+}
+
+TEST(SharedSpinLock, tryLockFailsWhileLocked)
+{
+  expectTryLockFailsWhileLocked<cctools::SharedSpinLock>();
+}
+
+TEST(SharedSpinLock, mutualExclusion)
+{
+  expectMutualExclusion<cctools::SharedSpinLock>();
+}
+
+TEST(SharedSpinLock, threadsafeList)
+{
+  expectWorksWithThreadsafeList<cctools::SharedSpinLock>();
+}
+
+TEST(SharedSpinLock, threadsafeHashMap)
+{
+  expectWorksWithThreadsafeHashMap<cctools::SharedSpinLock>();
+}
+
+TEST(HybridMutex, tryLockFailsWhileLocked)
+{
+  expectTryLockFailsWhileLocked<cctools::HybridMutex>();
+}
+
+TEST(HybridMutex, mutualExclusion)
+{
+  expectMutualExclusion<cctools::HybridMutex>();
+}
+
+TEST(HybridMutex, threadsafeList)
+{
+  expectWorksWithThreadsafeList<cctools::HybridMutex>();
+}
+
+TEST(HybridMutex, threadsafeHashMap)
+{
+  expectWorksWithThreadsafeHashMap<cctools::HybridMutex>();
+}
+
+TEST(SharedSpinLock, isSharedMutex)
+{
+  EXPECT_TRUE(cctools::tmp::IsSharedMutex<cctools::SharedSpinLock>);
+  EXPECT_FALSE(cctools::tmp::IsSharedMutex<cctools::SpinLock>);
+  EXPECT_FALSE(cctools::tmp::IsSharedMutex<cctools::HybridMutex>);
+}
+
+TEST(SharedSpinLock, readersShareTheLock)
+{
+  cctools::SharedSpinLock mutex;
+  mutex.lock_shared();
+
+  auto reader = std::async(std::launch::async, [&mutex] {
+    const bool success = mutex.try_lock_shared();
+    if(success)
+    {
+      mutex.unlock_shared();
+    }
+    return success;
+  });
+  EXPECT_TRUE(reader.get());
+  EXPECT_FALSE(mutex.try_lock());
+
+  mutex.unlock_shared();
+  EXPECT_TRUE(mutex.try_lock());
+  EXPECT_FALSE(mutex.try_lock_shared());
+  mutex.unlock();
+}
+
+TEST(SharedSpinLock, waitingWriterBlocksNewReaders)
+{
+  cctools::SharedSpinLock mutex;
+  mutex.lock_shared();
+
+  std::atomic<bool> writerDone {false};
+  auto writer = std::async(std::launch::async, [&] {
+    std::lock_guard lck(mutex);
+    writerDone = true;
+  });
+
+  // as soon as the writer announced itself, no reader may enter anymore
+  const auto until = std::chrono::steady_clock::now() + 5s;
+  bool blocked = false;
+  while(!blocked && std::chrono::steady_clock::now() < until)
+  {
+    blocked = !mutex.try_lock_shared();
+    if(!blocked)
+    {
+      mutex.unlock_shared();
+      std::this_thread::yield();
+    }
+  }
+  EXPECT_TRUE(blocked);
+  EXPECT_FALSE(writerDone);
+
+  mutex.unlock_shared();
+  writer.get();
+  EXPECT_TRUE(writerDone);
+  EXPECT_TRUE(mutex.try_lock_shared());
+  mutex.unlock_shared();
+}
+
+TEST(HybridMutex, parkedThreadIsWokenUp)
+{
+  cctools::HybridMutex mutex(cctools::WaitStrategy::blocking());
+  mutex.lock();
+
+  std::atomic<bool> acquired {false};
+  auto waiter = std::async(std::launch::async, [&] {
+    std::lock_guard lck(mutex);
+    acquired = true;
+  });
+
+  std::this_thread::sleep_for(100ms);
+  EXPECT_FALSE(acquired);
+
+  mutex.unlock();
+  waiter.get();
+  EXPECT_TRUE(acquired);
+  EXPECT_TRUE(mutex.try_lock());
+  mutex.unlock();
+}
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // LOCKSTEST_H_38475610293847561029384756102938475610293847
@@ -0,0 +1,248 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    MetricsTest.h
+ * @brief
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef METRICSTEST_H_40192837465019283746501928374650192837465019283
+#define METRICSTEST_H_40192837465019283746501928374650192837465019283
+
+
+// includes
+#include <ConcurrencyTools/Metrics.h>
+#include <ConcurrencyTools/ThreadPool.h>
+#include <ConcurrencyTools/ThreadsafeQueue.h>
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+
+TEST(HistogramSnapshot, bucketsAreContiguousAndPrecise)
+{
+  using snapshot = cctools::HistogramSnapshot;
+  EXPECT_EQ(snapshot::lowerBound(0ULL), 0ULL);
+  for(std::size_t bucket = 1ULL; bucket < snapshot::numBuckets; ++bucket)
+  {
+    EXPECT_EQ(snapshot::lowerBound(bucket), snapshot::upperBound(bucket - 1ULL) + 1ULL);
+    EXPECT_EQ(snapshot::bucketIndex(snapshot::lowerBound(bucket)), bucket);
+    EXPECT_EQ(snapshot::bucketIndex(snapshot::upperBound(bucket)), bucket);
+    EXPECT_LE(snapshot::upperBound(bucket) - snapshot::lowerBound(bucket), snapshot::lowerBound(bucket) / 16ULL);
+  }
+  EXPECT_EQ(snapshot::bucketIndex(~std::uint64_t{0ULL}), snapshot::numBuckets - 1ULL);
+}
+
+TEST(LatencyHistogram, percentilesAndMean)
+{
+  cctools::LatencyHistogram histogram;
+  for(long long ns = 1LL; ns <= 1000LL; ++ns)
+  {
+    histogram.record(std::chrono::nanoseconds{ns * 1000LL});
+  }
+
+  const auto snapshot = histogram.snapshot();
+  EXPECT_EQ(snapshot.count(), 1000ULL);
+  EXPECT_EQ(snapshot.mean(), std::chrono::nanoseconds{500500LL});
+
+  const auto median = snapshot.percentile(50.0);
+  EXPECT_GE(median, std::chrono::microseconds(500));
+  EXPECT_LE(median, std::chrono::microseconds(500) + std::chrono::microseconds(500) / 16);
+  EXPECT_GE(snapshot.max(), std::chrono::milliseconds(1));
+  EXPECT_LE(snapshot.max(), std::chrono::nanoseconds(1000000LL + 1000000LL / 16LL));
+
+  std::uint64_t total = 0ULL;
+  snapshot.forEachBucket([&total](std::uint64_t lower, std::uint64_t upper, std::uint64_t count) {
+    EXPECT_LE(lower, upper);
+    total += count;
+  });
+  EXPECT_EQ(total, 1000ULL);
+}
+
+TEST(ThreadPoolMetrics, countsTasksAndLatencies)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::fifo, cctools::metricsPolicy::enabled> pool(2);
+
+  std::vector<std::future<void>> results;
+  for(int t = 0; t < 20; ++t)
+  {
+    results.push_back(pool.submit([] { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }));
+  }
+  for(auto& r : results)
+  {
+    r.get();
+  }
+  // the counters are updated after the futures are ready
+  for(int i = 0; i < 1000 && pool.metrics().tasksCompleted < 20ULL; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  const auto metrics = pool.metrics();
+  EXPECT_EQ(metrics.tasksSubmitted, 20ULL);
+  EXPECT_EQ(metrics.tasksCompleted, 20ULL);
+  EXPECT_EQ(metrics.queueDepth, 0ULL);
+  EXPECT_EQ(metrics.runTime.count(), 20ULL);
+  EXPECT_EQ(metrics.waitLatency.count(), 20ULL);
+  EXPECT_GE(metrics.runTime.percentile(50.0), std::chrono::milliseconds(1));
+  ASSERT_EQ(metrics.workers.size(), 2ULL);
+
+  std::uint64_t tasksRun = 0ULL;
+  for(auto const& worker : metrics.workers)
+  {
+    tasksRun += worker.tasksRun;
+    EXPECT_LE(worker.busyTime, metrics.uptime);
+  }
+  EXPECT_EQ(tasksRun, 20ULL);
+}
+
+TEST(ThreadPoolMetrics, queueDepthOfBlockedPool)
+{
+  cctools::NonWaitableThreadPool<cctools::queuePolicy::prioritized, cctools::metricsPolicy::enabled> pool(1);
+
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  std::promise<void> started;
+  pool.submit([&started, released] {
+    started.set_value();
+    released.wait();
+  });
+  started.get_future().wait();
+  for(int t = 0; t < 5; ++t)
+  {
+    pool.submit([] {});
+  }
+
+  EXPECT_EQ(pool.metrics().queueDepth, 5ULL);
+  release.set_value();
+}
+
+TEST(ThreadPoolMetrics, countsCancelledTasks)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::fifo, cctools::metricsPolicy::enabled> pool(1);
+
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  auto blocker = pool.submit([released] { released.wait(); });
+
+  std::stop_source cancellation;
+  cctools::TaskOptions options;
+  options.cancellation = cancellation.get_token();
+  std::vector<std::future<void>> results;
+  for(int t = 0; t < 3; ++t)
+  {
+    results.push_back(pool.submit([] {}, options));
+  }
+  cancellation.request_stop();
+  release.set_value();
+  for(auto& result : results)
+  {
+    EXPECT_THROW(result.get(), cctools::TaskCancelled);
+  }
+
+  EXPECT_EQ(pool.metrics().tasksCancelled, 3ULL);
+}
+
+TEST(ThreadPoolMetrics, workStealingCountsSteals)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::workStealing, cctools::metricsPolicy::enabled> pool(4);
+
+  auto outer = pool.submit([&pool] {
+    std::vector<std::future<void>> inner;
+    for(int t = 0; t < 200; ++t)
+    {
+      inner.push_back(pool.submit([] { std::this_thread::sleep_for(std::chrono::microseconds(200)); }));
+    }
+    for(auto& f : inner)
+    {
+      while(f.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+      {
+        pool.runPendingTask();
+      }
+    }
+  });
+  outer.get();
+  for(int i = 0; i < 1000 && pool.metrics().tasksCompleted < 201ULL; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  const auto metrics = pool.metrics();
+  EXPECT_EQ(metrics.tasksCompleted, 201ULL);
+  EXPECT_GT(metrics.steals, 0ULL);
+}
+
+TEST(QueueMetrics, countsPushesPopsAndHighWaterMark)
+{
+  cctools::Queue<int, std::list, cctools::metricsPolicy::enabled> queue;
+  for(int i = 0; i < 10; ++i)
+  {
+    queue.push(i);
+  }
+  int value = 0;
+  for(int i = 0; i < 4; ++i)
+  {
+    queue.waitAndPop(value);
+  }
+  std::vector<int> values;
+  queue.tryPopBulk(std::back_inserter(values), 3ULL);
+
+  const auto metrics = queue.metrics();
+  EXPECT_EQ(metrics.pushes, 10ULL);
+  EXPECT_EQ(metrics.pops, 7ULL);
+  EXPECT_EQ(metrics.depth, 3ULL);
+  EXPECT_EQ(metrics.maxDepth, 10ULL);
+  EXPECT_EQ(metrics.consumerWait.count(), 4ULL);
+  EXPECT_EQ(metrics.producerWait.count(), 10ULL);
+}
+
+TEST(QueueMetrics, consumerWaitTime)
+{
+  cctools::PriorityQueue<int, std::less<int>, std::list, cctools::metricsPolicy::enabled> queue;
+  std::thread producer([&queue] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.push(1);
+  });
+
+  int value = 0;
+  queue.waitAndPop(value);
+  producer.join();
+
+  EXPECT_GE(queue.metrics().consumerWait.max(), std::chrono::milliseconds(15));
+}
+
+TEST(QueueMetrics, pushBulkRecordsOnlyBlockedTime)
+{
+  struct SlowCopy {
+    SlowCopy() = default;
+    SlowCopy(SlowCopy const&) { std::this_thread::sleep_for(std::chrono::milliseconds(2)); }
+    SlowCopy(SlowCopy&&) noexcept = default;
+    auto operator=(SlowCopy&&) noexcept -> SlowCopy& = default;
+  };
+
+  // copying the elements takes about 20ms, but the queue never runs out of capacity
+  cctools::Queue<SlowCopy, std::list, cctools::metricsPolicy::enabled> queue;
+  const std::vector<SlowCopy> values(10ULL);
+  EXPECT_EQ(queue.pushBulk(values), 10ULL);
+
+  const auto metrics = queue.metrics();
+  EXPECT_EQ(metrics.producerWait.count(), 1ULL);
+  EXPECT_LT(metrics.producerWait.max(), std::chrono::milliseconds(10));
+}
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // METRICSTEST_H_40192837465019283746501928374650192837465019283
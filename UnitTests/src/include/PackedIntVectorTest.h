@@ -0,0 +1,261 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    PackedIntVectorTest.h
+ * @brief
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef PACKEDINTVECTORTEST_H_83920174658392017465839201746583920174658392
+#define PACKEDINTVECTORTEST_H_83920174658392017465839201746583920174658392
+
+
+// includes
+#include <Bitwise/PackedIntVector.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+namespace {
+
+/// random values of numBits bits each
+auto makeRandomValues(std::size_t size, std::size_t numBits, std::mt19937::result_type seed) -> std::vector<std::uint32_t>
+{
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<std::uint32_t> distrib(0U, bws::punchMask<std::uint32_t>(numBits));
+
+  std::vector<std::uint32_t> values(size);
+  for(auto& v : values)
+  {
+    v = distrib(gen);
+  }
+  return values;
+}
+
+template <typename Vector>
+void expectValues(Vector const& v, std::vector<std::uint32_t> const& expected)
+{
+  ASSERT_EQ(expected.size(), v.size());
+  for(std::size_t i{}; i < expected.size(); ++i)
+  {
+    ASSERT_EQ(expected[i], v.get(i)) << "index " << i << " width " << v.width();
+  }
+}
+
+template <typename Vector>
+void testRoundTrip(Vector& v, std::mt19937::result_type seed)
+{
+  const auto values = makeRandomValues(v.size(), v.width(), seed);
+  for(std::size_t i{}; i < values.size(); ++i)
+  {
+    v[i] = values[i];
+  }
+  expectValues(v, values);
+
+  std::vector<std::uint32_t> decoded(v.size());
+  v.decode(decoded.data());
+  EXPECT_EQ(values, decoded);
+
+  // unaligned ranges are read by get in front of and behind the complete blocks
+  for(const auto& [first, count] : {std::pair{0ULL, 0ULL}, std::pair{3ULL, 61ULL}, std::pair{5ULL, 200ULL},
+                                   std::pair{64ULL, 128ULL}, std::pair{63ULL, 2ULL}, std::pair{100ULL, 900ULL}})
+  {
+    std::vector<std::uint32_t> range(count);
+    v.decode(first, count, range.data());
+    EXPECT_TRUE(std::equal(range.begin(), range.end(), values.begin() + static_cast<std::ptrdiff_t>(first)))
+      << "first " << first << " count " << count << " width " << v.width();
+  }
+}
+
+template <std::size_t Bits>
+void testCompileTimeWidth()
+{
+  bws::PackedIntVector<Bits> v(1000ULL);
+  EXPECT_EQ(Bits, v.width());
+  testRoundTrip(v, Bits);
+}
+
+}
+
+
+TEST(PackedIntVectorTest, compileTimeWidthRoundTrip)
+{
+  testCompileTimeWidth<1>();
+  testCompileTimeWidth<3>();
+  testCompileTimeWidth<7>();
+  testCompileTimeWidth<8>();
+  testCompileTimeWidth<13>();
+  testCompileTimeWidth<17>();
+  testCompileTimeWidth<31>();
+  testCompileTimeWidth<32>();
+}
+
+TEST(PackedIntVectorTest, runtimeWidthRoundTrip)
+{
+  for(std::size_t numBits = 1ULL; numBits <= 32ULL; ++numBits)
+  {
+    bws::PackedIntVector<> v(numBits, 1000ULL);
+    EXPECT_EQ(numBits, v.width());
+    testRoundTrip(v, static_cast<std::mt19937::result_type>(numBits));
+  }
+
+  EXPECT_THROW(bws::PackedIntVector<>(0ULL, 10ULL), std::invalid_argument);
+  EXPECT_THROW(bws::PackedIntVector<>(33ULL, 10ULL), std::invalid_argument);
+}
+
+TEST(PackedIntVectorTest, construction)
+{
+  bws::PackedIntVector<5> v(100ULL, 21U);
+  EXPECT_EQ(100ULL, v.size());
+  EXPECT_EQ(31U, v.maxValue());
+  expectValues(v, std::vector<std::uint32_t>(100ULL, 21U));
+
+  // values are masked to the bit width
+  bws::PackedIntVector<> w(3ULL, 10ULL, 0xFFU);
+  expectValues(w, std::vector<std::uint32_t>(10ULL, 7U));
+
+  auto copy = w;
+  EXPECT_TRUE(copy == w);
+  copy[9] = 0U;
+  EXPECT_TRUE(copy != w);
+
+  const auto moved = std::move(copy);
+  EXPECT_EQ(10ULL, moved.size());
+  EXPECT_EQ(0U, moved.get(9ULL));
+}
+
+TEST(PackedIntVectorTest, proxies)
+{
+  bws::PackedIntVector<6> v(10ULL);
+
+  v[0] = 63U;
+  v[1] = v[0];
+  EXPECT_EQ(63U, v.get(1ULL));
+
+  v[1] -= 3U;
+  ++v[2];
+  v[3] += 70U;
+  EXPECT_EQ(60U, v[1]);
+  EXPECT_EQ(1U, v[2]);
+  EXPECT_EQ(6U, v[3]);
+
+  // increments wrap around at the bit width
+  ++v[0];
+  --v[4];
+  EXPECT_EQ(0U, v[0]);
+  EXPECT_EQ(63U, v[4]);
+
+  v.front() = 5U;
+  v.back()  = 9U;
+  EXPECT_EQ(5U, v.at(0ULL));
+  EXPECT_EQ(9U, v.at(9ULL));
+  EXPECT_THROW((void)v.at(10ULL), std::out_of_range);
+
+  std::uint32_t sum{};
+  for(const auto val : std::as_const(v))
+  {
+    sum += val;
+  }
+  EXPECT_EQ(5U + 60U + 1U + 6U + 63U + 9U, sum);
+
+  for(auto val : v)
+  {
+    val = 1U;
+  }
+  expectValues(v, std::vector<std::uint32_t>(10ULL, 1U));
+}
+
+TEST(PackedIntVectorTest, resize)
+{
+  bws::PackedIntVector<11> v;
+  for(std::uint32_t i{}; i < 300U; ++i)
+  {
+    v.push_back(i);
+  }
+  EXPECT_EQ(300ULL, v.size());
+  EXPECT_GE(v.capacity(), 300ULL);
+
+  v.resize(100ULL);
+  EXPECT_EQ(100ULL, v.size());
+  EXPECT_EQ(99U, v.back());
+
+  // values dropped by resize or pop_back don't reappear
+  v.pop_back();
+  v.resize(200ULL);
+  v.resize(250ULL, 7U);
+  std::vector<std::uint32_t> expected(250ULL);
+  for(std::uint32_t i{}; i < 99U; ++i)
+  {
+    expected[i] = i;
+  }
+  std::fill(expected.begin() + 200, expected.end(), 7U);
+  expectValues(v, expected);
+
+  // the capacity follows the bit width, 250 values of 11 bits fill 43 regions
+  v.shrink_to_fit();
+  EXPECT_EQ(250ULL, v.capacity());
+  v.reserve(1000ULL);
+  EXPECT_GE(v.capacity(), 1000ULL);
+  expectValues(v, expected);
+
+  v.assign(20ULL, 3U);
+  expectValues(v, std::vector<std::uint32_t>(20ULL, 3U));
+
+  v.clear();
+  EXPECT_TRUE(v.empty());
+  v.resize(20ULL);
+  expectValues(v, std::vector<std::uint32_t>(20ULL, 0U));
+}
+
+TEST(PackedIntVectorTest, setWidth)
+{
+  const auto values = makeRandomValues(777ULL, 9ULL, 42U);
+
+  bws::PackedIntVector<> v(9ULL, 0ULL);
+  for(const auto val : values)
+  {
+    v.push_back(val);
+  }
+
+  v.setWidth(23ULL);
+  EXPECT_EQ(23ULL, v.width());
+  expectValues(v, values);
+
+  v[5] = 1U << 20U;
+  EXPECT_THROW(v.setWidth(9ULL), std::invalid_argument);
+  EXPECT_EQ(23ULL, v.width());
+  EXPECT_EQ(1U << 20U, v[5]);
+
+  v[5] = values[5];
+  v.setWidth(9ULL);
+  EXPECT_EQ(9ULL, v.width());
+  expectValues(v, values);
+
+  bws::PackedIntVector<> w(23ULL, 0ULL);
+  for(const auto val : values)
+  {
+    w.push_back(val);
+  }
+  EXPECT_TRUE(v == w);
+
+  EXPECT_THROW(v.setWidth(0ULL), std::invalid_argument);
+  EXPECT_THROW(v.setWidth(40ULL), std::invalid_argument);
+}
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // PACKEDINTVECTORTEST_H_83920174658392017465839201746583920174658392
@@ -0,0 +1,173 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ParallelAlgorithmsTest.h
+ * @brief
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef PARALLELALGORITHMSTEST_H_82736450192837465019283746501928374650192
+#define PARALLELALGORITHMSTEST_H_82736450192837465019283746501928374650192
+
+
+// includes
+#include <ConcurrencyTools/ParallelAlgorithms.h>
+#include <ConcurrencyTools/ThreadPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+
+TEST(ParallelAlgorithms, parallelForVisitsEveryIndexOnce)
+{
+  cctools::NonWaitableThreadPool<cctools::queuePolicy::workStealing> pool(4);
+
+  const std::size_t size = 10007ULL;
+  std::vector<int> visits(size, 0);
+  std::atomic<int> numInvocations {0};
+  cctools::parallelFor(pool, std::size_t{0ULL}, size, 64ULL, [&](std::size_t first, std::size_t last) {
+    EXPECT_LE(last - first, 64ULL);
+    ++numInvocations;
+    for(; first != last; ++first)
+    {
+      ++visits[first];
+    }
+  });
+
+  EXPECT_GE(numInvocations, static_cast<int>(size / 64ULL));
+  for(auto const v : visits)
+  {
+    EXPECT_EQ(v, 1);
+  }
+}
+
+TEST(ParallelAlgorithms, parallelForSmallRangeRunsInline)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::fifo> pool(2);
+
+  int numInvocations = 0;
+  cctools::parallelFor(pool, 5, 10, 16, [&](int first, int last) {
+    EXPECT_EQ(first, 5);
+    EXPECT_EQ(last, 10);
+    ++numInvocations;
+  });
+  cctools::parallelFor(pool, 10, 10, 16, [&](int, int) { ++numInvocations; });
+
+  EXPECT_EQ(numInvocations, 1);
+}
+
+TEST(ParallelAlgorithms, nestedParallelForOnWorkingThreads)
+{
+  cctools::NonWaitableThreadPool<cctools::queuePolicy::fifo> pool(2);
+
+  std::atomic<int> counter {0};
+  cctools::parallelFor(pool, 0, 8, 1, [&](int first, int last) {
+    for(; first != last; ++first)
+    {
+      cctools::parallelFor(pool, 0, 100, 10, [&](int b, int e) { counter += e - b; });
+    }
+  });
+
+  EXPECT_EQ(counter, 800);
+}
+
+TEST(ParallelAlgorithms, parallelForRethrowsException)
+{
+  cctools::NonWaitableThreadPool<cctools::queuePolicy::workStealing> pool(4);
+
+  auto const throwingLoop = [&pool] {
+    cctools::parallelFor(pool, 0, 1000, 10, [](int first, int last) {
+      if(first <= 500 && 500 < last)
+      {
+        throw std::runtime_error("index 500");
+      }
+    });
+  };
+
+  EXPECT_THROW(throwingLoop(), std::runtime_error);
+}
+
+TEST(ParallelAlgorithms, parallelReduceSum)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::prioritized> pool(3);
+
+  const auto sum = cctools::parallelReduce(
+    pool, 1LL, 100001LL, 1000LL, 0LL,
+    [](long long first, long long last) {
+      long long partialSum = 0LL;
+      for(; first != last; ++first)
+      {
+        partialSum += first;
+      }
+      return partialSum;
+    },
+    [](long long a, long long b) { return a + b; });
+
+  EXPECT_EQ(sum, 5000050000LL);
+}
+
+TEST(ParallelAlgorithms, parallelReduceIsDeterministic)
+{
+  std::vector<double> values(100000ULL);
+  for(std::size_t i = 0ULL; i < values.size(); ++i)
+  {
+    values[i] = 1.0 / static_cast<double>(i + 1ULL);
+  }
+
+  auto const reduce = [&values] {
+    return cctools::parallelReduce(
+      std::size_t{0ULL}, values.size(), 128ULL, 0.0,
+      [&values](std::size_t first, std::size_t last) {
+        double partialSum = 0.0;
+        for(; first != last; ++first)
+        {
+          partialSum += values[first];
+        }
+        return partialSum;
+      },
+      [](double a, double b) { return a + b; });
+  };
+
+  const auto result = reduce();
+  for(int i = 0; i < 10; ++i)
+  {
+    EXPECT_EQ(reduce(), result);
+  }
+}
+
+TEST(ParallelAlgorithms, parallelReduceOfBool)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::fifo> pool(4);
+  std::vector<int> values(100000ULL, 1);
+  values[77777ULL] = -1;
+
+  // neighbouring chunks store their partial results concurrently
+  const auto anyNegative = cctools::parallelReduce(
+    pool, std::size_t{0ULL}, values.size(), 16ULL, false,
+    [&values](std::size_t first, std::size_t last) {
+      return std::any_of(values.begin() + static_cast<std::ptrdiff_t>(first),
+                         values.begin() + static_cast<std::ptrdiff_t>(last), [](int v) { return v < 0; });
+    },
+    [](bool a, bool b) { return a || b; });
+
+  EXPECT_TRUE(anyNegative);
+}
+
+TEST(ParallelAlgorithms, parallelReduceEmptyRangeReturnsIdentity)
+{
+  const auto result = cctools::parallelReduce(
+    0, 0, 10, 42, [](int, int) { return 1; }, [](int a, int b) { return a + b; });
+  EXPECT_EQ(result, 42);
+}
+
+
+#endif   // PARALLELALGORITHMSTEST_H_82736450192837465019283746501928374650192
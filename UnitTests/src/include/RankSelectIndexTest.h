@@ -0,0 +1,142 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    RankSelectIndexTest.h
+ * @brief
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef RANKSELECTINDEXTEST_H_38475610293847561029384756102938475610293
+#define RANKSELECTINDEXTEST_H_38475610293847561029384756102938475610293
+
+
+// includes
+#include <Bitwise/BitVector.h>
+#include <Bitwise/RankSelectIndex.h>
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+
+namespace {
+
+template <typename IntType>
+auto makeRandomBitVector(std::size_t size, double density) -> bws::BitVectorT<IntType>
+{
+  std::mt19937 gen(static_cast<std::mt19937::result_type>(size));
+  std::bernoulli_distribution distrib(density);
+
+  bws::BitVectorT<IntType> b(size);
+  for(std::size_t i{}; i < size; ++i)
+  {
+    b[i] = distrib(gen);
+  }
+  return b;
+}
+
+/// compares rank and select with a linear scan over the proxies
+template <typename IntType>
+void expectRankSelectMatch(std::size_t size, double density)
+{
+  const auto b = makeRandomBitVector<IntType>(size, density);
+  const bws::RankSelectIndex<IntType> index(b);
+
+  std::vector<std::size_t> setBits;
+  for(std::size_t i{}; i < size; ++i)
+  {
+    ASSERT_EQ(index.rank(i), setBits.size()) << "at index " << i;
+    if(b[i])
+    {
+      setBits.push_back(i);
+    }
+  }
+  ASSERT_EQ(index.rank(size), setBits.size());
+  ASSERT_EQ(index.count(), setBits.size());
+  ASSERT_EQ(index.size(), size);
+
+  for(std::size_t k{}; k < setBits.size(); ++k)
+  {
+    ASSERT_EQ(index.select(k), setBits[k]) << "for k = " << k;
+  }
+  EXPECT_EQ(index.select(setBits.size()), index.npos);
+}
+
+}   // namespace
+
+
+TEST(RankSelectIndex, emptyVector)
+{
+  const bws::BitVectorT<std::uint8_t> b;
+  const bws::RankSelectIndex index(b);
+  EXPECT_EQ(index.size(), 0ULL);
+  EXPECT_EQ(index.count(), 0ULL);
+  EXPECT_EQ(index.rank(0ULL), 0ULL);
+  EXPECT_EQ(index.select(0ULL), index.npos);
+}
+
+TEST(RankSelectIndex, rankBeyondSizeThrows)
+{
+  const bws::BitVectorT<std::uint8_t> b(100ULL, true);
+  const bws::RankSelectIndex index(b);
+  EXPECT_EQ(index.rank(100ULL), 100ULL);
+  EXPECT_THROW(static_cast<void>(index.rank(101ULL)), std::out_of_range);
+}
+
+TEST(RankSelectIndex, rankAndSelectMatchReference)
+{
+  expectRankSelectMatch<std::uint8_t>(1000ULL, 0.5);
+  expectRankSelectMatch<std::uint16_t>(4099ULL, 0.95);
+  expectRankSelectMatch<std::uint32_t>(512ULL, 0.3);
+  // spans several superblocks
+  expectRankSelectMatch<std::uint64_t>(3ULL * 65536ULL + 777ULL, 0.5);
+  expectRankSelectMatch<std::uint64_t>(2ULL * 65536ULL, 0.001);
+  expectRankSelectMatch<std::uint8_t>(70000ULL, 0.0);
+}
+
+TEST(RankSelectIndex, rankSelectRoundTrip)
+{
+  const auto b = makeRandomBitVector<std::uint64_t>(200000ULL, 0.01);
+  const bws::RankSelectIndex index(b);
+
+  std::size_t k = 0ULL;
+  for(const auto pos : b.setBits())
+  {
+    ASSERT_EQ(index.select(k), pos);
+    ASSERT_EQ(index.rank(pos), k);
+    ++k;
+  }
+  EXPECT_EQ(k, index.count());
+}
+
+TEST(RankSelectIndex, rebuildAfterModification)
+{
+  bws::BitVectorT<std::uint16_t> b(1000ULL);
+  bws::RankSelectIndex index(b);
+  EXPECT_EQ(index.count(), 0ULL);
+
+  b[10]  = true;
+  b[999] = true;
+  b.resize(2000ULL, true);
+  index.rebuild();
+
+  EXPECT_EQ(index.size(), 2000ULL);
+  EXPECT_EQ(index.count(), 1002ULL);
+  EXPECT_EQ(index.select(0ULL), 10ULL);
+  EXPECT_EQ(index.select(1ULL), 999ULL);
+  EXPECT_EQ(index.select(2ULL), 1000ULL);
+  EXPECT_EQ(index.rank(1500ULL), 502ULL);
+}
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // RANKSELECTINDEXTEST_H_38475610293847561029384756102938475610293
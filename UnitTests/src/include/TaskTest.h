@@ -0,0 +1,342 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    TaskTest.h
+ * @brief
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef TASKTEST_H_50192837465019283746501928374650192837465019
+#define TASKTEST_H_50192837465019283746501928374650192837465019
+
+
+// includes
+#include <ConcurrencyTools/OneShotEvent.h>
+#include <ConcurrencyTools/Task.h>
+#include <ConcurrencyTools/ThreadPool.h>
+#include <ConcurrencyTools/ThreadsafeQueue.h>
+
+#include <chrono>
+#include <future>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+using namespace std::chrono_literals;
+
+
+namespace {
+
+using TaskPool = cctools::WaitableThreadPool<cctools::queuePolicy::fifo>;
+
+auto answer() -> cctools::Task<int>
+{
+  co_return 42;
+}
+
+auto twice(int i) -> cctools::Task<int>
+{
+  const int value = co_await answer();
+  co_return i * value;
+}
+
+auto failing() -> cctools::Task<void>
+{
+  throw std::runtime_error("failed");
+  co_return;
+}
+
+auto threadAfterSchedule(TaskPool& pool) -> cctools::Task<std::thread::id>
+{
+  co_await pool.schedule();
+  co_return std::this_thread::get_id();
+}
+
+auto sumOfPops(cctools::Queue<int>& queue, int numValues) -> cctools::Task<int>
+{
+  int sum = 0;
+  for(int i = 0; i < numValues; ++i)
+  {
+    auto value = co_await queue.asyncPop();
+    sum += value.value_or(0);
+  }
+  co_return sum;
+}
+
+/// runs posted tasks inline and probes from another thread, whether the queue is locked meanwhile
+struct LockProbingPool {
+  cctools::Queue<int>&     queue;
+  std::future<std::size_t> probe {};
+  bool                     queueWasLocked {false};
+
+  void post(cctools::FunctionWrapper&& task)
+  {
+    probe          = std::async(std::launch::async, [this] { return queue.size(); });
+    queueWasLocked = probe.wait_for(1s) == std::future_status::timeout;
+    task();
+  }
+};
+
+}   // namespace
+
+
+TEST(Task, syncWaitReturnsValue)
+{
+  EXPECT_EQ(cctools::syncWait(answer()), 42);
+  EXPECT_EQ(cctools::syncWait(twice(2)), 84);
+}
+
+TEST(Task, isLazy)
+{
+  bool started = false;
+  auto task = [](bool& flag) -> cctools::Task<void> { flag = true; co_return; }(started);
+  EXPECT_TRUE(task.valid());
+  EXPECT_FALSE(task.isReady());
+  EXPECT_FALSE(started);
+
+  cctools::syncWait(std::move(task));
+  EXPECT_TRUE(started);
+}
+
+TEST(Task, exceptionIsRethrown)
+{
+  EXPECT_THROW(cctools::syncWait(failing()), std::runtime_error);
+
+  auto future = cctools::spawn(failing());
+  EXPECT_TRUE(future.isReady());
+  EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(Task, scheduleMovesToPool)
+{
+  TaskPool pool(1);
+  const auto id = cctools::syncWait(threadAfterSchedule(pool));
+  EXPECT_NE(id, std::this_thread::get_id());
+}
+
+TEST(Task, spawnOnPool)
+{
+  TaskPool pool(2);
+  auto future = cctools::spawn(pool, twice(3));
+  EXPECT_EQ(future.get(), 126);
+}
+
+TEST(Task, awaitFutureOfPool)
+{
+  TaskPool pool(2);
+  auto task = [](TaskPool& p) -> cctools::Task<std::string> {
+    co_await p.schedule();
+    const int i = co_await p.async([] { return 17; });
+    const auto s = co_await p.async([i] { return std::to_string(i); });
+    co_return s + "!";
+  }(pool);
+
+  EXPECT_EQ(cctools::syncWait(std::move(task)), "17!");
+}
+
+TEST(Task, awaitFutureOfPromise)
+{
+  TaskPool pool(1);
+  cctools::Promise<int> promise;
+
+  auto future = cctools::spawn(pool, [](cctools::Future<int> f) -> cctools::Task<int> {
+    co_return co_await std::move(f) + 1;
+  }(promise.getFuture()));
+
+  std::this_thread::sleep_for(50ms);
+  EXPECT_FALSE(future.isReady());
+  promise.setValue(41);
+  EXPECT_EQ(future.get(), 42);
+}
+
+TEST(Task, awaitOneShotEvent)
+{
+  cctools::OneShotEvent<int> event;
+
+  // the task runs inline up to co_await, so it retrieves the future before the event is notified
+  auto future = cctools::spawn([](cctools::OneShotEvent<int>& e) -> cctools::Task<int> {
+    co_return co_await e;
+  }(event));
+  EXPECT_FALSE(future.isReady());
+
+  auto notifier = std::async(std::launch::async, [&event] {
+    std::this_thread::sleep_for(50ms);
+    event.notify(7);
+  });
+  EXPECT_EQ(future.get(), 7);
+  notifier.get();
+}
+
+TEST(Task, suspendedAsyncPopHoldsNoThread)
+{
+  constexpr int numValues = 100;
+
+  TaskPool pool(1);
+  cctools::Queue<int> queue;
+  auto sum = cctools::spawn(pool, sumOfPops(queue, numValues));
+
+  // the consumer waits for values, but the only thread of the pool is still free for other work
+  auto other = pool.async([] { return 5; });
+  EXPECT_EQ(other.get(), 5);
+  EXPECT_FALSE(sum.isReady());
+
+  for(int i = 1; i <= numValues; ++i)
+  {
+    queue.push(i);
+  }
+  EXPECT_EQ(sum.get(), numValues * (numValues + 1) / 2);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(Task, deactivatedPoolResumesInline)
+{
+  TaskPool pool(1);
+  pool.deactivate();
+
+  // the pool rejects the coroutines, which continue on the calling thread instead
+  EXPECT_EQ(cctools::syncWait(threadAfterSchedule(pool)), std::this_thread::get_id());
+
+  auto future = cctools::spawn(pool, twice(3));
+  EXPECT_EQ(future.get(), 126);
+}
+
+TEST(Task, rejectedScheduleDoesNotNestResumptions)
+{
+  TaskPool pool(1);
+  pool.deactivate();
+
+  // every rejected schedule would add a stack frame, if the coroutine was resumed by await_suspend
+  auto task = [](TaskPool& p, int numSchedules) -> cctools::Task<int> {
+    int count = 0;
+    for(int i = 0; i < numSchedules; ++i)
+    {
+      co_await p.schedule();
+      ++count;
+    }
+    co_return count;
+  }(pool, 1'000'000);
+
+  EXPECT_EQ(cctools::syncWait(std::move(task)), 1'000'000);
+}
+
+TEST(Task, awaitFutureOfDeactivatedPool)
+{
+  TaskPool pool(1);
+  cctools::Promise<int> promise;
+  std::promise<void>    started;
+
+  auto future = cctools::spawn(pool, [](cctools::Future<int> f, std::promise<void>& s) -> cctools::Task<int> {
+    s.set_value();
+    co_return co_await std::move(f) + 1;
+  }(promise.getFuture(), started));
+
+  started.get_future().wait();
+  std::this_thread::sleep_for(50ms);
+  pool.deactivate();
+
+  // the pool rejects the continuation, so the coroutine resumes on the thread setting the value
+  promise.setValue(41);
+  EXPECT_EQ(future.get(), 42);
+}
+
+TEST(Task, asyncPopTakesAvailableValue)
+{
+  cctools::Queue<int> queue;
+  queue.push(3);
+
+  TaskPool pool(1);
+  auto task = [](cctools::Queue<int>& q, TaskPool& p) -> cctools::Task<std::optional<int>> {
+    co_return co_await q.asyncPop(p);
+  }(queue, pool);
+
+  EXPECT_EQ(cctools::syncWait(std::move(task)), 3);
+}
+
+TEST(Task, asyncPopReturnsNulloptWhenQueueStopped)
+{
+  TaskPool pool(1);
+  cctools::Queue<int> queue;
+  auto future = cctools::spawn(pool, [](cctools::Queue<int>& q) -> cctools::Task<std::optional<int>> {
+    co_return co_await q.asyncPop();
+  }(queue));
+
+  std::this_thread::sleep_for(50ms);
+  queue.stopQueue();
+  EXPECT_EQ(future.get(), std::nullopt);
+}
+
+TEST(Task, asyncPopIsResumedAfterTheQueueIsUnlocked)
+{
+  cctools::Queue<int> queue;
+  LockProbingPool pool{queue};
+  auto future = cctools::spawn([](cctools::Queue<int>& q, LockProbingPool& p) -> cctools::Task<std::optional<int>> {
+    co_return co_await q.asyncPop(p);
+  }(queue, pool));
+
+  queue.push(5);
+  EXPECT_EQ(future.get(), 5);
+  EXPECT_FALSE(pool.queueWasLocked);
+}
+
+TEST(Task, asyncPopWithoutPoolThrows)
+{
+  cctools::Queue<int> queue;
+  auto task = [](cctools::Queue<int>& q) -> cctools::Task<std::optional<int>> {
+    co_return co_await q.asyncPop();
+  }(queue);
+
+  EXPECT_THROW(cctools::syncWait(std::move(task)), std::logic_error);
+}
+
+TEST(Task, manyConsumersAndProducers)
+{
+  constexpr int numConsumers = 8;
+  constexpr int numValues    = 1000;
+
+  TaskPool pool(2);
+  cctools::Queue<int> queue;
+
+  std::vector<cctools::Future<int>> sums;
+  for(int c = 0; c < numConsumers; ++c)
+  {
+    sums.push_back(cctools::spawn(pool, sumOfPops(queue, numValues)));
+  }
+
+  std::vector<std::future<void>> producers;
+  for(int p = 0; p < 2; ++p)
+  {
+    producers.push_back(std::async(std::launch::async, [&queue] {
+      for(int i = 0; i < numConsumers * numValues / 2; ++i)
+      {
+        queue.push(1);
+      }
+    }));
+  }
+  for(auto& producer : producers)
+  {
+    producer.get();
+  }
+
+  int total = 0;
+  for(auto& sum : sums)
+  {
+    total += sum.get();
+  }
+  EXPECT_EQ(total, numConsumers * numValues);
+}
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // TASKTEST_H_50192837465019283746501928374650192837465019
@@ -0,0 +1,159 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ThreadPlacementTest.h
+ * @brief
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef THREADPLACEMENTTEST_H_19283746501928374650192837465019283746501928
+#define THREADPLACEMENTTEST_H_19283746501928374650192837465019283746501928
+
+
+// includes
+#include <ConcurrencyTools/RAIIThread.h>
+#include <ConcurrencyTools/ThreadPlacement.h>
+#include <ConcurrencyTools/ThreadPool.h>
+
+#include <future>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+TEST(CpuSet, parseCpuList)
+{
+  const auto cpus = cctools::CpuSet::parse("0-3,8,10-11\n");
+  EXPECT_EQ(cpus, (cctools::CpuSet{0U, 1U, 2U, 3U, 8U, 10U, 11U}));
+  EXPECT_TRUE(cpus.contains(8U));
+  EXPECT_FALSE(cpus.contains(9U));
+}
+
+TEST(CpuSet, parseSkipsMalformedEntries)
+{
+  const auto cpus = cctools::CpuSet::parse("1,x,3-,5");
+  EXPECT_EQ(cpus, (cctools::CpuSet{1U, 5U}));
+}
+
+TEST(CpuSet, addKeepsOrderAndUniqueness)
+{
+  cctools::CpuSet cpus;
+  cpus.add(4U);
+  cpus.add(1U);
+  cpus.add(4U);
+  EXPECT_EQ(cpus.size(), 2ULL);
+  EXPECT_EQ(cpus[0ULL], 1U);
+  EXPECT_EQ(cpus[1ULL], 4U);
+}
+
+TEST(ThreadPlacement, numaNodesCoverAtLeastOneCpu)
+{
+  const auto nodes = cctools::numaNodes();
+  ASSERT_FALSE(nodes.empty());
+  EXPECT_FALSE(nodes.front().empty());
+}
+
+TEST(ThreadPoolConfig, perNumaNodeThreadCount)
+{
+  const auto nodes  = cctools::numaNodes();
+  const auto config = cctools::ThreadPoolConfig::perNumaNode(2ULL);
+  EXPECT_EQ(config.groups.size(), nodes.size());
+  EXPECT_EQ(config.numThreads(), 2ULL * nodes.size());
+}
+
+TEST(ThreadPoolConfig, poolSizeFollowsGroups)
+{
+  cctools::ThreadPoolConfig config;
+  config.groups.push_back({2ULL, {}, false});
+  config.groups.push_back({3ULL, {}, false});
+  cctools::WaitableThreadPool<cctools::queuePolicy::workStealing> pool(config);
+  EXPECT_EQ(pool.size(), 5ULL);
+
+  std::vector<std::future<int>> results;
+  for(int t = 0; t < 100; ++t)
+  {
+    results.push_back(pool.submit([t] { return t; }));
+  }
+  for(int t = 0; t < 100; ++t)
+  {
+    EXPECT_EQ(results[t].get(), t);
+  }
+}
+
+#if defined(__linux__)
+
+TEST(RAIIThread, setNameAndAffinity)
+{
+  std::promise<void> started;
+  std::promise<void> finish;
+  auto finished = finish.get_future();
+  cctools::JoinThread thread([&started, &finished] {
+    started.set_value();
+    finished.wait();
+  });
+  started.get_future().wait();
+
+  EXPECT_TRUE(thread.setName("cctools-test"));
+  EXPECT_TRUE(thread.setAffinity(cctools::CpuSet{0U}));
+
+  char name[16] {};
+  pthread_getname_np(thread.nativeHandle(), name, sizeof(name));
+  EXPECT_EQ(std::string(name), "cctools-test");
+
+  cpu_set_t cpuSet;
+  pthread_getaffinity_np(thread.nativeHandle(), sizeof(cpu_set_t), &cpuSet);
+  EXPECT_EQ(CPU_COUNT(&cpuSet), 1);
+  EXPECT_TRUE(CPU_ISSET(0, &cpuSet));
+
+  finish.set_value();
+}
+
+TEST(ThreadPoolConfig, workersRunOnTheirCpuSubset)
+{
+  const auto allCpus = cctools::numaNodes().front();
+  const cctools::CpuSet subset{allCpus[0ULL]};
+
+  cctools::ThreadPoolConfig config;
+  config.groups.push_back({3ULL, subset, false});
+  config.name = "placed";
+  cctools::WaitableThreadPool<cctools::queuePolicy::fifo> pool(config);
+
+  std::vector<std::future<std::pair<int, std::string>>> results;
+  for(int t = 0; t < 50; ++t)
+  {
+    results.push_back(pool.submit([] {
+      char name[16] {};
+      pthread_getname_np(pthread_self(), name, sizeof(name));
+      return std::make_pair(sched_getcpu(), std::string(name));
+    }));
+  }
+
+  std::set<std::string> names;
+  for(auto& r : results)
+  {
+    const auto [cpu, name] = r.get();
+    EXPECT_TRUE(subset.contains(static_cast<unsigned>(cpu)));
+    names.insert(name);
+  }
+  for(auto const& name : names)
+  {
+    EXPECT_TRUE(name == "placed-0" || name == "placed-1" || name == "placed-2");
+  }
+}
+
+#endif
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // THREADPLACEMENTTEST_H_19283746501928374650192837465019283746501928
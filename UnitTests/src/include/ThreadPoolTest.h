@@ -21,7 +21,13 @@
 
 #include <ConcurrencyTools/ThreadPool.h>
 
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <latch>
 #include <mutex>
+#include <stdexcept>
+#include <stop_token>
 #include <thread>
 #include <vector>
 
@@ -98,6 +104,91 @@ TEST(WaitableThreadPool, submitSeveralTasksCheckResult)
   }
 }
 
+TEST(WaitableThreadPool, workStealingSubmitSeveralTasksCheckResult)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::workStealing> pool(4);
+
+  const int i = 12;
+  const int nrTasks = 1000;
+  std::vector<std::future<int>> results;
+  results.reserve(nrTasks);
+  for(int t = 0; t < nrTasks; ++t)
+  {
+    results.push_back(pool.submit([i, t] { return i + t; }));
+  }
+
+  for(int t = 0; t < nrTasks; ++t)
+  {
+    EXPECT_EQ(results[t].get(), i + t);
+  }
+}
+
+TEST(NonWaitableThreadPool, workStealingNestedSubmission)
+{
+  using pool_type = cctools::NonWaitableThreadPool<cctools::queuePolicy::workStealing>;
+  pool_type pool(4);
+
+  const int          nrOuterTasks = 50;
+  const int          nrInnerTasks = 20;
+  std::atomic<int>   counter {0};
+  std::promise<void> allDone;
+
+  for(int t = 0; t < nrOuterTasks; ++t)
+  {
+    pool.submit([&pool, &counter, &allDone] {
+      for(int s = 0; s < nrInnerTasks; ++s)
+      {
+        // scheduled into the local queue of the current working thread
+        pool.submit([&counter, &allDone] {
+          if(++counter == nrOuterTasks * nrInnerTasks)
+          {
+            allDone.set_value();
+          }
+        });
+      }
+    });
+  }
+
+  EXPECT_EQ(allDone.get_future().wait_for(10s), std::future_status::ready);
+  EXPECT_EQ(counter, nrOuterTasks * nrInnerTasks);
+}
+
+TEST(WaitableThreadPool, severalTasksPerWakeUpCheckResult)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::fifo> pool(4, 256, 8);
+
+  const int nrTasks = 1000;
+  std::vector<std::future<int>> results;
+  results.reserve(nrTasks);
+  for(int t = 0; t < nrTasks; ++t)
+  {
+    results.push_back(pool.submit([t] { return 3 * t; }));
+  }
+
+  for(int t = 0; t < nrTasks; ++t)
+  {
+    EXPECT_EQ(results[t].get(), 3 * t);
+  }
+}
+
+TEST(WaitableThreadPool, boundedLockFreeSeveralTasksPerWakeUpCheckResult)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::boundedLockFree> pool(4, 64, 8);
+
+  const int nrTasks = 1000;
+  std::vector<std::future<int>> results;
+  results.reserve(nrTasks);
+  for(int t = 0; t < nrTasks; ++t)
+  {
+    results.push_back(pool.submit([t] { return 3 * t; }));
+  }
+
+  for(int t = 0; t < nrTasks; ++t)
+  {
+    EXPECT_EQ(results[t].get(), 3 * t);
+  }
+}
+
 #if 0
 TEST(NonWaitableThreadPool, submitSeveralTasksCheckPriority)
 {
@@ -137,6 +228,331 @@ TEST(NonWaitableThreadPool, submitSeveralTasksCheckPriority)
   }
 }
 #endif
+
+
+TEST(WaitableThreadPool, spinningWaitStrategyCheckResult)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::fifo> pool(4);
+  pool.setWaitStrategy(cctools::WaitStrategy::adaptive());
+  EXPECT_TRUE(pool.waitStrategy().spins());
+
+  for(int burst = 0; burst < 20; ++burst)
+  {
+    std::vector<std::future<int>> results;
+    for(int t = 0; t < 50; ++t)
+    {
+      results.push_back(pool.submit([t] { return t; }));
+    }
+    for(int t = 0; t < 50; ++t)
+    {
+      EXPECT_EQ(results[t].get(), t);
+    }
+    std::this_thread::sleep_for(1ms);
+  }
+}
+
+TEST(WaitableThreadPool, workStealingSpinningWaitStrategyFromConfig)
+{
+  auto config = cctools::ThreadPoolConfig::uniform(4ULL);
+  config.waitStrategy = cctools::WaitStrategy::adaptive();
+  cctools::WaitableThreadPool<cctools::queuePolicy::workStealing> pool(config);
+  EXPECT_TRUE(pool.waitStrategy().spins());
+
+  for(int burst = 0; burst < 20; ++burst)
+  {
+    std::vector<std::future<int>> results;
+    for(int t = 0; t < 50; ++t)
+    {
+      results.push_back(pool.submit([t] { return 2 * t; }));
+    }
+    for(int t = 0; t < 50; ++t)
+    {
+      EXPECT_EQ(results[t].get(), 2 * t);
+    }
+    std::this_thread::sleep_for(1ms);
+  }
+}
+
+
+namespace {
+
+template <typename Predicate>
+auto eventually(Predicate&& predicate, std::chrono::milliseconds timeOut = 5000ms) -> bool
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeOut;
+  while(!predicate())
+  {
+    if(std::chrono::steady_clock::now() > deadline)
+    {
+      return false;
+    }
+    std::this_thread::sleep_for(1ms);
+  }
+  return true;
+}
+
+}   // namespace
+
+
+TEST(WaitableThreadPool, resizeStartsAndRetiresWorkers)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::fifo> pool(cctools::ThreadPoolConfig::uniform(2ULL).elastic(1ULL, 6ULL, 10s));
+  EXPECT_EQ(pool.size(), 2ULL);
+  EXPECT_EQ(pool.minSize(), 1ULL);
+  EXPECT_EQ(pool.maxSize(), 6ULL);
+
+  pool.resize(5ULL);
+  EXPECT_EQ(pool.size(), 5ULL);
+  pool.resize(100ULL);
+  EXPECT_EQ(pool.size(), 6ULL);
+
+  // surplus workers retire asynchronously
+  pool.resize(0ULL);
+  EXPECT_TRUE(eventually([&pool] { return pool.size() == 1ULL; }));
+  EXPECT_EQ(pool.submit([] { return 42; }).get(), 42);
+
+  pool.resize(3ULL);
+  EXPECT_EQ(pool.size(), 3ULL);
+  std::vector<std::future<int>> results;
+  for(int t = 0; t < 100; ++t)
+  {
+    results.push_back(pool.submit([t] { return t; }));
+  }
+  for(int t = 0; t < 100; ++t)
+  {
+    EXPECT_EQ(results[t].get(), t);
+  }
+}
+
+TEST(WaitableThreadPool, resizeFixedPool)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::prioritized> pool(4ULL);
+  EXPECT_EQ(pool.minSize(), 4ULL);
+  EXPECT_EQ(pool.maxSize(), 4ULL);
+
+  pool.resize(1ULL);
+  EXPECT_EQ(pool.size(), 4ULL);
+  EXPECT_EQ(pool.submit([] { return 1; }).get(), 1);
+}
+
+TEST(WaitableThreadPool, elasticPoolGrowsWithBacklogAndShrinksWhenIdle)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::fifo> pool(cctools::ThreadPoolConfig::uniform(1ULL).elastic(1ULL, 4ULL, 50ms));
+  EXPECT_EQ(pool.size(), 1ULL);
+
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::atomic<int> running {0};
+  std::vector<std::future<void>> results;
+  for(int t = 0; t < 4; ++t)
+  {
+    results.push_back(pool.submit([released, &running] { ++running; released.wait(); }));
+    EXPECT_TRUE(eventually([&running, t] { return running == t + 1; }));
+  }
+  EXPECT_EQ(pool.size(), 4ULL);
+
+  // the pool does not grow beyond its maximum
+  results.push_back(pool.submit([] {}));
+  EXPECT_EQ(pool.size(), 4ULL);
+
+  release.set_value();
+  for(auto& result : results)
+  {
+    result.get();
+  }
+  EXPECT_TRUE(eventually([&pool] { return pool.size() == 1ULL; }));
+  EXPECT_EQ(pool.submit([] { return 7; }).get(), 7);
+}
+
+TEST(WaitableThreadPool, workStealingElasticPoolGrowsAndShrinks)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::workStealing> pool(cctools::ThreadPoolConfig::uniform(2ULL).elastic(1ULL, 4ULL, 50ms));
+
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::atomic<int> running {0};
+  std::vector<std::future<void>> results;
+  for(int t = 0; t < 4; ++t)
+  {
+    results.push_back(pool.submit([released, &running] { ++running; released.wait(); }));
+    EXPECT_TRUE(eventually([&running, t] { return running == t + 1; }));
+  }
+  EXPECT_EQ(pool.size(), 4ULL);
+
+  release.set_value();
+  for(auto& result : results)
+  {
+    result.get();
+  }
+  EXPECT_TRUE(eventually([&pool] { return pool.size() == 1ULL; }));
+  EXPECT_EQ(pool.submit([] { return 7; }).get(), 7);
+}
+
+TEST(NonWaitableThreadPool, workStealingRetiringWorkersKeepLocalTasks)
+{
+  using pool_type = cctools::NonWaitableThreadPool<cctools::queuePolicy::workStealing>;
+  pool_type pool(cctools::ThreadPoolConfig::uniform(4ULL).elastic(1ULL, 4ULL, 10s));
+
+  const int          nrOuterTasks = 8;
+  const int          nrInnerTasks = 200;
+  std::atomic<int>   counter {0};
+  std::promise<void> allDone;
+  std::latch         submitted {nrOuterTasks};
+
+  for(int t = 0; t < nrOuterTasks; ++t)
+  {
+    pool.submit([&pool, &counter, &allDone, &submitted] {
+      for(int s = 0; s < nrInnerTasks; ++s)
+      {
+        pool.submit([&counter, &allDone] {
+          std::this_thread::sleep_for(10us);
+          if(++counter == nrOuterTasks * nrInnerTasks)
+          {
+            allDone.set_value();
+          }
+        });
+      }
+      submitted.count_down();
+    });
+  }
+
+  // the workers retire while their local queues are still filled
+  submitted.wait();
+  pool.resize(1ULL);
+
+  EXPECT_EQ(allDone.get_future().wait_for(10s), std::future_status::ready);
+  EXPECT_EQ(counter, nrOuterTasks * nrInnerTasks);
+  EXPECT_TRUE(eventually([&pool] { return pool.size() == 1ULL; }));
+}
+
+TEST(NonWaitableThreadPool, retiringWorkersKeepQueuedTasks)
+{
+  using pool_type = cctools::NonWaitableThreadPool<cctools::queuePolicy::prioritized>;
+  pool_type pool(cctools::ThreadPoolConfig::uniform(4ULL).elastic(1ULL, 4ULL, 10s), pool_type::size_type{1024ULL}, 4ULL);
+
+  const int          nrTasks = 1000;
+  std::atomic<int>   counter {0};
+  std::promise<void> allDone;
+  for(int t = 0; t < nrTasks; ++t)
+  {
+    pool.submit([&counter, &allDone] {
+      std::this_thread::sleep_for(10us);
+      if(++counter == nrTasks)
+      {
+        allDone.set_value();
+      }
+    });
+    if(t == nrTasks / 2)
+    {
+      pool.resize(1ULL);
+    }
+  }
+
+  EXPECT_EQ(allDone.get_future().wait_for(10s), std::future_status::ready);
+  EXPECT_EQ(counter, nrTasks);
+}
+
+
+TEST(WaitableThreadPool, cancelledTaskIsDropped)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::fifo> pool(1ULL);
+
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::promise<void> started;
+  auto blocker = pool.submit([&started, released] {
+    started.set_value();
+    released.wait();
+  });
+  started.get_future().wait();
+
+  std::stop_source   cancellation;
+  std::atomic<bool>  hasRun {false};
+  cctools::TaskOptions options;
+  options.cancellation = cancellation.get_token();
+  auto cancelled = pool.submit([&hasRun] { hasRun = true; return 1; }, options);
+  auto kept      = pool.submit([] { return 2; }, cctools::TaskOptions{});
+
+  cancellation.request_stop();
+  release.set_value();
+  blocker.get();
+
+  try
+  {
+    cancelled.get();
+    FAIL() << "expected TaskCancelled";
+  }
+  catch(cctools::TaskCancelled const& e)
+  {
+    EXPECT_EQ(e.reason(), cctools::cancelReason::cancelled);
+  }
+  EXPECT_EQ(kept.get(), 2);
+  EXPECT_FALSE(hasRun);
+}
+
+TEST(WaitableThreadPool, expiredTaskIsDropped)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::prioritized> pool(1ULL);
+
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  auto blocker = pool.submit([released] { released.wait(); });
+
+  std::atomic<bool> hasRun {false};
+  auto expired = pool.submit([&hasRun] { hasRun = true; }, cctools::TaskOptions::expiringAfter(1ms));
+  auto pending = pool.submit([] { return 3; }, cctools::TaskOptions::expiringAfter(10s));
+
+  std::this_thread::sleep_for(20ms);
+  release.set_value();
+  blocker.get();
+
+  try
+  {
+    expired.get();
+    FAIL() << "expected TaskCancelled";
+  }
+  catch(cctools::TaskCancelled const& e)
+  {
+    EXPECT_EQ(e.reason(), cctools::cancelReason::expired);
+  }
+  EXPECT_EQ(pending.get(), 3);
+  EXPECT_FALSE(hasRun);
+}
+
+TEST(WaitableThreadPool, exceptionOfTaskWithOptionsIsPropagated)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::workStealing> pool(2ULL);
+  auto result = pool.submit([]() -> int { throw std::logic_error("failed"); }, cctools::TaskOptions{});
+  EXPECT_THROW(result.get(), std::logic_error);
+}
+
+TEST(NonWaitableThreadPool, cancelledTasksAreSkipped)
+{
+  cctools::NonWaitableThreadPool<cctools::queuePolicy::workStealing> pool(1ULL);
+
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  pool.submit([released] { released.wait(); });
+
+  std::stop_source  cancellation;
+  std::atomic<int>  counter {0};
+  std::promise<void> done;
+  cctools::TaskOptions options;
+  options.cancellation = cancellation.get_token();
+  for(int t = 0; t < 10; ++t)
+  {
+    pool.submit([&counter] { ++counter; }, options);
+  }
+  auto asyncResult = pool.async([] { return 5; }, options);
+  pool.post([&done] { done.set_value(); }, cctools::TaskOptions{});
+
+  cancellation.request_stop();
+  release.set_value();
+
+  EXPECT_EQ(done.get_future().wait_for(10s), std::future_status::ready);
+  EXPECT_EQ(counter, 0);
+  EXPECT_THROW(asyncResult.get(), cctools::TaskCancelled);
+}
  
  
 // *************************************************************************** // 
@@ -0,0 +1,257 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ThreadsafeHeapPriorityQueueTest.h
+ * @brief
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef THREADSAFEHEAPPRIORITYQUEUETEST_H_55019283746510293847561029384756102938
+#define THREADSAFEHEAPPRIORITYQUEUETEST_H_55019283746510293847561029384756102938
+
+
+// includes
+#include "Person.h"
+#include <ConcurrencyTools/ThreadPool.h>
+#include <ConcurrencyTools/ThreadsafeQueue.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <vector>
+
+
+using namespace std::chrono_literals;
+using namespace std::string_literals;
+
+
+TEST(ThreadsafeHeapPriorityQueue, popInPriorityOrder)
+{
+  cctools::HeapPriorityQueue<int> queue;
+  for(const int v : {23, 42, 7, 81, 15, 42, 3})
+  {
+    queue.push(v);
+  }
+  EXPECT_EQ(queue.size(), 7ULL);
+
+  std::vector<int> popped;
+  int v;
+  while(queue.tryPop(v))
+  {
+    popped.push_back(v);
+  }
+
+  const std::vector<int> expected {81, 42, 42, 23, 15, 7, 3};
+  EXPECT_EQ(popped, expected);
+}
+
+TEST(ThreadsafeHeapPriorityQueue, greaterComparePopsSmallestFirst)
+{
+  cctools::HeapPriorityQueue<int, std::greater<int>> queue;
+  queue.push(23);
+  queue.push(42);
+  queue.push(7);
+
+  int v;
+  queue.waitAndPop(v);
+  EXPECT_EQ(v, 7);
+  queue.waitAndPop(v);
+  EXPECT_EQ(v, 23);
+  queue.waitAndPop(v);
+  EXPECT_EQ(v, 42);
+}
+
+TEST(ThreadsafeHeapPriorityQueue, removeIf)
+{
+  cctools::HeapPriorityQueue<test::Person> queue(3);
+  queue.push(test::Person{78, "Bob"s});
+  queue.push(test::Person{56, "Joe"s});
+  queue.push(test::Person{67, "Jane"s});
+
+  auto pushThread = std::async(std::launch::async, [&] { queue.push(test::Person{81, "Bill"s}); });
+
+  std::this_thread::sleep_for(1s);
+
+  const auto r = queue.removeIf([](auto const& p) { return p.getAge() < 70;});
+  pushThread.get();
+  test::Person p;
+  queue.waitAndPop(p);
+  EXPECT_EQ(p.getAge(), 81);
+  queue.waitAndPop(p);
+  EXPECT_EQ(p.getAge(), 78);
+  EXPECT_EQ(r, 2ULL);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(ThreadsafeHeapPriorityQueue, extractIfReturnValue)
+{
+  cctools::HeapPriorityQueue<test::Person> queue;
+  queue.push(test::Person{78, "Bob"s});
+  queue.push(test::Person{56, "Joe"s});
+  queue.push(test::Person{81, "Bill"s});
+  queue.push(test::Person{12, "Johann"s});
+
+  test::Person p;
+  EXPECT_TRUE(queue.extractIf(p, [](auto const& p) { return p.getAge() == 78; }));
+  EXPECT_EQ(p.getName(), "Bob"s);
+  EXPECT_FALSE(queue.extractIf(p, [](auto const& p) { return p.getAge() == 78; }));
+
+  queue.waitAndPop(p);
+  EXPECT_EQ(p.getAge(), 81);
+  queue.waitAndPop(p);
+  EXPECT_EQ(p.getAge(), 56);
+  queue.waitAndPop(p);
+  EXPECT_EQ(p.getAge(), 12);
+}
+
+TEST(ThreadsafeHeapPriorityQueue, extractIf)
+{
+  cctools::HeapPriorityQueue<test::Person> queue;
+  queue.push(test::Person{56, "Joe"s});
+  queue.push(test::Person{78, "Bob"s});
+  queue.push(test::Person{81, "Bill"s});
+  queue.push(test::Person{23, "Jill"s});
+
+  auto elems = queue.extractIf([](auto const& p) {return p.getAge() > 50 && p.getAge() < 80;});
+  ASSERT_EQ(elems.size(), 2ULL);
+  auto p1 = elems.begin();
+  EXPECT_EQ(p1->getAge(), 78);
+  ++p1;
+  EXPECT_EQ(p1->getAge(), 56);
+
+  test::Person p;
+  queue.waitAndPop(p);
+  EXPECT_EQ(p.getAge(), 81);
+  queue.waitAndPop(p);
+  EXPECT_EQ(p.getAge(), 23);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(ThreadsafeHeapPriorityQueue, extractVisitReinsertReturnValue)
+{
+  cctools::HeapPriorityQueue<test::Person> queue;
+  queue.push(test::Person{78, "Bob"s});
+  queue.push(test::Person{56, "Joe"s});
+  queue.push(test::Person{81, "Bill"s});
+
+  const auto name = queue.extractVisitReinsert(
+    [](test::Person& p) { p.setAge(23); return p.getName();},
+    [](test::Person const& p) { return p.getAge() >= 80;}
+  );
+
+  test::Person p;
+  queue.waitAndPop(p);
+  EXPECT_EQ(p.getAge(), 78);
+  queue.waitAndPop(p);
+  EXPECT_EQ(p.getAge(), 56);
+  queue.waitAndPop(p);
+  EXPECT_EQ(p.getAge(), 23);
+  EXPECT_EQ(p.getName(), "Bill"s);
+  EXPECT_EQ(name, "Bill"s);
+}
+
+TEST(ThreadsafeHeapPriorityQueue, extractVisitVoidReinsert)
+{
+  cctools::HeapPriorityQueue<test::Person> queue;
+  queue.push(test::Person{78, "Bob"s});
+  queue.push(test::Person{56, "Joe"s});
+  queue.push(test::Person{81, "Bill"s});
+  queue.push(test::Person{86, "Judy"s});
+
+  std::vector<std::string> names;
+  const auto numHosts = queue.extractVisitReinsert([&names](const test::Person& p) { return names.push_back(p.getName()); },
+                                                   [](const test::Person& p) { return 70 <= p.getAge() && p.getAge() <= 90; });
+
+  EXPECT_EQ(numHosts, 3);
+  ASSERT_EQ(names.size(), 3ULL);
+  EXPECT_EQ(names[0], "Judy"s);
+  EXPECT_EQ(names[1], "Bill"s);
+  EXPECT_EQ(names[2], "Bob"s);
+  EXPECT_EQ(queue.size(), 4ULL);
+}
+
+TEST(ThreadsafeHeapPriorityQueue, visitTop)
+{
+  cctools::HeapPriorityQueue<test::Person> queue;
+  EXPECT_EQ(queue.visitTop([](const test::Person& p) { return p.getAge(); }, 123), 123);
+  EXPECT_THROW(queue.visitTop([](const test::Person&) {}), std::out_of_range);
+
+  queue.push(test::Person{78, "Bob"s});
+  queue.push(test::Person{56, "Joe"s});
+  queue.push(test::Person{81, "Bill"s});
+
+  EXPECT_EQ(queue.visitTop([](const test::Person& p) { return p.getAge(); }), 81);
+  EXPECT_TRUE(queue.hasTopProperty([](const test::Person& p) { return p.getName() == "Bill"s; }));
+}
+
+TEST(ThreadsafeHeapPriorityQueue, extractFromRandomPositionsKeepsHeapOrder)
+{
+  cctools::HeapPriorityQueue<int> queue;
+  std::vector<int>                values(500);
+  std::iota(values.begin(), values.end(), 0);
+  std::shuffle(values.begin(), values.end(), std::mt19937{42});
+  for(const int v : values)
+  {
+    queue.push(v);
+  }
+
+  int extracted;
+  for(int v = 3; v < 500; v += 7)
+  {
+    EXPECT_TRUE(queue.extractIf(extracted, [v](int i) { return i == v; }));
+  }
+
+  int previous = 500;
+  int v;
+  while(queue.tryPop(v))
+  {
+    EXPECT_LT(v, previous);
+    EXPECT_NE(v % 7, 3);
+    previous = v;
+  }
+}
+
+TEST(ThreadsafeHeapPriorityQueue, threadPoolExecutesByPriority)
+{
+  cctools::WaitableThreadPool<cctools::queuePolicy::heapPrioritized> pool(1);
+
+  std::promise<void> started;
+  std::promise<void> release;
+  auto blocker = pool.submit([&started, f = release.get_future().share()] { started.set_value(); f.wait(); });
+  started.get_future().wait();
+
+  std::mutex                     mut;
+  std::vector<int>               order;
+  std::vector<std::future<void>> futs;
+  for(int i = 0; i < 10; ++i)
+  {
+    futs.push_back(pool.submit([&mut, &order, i] { std::lock_guard lk(mut); order.push_back(i); }, i));
+  }
+
+  release.set_value();
+  blocker.get();
+  for(auto& fut : futs)
+  {
+    fut.get();
+  }
+
+  const std::vector<int> expected {9, 8, 7, 6, 5, 4, 3, 2, 1, 0};
+  EXPECT_EQ(order, expected);
+}
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // THREADSAFEHEAPPRIORITYQUEUETEST_H_55019283746510293847561029384756102938
@@ -22,6 +22,8 @@
  
 #include <chrono>
 #include <future>
+#include <iterator>
+#include <vector>
 
 
 using namespace std::chrono_literals;
@@ -552,6 +554,19 @@ TEST(ThreadsafePriorityQueue, extractVisitVoidReinsert)
   EXPECT_EQ(names[1], "Bill"s);
   EXPECT_EQ(names[2], "Bob"s);
 }
+
+TEST(ThreadsafePriorityQueue, pushBulkTryPopBulk)
+{
+  PriorityQueue<int> queue;
+  queue.pushBulk(std::vector<int>{23, 81, 7, 42});
+
+  std::vector<int> popped;
+  EXPECT_EQ(queue.tryPopBulk(std::back_inserter(popped), 3ULL), 3ULL);
+
+  const std::vector<int> expected {81, 42, 23};
+  EXPECT_EQ(popped, expected);
+  EXPECT_EQ(queue.size(), 1ULL);
+}
  
  
 // *************************************************************************** // 
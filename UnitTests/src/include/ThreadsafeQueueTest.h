@@ -22,6 +22,9 @@
  
 #include <chrono>
 #include <future>
+#include <iterator>
+#include <memory>
+#include <vector>
 
 
 using namespace std::chrono_literals;
@@ -525,6 +528,138 @@ TEST(ThreadsafeQueue, extractVisitVoidReinsert)
   EXPECT_EQ(names[1], "Bill"s);
   EXPECT_EQ(names[2], "Judy"s);
 }
+
+TEST(ThreadsafeQueue, pushBulkRange)
+{
+  Queue<int> queue;
+  const std::vector<int> values {23, 42, 7};
+  EXPECT_EQ(queue.pushBulk(values), 3ULL);
+  EXPECT_EQ(queue.size(), 3ULL);
+
+  int v;
+  queue.waitAndPop(v);
+  EXPECT_EQ(v, 23);
+  queue.waitAndPop(v);
+  EXPECT_EQ(v, 42);
+  queue.waitAndPop(v);
+  EXPECT_EQ(v, 7);
+}
+
+TEST(ThreadsafeQueue, pushBulkMovesFromRvalueRange)
+{
+  Queue<std::unique_ptr<int>> queue;
+  std::vector<std::unique_ptr<int>> values;
+  values.push_back(std::make_unique<int>(1));
+  values.push_back(std::make_unique<int>(2));
+
+  EXPECT_EQ(queue.pushBulk(std::move(values)), 2ULL);
+
+  std::unique_ptr<int> p;
+  queue.waitAndPop(p);
+  EXPECT_EQ(*p, 1);
+  queue.waitAndPop(p);
+  EXPECT_EQ(*p, 2);
+}
+
+TEST(ThreadsafeQueue, pushBulkCapacityExceededRemoveElementsInBetween)
+{
+  Queue<int> queue(2);
+  const std::vector<int> values {1, 2, 3, 4, 5};
+
+  auto pushThread = std::async(std::launch::async, [&] { return queue.pushBulk(values.cbegin(), values.cend()); });
+
+  std::vector<int> popped;
+  while(popped.size() < values.size())
+  {
+    queue.waitAndPopBulk(std::back_inserter(popped), 2ULL);
+  }
+
+  EXPECT_EQ(pushThread.get(), 5ULL);
+  EXPECT_EQ(popped, values);
+}
+
+TEST(ThreadsafeQueue, pushBulkCapacityExceededStopQueueDuringPush)
+{
+  Queue<int> queue(2);
+  const std::vector<int> values {1, 2, 3};
+
+  auto stopThread = std::async(std::launch::async,
+    [&](){ std::this_thread::sleep_for(1s); queue.stopQueue();}
+  );
+
+  EXPECT_EQ(queue.pushBulk(values), 2ULL);
+  stopThread.get();
+  EXPECT_EQ(queue.size(), 2ULL);
+}
+
+TEST(ThreadsafeQueue, tryPopBulk)
+{
+  Queue<int> queue;
+  std::vector<int> popped;
+  EXPECT_EQ(queue.tryPopBulk(std::back_inserter(popped), 4ULL), 0ULL);
+
+  queue.pushBulk(std::vector<int>{1, 2, 3, 4, 5, 6});
+  EXPECT_EQ(queue.tryPopBulk(std::back_inserter(popped), 4ULL), 4ULL);
+  EXPECT_EQ(queue.tryPopBulk(std::back_inserter(popped), 4ULL), 2ULL);
+
+  const std::vector<int> expected {1, 2, 3, 4, 5, 6};
+  EXPECT_EQ(popped, expected);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(ThreadsafeQueue, waitAndPopBulkEmptyQueueStopped)
+{
+  Queue<int> queue;
+
+  auto stopThread = std::async(std::launch::async,
+    [&](){ std::this_thread::sleep_for(1s); queue.stopQueue();}
+  );
+
+  std::vector<int> popped;
+  EXPECT_EQ(queue.waitAndPopBulk(std::back_inserter(popped), 4ULL), 0ULL);
+  stopThread.get();
+  EXPECT_TRUE(popped.empty());
+}
+
+TEST(ThreadsafeQueue, spinningConsumersReceiveAllElements)
+{
+  Queue<int> queue;
+  queue.setWaitStrategy(cctools::WaitStrategy::adaptive());
+  EXPECT_EQ(queue.waitStrategy().spinCount, cctools::WaitStrategy::adaptive().spinCount);
+
+  const int numValues = 10000;
+  auto consumer = std::async(std::launch::async, [&queue] {
+    long long sum = 0LL;
+    for(int i = 0; i < numValues; ++i)
+    {
+      int value = 0;
+      queue.waitAndPop(value);
+      sum += value;
+    }
+    return sum;
+  });
+
+  for(int i = 1; i <= numValues; ++i)
+  {
+    queue.push(i);
+  }
+  EXPECT_EQ(consumer.get(), static_cast<long long>(numValues) * (numValues + 1) / 2);
+}
+
+TEST(ThreadsafeQueue, spinningConsumerStopped)
+{
+  Queue<int> queue;
+  queue.setWaitStrategy(cctools::WaitStrategy{1000U, 1000U});
+
+  auto stopThread = std::async(std::launch::async,
+    [&](){ std::this_thread::sleep_for(100ms); queue.stopQueue();}
+  );
+
+  std::vector<int> popped;
+  EXPECT_EQ(queue.waitAndPopBulk(std::back_inserter(popped), 4ULL), 0ULL);
+  stopThread.get();
+  EXPECT_TRUE(popped.empty());
+}
  
 // *************************************************************************** // 
 // ******************************* END OF FILE ******************************* // 
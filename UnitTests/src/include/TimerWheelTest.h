@@ -0,0 +1,216 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    TimerWheelTest.h
+ * @brief
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef TIMERWHEELTEST_H_61928374650192837465019283746501928374650192
+#define TIMERWHEELTEST_H_61928374650192837465019283746501928374650192
+
+
+// includes
+#include <ConcurrencyTools/TimerWheel.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+
+TEST(TimerWheel, scheduleAfterFiresOnceInOrder)
+{
+  cctools::TimerWheel wheel;
+  std::mutex mut;
+  std::vector<int> order;
+  std::promise<void> done;
+
+  wheel.scheduleAfter(std::chrono::milliseconds(30), [&] {
+    std::lock_guard<std::mutex> lock(mut);
+    order.push_back(3);
+    done.set_value();
+  });
+  wheel.scheduleAfter(std::chrono::milliseconds(10), [&] {
+    std::lock_guard<std::mutex> lock(mut);
+    order.push_back(1);
+  });
+  wheel.scheduleAfter(std::chrono::milliseconds(20), [&] {
+    std::lock_guard<std::mutex> lock(mut);
+    order.push_back(2);
+  });
+
+  done.get_future().wait();
+  std::lock_guard<std::mutex> lock(mut);
+  EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+
+  // the last timer is released once its callback has returned
+  for(int i = 0; i < 100 && wheel.size() != 0ULL; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(wheel.size(), 0ULL);
+}
+
+TEST(TimerWheel, neverFiresEarly)
+{
+  cctools::TimerWheel wheel;
+  std::promise<std::chrono::steady_clock::duration> fired;
+  const auto start = std::chrono::steady_clock::now();
+  wheel.scheduleAfter(std::chrono::milliseconds(25),
+                      [&] { fired.set_value(std::chrono::steady_clock::now() - start); });
+  EXPECT_GE(fired.get_future().get(), std::chrono::milliseconds(25));
+}
+
+TEST(TimerWheel, cancelPreventsFiring)
+{
+  cctools::TimerWheel wheel;
+  std::atomic<bool> fired {false};
+  const auto id = wheel.scheduleAfter(std::chrono::milliseconds(20), [&fired] { fired = true; });
+  EXPECT_TRUE(wheel.isPending(id));
+  EXPECT_TRUE(wheel.cancel(id));
+  EXPECT_FALSE(wheel.cancel(id));
+  EXPECT_FALSE(wheel.isPending(id));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(fired);
+}
+
+TEST(TimerWheel, staleIdDoesNotAffectReusedTimer)
+{
+  cctools::TimerWheel wheel;
+  const auto stale = wheel.scheduleAfter(std::chrono::seconds(10), [] {});
+  wheel.cancel(stale);
+
+  std::promise<void> fired;
+  const auto id = wheel.scheduleAfter(std::chrono::milliseconds(10), [&fired] { fired.set_value(); });
+  EXPECT_NE(id, stale);
+  EXPECT_FALSE(wheel.cancel(stale));
+  EXPECT_FALSE(wheel.kick(stale));
+  fired.get_future().wait();
+}
+
+TEST(TimerWheel, kickPostponesFiring)
+{
+  cctools::TimerWheel wheel;
+  std::atomic<bool> fired {false};
+  const auto id = wheel.scheduleAfter(std::chrono::milliseconds(60), [&fired] { fired = true; });
+  for(int i = 0; i < 5; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_TRUE(wheel.kick(id));
+  }
+  EXPECT_FALSE(fired);
+  EXPECT_TRUE(wheel.cancel(id));
+}
+
+TEST(TimerWheel, periodicTimerCancelledFromCallback)
+{
+  cctools::TimerWheel wheel;
+  std::atomic<int> numFired {0};
+  std::promise<void> done;
+  std::promise<cctools::TimerWheel::TimerId> idPromise;
+  auto idFuture = idPromise.get_future().share();
+
+  const auto id = wheel.schedulePeriodic(std::chrono::milliseconds(2), [&, idFuture] {
+    if(++numFired == 5)
+    {
+      EXPECT_TRUE(wheel.cancel(idFuture.get()));
+      done.set_value();
+    }
+  });
+  idPromise.set_value(id);
+
+  done.get_future().wait();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(numFired, 5);
+  EXPECT_FALSE(wheel.isPending(id));
+}
+
+TEST(TimerWheel, timerCancelledInSameTickDoesNotFire)
+{
+  // with a coarse tick both timers expire in the same tick, the first callback cancels the other timer
+  cctools::TimerWheel wheel(std::chrono::milliseconds(50));
+  std::atomic<int> numFired {0};
+  std::atomic<int> numCancelled {0};
+  std::promise<void> idsSet;
+  auto idsReady = idsSet.get_future().share();
+  std::array<cctools::TimerWheel::TimerId, 2> ids {};
+
+  for(std::size_t i = 0ULL; i < ids.size(); ++i)
+  {
+    ids[i] = wheel.scheduleAfter(std::chrono::milliseconds(10), [&, i, idsReady] {
+      idsReady.wait();
+      ++numFired;
+      numCancelled += wheel.cancel(ids[1ULL - i]) ? 1 : 0;
+    });
+  }
+  idsSet.set_value();
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_EQ(numFired, 1);
+  EXPECT_EQ(numCancelled, 1);
+  EXPECT_EQ(wheel.size(), 0ULL);
+}
+
+TEST(TimerWheel, timersBeyondFirstLevelCascade)
+{
+  cctools::TimerWheel wheel(std::chrono::microseconds(100));
+  std::promise<void> fired;
+  const auto start = std::chrono::steady_clock::now();
+  // 3000 ticks spans the first two levels of the wheel
+  wheel.scheduleAfter(std::chrono::microseconds(300000), [&fired] { fired.set_value(); });
+  fired.get_future().wait();
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(300));
+}
+
+TEST(TimerWheel, manyTimersAllFire)
+{
+  cctools::TimerWheel wheel;
+  const int numTimers = 100000;
+  std::atomic<int> numFired {0};
+  std::atomic<long long> maxLateness {0LL};
+  std::mt19937 gen(42U);
+  std::uniform_int_distribution<int> delays(1, 300);
+
+  for(int i = 0; i < numTimers; ++i)
+  {
+    const auto delay = std::chrono::milliseconds(delays(gen));
+    const auto due   = std::chrono::steady_clock::now() + delay;
+    wheel.scheduleAfter(delay, [&, due] {
+      const auto lateness = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - due).count();
+      EXPECT_GE(lateness, 0LL);
+      auto current = maxLateness.load();
+      while(lateness > current && !maxLateness.compare_exchange_weak(current, lateness))
+      {
+      }
+      ++numFired;
+    });
+  }
+
+  for(int i = 0; i < 200 && numFired < numTimers; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(numFired, numTimers);
+  // generous bound for loaded test machines, the wheel itself adds at most one tick
+  EXPECT_LT(maxLateness, 200000LL);
+}
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // TIMERWHEELTEST_H_61928374650192837465019283746501928374650192
@@ -18,13 +18,66 @@
  
 // includes
 #include <ConcurrencyTools/Watchdog.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
  
  
-TEST(Watchdog, voidEventNoException)
+TEST(Watchdog, firesRecurrentlyWithoutKick)
 {
- 
+  std::atomic<int> numFired {0};
+  cctools::Watchdog watchdog([&numFired] { ++numFired; }, std::chrono::milliseconds(5), true);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  watchdog.stop();
+  const int fired = numFired;
+  EXPECT_GE(fired, 3);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  EXPECT_EQ(numFired, fired);
+}
+
+TEST(Watchdog, kickPreventsFiring)
+{
+  std::atomic<int> numFired {0};
+  cctools::Watchdog watchdog([&numFired] { ++numFired; }, std::chrono::milliseconds(200), true);
+
+  for(int i = 0; i < 10; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    watchdog.kick();
+  }
+  EXPECT_EQ(numFired, 0);
+  EXPECT_TRUE(watchdog.isRunning());
+}
+
+TEST(Watchdog, startWithoutCallbackThrows)
+{
+  cctools::Watchdog watchdog(nullptr, std::chrono::milliseconds(10), false);
+  EXPECT_THROW(watchdog.start(), std::runtime_error);
+  EXPECT_FALSE(watchdog.isRunning());
+}
+
+TEST(Watchdog, manyWatchdogsShareOneWheel)
+{
+  cctools::TimerWheel wheel;
+  std::atomic<int> numFired {0};
+  std::vector<std::unique_ptr<cctools::Watchdog>> watchdogs;
+  for(int i = 0; i < 1000; ++i)
+  {
+    watchdogs.push_back(std::make_unique<cctools::Watchdog>([&numFired] { ++numFired; },
+                                                            std::chrono::milliseconds(10), true, wheel));
+  }
+  EXPECT_EQ(wheel.size(), 1000ULL);
 
-  EXPECT_TRUE(true);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  watchdogs.clear();
+  EXPECT_GE(numFired, 1000);
+  EXPECT_EQ(wheel.size(), 0ULL);
 }
  
  
@@ -18,6 +18,8 @@
  
 // includes
 #include <Bitwise/BitFieldIterator.h>
+#include <Bitwise/SetBitIterator.h>
+#include <Bitwise/details/BitVectorKernels.h>
 #include <Utils/miscellaneous.h>
 
 #include <algorithm>
@@ -29,14 +31,20 @@
 #include <new>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
 
 
 namespace bws {
 
 
 /**
- * @class BitVector
+ * @class  BitVector
  * @brief
+ * @remark The bitwise operators, count and the find methods work on whole regions of IntType and
+ *         process long vectors with SIMD instructions, see details/BitVectorKernels.h.
+ *         Bits beyond size() within the last region are undefined and ignored by all of them.
+ * @remark setBits and forEachSetBit visit only the bits set, word by word. For rank and select
+ *         queries see RankSelectIndex.
  */
 template <typename IntType = std::uint8_t>
 class BitVectorT {
@@ -61,7 +69,11 @@ public:
   using const_reference = BitProxy<byte, true>;
   using iterator        = BitFieldIterator<byte, false>;
   using const_iterator  = BitFieldIterator<byte, true>;
-  
+
+  // ---------------------------------------------------
+  // public constants
+  static constexpr size_type npos = ~size_type{};
+
   // ---------------------------------------------------
   // ctor & dtor
   BitVectorT     () = default;
@@ -100,6 +112,34 @@ public:
   auto cbegin                 () const noexcept -> const_iterator;
   auto cend                   () const noexcept -> const_iterator;
 
+  // ---------------------------------------------------
+  // bulk operations
+  auto operator&=              (BitVectorT const& rhs) -> BitVectorT&;
+  auto operator|=              (BitVectorT const& rhs) -> BitVectorT&;
+  auto operator^=              (BitVectorT const& rhs) -> BitVectorT&;
+  auto operator<<=             (size_type n) noexcept -> BitVectorT&;
+  auto operator>>=             (size_type n) noexcept -> BitVectorT&;
+  auto operator~               () const -> BitVectorT;
+  void flip                    () noexcept;
+  [[nodiscard]] auto count     () const noexcept -> size_type;
+  [[nodiscard]] auto all       () const noexcept -> bool;
+  [[nodiscard]] auto any       () const noexcept -> bool;
+  [[nodiscard]] auto none      () const noexcept -> bool;
+  [[nodiscard]] auto findFirst () const noexcept -> size_type;
+  [[nodiscard]] auto findNext  (size_type pos) const noexcept -> size_type;
+
+  // ---------------------------------------------------
+  // set bit access
+  [[nodiscard]] auto numWords  () const noexcept -> size_type;
+  [[nodiscard]] auto word      (size_type index) const noexcept -> std::uint64_t;
+  void setWord                 (size_type index, std::uint64_t w) noexcept;
+  [[nodiscard]] auto setBits   () const noexcept -> SetBitRange<BitVectorT>;
+  template <typename Func>
+  void forEachSetBit           (Func&& func) const;
+
+  template <typename IntType1, typename IntType2>
+  friend auto operator== (BitVectorT<IntType1> const& lhs, BitVectorT<IntType2> const& rhs) -> bool;
+
 private:
 
   // ---------------------------------------------------
@@ -115,6 +155,13 @@ private:
   void performBoundsCheck (size_type);
   auto minCapacity        (size_type size) const -> size_type;
   auto realloc            (size_type const c) -> bool;
+  auto numUsedRegions     () const noexcept -> size_type;
+  auto bytes              () noexcept -> unsigned char*;
+  auto bytes              () const noexcept -> unsigned char const*;
+  void clearUnusedBits    () noexcept;
+  void checkSameSize      (BitVectorT const& rhs) const;
+  auto findFrom           (size_type first) const noexcept -> size_type;
+  auto isEqual            (BitVectorT const& rhs) const noexcept -> bool;
 };
 
 
@@ -165,7 +212,10 @@ template <typename IntType>
 inline BitVectorT<IntType>::BitVectorT(BitVectorT const& src)
   : BitVectorT(src.size())
 {
-  std::memcpy(data.get(), src.data.get(), currentCapacity / 8ULL);
+  if(currentCapacity > 0ULL)
+  {
+    std::memcpy(data.get(), src.data.get(), currentCapacity / 8ULL);
+  }
 }
 
 /**
@@ -321,21 +371,20 @@ void BitVectorT<IntType>::resize(size_type size, value_type val)
 template <typename IntType>
 void BitVectorT<IntType>::assign(size_type size, value_type val)
 {
-  if(size < regionSize)
+  if(const auto requiredCapacity = minCapacity(size); requiredCapacity > currentCapacity)
   {
-    data[0ULL] = punchMask<byte>(size);
+    data            = allocateMemory(requiredCapacity / regionSize);
+    currentCapacity = requiredCapacity;
   }
-  else
-  {
-    if(const auto requiredCapacity = minCapacity(size); requiredCapacity > currentCapacity)
-    {
-      data            = allocateMemory(requiredCapacity / regionSize);
-      currentCapacity = requiredCapacity;
-    }
 
-    const auto numCompleteRegions = size / regionSize;
+  if(const auto numCompleteRegions = size / regionSize; numCompleteRegions > 0ULL)
+  {
     std::memset(data.get(), val ? static_cast<int>(~0) : 0, numCompleteRegions * byteSize);
-    data[numCompleteRegions] = val ? punchMask<byte>(size % regionSize) : byte{};
+  }
+
+  if(const auto numRemainingElements = size % regionSize; numRemainingElements > 0ULL)
+  {
+    data[size / regionSize] = val ? punchMask<byte>(numRemainingElements) : byte{};
   }
 
   currentSize = size;
@@ -353,7 +402,7 @@ auto BitVectorT<IntType>::realloc(size_type const newCapacity) -> bool
   {
     if(data)
     {
-      std::memcpy(newStorage, data.get(), newCapacity / 8ULL);
+      std::memcpy(newStorage, data.get(), (std::min)(newCapacity, currentCapacity) / 8ULL);
     }
     data.reset(newStorage);
     currentCapacity = newCapacity;
@@ -586,14 +635,405 @@ auto BitVectorT<IntType>::allocateMemory(size_type numRegions) const -> dataPtr
   return std::make_unique<byte[]>(numRegions);
 }
 
+/**
+ * @brief Combines the vector bitwise with rhs by means of a logical AND.
+ * @throw std::invalid_argument if the sizes differ.
+ */
+template <typename IntType>
+inline auto BitVectorT<IntType>::operator&=(BitVectorT const& rhs) -> BitVectorT&
+{
+  checkSameSize(rhs);
+  details::transformBytes<details::AndOp>(bytes(), rhs.bytes(), numUsedRegions() * byteSize);
+  return *this;
+}
+
+/**
+ * @brief Combines the vector bitwise with rhs by means of a logical OR.
+ * @throw std::invalid_argument if the sizes differ.
+ */
+template <typename IntType>
+inline auto BitVectorT<IntType>::operator|=(BitVectorT const& rhs) -> BitVectorT&
+{
+  checkSameSize(rhs);
+  details::transformBytes<details::OrOp>(bytes(), rhs.bytes(), numUsedRegions() * byteSize);
+  return *this;
+}
+
+/**
+ * @brief Combines the vector bitwise with rhs by means of a logical XOR.
+ * @throw std::invalid_argument if the sizes differ.
+ */
+template <typename IntType>
+inline auto BitVectorT<IntType>::operator^=(BitVectorT const& rhs) -> BitVectorT&
+{
+  checkSameSize(rhs);
+  details::transformBytes<details::XorOp>(bytes(), rhs.bytes(), numUsedRegions() * byteSize);
+  return *this;
+}
+
+/**
+ * @brief  Moves every bit n positions towards the end of the vector like std::bitset.
+ *         The first n bits are cleared, the last n bits are dropped. The size doesn't change.
+ */
+template <typename IntType>
+auto BitVectorT<IntType>::operator<<=(size_type n) noexcept -> BitVectorT&
+{
+  const auto numRegions = numUsedRegions();
+  if(n >= currentSize)
+  {
+    std::fill_n(data.get(), numRegions, byte{});
+    return *this;
+  }
+
+  const auto regionShift = n / regionSize;
+  const auto bitShift    = n % regionSize;
+  if(bitShift == 0ULL)
+  {
+    std::copy_backward(data.get(), data.get() + numRegions - regionShift, data.get() + numRegions);
+  }
+  else
+  {
+    for(auto i = numRegions - 1ULL; i > regionShift; --i)
+    {
+      data[i] = static_cast<byte>((data[i - regionShift] << bitShift) | (data[i - regionShift - 1ULL] >> (regionSize - bitShift)));
+    }
+    data[regionShift] = static_cast<byte>(data[0ULL] << bitShift);
+  }
+  std::fill_n(data.get(), regionShift, byte{});
+
+  return *this;
+}
+
+/**
+ * @brief  Moves every bit n positions towards the beginning of the vector like std::bitset.
+ *         The last n bits are cleared, the first n bits are dropped. The size doesn't change.
+ */
+template <typename IntType>
+auto BitVectorT<IntType>::operator>>=(size_type n) noexcept -> BitVectorT&
+{
+  const auto numRegions = numUsedRegions();
+  if(n >= currentSize)
+  {
+    std::fill_n(data.get(), numRegions, byte{});
+    return *this;
+  }
+
+  // otherwise the undefined bits beyond size would be moved in
+  clearUnusedBits();
+
+  const auto regionShift = n / regionSize;
+  const auto bitShift    = n % regionSize;
+  const auto numMoved    = numRegions - regionShift;
+  if(bitShift == 0ULL)
+  {
+    std::copy(data.get() + regionShift, data.get() + numRegions, data.get());
+  }
+  else
+  {
+    for(size_type i = 0ULL; i + 1ULL < numMoved; ++i)
+    {
+      data[i] = static_cast<byte>((data[i + regionShift] >> bitShift) | (data[i + regionShift + 1ULL] << (regionSize - bitShift)));
+    }
+    data[numMoved - 1ULL] = static_cast<byte>(data[numRegions - 1ULL] >> bitShift);
+  }
+  std::fill_n(data.get() + numMoved, regionShift, byte{});
+
+  return *this;
+}
+
+/**
+ * @brief Returns a copy of the vector with all bits inverted.
+ */
+template <typename IntType>
+inline auto BitVectorT<IntType>::operator~() const -> BitVectorT
+{
+  BitVectorT result(*this);
+  result.flip();
+  return result;
+}
+
+/**
+ * @brief Inverts all bits.
+ */
+template <typename IntType>
+inline void BitVectorT<IntType>::flip() noexcept
+{
+  details::flipBytes(bytes(), numUsedRegions() * byteSize);
+}
+
+/**
+ * @brief Returns the number of bits set.
+ */
+template <typename IntType>
+auto BitVectorT<IntType>::count() const noexcept -> size_type
+{
+  const auto numCompleteRegions = currentSize / regionSize;
+  auto       numBits            = details::countBitsBytes(bytes(), numCompleteRegions * byteSize);
+  if(const auto numRemainingElements = currentSize % regionSize; numRemainingElements > 0ULL)
+  {
+    numBits += countBits(static_cast<byte>(data[numCompleteRegions] & punchMask<byte>(numRemainingElements)));
+  }
+
+  return numBits;
+}
+
+/**
+ * @brief Checks if all bits are set. This is true for an empty vector.
+ */
+template <typename IntType>
+inline auto BitVectorT<IntType>::all() const noexcept -> bool
+{
+  return count() == currentSize;
+}
+
+/**
+ * @brief Checks if any bit is set.
+ */
+template <typename IntType>
+inline auto BitVectorT<IntType>::any() const noexcept -> bool
+{
+  return findFrom(0ULL) != npos;
+}
+
+/**
+ * @brief Checks if no bit is set.
+ */
+template <typename IntType>
+inline auto BitVectorT<IntType>::none() const noexcept -> bool
+{
+  return !any();
+}
+
+/**
+ * @brief  Looks for the first bit set.
+ * @return its index or npos, if no bit is set.
+ */
+template <typename IntType>
+inline auto BitVectorT<IntType>::findFirst() const noexcept -> size_type
+{
+  return findFrom(0ULL);
+}
+
+/**
+ * @brief  Looks for the first bit set behind pos.
+ * @return its index or npos, if no further bit is set.
+ */
+template <typename IntType>
+inline auto BitVectorT<IntType>::findNext(size_type pos) const noexcept -> size_type
+{
+  return pos == npos ? npos : findFrom(pos + 1ULL);
+}
+
+/**
+ * @brief Returns the number of 64 bit words covering the vector, see word.
+ */
+template <typename IntType>
+inline auto BitVectorT<IntType>::numWords() const noexcept -> size_type
+{
+  return (currentSize + 63ULL) / 64ULL;
+}
+
+/**
+ * @brief  Returns the bits [64 * index, 64 * index + 64) as a single word, bit i of the word
+ *         being bit 64 * index + i of the vector. Bits beyond size are cleared.
+ * @remark index must be less than numWords. The regions are reinterpreted as a sequence of
+ *         bytes, which requires a little endian target.
+ */
+template <typename IntType>
+inline auto BitVectorT<IntType>::word(size_type index) const noexcept -> std::uint64_t
+{
+  const auto firstByte = index * 8ULL;
+  const auto numBytes  = numUsedRegions() * byteSize;
+
+  std::uint64_t w = 0ULL;
+  if(firstByte + 8ULL <= numBytes)
+  {
+    w = details::load64(bytes() + firstByte);
+  }
+  else
+  {
+    std::memcpy(&w, bytes() + firstByte, numBytes - firstByte);
+  }
+  if(const auto numBits = currentSize - index * 64ULL; numBits < 64ULL)
+  {
+    w &= punchMask<std::uint64_t>(numBits);
+  }
+
+  return w;
+}
+
+/**
+ * @brief  Overwrites the bits [64 * index, 64 * index + 64) with w, the counterpart of word.
+ *         Bits of w beyond size are ignored like all unused bits of the last region.
+ * @remark index must be less than numWords.
+ */
+template <typename IntType>
+inline void BitVectorT<IntType>::setWord(size_type index, std::uint64_t w) noexcept
+{
+  const auto firstByte = index * 8ULL;
+  const auto numBytes  = numUsedRegions() * byteSize;
+
+  if(firstByte + 8ULL <= numBytes)
+  {
+    details::store64(bytes() + firstByte, w);
+  }
+  else
+  {
+    std::memcpy(bytes() + firstByte, &w, numBytes - firstByte);
+  }
+}
+
+/**
+ * @brief  Returns a range over the indices of the bits set, in ascending order.
+ * @remark The range is invalidated by any modification of the vector.
+ */
+template <typename IntType>
+inline auto BitVectorT<IntType>::setBits() const noexcept -> SetBitRange<BitVectorT>
+{
+  return SetBitRange<BitVectorT>{*this};
+}
+
+/**
+ * @brief Calls func with the index of every bit set, in ascending order. Each word is consumed
+ *        by counting trailing zeros, words without any bit set are skipped by the
+ *        word-parallel kernel.
+ */
+template <typename IntType>
+template <typename Func>
+void BitVectorT<IntType>::forEachSetBit(Func&& func) const
+{
+  for(auto pos = findFrom(0ULL); pos != npos; pos = findFrom((pos / 64ULL + 1ULL) * 64ULL))
+  {
+    const auto wordIndex = pos / 64ULL;
+    for(auto bits = word(wordIndex); bits != 0ULL; bits &= bits - 1ULL)
+    {
+      func(wordIndex * 64ULL + firstBitSet(bits));
+    }
+  }
+}
+
+/**
+ * @brief Returns the number of regions holding the bits of the vector.
+ */
+template <typename IntType>
+inline auto BitVectorT<IntType>::numUsedRegions() const noexcept -> size_type
+{
+  return (currentSize + regionSize - 1ULL) / regionSize;
+}
+
+/**
+ * @brief Returns the storage as raw bytes for the word-parallel kernels.
+ */
+template <typename IntType>
+inline auto BitVectorT<IntType>::bytes() noexcept -> unsigned char*
+{
+  return reinterpret_cast<unsigned char*>(data.get());
+}
+
+/**
+ * @brief Returns the storage as raw bytes for the word-parallel kernels.
+ */
+template <typename IntType>
+inline auto BitVectorT<IntType>::bytes() const noexcept -> unsigned char const*
+{
+  return reinterpret_cast<unsigned char const*>(data.get());
+}
+
+/**
+ * @brief Clears the bits beyond size within the last region.
+ */
+template <typename IntType>
+inline void BitVectorT<IntType>::clearUnusedBits() noexcept
+{
+  if(const auto numRemainingElements = currentSize % regionSize; numRemainingElements > 0ULL)
+  {
+    data[currentSize / regionSize] &= punchMask<byte>(numRemainingElements);
+  }
+}
+
+/**
+ * @brief Throws an exception of type std::invalid_argument, if the size of rhs differs.
+ * @throw std::invalid_argument.
+ */
+template <typename IntType>
+void BitVectorT<IntType>::checkSameSize(BitVectorT const& rhs) const
+{
+  if(currentSize != rhs.currentSize)
+  {
+    std::stringstream errMsg;
+    errMsg << "Error : size of operand [which is " << rhs.currentSize << "] != size [which is " << currentSize << "]";
+    throw std::invalid_argument(errMsg.str());
+  }
+}
+
+/**
+ * @brief  Looks for the first bit set at or behind first. Zero regions are skipped
+ *         by the word-parallel kernel.
+ * @return its index or npos, if there is none.
+ */
+template <typename IntType>
+auto BitVectorT<IntType>::findFrom(size_type first) const noexcept -> size_type
+{
+  if(first >= currentSize)
+  {
+    return npos;
+  }
+
+  const auto numRegions = numUsedRegions();
+  auto       region     = first / regionSize;
+  auto       bits       = static_cast<byte>(data[region] & ~punchMask<byte>(first % regionSize));
+  if(bits == byte{})
+  {
+    ++region;
+    region += details::findNonZeroByte(bytes() + region * byteSize, (numRegions - region) * byteSize) / byteSize;
+    if(region >= numRegions)
+    {
+      return npos;
+    }
+    bits = data[region];
+  }
+
+  // a bit beyond size belongs to the undefined rest of the last region
+  const auto pos = region * regionSize + firstBitSet(bits);
+  return pos < currentSize ? pos : npos;
+}
+
+/**
+ * @brief Compares size and bits with rhs region by region.
+ */
+template <typename IntType>
+auto BitVectorT<IntType>::isEqual(BitVectorT const& rhs) const noexcept -> bool
+{
+  if(currentSize != rhs.currentSize)
+  {
+    return false;
+  }
+
+  const auto numCompleteRegions = currentSize / regionSize;
+  if(!details::equalBytes(bytes(), rhs.bytes(), numCompleteRegions * byteSize))
+  {
+    return false;
+  }
+  if(const auto numRemainingElements = currentSize % regionSize; numRemainingElements > 0ULL)
+  {
+    return ((data[numCompleteRegions] ^ rhs.data[numCompleteRegions]) & punchMask<byte>(numRemainingElements)) == 0;
+  }
+
+  return true;
+}
+
 /**
  * @brief Checks if the content of lhs and rhs are equal, that is they have the same size
  *        and all bits are equal.
  */
 template <typename IntType1, typename IntType2>
-auto operator==(BitVectorT<IntType1> const& lhs, BitVectorT<IntType2> const& rhs)
+auto operator==(BitVectorT<IntType1> const& lhs, BitVectorT<IntType2> const& rhs) -> bool
 {
-  if(const auto s = lhs.size(); s == rhs.size())
+  if constexpr(std::is_same_v<IntType1, IntType2>)
+  {
+    return lhs.isEqual(rhs);
+  }
+  else if(const auto s = lhs.size(); s == rhs.size())
   {
     for(std::size_t i = 0ULL; i < s; ++i)
     {
@@ -605,8 +1045,10 @@ auto operator==(BitVectorT<IntType1> const& lhs, BitVectorT<IntType2> const& rhs
 
     return true;
   }
-
-  return false;
+  else
+  {
+    return false;
+  }
 }
 
 template <typename IntType1, typename IntType2>
@@ -615,6 +1057,59 @@ auto operator!=(BitVectorT<IntType1> const& lhs, BitVectorT<IntType2> const& rhs
   return !(lhs == rhs);
 }
 
+/**
+ * @brief Returns the bitwise AND of lhs and rhs.
+ * @throw std::invalid_argument if the sizes differ.
+ */
+template <typename IntType>
+inline auto operator&(BitVectorT<IntType> lhs, BitVectorT<IntType> const& rhs) -> BitVectorT<IntType>
+{
+  lhs &= rhs;
+  return lhs;
+}
+
+/**
+ * @brief Returns the bitwise OR of lhs and rhs.
+ * @throw std::invalid_argument if the sizes differ.
+ */
+template <typename IntType>
+inline auto operator|(BitVectorT<IntType> lhs, BitVectorT<IntType> const& rhs) -> BitVectorT<IntType>
+{
+  lhs |= rhs;
+  return lhs;
+}
+
+/**
+ * @brief Returns the bitwise XOR of lhs and rhs.
+ * @throw std::invalid_argument if the sizes differ.
+ */
+template <typename IntType>
+inline auto operator^(BitVectorT<IntType> lhs, BitVectorT<IntType> const& rhs) -> BitVectorT<IntType>
+{
+  lhs ^= rhs;
+  return lhs;
+}
+
+/**
+ * @brief Returns a copy of lhs with all bits moved n positions towards the end.
+ */
+template <typename IntType>
+inline auto operator<<(BitVectorT<IntType> lhs, std::size_t n) -> BitVectorT<IntType>
+{
+  lhs <<= n;
+  return lhs;
+}
+
+/**
+ * @brief Returns a copy of lhs with all bits moved n positions towards the beginning.
+ */
+template <typename IntType>
+inline auto operator>>(BitVectorT<IntType> lhs, std::size_t n) -> BitVectorT<IntType>
+{
+  lhs >>= n;
+  return lhs;
+}
+
 
 }   // namespace bws
 
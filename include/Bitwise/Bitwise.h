@@ -17,9 +17,34 @@
  
  
 // includes
+#include <climits>
+#include <cstddef>
 #include <cstdint>
 #include <ostream>
 #include <type_traits>
+
+// The hardware backends work on 64 bit words. POPCNT, TZCNT and LZCNT are only used if the target
+// guarantees them (-mpopcnt, -mbmi, -mlzcnt or /arch:AVX, /arch:AVX2), because on older processors
+// TZCNT and LZCNT silently execute as BSF and BSR, which return different results.
+#if (defined(_M_X64) || defined(__x86_64__)) && __has_include(<immintrin.h>)
+#  include <immintrin.h>
+#  if defined(__POPCNT__) || (defined(_MSC_VER) && defined(__AVX__))
+#    define BWS_HAS_POPCNT
+#  endif
+#  if defined(__BMI__) || (defined(_MSC_VER) && defined(__AVX2__))
+#    define BWS_HAS_TZCNT
+#  endif
+#  if defined(__LZCNT__) || (defined(_MSC_VER) && defined(__AVX2__))
+#    define BWS_HAS_LZCNT
+#  endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#  define BWS_HAS_BUILTIN_BITSCAN
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+#  include <intrin.h>
+#  define BWS_HAS_MSVC_BITSCAN
+#endif
  
 
 namespace bws {
@@ -86,78 +111,199 @@ template <typename T>
   }
 }
 
+namespace details {
+
+
 /**
- * @brief  Counts the number of bits set in a give value v.
- * @tparam T the type of the value.
+ * @brief Counts the bits set by the SWAR bit trick, portable and constexpr.
  */
 template <typename T>
-[[nodiscard]] constexpr auto countBits(T v) noexcept -> std::enable_if_t<!std::is_signed_v<T>, std::size_t>
+[[nodiscard]] constexpr auto countBitsFallback(T v) noexcept -> std::size_t
 {
   v = v - ((v >> 1) & (T) ~(T)0 / 3);
   v = (v & (T) ~(T)0 / 15 * 3) + ((v >> 2) & (T) ~(T)0 / 15 * 3);
-  //v = (v + (v >> 4)) & (T) ~(T)0 / 255 * 15;
-  //return (T)(v * ((T) ~(T)0 / 255)) >> ((sizeof(T) - 1) * CHAR_BIT);
 
   return (T)(((v + (v >> 4)) & (T) ~(T)0 / 255 * 15) * ((T) ~(T)0 / 255)) >> ((sizeof(T) - 1ULL) * CHAR_BIT);
 }
 
+/**
+ * @brief Determines the index of the lowest bit set by a binary search, portable and constexpr.
+ *        Returns the number of bits of T, if v is zero.
+ */
 template <typename T>
-[[nodiscard]] constexpr auto countBits(T v) noexcept -> std::enable_if_t<std::is_signed_v<T>, std::size_t>
+[[nodiscard]] constexpr auto firstBitSetFallback(T v) noexcept -> std::size_t
 {
+  constexpr std::size_t numBits = sizeof(T) * CHAR_BIT;
+  if(v == T{})
+  {
+    return numBits;
+  }
+
   std::size_t c{};
-  for(; v; v >>= 1)
+  for(std::size_t shift = numBits / 2ULL; shift > 0ULL; shift /= 2ULL)
   {
-    c += v & 1;
+    if((v & punchMask<T>(shift)) == T{})
+    {
+      v = static_cast<T>(v >> shift);
+      c += shift;
+    }
   }
 
   return c;
 }
 
+/**
+ * @brief Determines the index of the highest bit set by a binary search, portable and constexpr.
+ *        Returns the number of bits of T, if v is zero.
+ */
 template <typename T>
-[[nodiscard]] auto firstBitSet(T v) noexcept -> std::size_t
+[[nodiscard]] constexpr auto lastBitSetFallback(T v) noexcept -> std::size_t
 {
-  std::size_t c{};
-  if(v & 0x1)
+  constexpr std::size_t numBits = sizeof(T) * CHAR_BIT;
+  if(v == T{})
   {
-    // special case for odd v (assumed to happen half of the time)
-    c = 0;
+    return numBits;
   }
-  else
+
+  std::size_t c{};
+  for(std::size_t shift = numBits / 2ULL; shift > 0ULL; shift /= 2ULL)
   {
-    c = 1;
-    if((v & 0xffff) == 0)
-    {
-      v >>= 16;
-      c += 16;
-    }
-    if((v & 0xff) == 0)
+    if((v >> (numBits - shift)) == T{})
     {
-      v >>= 8;
-      c += 8;
+      v = static_cast<T>(v << shift);
+      c += shift;
     }
-    if((v & 0xf) == 0)
-    {
-      v >>= 4;
-      c += 4;
-    }
-    if((v & 0x3) == 0)
-    {
-      v >>= 2;
-      c += 2;
-    }
-    c -= v & 0x1;
   }
 
-  return c;
+  return numBits - 1ULL - c;
+}
+
+/**
+ * @brief Counts the bits set by POPCNT if the target guarantees it, otherwise by the fallback.
+ */
+template <typename T>
+[[nodiscard]] inline auto countBitsHardware(T v) noexcept -> std::size_t
+{
+#if defined(BWS_HAS_POPCNT)
+  return static_cast<std::size_t>(_mm_popcnt_u64(v));
+#else
+  return countBitsFallback(v);
+#endif
+}
+
+/**
+ * @brief Determines the index of the lowest bit set by TZCNT or a bit scan instruction.
+ *        Returns the number of bits of T, if v is zero.
+ */
+template <typename T>
+[[nodiscard]] inline auto firstBitSetHardware(T v) noexcept -> std::size_t
+{
+  constexpr std::size_t numBits = sizeof(T) * CHAR_BIT;
+  if(v == T{})
+  {
+    return numBits;
+  }
+
+#if defined(BWS_HAS_TZCNT)
+  return static_cast<std::size_t>(_tzcnt_u64(v));
+#elif defined(BWS_HAS_BUILTIN_BITSCAN)
+  return static_cast<std::size_t>(__builtin_ctzll(v));
+#elif defined(BWS_HAS_MSVC_BITSCAN)
+  unsigned long index;
+  _BitScanForward64(&index, v);
+  return static_cast<std::size_t>(index);
+#else
+  return firstBitSetFallback(v);
+#endif
+}
+
+/**
+ * @brief Determines the index of the highest bit set by LZCNT or a bit scan instruction.
+ *        Returns the number of bits of T, if v is zero.
+ */
+template <typename T>
+[[nodiscard]] inline auto lastBitSetHardware(T v) noexcept -> std::size_t
+{
+  constexpr std::size_t numBits = sizeof(T) * CHAR_BIT;
+  if(v == T{})
+  {
+    return numBits;
+  }
+
+#if defined(BWS_HAS_LZCNT)
+  return 63ULL - static_cast<std::size_t>(_lzcnt_u64(v));
+#elif defined(BWS_HAS_BUILTIN_BITSCAN)
+  return 63ULL - static_cast<std::size_t>(__builtin_clzll(v));
+#elif defined(BWS_HAS_MSVC_BITSCAN)
+  unsigned long index;
+  _BitScanReverse64(&index, v);
+  return static_cast<std::size_t>(index);
+#else
+  return lastBitSetFallback(v);
+#endif
+}
+
+template <typename T>
+inline constexpr bool isBitCountable = std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8ULL;
+
+
+}   // namespace details
+
+
+/**
+ * @brief  Counts the number of bits set in a give value v.
+ * @tparam T an integral type of up to 64 bits. Signed values are counted in two's complement.
+ * @remark Uses POPCNT if the target guarantees it, the SWAR fallback in constant expressions.
+ */
+template <typename T>
+[[nodiscard]] constexpr auto countBits(T v) noexcept -> std::size_t
+{
+  static_assert(details::isBitCountable<T>, "countBits requires an integral type of up to 64 bits");
+  using U = std::make_unsigned_t<T>;
+
+  if(std::is_constant_evaluated())
+  {
+    return details::countBitsFallback(static_cast<U>(v));
+  }
+  return details::countBitsHardware(static_cast<std::uint64_t>(static_cast<U>(v)));
+}
+
+/**
+ * @brief  Determines the index of the lowest bit set in a given value v.
+ * @tparam T an integral type of up to 64 bits.
+ * @return the index counted from the least significant bit, the number of bits of T if v is zero.
+ * @remark Uses TZCNT or a bit scan instruction, the binary search fallback in constant expressions.
+ */
+template <typename T>
+[[nodiscard]] constexpr auto firstBitSet(T v) noexcept -> std::size_t
+{
+  static_assert(details::isBitCountable<T>, "firstBitSet requires an integral type of up to 64 bits");
+  using U = std::make_unsigned_t<T>;
 
-  //std::size_t c{};
-  //while(!(v & T{1}))
-  //{
-  //  ++c;
-  //  v >>= 1;
-  //}
+  if(std::is_constant_evaluated() || v == T{})
+  {
+    return details::firstBitSetFallback(static_cast<U>(v));
+  }
+  return details::firstBitSetHardware(static_cast<std::uint64_t>(static_cast<U>(v)));
+}
+
+/**
+ * @brief  Determines the index of the highest bit set in a given value v.
+ * @tparam T an integral type of up to 64 bits.
+ * @return the index counted from the least significant bit, the number of bits of T if v is zero.
+ * @remark Uses LZCNT or a bit scan instruction, the binary search fallback in constant expressions.
+ */
+template <typename T>
+[[nodiscard]] constexpr auto lastBitSet(T v) noexcept -> std::size_t
+{
+  static_assert(details::isBitCountable<T>, "lastBitSet requires an integral type of up to 64 bits");
+  using U = std::make_unsigned_t<T>;
 
-  //return c;
+  if(std::is_constant_evaluated() || v == T{})
+  {
+    return details::lastBitSetFallback(static_cast<U>(v));
+  }
+  return details::lastBitSetHardware(static_cast<std::uint64_t>(static_cast<U>(v)));
 }
 
 
@@ -0,0 +1,594 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    CompressedBitmap.h
+ * @brief   compressed bitmap for sparse masks and masks with long runs
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef COMPRESSEDBITMAP_H_10293847561029384756102938475610293847561029
+#define COMPRESSEDBITMAP_H_10293847561029384756102938475610293847561029
+
+
+// includes
+#include <Bitwise/BitVector.h>
+#include <Bitwise/details/BitmapContainers.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+
+namespace bws {
+
+
+/**
+ * @class  CompressedBitmap
+ * @brief  Set of bit positions in the manner of a roaring bitmap. The positions are split into
+ *         chunks of 65536, every chunk holding at least one bit set is stored in a container of
+ *         its own:
+ *         - an array of the 16 bit offsets, if at most 4096 bits are set,
+ *         - a plain bitmap of 8 KiB otherwise,
+ *         - sorted runs of bits set, if runOptimize or the conversion from a BitVectorT finds
+ *           them to be smaller.
+ *         Sparse masks and masks with long runs thus need a fraction of the memory of a
+ *         BitVectorT, and the set operations only touch chunks present in the operands.
+ * @remark Bitmap containers are combined with the word-parallel kernels of BitVectorT, see
+ *         details/BitVectorKernels.h.
+ */
+class CompressedBitmap {
+
+public:
+
+  // ---------------------------------------------------
+  // public types and constants
+  using size_type  = std::size_t;
+  using value_type = std::size_t;
+
+  class const_iterator;
+  using iterator = const_iterator;
+
+  static constexpr size_type npos = ~size_type{};
+
+  // ---------------------------------------------------
+  // construction
+  CompressedBitmap () = default;
+  CompressedBitmap (std::initializer_list<size_type> l);
+  template <typename IntType>
+  explicit CompressedBitmap (BitVectorT<IntType> const& bitVector);
+
+  // ---------------------------------------------------
+  // public api
+  auto add                          (size_type pos) -> bool;
+  auto remove                       (size_type pos) -> bool;
+  [[nodiscard]] auto contains       (size_type pos) const noexcept -> bool;
+  [[nodiscard]] auto cardinality    () const noexcept -> size_type;
+  [[nodiscard]] auto empty          () const noexcept -> bool;
+  [[nodiscard]] auto minimum        () const noexcept -> size_type;
+  [[nodiscard]] auto maximum        () const noexcept -> size_type;
+  [[nodiscard]] auto memoryUsage    () const noexcept -> size_type;
+  void clear                        () noexcept;
+  void runOptimize                  ();
+  template <typename IntType = std::uint8_t>
+  [[nodiscard]] auto toBitVector    (size_type size) const -> BitVectorT<IntType>;
+
+  // ---------------------------------------------------
+  // iteration
+  auto begin                        () const noexcept -> const_iterator;
+  auto end                          () const noexcept -> const_iterator;
+  template <typename Func>
+  void forEachSetBit                (Func&& func) const;
+
+  // ---------------------------------------------------
+  // set operations
+  auto operator&=                   (CompressedBitmap const& rhs) -> CompressedBitmap&;
+  auto operator|=                   (CompressedBitmap const& rhs) -> CompressedBitmap&;
+  auto operator^=                   (CompressedBitmap const& rhs) -> CompressedBitmap&;
+  auto andNot                       (CompressedBitmap const& rhs) -> CompressedBitmap&;
+
+  friend auto operator== (CompressedBitmap const& lhs, CompressedBitmap const& rhs) -> bool;
+
+private:
+
+  // ---------------------------------------------------
+  // private data
+  std::vector<size_type>          keys;
+  std::vector<details::Container> containers;
+
+  // ---------------------------------------------------
+  // private methods
+  static auto keyOf    (size_type pos) noexcept -> size_type { return pos / details::containerBits; }
+  static auto lowOf    (size_type pos) noexcept -> std::uint16_t { return static_cast<std::uint16_t>(pos % details::containerBits); }
+  auto findKey         (size_type key) const noexcept -> std::vector<size_type>::const_iterator;
+  template <typename Op>
+  void combineWith     (CompressedBitmap const& rhs);
+};
+
+
+/**
+ * @class  CompressedBitmap::const_iterator
+ * @brief  Forward iterator over the positions set, in ascending order.
+ */
+class CompressedBitmap::const_iterator {
+
+public:
+
+  // ---------------------------------------------------
+  // iterator properties
+  using iterator_category = std::forward_iterator_tag;
+  using value_type        = CompressedBitmap::value_type;
+  using difference_type   = std::ptrdiff_t;
+  using pointer           = value_type const*;
+  using reference         = value_type;
+
+  const_iterator () noexcept = default;
+  const_iterator (CompressedBitmap const& bitmap, size_type containerIndex) noexcept;
+
+  auto operator*  () const noexcept -> reference;
+  auto operator++ () noexcept -> const_iterator&;
+  auto operator++ (int) noexcept -> const_iterator;
+
+  friend auto operator== (const_iterator const& it1, const_iterator const& it2) noexcept -> bool;
+  friend auto operator!= (const_iterator const& it1, const_iterator const& it2) noexcept -> bool;
+
+private:
+
+  CompressedBitmap const*  bitmap         {nullptr};
+  size_type                containerIndex {};
+  details::ContainerCursor cursor;
+};
+
+
+/**
+ * @brief Constructor. Adds the positions of l.
+ */
+inline CompressedBitmap::CompressedBitmap(std::initializer_list<size_type> l)
+{
+  for(const auto pos : l)
+  {
+    add(pos);
+  }
+}
+
+/**
+ * @brief Constructor. Takes the bits set in bitVector. Every chunk is read as a bitmap and then
+ *        stored in the smallest representation.
+ */
+template <typename IntType>
+CompressedBitmap::CompressedBitmap(BitVectorT<IntType> const& bitVector)
+{
+  const auto numWords = bitVector.numWords();
+  for(size_type firstWord = 0ULL; firstWord < numWords; firstWord += details::containerWords)
+  {
+    details::BitmapContainer b;
+    const auto lastWord = std::min<size_type>(firstWord + details::containerWords, numWords);
+    for(auto w = firstWord; w < lastWord; ++w)
+    {
+      b.words[w - firstWord] = bitVector.word(w);
+    }
+    details::recount(b);
+
+    if(b.cardinality > 0ULL)
+    {
+      keys.push_back(firstWord / details::containerWords);
+      containers.emplace_back(std::move(b));
+      details::optimize(containers.back());
+    }
+  }
+}
+
+/**
+ * @brief  Sets the bit pos.
+ * @return true, if it wasn't set before.
+ */
+inline auto CompressedBitmap::add(size_type pos) -> bool
+{
+  const auto key = keyOf(pos);
+  const auto it  = std::lower_bound(keys.begin(), keys.end(), key);
+  const auto i   = it - keys.begin();
+  if(it == keys.end() || *it != key)
+  {
+    keys.insert(it, key);
+    containers.insert(containers.begin() + i, details::ArrayContainer{});
+  }
+
+  return details::add(containers[static_cast<size_type>(i)], lowOf(pos));
+}
+
+/**
+ * @brief  Clears the bit pos.
+ * @return true, if it was set before.
+ */
+inline auto CompressedBitmap::remove(size_type pos) -> bool
+{
+  const auto it = findKey(keyOf(pos));
+  if(it == keys.end())
+  {
+    return false;
+  }
+
+  const auto i       = static_cast<size_type>(it - keys.begin());
+  const bool removed = details::remove(containers[i], lowOf(pos));
+  if(details::cardinality(containers[i]) == 0ULL)
+  {
+    keys.erase(keys.begin() + static_cast<std::ptrdiff_t>(i));
+    containers.erase(containers.begin() + static_cast<std::ptrdiff_t>(i));
+  }
+
+  return removed;
+}
+
+/**
+ * @brief Checks if the bit pos is set.
+ */
+inline auto CompressedBitmap::contains(size_type pos) const noexcept -> bool
+{
+  const auto it = findKey(keyOf(pos));
+  return it != keys.end() && details::contains(containers[static_cast<size_type>(it - keys.begin())], lowOf(pos));
+}
+
+/**
+ * @brief Returns the number of bits set.
+ */
+inline auto CompressedBitmap::cardinality() const noexcept -> size_type
+{
+  size_type n = 0ULL;
+  for(const auto& c : containers)
+  {
+    n += details::cardinality(c);
+  }
+  return n;
+}
+
+/**
+ * @brief Checks if no bit is set.
+ */
+inline auto CompressedBitmap::empty() const noexcept -> bool
+{
+  return keys.empty();
+}
+
+/**
+ * @brief Returns the lowest position set or npos, if the bitmap is empty.
+ */
+inline auto CompressedBitmap::minimum() const noexcept -> size_type
+{
+  return empty() ? npos : keys.front() * details::containerBits + details::minimum(containers.front());
+}
+
+/**
+ * @brief Returns the highest position set or npos, if the bitmap is empty.
+ */
+inline auto CompressedBitmap::maximum() const noexcept -> size_type
+{
+  return empty() ? npos : keys.back() * details::containerBits + details::maximum(containers.back());
+}
+
+/**
+ * @brief Returns the number of bytes allocated by the bitmap and its containers.
+ */
+inline auto CompressedBitmap::memoryUsage() const noexcept -> size_type
+{
+  auto n = keys.capacity() * sizeof(size_type) + containers.capacity() * sizeof(details::Container);
+  for(const auto& c : containers)
+  {
+    n += details::sizeInBytes(c);
+  }
+  return n;
+}
+
+/**
+ * @brief Clears all bits.
+ */
+inline void CompressedBitmap::clear() noexcept
+{
+  keys.clear();
+  containers.clear();
+}
+
+/**
+ * @brief Converts every container to the smallest of the array, bitmap and run representation
+ *        and releases unused capacity. The set operations create arrays and bitmaps only, except
+ *        for AND and OR of two run containers, this brings back the runs.
+ */
+inline void CompressedBitmap::runOptimize()
+{
+  for(auto& c : containers)
+  {
+    details::optimize(c);
+  }
+}
+
+/**
+ * @brief Returns a BitVectorT of the given size holding the bits set. Bits at or beyond size are dropped.
+ */
+template <typename IntType>
+auto CompressedBitmap::toBitVector(size_type size) const -> BitVectorT<IntType>
+{
+  BitVectorT<IntType> result(size);
+  const auto numWords = result.numWords();
+
+  // bitmaps and runs are written word by word, the few bits of an array one by one
+  const auto setWords = [&result, numWords](size_type firstWord, std::vector<std::uint64_t> const& words) {
+    const auto lastWord = std::min<size_type>(firstWord + details::containerWords, numWords);
+    for(auto w = firstWord; w < lastWord; ++w)
+    {
+      if(const auto bits = words[w - firstWord]; bits != 0ULL)
+      {
+        result.setWord(w, bits);
+      }
+    }
+  };
+
+  for(size_type i = 0ULL; i < keys.size(); ++i)
+  {
+    const auto base = keys[i] * details::containerBits;
+    if(base >= size)
+    {
+      break;
+    }
+
+    if(std::holds_alternative<details::ArrayContainer>(containers[i]))
+    {
+      details::forEachValue(containers[i], [&result, base, size](std::uint32_t v) {
+        if(base + v < size)
+        {
+          result[base + v] = true;
+        }
+      });
+    }
+    else if(const auto* bitmap = std::get_if<details::BitmapContainer>(&containers[i]))
+    {
+      setWords(keys[i] * details::containerWords, bitmap->words);
+    }
+    else
+    {
+      setWords(keys[i] * details::containerWords, details::toBitmap(containers[i]).words);
+    }
+  }
+
+  return result;
+}
+
+/**
+ * @brief Returns an iterator to the lowest position set.
+ */
+inline auto CompressedBitmap::begin() const noexcept -> const_iterator
+{
+  return const_iterator{*this, 0ULL};
+}
+
+/**
+ * @brief Returns an iterator behind the highest position set.
+ */
+inline auto CompressedBitmap::end() const noexcept -> const_iterator
+{
+  return const_iterator{*this, containers.size()};
+}
+
+/**
+ * @brief Calls func with every position set, in ascending order. Each container is traversed
+ *        by a loop specific to its representation.
+ */
+template <typename Func>
+void CompressedBitmap::forEachSetBit(Func&& func) const
+{
+  for(size_type i = 0ULL; i < keys.size(); ++i)
+  {
+    const auto base = keys[i] * details::containerBits;
+    details::forEachValue(containers[i], [&func, base](std::uint32_t v) { func(base + v); });
+  }
+}
+
+/**
+ * @brief Intersection.
+ */
+inline auto CompressedBitmap::operator&=(CompressedBitmap const& rhs) -> CompressedBitmap&
+{
+  combineWith<details::AndOp>(rhs);
+  return *this;
+}
+
+/**
+ * @brief Union.
+ */
+inline auto CompressedBitmap::operator|=(CompressedBitmap const& rhs) -> CompressedBitmap&
+{
+  combineWith<details::OrOp>(rhs);
+  return *this;
+}
+
+/**
+ * @brief Symmetric difference.
+ */
+inline auto CompressedBitmap::operator^=(CompressedBitmap const& rhs) -> CompressedBitmap&
+{
+  combineWith<details::XorOp>(rhs);
+  return *this;
+}
+
+/**
+ * @brief Difference, clears all bits set in rhs.
+ */
+inline auto CompressedBitmap::andNot(CompressedBitmap const& rhs) -> CompressedBitmap&
+{
+  combineWith<details::AndNotOp>(rhs);
+  return *this;
+}
+
+/**
+ * @brief Looks for the container of key.
+ * @return its position in keys or keys.end(), if there is none.
+ */
+inline auto CompressedBitmap::findKey(size_type key) const noexcept -> std::vector<size_type>::const_iterator
+{
+  const auto it = std::lower_bound(keys.begin(), keys.end(), key);
+  return it != keys.end() && *it == key ? it : keys.end();
+}
+
+/**
+ * @brief Merges the sorted keys of both operands. Chunks present in both are combined container
+ *        by container, chunks present in one of them are taken or dropped depending on Op.
+ */
+template <typename Op>
+void CompressedBitmap::combineWith(CompressedBitmap const& rhs)
+{
+  constexpr bool keepLhsOnly = !std::is_same_v<Op, details::AndOp>;
+  constexpr bool keepRhsOnly = std::is_same_v<Op, details::OrOp> || std::is_same_v<Op, details::XorOp>;
+
+  std::vector<size_type>          resultKeys;
+  std::vector<details::Container> resultContainers;
+
+  size_type i = 0ULL;
+  size_type j = 0ULL;
+  while(i < keys.size() || j < rhs.keys.size())
+  {
+    if(j == rhs.keys.size() || (i < keys.size() && keys[i] < rhs.keys[j]))
+    {
+      if constexpr(keepLhsOnly)
+      {
+        resultKeys.push_back(keys[i]);
+        resultContainers.push_back(std::move(containers[i]));
+      }
+      ++i;
+    }
+    else if(i == keys.size() || rhs.keys[j] < keys[i])
+    {
+      if constexpr(keepRhsOnly)
+      {
+        resultKeys.push_back(rhs.keys[j]);
+        resultContainers.push_back(rhs.containers[j]);
+      }
+      ++j;
+    }
+    else
+    {
+      if(auto c = details::combine<Op>(containers[i], rhs.containers[j]); details::cardinality(c) > 0ULL)
+      {
+        resultKeys.push_back(keys[i]);
+        resultContainers.push_back(std::move(c));
+      }
+      ++i;
+      ++j;
+    }
+  }
+
+  keys       = std::move(resultKeys);
+  containers = std::move(resultContainers);
+}
+
+/**
+ * @brief Checks if lhs and rhs have the same bits set, regardless of the representation of their containers.
+ */
+inline auto operator==(CompressedBitmap const& lhs, CompressedBitmap const& rhs) -> bool
+{
+  return lhs.keys == rhs.keys
+      && std::equal(lhs.containers.begin(), lhs.containers.end(), rhs.containers.begin(),
+                    [](details::Container const& a, details::Container const& b) { return details::equal(a, b); });
+}
+
+inline auto operator!=(CompressedBitmap const& lhs, CompressedBitmap const& rhs) -> bool
+{
+  return !(lhs == rhs);
+}
+
+inline auto operator&(CompressedBitmap lhs, CompressedBitmap const& rhs) -> CompressedBitmap
+{
+  lhs &= rhs;
+  return lhs;
+}
+
+inline auto operator|(CompressedBitmap lhs, CompressedBitmap const& rhs) -> CompressedBitmap
+{
+  lhs |= rhs;
+  return lhs;
+}
+
+inline auto operator^(CompressedBitmap lhs, CompressedBitmap const& rhs) -> CompressedBitmap
+{
+  lhs ^= rhs;
+  return lhs;
+}
+
+/**
+ * @brief Returns the bits set in lhs but not in rhs.
+ */
+inline auto andNot(CompressedBitmap lhs, CompressedBitmap const& rhs) -> CompressedBitmap
+{
+  lhs.andNot(rhs);
+  return lhs;
+}
+
+
+/**
+ * @brief Constructor. Points to the first value of the container containerIndex or is the end
+ *        iterator, if containerIndex is the number of containers.
+ */
+inline CompressedBitmap::const_iterator::const_iterator(CompressedBitmap const& bitmap, size_type containerIndex) noexcept
+  : bitmap         {&bitmap}
+  , containerIndex {containerIndex}
+{
+  if(containerIndex < bitmap.containers.size())
+  {
+    details::firstValue(bitmap.containers[containerIndex], cursor);
+  }
+}
+
+inline auto CompressedBitmap::const_iterator::operator*() const noexcept -> reference
+{
+  return bitmap->keys[containerIndex] * details::containerBits + cursor.value;
+}
+
+inline auto CompressedBitmap::const_iterator::operator++() noexcept -> const_iterator&
+{
+  if(!details::nextValue(bitmap->containers[containerIndex], cursor))
+  {
+    // containers are never empty, the end iterator has a default cursor
+    if(++containerIndex < bitmap->containers.size())
+    {
+      details::firstValue(bitmap->containers[containerIndex], cursor);
+    }
+    else
+    {
+      cursor = details::ContainerCursor{};
+    }
+  }
+  return *this;
+}
+
+inline auto CompressedBitmap::const_iterator::operator++(int) noexcept -> const_iterator
+{
+  auto it = *this;
+  ++*this;
+  return it;
+}
+
+inline auto operator==(CompressedBitmap::const_iterator const& it1, CompressedBitmap::const_iterator const& it2) noexcept -> bool
+{
+  return it1.containerIndex == it2.containerIndex && it1.cursor.value == it2.cursor.value;
+}
+
+inline auto operator!=(CompressedBitmap::const_iterator const& it1, CompressedBitmap::const_iterator const& it2) noexcept -> bool
+{
+  return !(it1 == it2);
+}
+
+
+}   // namespace bws
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // COMPRESSEDBITMAP_H_10293847561029384756102938475610293847561029
@@ -0,0 +1,952 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    PackedIntVector.h
+ * @brief   vector of unsigned integers of a fixed number of bits, packed densely into 64 bit regions
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef PACKEDINTVECTOR_H_56473829105647382910564738291056473829105647
+#define PACKEDINTVECTOR_H_56473829105647382910564738291056473829105647
+
+
+// includes
+#include <Bitwise/Bitwise.h>
+#include <Bitwise/details/PackedIntKernels.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+
+
+namespace bws {
+
+
+/// bit width of a PackedIntVector, which is chosen at runtime
+inline constexpr std::size_t runtimeBitWidth = 0ULL;
+
+
+/**
+ * @class  PackedIntProxy
+ * @brief  Reference to a single value of a PackedIntVector. Assigning a proxy to another one
+ *         copies the value, not the reference.
+ */
+template <typename Vector, bool IsConst>
+class PackedIntProxy {
+
+public:
+
+  // ---------------------------------------------------
+  // public types
+  using size_type      = std::size_t;
+  using value_type     = typename Vector::value_type;
+  using vector_pointer = std::conditional_t<IsConst, Vector const*, Vector*>;
+
+  // ---------------------------------------------------
+  // construction
+  constexpr PackedIntProxy (vector_pointer v, size_type i) noexcept : vector{v}, index{i} {}
+  PackedIntProxy           (PackedIntProxy const&) noexcept = default;
+
+  // ---------------------------------------------------
+  // access
+  operator value_type       () const noexcept { return vector->get(index); }
+  auto value                () const noexcept -> value_type { return vector->get(index); }
+  auto operator=            (PackedIntProxy const& rhs) noexcept -> PackedIntProxy&;
+  auto operator=            (value_type val) noexcept -> PackedIntProxy&;
+  auto operator+=           (value_type val) noexcept -> PackedIntProxy&;
+  auto operator-=           (value_type val) noexcept -> PackedIntProxy&;
+  auto operator++           () noexcept -> PackedIntProxy&;
+  auto operator--           () noexcept -> PackedIntProxy&;
+
+private:
+
+  // ---------------------------------------------------
+  // private data
+  vector_pointer vector;
+  size_type      index;
+};
+
+
+/**
+ * @class  PackedIntIterator
+ * @brief  Bidirectional iterator over the values of a PackedIntVector, dereferencing yields a
+ *         PackedIntProxy.
+ */
+template <typename Vector, bool IsConst>
+class PackedIntIterator {
+
+public:
+
+  // ---------------------------------------------------
+  // iterator properties
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type        = typename Vector::value_type;
+  using size_type         = std::size_t;
+  using difference_type   = std::ptrdiff_t;
+  using pointer           = void;
+  using reference         = PackedIntProxy<Vector, IsConst>;
+  using vector_pointer    = typename reference::vector_pointer;
+
+  // ---------------------------------------------------
+  // construction
+  PackedIntIterator () noexcept = default;
+  PackedIntIterator (vector_pointer v, size_type i) noexcept : vector{v}, index{i} {}
+
+  // ---------------------------------------------------
+  // access, increment and decrement
+  auto operator*  () const noexcept -> reference { return reference{vector, index}; }
+  auto operator++ () noexcept -> PackedIntIterator& { ++index; return *this; }
+  auto operator++ (int) noexcept -> PackedIntIterator { auto it = *this; ++index; return it; }
+  auto operator-- () noexcept -> PackedIntIterator& { --index; return *this; }
+  auto operator-- (int) noexcept -> PackedIntIterator { auto it = *this; --index; return it; }
+
+  friend auto operator== (PackedIntIterator const& it1, PackedIntIterator const& it2) noexcept -> bool
+  {
+    return it1.vector == it2.vector && it1.index == it2.index;
+  }
+  friend auto operator!= (PackedIntIterator const& it1, PackedIntIterator const& it2) noexcept -> bool
+  {
+    return !(it1 == it2);
+  }
+
+private:
+
+  // ---------------------------------------------------
+  // private data
+  vector_pointer vector {nullptr};
+  size_type      index  {};
+};
+
+
+/**
+ * @class  PackedIntVector
+ * @brief  Vector of unsigned integers of Bits bits each, stored back to back in 64 bit regions,
+ *         such that a value may straddle two regions. Values are masked to the bit width on
+ *         assignment. decode unpacks consecutive values into a buffer of std::uint32_t, blocks of
+ *         64 values are unpacked by the kernels of details/PackedIntKernels.h.
+ * @remark With Bits == runtimeBitWidth the width is passed to the constructor and may be changed
+ *         by setWidth, which repacks all values.
+ * @remark Bits beyond size() * width() are kept cleared.
+ * @tparam Bits the width of a value in [1, 32] or runtimeBitWidth.
+ */
+template <std::size_t Bits = runtimeBitWidth>
+class PackedIntVector {
+
+  static_assert(Bits <= 32ULL, "PackedIntVector supports widths of up to 32 bits");
+
+  // ---------------------------------------------------
+  // private types
+  using region  = std::uint64_t;
+  using dataPtr = std::unique_ptr<region[]>;
+
+  // ---------------------------------------------------
+  //  private constants
+  static constexpr std::size_t regionSize      = 64ULL;
+  static constexpr std::size_t maxWidth        = 32ULL;
+  static constexpr bool        hasRuntimeWidth = Bits == runtimeBitWidth;
+
+public:
+
+  // ---------------------------------------------------
+  // public types
+  using size_type       = std::size_t;
+  using value_type      = std::uint32_t;
+  using reference       = PackedIntProxy<PackedIntVector, false>;
+  using const_reference = PackedIntProxy<PackedIntVector, true>;
+  using iterator        = PackedIntIterator<PackedIntVector, false>;
+  using const_iterator  = PackedIntIterator<PackedIntVector, true>;
+
+  // ---------------------------------------------------
+  // public constants
+  static constexpr size_type bitWidth = Bits;
+
+  // ---------------------------------------------------
+  // ctor & dtor
+  PackedIntVector () = default;
+  template <std::size_t B = Bits, typename = std::enable_if_t<B != runtimeBitWidth>>
+  explicit PackedIntVector (size_type s, value_type val = value_type{});
+  template <std::size_t B = Bits, typename = std::enable_if_t<B == runtimeBitWidth>, typename = void>
+  PackedIntVector (size_type numBits, size_type s, value_type val = value_type{});
+  PackedIntVector (PackedIntVector const& src);
+  PackedIntVector (PackedIntVector&& src) noexcept;
+  auto operator=  (PackedIntVector src) noexcept -> PackedIntVector&;
+
+  // ---------------------------------------------------
+  // public api
+  [[nodiscard]] auto size     () const noexcept -> size_type;
+  [[nodiscard]] auto empty    () const noexcept -> bool;
+  [[nodiscard]] auto capacity () const noexcept -> size_type;
+  [[nodiscard]] auto width    () const noexcept -> size_type;
+  [[nodiscard]] auto maxValue () const noexcept -> value_type;
+  void swap                   (PackedIntVector&) noexcept;
+  void reserve                (size_type c);
+  void shrink_to_fit          ();
+  void resize                 (size_type size, value_type val = value_type{});
+  void assign                 (size_type size, value_type val);
+  void clear                  () noexcept;
+  auto operator[]             (size_type index) const -> const_reference;
+  auto operator[]             (size_type index) -> reference;
+  auto at                     (size_type index) const -> const_reference;
+  auto at                     (size_type index) -> reference;
+  void push_back              (value_type val);
+  void pop_back               () noexcept;
+  auto front                  () const -> const_reference;
+  auto front                  () -> reference;
+  auto back                   () const -> const_reference;
+  auto back                   () -> reference;
+  auto begin                  () noexcept -> iterator;
+  auto end                    () noexcept -> iterator;
+  auto begin                  () const noexcept -> const_iterator;
+  auto end                    () const noexcept -> const_iterator;
+  auto cbegin                 () const noexcept -> const_iterator;
+  auto cend                   () const noexcept -> const_iterator;
+
+  // ---------------------------------------------------
+  // packed access
+  [[nodiscard]] auto get      (size_type index) const noexcept -> value_type;
+  void set                    (size_type index, value_type val) noexcept;
+  void decode                 (size_type first, size_type count, value_type* out) const;
+  void decode                 (value_type* out) const noexcept;
+  template <std::size_t B = Bits, typename = std::enable_if_t<B == runtimeBitWidth>>
+  void setWidth               (size_type newWidth);
+
+  template <std::size_t B>
+  friend auto operator== (PackedIntVector<B> const& lhs, PackedIntVector<B> const& rhs) -> bool;
+
+private:
+
+  // ---------------------------------------------------
+  // private data
+  size_type currentSize     {};
+  size_type currentCapacity {};
+  size_type currentWidth    {hasRuntimeWidth ? maxWidth : Bits};
+  dataPtr   data;
+
+  // ---------------------------------------------------
+  // private methods
+  static void checkWidth  (size_type numBits);
+  auto numRegions         (size_type size) const noexcept -> size_type;
+  auto allocateMemory     (size_type numRegions) const -> dataPtr;
+  void performBoundsCheck (size_type index) const;
+  auto minCapacity        (size_type size) const noexcept -> size_type;
+  auto realloc            (size_type const c) -> bool;
+  void clearFrom          (size_type size) noexcept;
+  void fill               (size_type first, size_type last, value_type val) noexcept;
+  void unpackBlock        (size_type block, value_type* out) const noexcept;
+};
+
+
+/**
+ * @brief Assigns the value referred to by rhs.
+ */
+template <typename Vector, bool IsConst>
+inline auto PackedIntProxy<Vector, IsConst>::operator=(PackedIntProxy const& rhs) noexcept -> PackedIntProxy&
+{
+  return *this = rhs.value();
+}
+
+/**
+ * @brief Assigns val, masked to the bit width of the vector.
+ */
+template <typename Vector, bool IsConst>
+inline auto PackedIntProxy<Vector, IsConst>::operator=(value_type val) noexcept -> PackedIntProxy&
+{
+  static_assert(!IsConst, "a const PackedIntProxy can't be assigned");
+  vector->set(index, val);
+  return *this;
+}
+
+/**
+ * @brief Adds val, the result wraps around at the bit width of the vector.
+ */
+template <typename Vector, bool IsConst>
+inline auto PackedIntProxy<Vector, IsConst>::operator+=(value_type val) noexcept -> PackedIntProxy&
+{
+  return *this = value() + val;
+}
+
+/**
+ * @brief Subtracts val, the result wraps around at the bit width of the vector.
+ */
+template <typename Vector, bool IsConst>
+inline auto PackedIntProxy<Vector, IsConst>::operator-=(value_type val) noexcept -> PackedIntProxy&
+{
+  return *this = value() - val;
+}
+
+template <typename Vector, bool IsConst>
+inline auto PackedIntProxy<Vector, IsConst>::operator++() noexcept -> PackedIntProxy&
+{
+  return *this += 1U;
+}
+
+template <typename Vector, bool IsConst>
+inline auto PackedIntProxy<Vector, IsConst>::operator--() noexcept -> PackedIntProxy&
+{
+  return *this -= 1U;
+}
+
+
+/**
+ * @brief Constructor. Creates s values of val.
+ */
+template <std::size_t Bits>
+template <std::size_t B, typename>
+PackedIntVector<Bits>::PackedIntVector(size_type s, value_type val)
+  : currentSize     {s}
+  , currentCapacity {minCapacity(s)}
+  , data            {allocateMemory(numRegions(s))}
+{
+  fill(0ULL, s, val);
+}
+
+/**
+ * @brief Constructor. Creates s values of val of numBits bits each.
+ * @throw std::invalid_argument if numBits is not within [1, 32].
+ */
+template <std::size_t Bits>
+template <std::size_t B, typename, typename>
+PackedIntVector<Bits>::PackedIntVector(size_type numBits, size_type s, value_type val)
+  : currentWidth {(checkWidth(numBits), numBits)}
+{
+  currentCapacity = minCapacity(s);
+  data            = allocateMemory(numRegions(s));
+  currentSize     = s;
+  fill(0ULL, s, val);
+}
+
+/**
+ * @brief Copy constructor.
+ */
+template <std::size_t Bits>
+PackedIntVector<Bits>::PackedIntVector(PackedIntVector const& src)
+  : currentSize     {src.currentSize}
+  , currentCapacity {src.minCapacity(src.currentSize)}
+  , currentWidth    {src.currentWidth}
+  , data            {allocateMemory(src.numRegions(src.currentSize))}
+{
+  if(const auto n = numRegions(currentSize); n > 0ULL)
+  {
+    std::memcpy(data.get(), src.data.get(), n * sizeof(region));
+  }
+}
+
+/**
+ * @brief Move constructor.
+ */
+template <std::size_t Bits>
+PackedIntVector<Bits>::PackedIntVector(PackedIntVector&& src) noexcept
+{
+  swap(src);
+}
+
+/**
+ * @brief Assignment operator.
+ */
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::operator=(PackedIntVector src) noexcept -> PackedIntVector&
+{
+  swap(src);
+  return *this;
+}
+
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::size() const noexcept -> size_type
+{
+  return currentSize;
+}
+
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::empty() const noexcept -> bool
+{
+  return currentSize == 0ULL;
+}
+
+/**
+ * @brief Returns the number of values that fit into the allocated regions.
+ */
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::capacity() const noexcept -> size_type
+{
+  return currentCapacity;
+}
+
+/**
+ * @brief Returns the number of bits of a value.
+ */
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::width() const noexcept -> size_type
+{
+  if constexpr(hasRuntimeWidth)
+  {
+    return currentWidth;
+  }
+  else
+  {
+    return Bits;
+  }
+}
+
+/**
+ * @brief Returns the largest value that can be stored.
+ */
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::maxValue() const noexcept -> value_type
+{
+  return punchMask<value_type>(width());
+}
+
+template <std::size_t Bits>
+inline void PackedIntVector<Bits>::swap(PackedIntVector& src) noexcept
+{
+  std::swap(currentSize, src.currentSize);
+  std::swap(currentCapacity, src.currentCapacity);
+  std::swap(currentWidth, src.currentWidth);
+  data.swap(src.data);
+}
+
+/**
+ * @brief  Increase the capacity of the vector to a value that's greater or equal to newCapacity.
+ *         If newCapacity is greater than the current capacity(), new storage is allocated, otherwise the method does nothing.
+ * @remark If newCapacity is greater than capacity(), all iterators, including the past-the-end iterator,
+ *         and all references to the elements are invalidated. Otherwise, no iterators or references are invalidated.
+ */
+template <std::size_t Bits>
+inline void PackedIntVector<Bits>::reserve(size_type newCapacity)
+{
+  if(newCapacity > currentCapacity)
+  {
+    realloc(minCapacity(newCapacity));
+  }
+}
+
+/**
+ * @brief  Requests the removal of unused capacity.
+ * @remark If reallocation occurs, all iterators, including the past the end iterator,
+ *         and all references to the elements are invalidated.
+ */
+template <std::size_t Bits>
+inline void PackedIntVector<Bits>::shrink_to_fit()
+{
+  if(const auto newCapacity = minCapacity(currentSize); newCapacity < currentCapacity)
+  {
+    realloc(newCapacity);
+  }
+}
+
+/**
+ * @brief  Resizes the container to contain size values. The storage is sized from the bit width,
+ *         such that size * width() bits are allocated.
+ * @remark If the current size is greater than size, the container is reduced to its first size values.
+ *         If the current size is less than size, additional copies of val are appended.
+ */
+template <std::size_t Bits>
+void PackedIntVector<Bits>::resize(size_type size, value_type val)
+{
+  if(size < currentSize)
+  {
+    clearFrom(size);
+    currentSize = size;
+    shrink_to_fit();
+  }
+  else if(size > currentSize)
+  {
+    if(size > currentCapacity && !realloc(minCapacity(size)))
+    {
+      throw std::bad_alloc();
+    }
+
+    fill(currentSize, size, val);
+    currentSize = size;
+  }
+}
+
+/**
+ * @brief Replaces the content with size copies of val.
+ */
+template <std::size_t Bits>
+void PackedIntVector<Bits>::assign(size_type size, value_type val)
+{
+  if(size > currentCapacity)
+  {
+    data            = allocateMemory(numRegions(size));
+    currentCapacity = minCapacity(size);
+  }
+  else
+  {
+    clearFrom(0ULL);
+  }
+
+  currentSize = size;
+  fill(0ULL, size, val);
+}
+
+/**
+ * @brief Removes all values, the capacity is left unchanged.
+ */
+template <std::size_t Bits>
+inline void PackedIntVector<Bits>::clear() noexcept
+{
+  clearFrom(0ULL);
+  currentSize = 0ULL;
+}
+
+/**
+ * @brief  Accesses the value at a given position.
+ * @return returns a const /link #PackedIntProxy /endlink object providing
+ *         reading access to the underlying value.
+ */
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::operator[](size_type index) const -> const_reference
+{
+  return const_reference{this, index};
+}
+
+/**
+ * @brief  Accesses the value at a given position.
+ * @return returns a /link #PackedIntProxy /endlink object providing
+ *         writing access to the underlying value.
+ */
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::operator[](size_type index) -> reference
+{
+  return reference{this, index};
+}
+
+/**
+ * @brief  Accesses the value at a given position.
+ * @remark If index is not within the range of the container, an exception of type std::out_of_range is thrown.
+ * @throw  std::out_of_range
+ */
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::at(size_type index) const -> const_reference
+{
+  performBoundsCheck(index);
+  return (*this)[index];
+}
+
+/**
+ * @brief  Accesses the value at a given position.
+ * @remark If index is not within the range of the container, an exception of type std::out_of_range is thrown.
+ * @throw  std::out_of_range
+ */
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::at(size_type index) -> reference
+{
+  performBoundsCheck(index);
+  return (*this)[index];
+}
+
+/**
+ * @brief Appends a new value to the given container. The capacity grows geometrically.
+ */
+template <std::size_t Bits>
+void PackedIntVector<Bits>::push_back(value_type val)
+{
+  if(currentSize == currentCapacity && !realloc(minCapacity(std::max<size_type>(2ULL * currentCapacity, regionSize))))
+  {
+    throw std::bad_alloc();
+  }
+
+  set(currentSize, val);
+  ++currentSize;
+}
+
+/**
+ * @brief Removes the last element of the container.
+ */
+template <std::size_t Bits>
+inline void PackedIntVector<Bits>::pop_back() noexcept
+{
+  if(currentSize > 0ULL)
+  {
+    set(currentSize - 1ULL, value_type{});
+    --currentSize;
+  }
+}
+
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::front() const -> const_reference
+{
+  return (*this)[0ULL];
+}
+
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::front() -> reference
+{
+  return (*this)[0ULL];
+}
+
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::back() const -> const_reference
+{
+  return (*this)[currentSize - 1ULL];
+}
+
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::back() -> reference
+{
+  return (*this)[currentSize - 1ULL];
+}
+
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::begin() noexcept -> iterator
+{
+  return iterator{this, 0ULL};
+}
+
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::end() noexcept -> iterator
+{
+  return iterator{this, currentSize};
+}
+
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::begin() const noexcept -> const_iterator
+{
+  return const_iterator{this, 0ULL};
+}
+
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::end() const noexcept -> const_iterator
+{
+  return const_iterator{this, currentSize};
+}
+
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::cbegin() const noexcept -> const_iterator
+{
+  return begin();
+}
+
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::cend() const noexcept -> const_iterator
+{
+  return end();
+}
+
+/**
+ * @brief Returns the value at index, which is read from two regions if it straddles them.
+ */
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::get(size_type index) const noexcept -> value_type
+{
+  const auto w      = width();
+  const auto bit    = index * w;
+  const auto r      = bit / regionSize;
+  const auto offset = bit % regionSize;
+
+  auto val = data[r] >> offset;
+  if(offset + w > regionSize)
+  {
+    val |= data[r + 1ULL] << (regionSize - offset);
+  }
+
+  return static_cast<value_type>(val & punchMask<region>(w));
+}
+
+/**
+ * @brief Stores val, masked to the bit width, at index.
+ */
+template <std::size_t Bits>
+inline void PackedIntVector<Bits>::set(size_type index, value_type val) noexcept
+{
+  const auto w      = width();
+  const auto bit    = index * w;
+  const auto r      = bit / regionSize;
+  const auto offset = bit % regionSize;
+  const auto v      = static_cast<region>(val) & punchMask<region>(w);
+
+  data[r] = (data[r] & ~punchMask<region>(w, offset)) | (v << offset);
+  if(offset + w > regionSize)
+  {
+    const auto numHighBits = offset + w - regionSize;
+    data[r + 1ULL]         = (data[r + 1ULL] & ~punchMask<region>(numHighBits)) | (v >> (regionSize - offset));
+  }
+}
+
+/**
+ * @brief  Writes the count values starting at first to out. Values in front of the first and
+ *         behind the last complete block of 64 values are read one by one, the blocks in between
+ *         are unpacked at once.
+ * @throw  std::out_of_range if [first, first + count) is not within the range of the container.
+ */
+template <std::size_t Bits>
+void PackedIntVector<Bits>::decode(size_type first, size_type count, value_type* out) const
+{
+  if(first > currentSize || count > currentSize - first)
+  {
+    std::stringstream errMsg;
+    errMsg << "Error : range [which is [" << first << ", " << first + count << ")] exceeds size [which is " << currentSize << "]";
+    throw std::out_of_range(errMsg.str());
+  }
+
+  const auto last = first + count;
+  auto       i    = first;
+
+  for(; i < last && i % details::packedBlockSize != 0ULL; ++i)
+  {
+    *out++ = get(i);
+  }
+  for(; i + details::packedBlockSize <= last; i += details::packedBlockSize, out += details::packedBlockSize)
+  {
+    unpackBlock(i / details::packedBlockSize, out);
+  }
+  for(; i < last; ++i)
+  {
+    *out++ = get(i);
+  }
+}
+
+/**
+ * @brief Writes all values to out, which has to hold size() values.
+ */
+template <std::size_t Bits>
+inline void PackedIntVector<Bits>::decode(value_type* out) const noexcept
+{
+  const auto numBlocks = currentSize / details::packedBlockSize;
+  for(size_type block = 0ULL; block < numBlocks; ++block, out += details::packedBlockSize)
+  {
+    unpackBlock(block, out);
+  }
+  for(auto i = numBlocks * details::packedBlockSize; i < currentSize; ++i)
+  {
+    *out++ = get(i);
+  }
+}
+
+/**
+ * @brief  Changes the bit width and repacks all values. The vector is left unchanged, if an
+ *         exception is thrown.
+ * @throw  std::invalid_argument if newWidth is not within [1, 32] or a value exceeds the new width.
+ */
+template <std::size_t Bits>
+template <std::size_t B, typename>
+void PackedIntVector<Bits>::setWidth(size_type newWidth)
+{
+  if(newWidth == currentWidth)
+  {
+    return;
+  }
+
+  PackedIntVector repacked(newWidth, currentSize);
+  const auto      newMaxValue = repacked.maxValue();
+
+  std::array<value_type, 16ULL * details::packedBlockSize> buffer;
+  for(size_type first = 0ULL; first < currentSize; first += buffer.size())
+  {
+    const auto count = std::min<size_type>(buffer.size(), currentSize - first);
+    decode(first, count, buffer.data());
+
+    for(size_type k = 0ULL; k < count; ++k)
+    {
+      if(buffer[k] > newMaxValue)
+      {
+        std::stringstream errMsg;
+        errMsg << "Error : value [which is " << buffer[k] << "] at index [which is " << first + k
+               << "] exceeds bit width [which is " << newWidth << "]";
+        throw std::invalid_argument(errMsg.str());
+      }
+      repacked.set(first + k, buffer[k]);
+    }
+  }
+
+  swap(repacked);
+}
+
+/**
+ * @brief Throws an exception of type std::invalid_argument, if numBits is not within [1, 32].
+ * @throw std::invalid_argument
+ */
+template <std::size_t Bits>
+void PackedIntVector<Bits>::checkWidth(size_type numBits)
+{
+  if(numBits == 0ULL || numBits > maxWidth)
+  {
+    std::stringstream errMsg;
+    errMsg << "Error : bit width [which is " << numBits << "] not within [1, " << maxWidth << "]";
+    throw std::invalid_argument(errMsg.str());
+  }
+}
+
+/**
+ * @brief Returns the number of regions required to hold size values.
+ */
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::numRegions(size_type size) const noexcept -> size_type
+{
+  return (size * width() + regionSize - 1ULL) / regionSize;
+}
+
+/**
+ * @brief Allocates numRegions cleared regions.
+ */
+template <std::size_t Bits>
+auto PackedIntVector<Bits>::allocateMemory(size_type numRegions) const -> dataPtr
+{
+  return std::make_unique<region[]>(numRegions);
+}
+
+/**
+ * @brief Throws an exception of type std::out_of_range, if index is not within the range of the container.
+ * @throw std::out_of_range.
+ */
+template <std::size_t Bits>
+void PackedIntVector<Bits>::performBoundsCheck(size_type index) const
+{
+  if(index >= currentSize)
+  {
+    std::stringstream errMsg;
+    errMsg << "Error : index [which is " << index << "] >= size [which is " << currentSize << "]";
+    throw std::out_of_range(errMsg.str());
+  }
+}
+
+/**
+ * @brief Computes the number of values, that fit into the regions required to hold size values.
+ */
+template <std::size_t Bits>
+inline auto PackedIntVector<Bits>::minCapacity(size_type size) const noexcept -> size_type
+{
+  return numRegions(size) * regionSize / width();
+}
+
+/**
+ * @brief  Reallocates the regions holding the values.
+ * @remark newCapacity has to be a result of minCapacity. Regions beyond the copied ones are cleared.
+ */
+template <std::size_t Bits>
+auto PackedIntVector<Bits>::realloc(size_type const newCapacity) -> bool
+{
+  const auto newNumRegions = numRegions(newCapacity);
+  auto* const newStorage   = new(std::nothrow) region[newNumRegions]();
+  if(newStorage != nullptr)
+  {
+    if(data)
+    {
+      std::memcpy(newStorage, data.get(), std::min<size_type>(newNumRegions, numRegions(currentCapacity)) * sizeof(region));
+    }
+    data.reset(newStorage);
+    currentCapacity = newCapacity;
+
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * @brief Clears the bits of the values in [size, size()).
+ */
+template <std::size_t Bits>
+void PackedIntVector<Bits>::clearFrom(size_type size) noexcept
+{
+  const auto firstBit = size * width();
+  const auto lastBit  = currentSize * width();
+  if(firstBit >= lastBit)
+  {
+    return;
+  }
+
+  const auto firstRegion = firstBit / regionSize;
+  data[firstRegion] &= punchMask<region>(firstBit % regionSize);
+
+  const auto endRegion = (lastBit + regionSize - 1ULL) / regionSize;
+  if(endRegion > firstRegion + 1ULL)
+  {
+    std::memset(data.get() + firstRegion + 1ULL, 0, (endRegion - firstRegion - 1ULL) * sizeof(region));
+  }
+}
+
+/**
+ * @brief Stores val at the indices [first, last), which have to be cleared.
+ */
+template <std::size_t Bits>
+void PackedIntVector<Bits>::fill(size_type first, size_type last, value_type val) noexcept
+{
+  if((val & maxValue()) == value_type{})
+  {
+    return;
+  }
+
+  for(auto i = first; i < last; ++i)
+  {
+    set(i, val);
+  }
+}
+
+/**
+ * @brief Unpacks the 64 values of the given block, which occupy width() regions.
+ */
+template <std::size_t Bits>
+inline void PackedIntVector<Bits>::unpackBlock(size_type block, value_type* out) const noexcept
+{
+  const auto* const in = data.get() + block * width();
+  if constexpr(hasRuntimeWidth)
+  {
+    details::unpackBlockTable[currentWidth - 1ULL](in, out);
+  }
+  else
+  {
+    details::unpackBlock<Bits>(in, out);
+  }
+}
+
+/**
+ * @brief Compares the values of lhs and rhs, the bit widths of vectors of runtime width may differ.
+ */
+template <std::size_t B>
+auto operator==(PackedIntVector<B> const& lhs, PackedIntVector<B> const& rhs) -> bool
+{
+  if(lhs.size() != rhs.size())
+  {
+    return false;
+  }
+
+  if(lhs.width() == rhs.width())
+  {
+    // bits beyond size() * width() are cleared
+    const auto n = lhs.numRegions(lhs.size());
+    return n == 0ULL || std::memcmp(lhs.data.get(), rhs.data.get(), n * sizeof(std::uint64_t)) == 0;
+  }
+
+  for(std::size_t i = 0ULL; i < lhs.size(); ++i)
+  {
+    if(lhs.get(i) != rhs.get(i))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+template <std::size_t B>
+inline auto operator!=(PackedIntVector<B> const& lhs, PackedIntVector<B> const& rhs) -> bool
+{
+  return !(lhs == rhs);
+}
+
+
+}   // namespace bws
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // PACKEDINTVECTOR_H_56473829105647382910564738291056473829105647
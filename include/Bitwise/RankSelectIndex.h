@@ -0,0 +1,241 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    RankSelectIndex.h
+ * @brief   succinct rank and select index over a bws::BitVectorT
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef RANKSELECTINDEX_H_74650192837465019283746501928374650192837465
+#define RANKSELECTINDEX_H_74650192837465019283746501928374650192837465
+
+
+// includes
+#include <Bitwise/BitVector.h>
+#include <Bitwise/Bitwise.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+
+namespace bws {
+
+
+/**
+ * @class  RankSelectIndex
+ * @brief  Auxiliary index answering rank (number of bits set in front of a position) in constant
+ *         time and select (position of the k-th bit set) by two binary searches and a short scan.
+ *         It stores the number of bits set in front of every superblock of 65536 bits in 64 bit
+ *         and in front of every block of 512 bits relative to its superblock in 16 bit, which
+ *         adds about 3.2 % to the size of the vector.
+ * @remark The index refers to the vector, which has to outlive it. It doesn't observe the vector,
+ *         after a modification rebuild has to be called.
+ */
+template <typename IntType = std::uint8_t>
+class RankSelectIndex {
+
+public:
+
+  // ---------------------------------------------------
+  // public types and constants
+  using size_type   = std::size_t;
+  using bit_vector  = BitVectorT<IntType>;
+
+  static constexpr size_type npos                = bit_vector::npos;
+  static constexpr size_type wordSize            = 64ULL;
+  static constexpr size_type wordsPerBlock       = 8ULL;
+  static constexpr size_type blockSize           = wordSize * wordsPerBlock;
+  static constexpr size_type blocksPerSuperblock = 128ULL;
+  static constexpr size_type superblockSize      = blockSize * blocksPerSuperblock;
+
+  // ---------------------------------------------------
+  // construction
+  explicit RankSelectIndex (bit_vector const& bitVector);
+
+  // ---------------------------------------------------
+  // public api
+  void rebuild                 ();
+  [[nodiscard]] auto size      () const noexcept -> size_type;
+  [[nodiscard]] auto count     () const noexcept -> size_type;
+  [[nodiscard]] auto rank      (size_type pos) const -> size_type;
+  [[nodiscard]] auto select    (size_type k) const noexcept -> size_type;
+
+private:
+
+  // ---------------------------------------------------
+  // private data
+  bit_vector const*          bitVector;
+  size_type                  numBits    {};
+  size_type                  numBitsSet {};
+  std::vector<std::uint64_t> superblockRanks;
+  std::vector<std::uint16_t> blockRanks;
+
+  // ---------------------------------------------------
+  // private methods
+  auto selectInWord (std::uint64_t bits, size_type k) const noexcept -> size_type;
+};
+
+
+/**
+ * @brief Constructor. Builds the index for bitVector.
+ */
+template <typename IntType>
+RankSelectIndex<IntType>::RankSelectIndex(bit_vector const& bitVector)
+  : bitVector {&bitVector}
+{
+  rebuild();
+}
+
+/**
+ * @brief Rebuilds the index after a modification of the vector.
+ */
+template <typename IntType>
+void RankSelectIndex<IntType>::rebuild()
+{
+  numBits              = bitVector->size();
+  const auto numWords  = bitVector->numWords();
+  const auto numBlocks = numBits / blockSize + 1ULL;
+
+  // one entry more than necessary, such that rank(size()) needs no special treatment
+  superblockRanks.assign(numBits / superblockSize + 1ULL, 0ULL);
+  blockRanks.assign(numBlocks, std::uint16_t{});
+
+  size_type total = 0ULL;
+  for(size_type block = 0ULL; block < numBlocks; ++block)
+  {
+    const auto superblock = block / blocksPerSuperblock;
+    if(block % blocksPerSuperblock == 0ULL)
+    {
+      superblockRanks[superblock] = total;
+    }
+    blockRanks[block] = static_cast<std::uint16_t>(total - superblockRanks[superblock]);
+
+    const auto lastWord = std::min<size_type>((block + 1ULL) * wordsPerBlock, numWords);
+    for(auto w = block * wordsPerBlock; w < lastWord; ++w)
+    {
+      total += countBits(bitVector->word(w));
+    }
+  }
+
+  numBitsSet = total;
+}
+
+/**
+ * @brief Returns the size of the vector at the time the index was built.
+ */
+template <typename IntType>
+inline auto RankSelectIndex<IntType>::size() const noexcept -> size_type
+{
+  return numBits;
+}
+
+/**
+ * @brief Returns the number of bits set.
+ */
+template <typename IntType>
+inline auto RankSelectIndex<IntType>::count() const noexcept -> size_type
+{
+  return numBitsSet;
+}
+
+/**
+ * @brief  Returns the number of bits set in [0, pos).
+ * @throw  std::out_of_range if pos is greater than the size of the vector.
+ */
+template <typename IntType>
+auto RankSelectIndex<IntType>::rank(size_type pos) const -> size_type
+{
+  if(pos > numBits)
+  {
+    std::stringstream errMsg;
+    errMsg << "Error : position [which is " << pos << "] > size [which is " << numBits << "]";
+    throw std::out_of_range(errMsg.str());
+  }
+
+  const auto block  = pos / blockSize;
+  auto       result = static_cast<size_type>(superblockRanks[pos / superblockSize]) + blockRanks[block];
+
+  const auto wordIndex = pos / wordSize;
+  for(auto w = block * wordsPerBlock; w < wordIndex; ++w)
+  {
+    result += countBits(bitVector->word(w));
+  }
+  if(const auto numRemainingBits = pos % wordSize; numRemainingBits > 0ULL)
+  {
+    result += countBits(bitVector->word(wordIndex) & punchMask<std::uint64_t>(numRemainingBits));
+  }
+
+  return result;
+}
+
+/**
+ * @brief  Looks for the k-th bit set, counting from zero. The superblock and the block are found
+ *         by binary searches, the remaining at most eight words are scanned.
+ * @return its index or npos, if less than k + 1 bits are set.
+ */
+template <typename IntType>
+auto RankSelectIndex<IntType>::select(size_type k) const noexcept -> size_type
+{
+  if(k >= numBitsSet)
+  {
+    return npos;
+  }
+
+  // the last superblock and block in front of which at most k bits are set hold the bit
+  const auto superblock = static_cast<size_type>(
+    std::upper_bound(superblockRanks.begin(), superblockRanks.end(), k) - superblockRanks.begin() - 1);
+  auto remaining = k - static_cast<size_type>(superblockRanks[superblock]);
+
+  const auto firstBlock = blockRanks.begin() + static_cast<std::ptrdiff_t>(superblock * blocksPerSuperblock);
+  const auto lastBlock  = blockRanks.begin() + static_cast<std::ptrdiff_t>(
+    std::min<size_type>((superblock + 1ULL) * blocksPerSuperblock, blockRanks.size()));
+  const auto block = static_cast<size_type>(std::upper_bound(firstBlock, lastBlock, remaining) - blockRanks.begin() - 1);
+  remaining -= blockRanks[block];
+
+  for(auto w = block * wordsPerBlock;; ++w)
+  {
+    const auto bits = bitVector->word(w);
+    if(const auto n = countBits(bits); remaining < n)
+    {
+      return w * wordSize + selectInWord(bits, remaining);
+    }
+    else
+    {
+      remaining -= n;
+    }
+  }
+}
+
+/**
+ * @brief Returns the index of the k-th bit set within bits, which holds more than k bits.
+ */
+template <typename IntType>
+inline auto RankSelectIndex<IntType>::selectInWord(std::uint64_t bits, size_type k) const noexcept -> size_type
+{
+  for(; k > 0ULL; --k)
+  {
+    bits &= bits - 1ULL;
+  }
+
+  return firstBitSet(bits);
+}
+
+
+}   // namespace bws
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // RANKSELECTINDEX_H_74650192837465019283746501928374650192837465
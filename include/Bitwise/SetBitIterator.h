@@ -0,0 +1,196 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    SetBitIterator.h
+ * @brief   forward iterator over the indices of the bits set in a bit vector
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef SETBITITERATOR_H_61928374650192837465019283746501928374650192
+#define SETBITITERATOR_H_61928374650192837465019283746501928374650192
+
+
+// includes
+#include <Bitwise/Bitwise.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+
+namespace bws {
+
+
+/**
+ * @class  SetBitIterator
+ * @brief  Visits the indices of the bits set in ascending order. It holds the remaining bits of
+ *         the current 64 bit word and steps from one set bit to the next by counting trailing
+ *         zeros, words without any bit set are skipped by BitVector::findNext.
+ * @remark The iterator is invalidated by any modification of the vector.
+ * @tparam BitVector the bit vector, it provides size, findNext and word.
+ */
+template <typename BitVector>
+class SetBitIterator {
+
+  // ---------------------------------------------------
+  //  private constants
+  static constexpr std::size_t wordSize = 64ULL;
+
+public:
+
+  // ---------------------------------------------------
+  // iterator properties
+  using iterator_category = std::forward_iterator_tag;
+  using value_type        = std::size_t;
+  using size_type         = std::size_t;
+  using difference_type   = std::ptrdiff_t;
+  using pointer           = value_type const*;
+  using reference         = value_type;
+
+  // ---------------------------------------------------
+  // construction
+  SetBitIterator () noexcept = default;
+  SetBitIterator (BitVector const& bitVector, size_type firstSetBit) noexcept;
+
+  // ---------------------------------------------------
+  // access and increment
+  auto operator*  () const noexcept -> reference;
+  auto operator++ () noexcept -> SetBitIterator&;
+  auto operator++ (int) noexcept -> SetBitIterator;
+
+  template <typename B>
+  friend auto operator== (SetBitIterator<B> const& it1, SetBitIterator<B> const& it2) noexcept -> bool;
+  template <typename B>
+  friend auto operator!= (SetBitIterator<B> const& it1, SetBitIterator<B> const& it2) noexcept -> bool;
+
+private:
+
+  // ---------------------------------------------------
+  // private data
+  BitVector const* bitVector {nullptr};
+  size_type        wordIndex {BitVector::npos};
+  std::uint64_t    bits      {};
+
+  // ---------------------------------------------------
+  // private methods
+  void moveTo (size_type pos) noexcept;
+};
+
+
+/**
+ * @class  SetBitRange
+ * @brief  Range of the indices of the bits set in a bit vector, see BitVector::setBits.
+ */
+template <typename BitVector>
+class SetBitRange {
+
+public:
+
+  using iterator       = SetBitIterator<BitVector>;
+  using const_iterator = SetBitIterator<BitVector>;
+
+  explicit SetBitRange (BitVector const& bitVector) noexcept : bitVector{&bitVector} {}
+
+  auto begin () const noexcept -> iterator { return iterator{*bitVector, bitVector->findFirst()}; }
+  auto end   () const noexcept -> iterator { return iterator{}; }
+
+private:
+
+  BitVector const* bitVector;
+};
+
+
+/**
+ * @brief Constructor. Points to the bit firstSetBit, which must be set, or behaves like
+ *        the end iterator, if it is npos.
+ */
+template <typename BitVector>
+SetBitIterator<BitVector>::SetBitIterator(BitVector const& bitVector, size_type firstSetBit) noexcept
+  : bitVector {&bitVector}
+{
+  moveTo(firstSetBit);
+}
+
+/**
+ * @brief Returns the index of the current bit.
+ */
+template <typename BitVector>
+inline auto SetBitIterator<BitVector>::operator*() const noexcept -> reference
+{
+  return wordIndex * wordSize + firstBitSet(bits);
+}
+
+/**
+ * @brief  Moves to the next bit set (prefix version).
+ * @return a reference to the incremented iterator.
+ */
+template <typename BitVector>
+inline auto SetBitIterator<BitVector>::operator++() noexcept -> SetBitIterator&
+{
+  // clears the lowest bit set
+  bits &= bits - 1ULL;
+  if(bits == 0ULL)
+  {
+    moveTo(bitVector->findNext((wordIndex + 1ULL) * wordSize - 1ULL));
+  }
+
+  return *this;
+}
+
+/**
+ * @brief  Moves to the next bit set (postfix version).
+ * @return a copy of the iterator before the increment.
+ */
+template <typename BitVector>
+inline auto SetBitIterator<BitVector>::operator++(int) noexcept -> SetBitIterator
+{
+  auto it = *this;
+  ++*this;
+  return it;
+}
+
+/**
+ * @brief Loads the word holding pos and drops the bits in front of pos.
+ */
+template <typename BitVector>
+void SetBitIterator<BitVector>::moveTo(size_type pos) noexcept
+{
+  if(pos == BitVector::npos)
+  {
+    wordIndex = BitVector::npos;
+    bits      = 0ULL;
+  }
+  else
+  {
+    wordIndex = pos / wordSize;
+    bits      = bitVector->word(wordIndex) & ~punchMask<std::uint64_t>(pos % wordSize);
+  }
+}
+
+template <typename B>
+inline auto operator==(SetBitIterator<B> const& it1, SetBitIterator<B> const& it2) noexcept -> bool
+{
+  return it1.wordIndex == it2.wordIndex && it1.bits == it2.bits;
+}
+
+template <typename B>
+inline auto operator!=(SetBitIterator<B> const& it1, SetBitIterator<B> const& it2) noexcept -> bool
+{
+  return !(it1 == it2);
+}
+
+
+}   // namespace bws
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // SETBITITERATOR_H_61928374650192837465019283746501928374650192
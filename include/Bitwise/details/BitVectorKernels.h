@@ -0,0 +1,306 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    BitVectorKernels.h
+ * @brief   word-parallel loops over the raw storage of bit vectors. They process 64 bytes per step
+ *          with AVX-512, 32 bytes with AVX2 and 8 bytes otherwise. The instruction set is chosen at
+ *          compile time (/arch:AVX2, /arch:AVX512 or -mavx2, -mavx512f).
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef BITVECTORKERNELS_H_47382910564738291056473829105647382910564
+#define BITVECTORKERNELS_H_47382910564738291056473829105647382910564
+
+
+// includes
+#include <Bitwise/Bitwise.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__) && __has_include(<immintrin.h>)
+#  include <immintrin.h>
+#  define BWS_HAS_AVX2
+#  if defined(__AVX512F__)
+#    define BWS_HAS_AVX512
+#  endif
+#  if defined(__AVX512VPOPCNTDQ__)
+#    define BWS_HAS_AVX512_POPCNT
+#  endif
+#endif
+
+
+namespace bws::details {
+
+
+inline auto load64(unsigned char const* p) noexcept -> std::uint64_t
+{
+  std::uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline void store64(unsigned char* p, std::uint64_t v) noexcept
+{
+  std::memcpy(p, &v, sizeof(v));
+}
+
+
+/// dst &= src
+struct AndOp {
+  static auto apply(std::uint64_t a, std::uint64_t b) noexcept -> std::uint64_t { return a & b; }
+#if defined(BWS_HAS_AVX2)
+  static auto apply(__m256i a, __m256i b) noexcept -> __m256i { return _mm256_and_si256(a, b); }
+#endif
+#if defined(BWS_HAS_AVX512)
+  static auto apply(__m512i a, __m512i b) noexcept -> __m512i { return _mm512_and_si512(a, b); }
+#endif
+};
+
+/// dst |= src
+struct OrOp {
+  static auto apply(std::uint64_t a, std::uint64_t b) noexcept -> std::uint64_t { return a | b; }
+#if defined(BWS_HAS_AVX2)
+  static auto apply(__m256i a, __m256i b) noexcept -> __m256i { return _mm256_or_si256(a, b); }
+#endif
+#if defined(BWS_HAS_AVX512)
+  static auto apply(__m512i a, __m512i b) noexcept -> __m512i { return _mm512_or_si512(a, b); }
+#endif
+};
+
+/// dst ^= src
+struct XorOp {
+  static auto apply(std::uint64_t a, std::uint64_t b) noexcept -> std::uint64_t { return a ^ b; }
+#if defined(BWS_HAS_AVX2)
+  static auto apply(__m256i a, __m256i b) noexcept -> __m256i { return _mm256_xor_si256(a, b); }
+#endif
+#if defined(BWS_HAS_AVX512)
+  static auto apply(__m512i a, __m512i b) noexcept -> __m512i { return _mm512_xor_si512(a, b); }
+#endif
+};
+
+/// dst &= ~src
+struct AndNotOp {
+  static auto apply(std::uint64_t a, std::uint64_t b) noexcept -> std::uint64_t { return a & ~b; }
+#if defined(BWS_HAS_AVX2)
+  static auto apply(__m256i a, __m256i b) noexcept -> __m256i { return _mm256_andnot_si256(b, a); }
+#endif
+#if defined(BWS_HAS_AVX512)
+  static auto apply(__m512i a, __m512i b) noexcept -> __m512i { return _mm512_andnot_si512(b, a); }
+#endif
+};
+
+
+/**
+ * @brief  Combines the first n bytes of dst with those of src by means of Op.
+ * @tparam Op one of AndOp, OrOp, XorOp and AndNotOp.
+ */
+template <typename Op>
+inline void transformBytes(unsigned char* dst, unsigned char const* src, std::size_t n) noexcept
+{
+  std::size_t i = 0ULL;
+#if defined(BWS_HAS_AVX512)
+  for(; i + 64ULL <= n; i += 64ULL)
+  {
+    const auto a = _mm512_loadu_si512(dst + i);
+    const auto b = _mm512_loadu_si512(src + i);
+    _mm512_storeu_si512(dst + i, Op::apply(a, b));
+  }
+#endif
+#if defined(BWS_HAS_AVX2)
+  for(; i + 32ULL <= n; i += 32ULL)
+  {
+    const auto a = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(dst + i));
+    const auto b = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), Op::apply(a, b));
+  }
+#endif
+  for(; i + 8ULL <= n; i += 8ULL)
+  {
+    store64(dst + i, Op::apply(load64(dst + i), load64(src + i)));
+  }
+  for(; i < n; ++i)
+  {
+    dst[i] = static_cast<unsigned char>(Op::apply(dst[i], src[i]));
+  }
+}
+
+/**
+ * @brief Inverts the first n bytes of dst.
+ */
+inline void flipBytes(unsigned char* dst, std::size_t n) noexcept
+{
+  std::size_t i = 0ULL;
+#if defined(BWS_HAS_AVX512)
+  const auto ones512 = _mm512_set1_epi64(-1LL);
+  for(; i + 64ULL <= n; i += 64ULL)
+  {
+    _mm512_storeu_si512(dst + i, _mm512_xor_si512(_mm512_loadu_si512(dst + i), ones512));
+  }
+#endif
+#if defined(BWS_HAS_AVX2)
+  const auto ones256 = _mm256_set1_epi64x(-1LL);
+  for(; i + 32ULL <= n; i += 32ULL)
+  {
+    auto* const p = reinterpret_cast<__m256i*>(dst + i);
+    _mm256_storeu_si256(p, _mm256_xor_si256(_mm256_loadu_si256(p), ones256));
+  }
+#endif
+  for(; i + 8ULL <= n; i += 8ULL)
+  {
+    store64(dst + i, ~load64(dst + i));
+  }
+  for(; i < n; ++i)
+  {
+    dst[i] = static_cast<unsigned char>(~dst[i]);
+  }
+}
+
+/**
+ * @brief Checks if the first n bytes of lhs and rhs are equal.
+ */
+inline auto equalBytes(unsigned char const* lhs, unsigned char const* rhs, std::size_t n) noexcept -> bool
+{
+  std::size_t i = 0ULL;
+#if defined(BWS_HAS_AVX512)
+  for(; i + 64ULL <= n; i += 64ULL)
+  {
+    if(_mm512_cmpneq_epi64_mask(_mm512_loadu_si512(lhs + i), _mm512_loadu_si512(rhs + i)) != 0)
+    {
+      return false;
+    }
+  }
+#endif
+#if defined(BWS_HAS_AVX2)
+  for(; i + 32ULL <= n; i += 32ULL)
+  {
+    const auto a = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(lhs + i));
+    const auto b = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(rhs + i));
+    const auto x = _mm256_xor_si256(a, b);
+    if(!_mm256_testz_si256(x, x))
+    {
+      return false;
+    }
+  }
+#endif
+  for(; i + 8ULL <= n; i += 8ULL)
+  {
+    if(load64(lhs + i) != load64(rhs + i))
+    {
+      return false;
+    }
+  }
+  for(; i < n; ++i)
+  {
+    if(lhs[i] != rhs[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief  Counts the bits set in the first n bytes of src.
+ * @remark Without a native vector popcount, AVX2 counts the nibbles by a table lookup
+ *         and sums up the bytes with a sum of absolute differences (W. Mula).
+ */
+inline auto countBitsBytes(unsigned char const* src, std::size_t n) noexcept -> std::size_t
+{
+  std::size_t i     = 0ULL;
+  std::size_t count = 0ULL;
+#if defined(BWS_HAS_AVX512_POPCNT)
+  auto acc512 = _mm512_setzero_si512();
+  for(; i + 64ULL <= n; i += 64ULL)
+  {
+    acc512 = _mm512_add_epi64(acc512, _mm512_popcnt_epi64(_mm512_loadu_si512(src + i)));
+  }
+  count += static_cast<std::size_t>(_mm512_reduce_add_epi64(acc512));
+#endif
+#if defined(BWS_HAS_AVX2)
+  const auto lookup  = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const auto nibbles = _mm256_set1_epi8(0x0f);
+  auto acc256        = _mm256_setzero_si256();
+  for(; i + 32ULL <= n; i += 32ULL)
+  {
+    const auto v  = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + i));
+    const auto lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, nibbles));
+    const auto hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibbles));
+    acc256        = _mm256_add_epi64(acc256, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+  }
+  alignas(32) std::uint64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc256);
+  count += static_cast<std::size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+#endif
+  for(; i + 8ULL <= n; i += 8ULL)
+  {
+    count += countBits(load64(src + i));
+  }
+  for(; i < n; ++i)
+  {
+    count += countBits(src[i]);
+  }
+  return count;
+}
+
+/**
+ * @brief  Looks for the first byte that isn't zero among the first n bytes of src.
+ * @return the offset of the byte or n, if all bytes are zero.
+ */
+inline auto findNonZeroByte(unsigned char const* src, std::size_t n) noexcept -> std::size_t
+{
+  std::size_t i = 0ULL;
+#if defined(BWS_HAS_AVX512)
+  for(; i + 64ULL <= n; i += 64ULL)
+  {
+    const auto v = _mm512_loadu_si512(src + i);
+    if(_mm512_test_epi64_mask(v, v) != 0)
+    {
+      break;
+    }
+  }
+#endif
+#if defined(BWS_HAS_AVX2)
+  for(; i + 32ULL <= n; i += 32ULL)
+  {
+    const auto v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + i));
+    if(!_mm256_testz_si256(v, v))
+    {
+      break;
+    }
+  }
+#endif
+  for(; i + 8ULL <= n; i += 8ULL)
+  {
+    if(load64(src + i) != 0ULL)
+    {
+      break;
+    }
+  }
+  for(; i < n; ++i)
+  {
+    if(src[i] != 0U)
+    {
+      return i;
+    }
+  }
+  return n;
+}
+
+
+}   // namespace bws::details
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // BITVECTORKERNELS_H_47382910564738291056473829105647382910564
@@ -0,0 +1,885 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    BitmapContainers.h
+ * @brief   the containers of bws::CompressedBitmap. Each holds the bits of a chunk of 65536
+ *          positions as sorted array, as plain bitmap or as sorted runs, see CompressedBitmap.h.
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef BITMAPCONTAINERS_H_92837465019283746501928374650192837465019283
+#define BITMAPCONTAINERS_H_92837465019283746501928374650192837465019283
+
+
+// includes
+#include <Bitwise/Bitwise.h>
+#include <Bitwise/details/BitVectorKernels.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+
+namespace bws::details {
+
+
+inline constexpr std::size_t containerBits  = 65536ULL;
+inline constexpr std::size_t containerWords = containerBits / 64ULL;
+inline constexpr std::size_t bitmapBytes    = containerBits / 8ULL;
+
+/// an array container holds at most arrayLimit values, above that a bitmap is smaller
+inline constexpr std::size_t arrayLimit     = bitmapBytes / sizeof(std::uint16_t);
+
+
+/// sorted values without duplicates
+struct ArrayContainer {
+  std::vector<std::uint16_t> values;
+};
+
+/// one bit per position
+struct BitmapContainer {
+  BitmapContainer () : words(containerWords, 0ULL) {}
+
+  std::vector<std::uint64_t> words;
+  std::size_t                cardinality {};
+};
+
+/// the positions [start, last]
+struct Run {
+  std::uint16_t start;
+  std::uint16_t last;
+
+  auto operator== (Run const&) const -> bool = default;
+};
+
+/// sorted runs, which neither overlap nor touch each other
+struct RunContainer {
+  std::vector<Run> runs;
+};
+
+using Container = std::variant<ArrayContainer, BitmapContainer, RunContainer>;
+
+
+/// state of an iteration over the values of a container
+struct ContainerCursor {
+  std::size_t   index {};
+  std::uint64_t bits  {};
+  std::uint32_t value {};
+};
+
+
+// ---------------------------------------------------
+// bitmap helpers
+
+inline auto testBit(BitmapContainer const& b, std::uint32_t v) noexcept -> bool
+{
+  return (b.words[v / 64U] >> (v % 64U)) & 1ULL;
+}
+
+inline void setBit(BitmapContainer& b, std::uint32_t v) noexcept
+{
+  auto&      w   = b.words[v / 64U];
+  const auto old = w;
+  w |= 1ULL << (v % 64U);
+  b.cardinality += static_cast<std::size_t>(w != old);
+}
+
+inline void clearBit(BitmapContainer& b, std::uint32_t v) noexcept
+{
+  auto&      w   = b.words[v / 64U];
+  const auto old = w;
+  w &= ~(1ULL << (v % 64U));
+  b.cardinality -= static_cast<std::size_t>(w != old);
+}
+
+inline void flipBit(BitmapContainer& b, std::uint32_t v) noexcept
+{
+  auto& w = b.words[v / 64U];
+  w ^= 1ULL << (v % 64U);
+  if((w >> (v % 64U)) & 1ULL)
+  {
+    ++b.cardinality;
+  }
+  else
+  {
+    --b.cardinality;
+  }
+}
+
+/**
+ * @brief Sets the positions [first, last] word by word.
+ */
+inline void setRange(BitmapContainer& b, std::uint32_t first, std::uint32_t last) noexcept
+{
+  const auto firstWord = first / 64U;
+  const auto lastWord  = last / 64U;
+  if(firstWord == lastWord)
+  {
+    b.words[firstWord] |= punchMask<std::uint64_t>(last - first + 1U, first % 64U);
+    return;
+  }
+
+  b.words[firstWord] |= ~std::uint64_t{} << (first % 64U);
+  std::fill(b.words.begin() + firstWord + 1U, b.words.begin() + lastWord, ~std::uint64_t{});
+  b.words[lastWord] |= punchMask<std::uint64_t>(last % 64U + 1U);
+}
+
+inline void recount(BitmapContainer& b) noexcept
+{
+  b.cardinality = countBitsBytes(reinterpret_cast<unsigned char const*>(b.words.data()), bitmapBytes);
+}
+
+/**
+ * @brief Returns the number of runs in b, that is the number of bits set whose predecessor is clear.
+ */
+inline auto countRuns(BitmapContainer const& b) noexcept -> std::size_t
+{
+  std::size_t   numRuns = 0ULL;
+  std::uint64_t carry   = 0ULL;
+  for(const auto w : b.words)
+  {
+    numRuns += countBits(w & ~((w << 1U) | carry));
+    carry = w >> 63U;
+  }
+  return numRuns;
+}
+
+inline auto countRuns(ArrayContainer const& a) noexcept -> std::size_t
+{
+  std::size_t numRuns = 0ULL;
+  for(std::size_t i = 0ULL; i < a.values.size(); ++i)
+  {
+    numRuns += static_cast<std::size_t>(i == 0ULL || a.values[i] != a.values[i - 1ULL] + 1U);
+  }
+  return numRuns;
+}
+
+
+// ---------------------------------------------------
+// queries
+
+inline auto cardinality(Container const& c) noexcept -> std::size_t
+{
+  if(const auto* a = std::get_if<ArrayContainer>(&c))
+  {
+    return a->values.size();
+  }
+  else if(const auto* b = std::get_if<BitmapContainer>(&c))
+  {
+    return b->cardinality;
+  }
+  else
+  {
+    std::size_t n = 0ULL;
+    for(const auto& run : std::get<RunContainer>(c).runs)
+    {
+      n += static_cast<std::size_t>(run.last - run.start) + 1ULL;
+    }
+    return n;
+  }
+}
+
+/**
+ * @brief Returns the position of the first run, which starts behind v.
+ */
+inline auto upperRun(RunContainer const& r, std::uint32_t v) noexcept -> std::vector<Run>::const_iterator
+{
+  return std::upper_bound(r.runs.begin(), r.runs.end(), v, [](std::uint32_t x, Run const& run) { return x < run.start; });
+}
+
+inline auto contains(Container const& c, std::uint16_t v) noexcept -> bool
+{
+  if(const auto* a = std::get_if<ArrayContainer>(&c))
+  {
+    return std::binary_search(a->values.begin(), a->values.end(), v);
+  }
+  else if(const auto* b = std::get_if<BitmapContainer>(&c))
+  {
+    return testBit(*b, v);
+  }
+  else
+  {
+    const auto& r  = std::get<RunContainer>(c);
+    const auto  it = upperRun(r, v);
+    return it != r.runs.begin() && v <= std::prev(it)->last;
+  }
+}
+
+inline auto minimum(Container const& c) noexcept -> std::uint32_t
+{
+  if(const auto* a = std::get_if<ArrayContainer>(&c))
+  {
+    return a->values.front();
+  }
+  else if(const auto* b = std::get_if<BitmapContainer>(&c))
+  {
+    const auto it = std::find_if(b->words.begin(), b->words.end(), [](std::uint64_t w) { return w != 0ULL; });
+    return static_cast<std::uint32_t>((it - b->words.begin()) * 64 + static_cast<std::ptrdiff_t>(firstBitSet(*it)));
+  }
+  else
+  {
+    return std::get<RunContainer>(c).runs.front().start;
+  }
+}
+
+inline auto maximum(Container const& c) noexcept -> std::uint32_t
+{
+  if(const auto* a = std::get_if<ArrayContainer>(&c))
+  {
+    return a->values.back();
+  }
+  else if(const auto* b = std::get_if<BitmapContainer>(&c))
+  {
+    const auto it = std::find_if(b->words.rbegin(), b->words.rend(), [](std::uint64_t w) { return w != 0ULL; });
+    return static_cast<std::uint32_t>((b->words.rend() - it - 1) * 64 + static_cast<std::ptrdiff_t>(lastBitSet(*it)));
+  }
+  else
+  {
+    return std::get<RunContainer>(c).runs.back().last;
+  }
+}
+
+/**
+ * @brief Returns the number of bytes of the payload of c.
+ */
+inline auto sizeInBytes(Container const& c) noexcept -> std::size_t
+{
+  if(const auto* a = std::get_if<ArrayContainer>(&c))
+  {
+    return a->values.capacity() * sizeof(std::uint16_t);
+  }
+  else if(std::holds_alternative<BitmapContainer>(c))
+  {
+    return bitmapBytes;
+  }
+  else
+  {
+    return std::get<RunContainer>(c).runs.capacity() * sizeof(Run);
+  }
+}
+
+
+// ---------------------------------------------------
+// iteration
+
+/**
+ * @brief Calls func with every value of c in ascending order.
+ */
+template <typename Func>
+void forEachValue(Container const& c, Func&& func)
+{
+  if(const auto* a = std::get_if<ArrayContainer>(&c))
+  {
+    for(const auto v : a->values)
+    {
+      func(static_cast<std::uint32_t>(v));
+    }
+  }
+  else if(const auto* b = std::get_if<BitmapContainer>(&c))
+  {
+    for(std::uint32_t i = 0U; i < containerWords; ++i)
+    {
+      for(auto w = b->words[i]; w != 0ULL; w &= w - 1ULL)
+      {
+        func(i * 64U + static_cast<std::uint32_t>(firstBitSet(w)));
+      }
+    }
+  }
+  else
+  {
+    for(const auto& run : std::get<RunContainer>(c).runs)
+    {
+      for(std::uint32_t v = run.start; v <= run.last; ++v)
+      {
+        func(v);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Moves the cursor to the first value of c, which mustn't be empty.
+ */
+inline void firstValue(Container const& c, ContainerCursor& cursor) noexcept
+{
+  cursor.index = 0ULL;
+  if(const auto* a = std::get_if<ArrayContainer>(&c))
+  {
+    cursor.value = a->values.front();
+  }
+  else if(const auto* b = std::get_if<BitmapContainer>(&c))
+  {
+    while(b->words[cursor.index] == 0ULL)
+    {
+      ++cursor.index;
+    }
+    cursor.bits  = b->words[cursor.index];
+    cursor.value = static_cast<std::uint32_t>(cursor.index * 64ULL + firstBitSet(cursor.bits));
+  }
+  else
+  {
+    cursor.value = std::get<RunContainer>(c).runs.front().start;
+  }
+}
+
+/**
+ * @brief  Moves the cursor to the next value of c.
+ * @return false, if there is none.
+ */
+inline auto nextValue(Container const& c, ContainerCursor& cursor) noexcept -> bool
+{
+  if(const auto* a = std::get_if<ArrayContainer>(&c))
+  {
+    if(++cursor.index == a->values.size())
+    {
+      return false;
+    }
+    cursor.value = a->values[cursor.index];
+  }
+  else if(const auto* b = std::get_if<BitmapContainer>(&c))
+  {
+    cursor.bits &= cursor.bits - 1ULL;
+    while(cursor.bits == 0ULL)
+    {
+      if(++cursor.index == containerWords)
+      {
+        return false;
+      }
+      cursor.bits = b->words[cursor.index];
+    }
+    cursor.value = static_cast<std::uint32_t>(cursor.index * 64ULL + firstBitSet(cursor.bits));
+  }
+  else
+  {
+    const auto& runs = std::get<RunContainer>(c).runs;
+    if(cursor.value < runs[cursor.index].last)
+    {
+      ++cursor.value;
+    }
+    else if(++cursor.index == runs.size())
+    {
+      return false;
+    }
+    else
+    {
+      cursor.value = runs[cursor.index].start;
+    }
+  }
+
+  return true;
+}
+
+
+// ---------------------------------------------------
+// conversions
+
+inline auto toBitmap(Container const& c) -> BitmapContainer
+{
+  if(const auto* b = std::get_if<BitmapContainer>(&c))
+  {
+    return *b;
+  }
+
+  BitmapContainer result;
+  if(const auto* a = std::get_if<ArrayContainer>(&c))
+  {
+    for(const auto v : a->values)
+    {
+      result.words[v / 64U] |= 1ULL << (v % 64U);
+    }
+  }
+  else
+  {
+    for(const auto& run : std::get<RunContainer>(c).runs)
+    {
+      setRange(result, run.start, run.last);
+    }
+  }
+  result.cardinality = cardinality(c);
+
+  return result;
+}
+
+inline auto toArray(Container const& c) -> ArrayContainer
+{
+  if(const auto* a = std::get_if<ArrayContainer>(&c))
+  {
+    return *a;
+  }
+
+  ArrayContainer result;
+  result.values.reserve(cardinality(c));
+  forEachValue(c, [&result](std::uint32_t v) { result.values.push_back(static_cast<std::uint16_t>(v)); });
+
+  return result;
+}
+
+inline auto toRuns(Container const& c) -> RunContainer
+{
+  if(const auto* r = std::get_if<RunContainer>(&c))
+  {
+    return *r;
+  }
+
+  RunContainer result;
+  forEachValue(c, [&result](std::uint32_t v) {
+    if(!result.runs.empty() && result.runs.back().last + 1U == v)
+    {
+      result.runs.back().last = static_cast<std::uint16_t>(v);
+    }
+    else
+    {
+      result.runs.push_back(Run{static_cast<std::uint16_t>(v), static_cast<std::uint16_t>(v)});
+    }
+  });
+
+  return result;
+}
+
+/**
+ * @brief Returns an array container if c holds at most arrayLimit values, a bitmap container otherwise.
+ */
+inline auto toArrayOrBitmap(Container const& c) -> Container
+{
+  if(cardinality(c) <= arrayLimit)
+  {
+    return toArray(c);
+  }
+  else
+  {
+    return toBitmap(c);
+  }
+}
+
+inline auto normalize(ArrayContainer&& a) -> Container
+{
+  if(a.values.size() <= arrayLimit)
+  {
+    return std::move(a);
+  }
+  else
+  {
+    return toBitmap(Container{std::move(a)});
+  }
+}
+
+inline auto normalize(BitmapContainer&& b) -> Container
+{
+  if(b.cardinality <= arrayLimit)
+  {
+    return toArray(Container{std::move(b)});
+  }
+  else
+  {
+    return std::move(b);
+  }
+}
+
+/**
+ * @brief Converts c to the smallest of the three representations and releases unused capacity.
+ *        Runs are chosen only if they are strictly smaller.
+ */
+inline void optimize(Container& c)
+{
+  const auto card    = cardinality(c);
+  const auto numRuns = std::holds_alternative<RunContainer>(c)    ? std::get<RunContainer>(c).runs.size()
+                     : std::holds_alternative<BitmapContainer>(c) ? countRuns(std::get<BitmapContainer>(c))
+                                                                  : countRuns(std::get<ArrayContainer>(c));
+
+  const auto runBytes   = numRuns * sizeof(Run);
+  const auto otherBytes = card <= arrayLimit ? card * sizeof(std::uint16_t) : bitmapBytes;
+  if(runBytes < otherBytes)
+  {
+    if(!std::holds_alternative<RunContainer>(c))
+    {
+      c = toRuns(c);
+    }
+  }
+  else if(card <= arrayLimit)
+  {
+    if(!std::holds_alternative<ArrayContainer>(c))
+    {
+      c = toArray(c);
+    }
+  }
+  else if(!std::holds_alternative<BitmapContainer>(c))
+  {
+    c = toBitmap(c);
+  }
+
+  if(auto* a = std::get_if<ArrayContainer>(&c))
+  {
+    a->values.shrink_to_fit();
+  }
+  else if(auto* r = std::get_if<RunContainer>(&c))
+  {
+    r->runs.shrink_to_fit();
+  }
+}
+
+
+// ---------------------------------------------------
+// modification
+
+/**
+ * @brief  Adds v to c. An array container exceeding arrayLimit becomes a bitmap container.
+ * @return true, if v wasn't contained before.
+ */
+inline auto add(Container& c, std::uint16_t v) -> bool
+{
+  if(auto* a = std::get_if<ArrayContainer>(&c))
+  {
+    const auto it = std::lower_bound(a->values.begin(), a->values.end(), v);
+    if(it != a->values.end() && *it == v)
+    {
+      return false;
+    }
+    if(a->values.size() < arrayLimit)
+    {
+      a->values.insert(it, v);
+      return true;
+    }
+    c = toBitmap(c);
+  }
+
+  if(auto* b = std::get_if<BitmapContainer>(&c))
+  {
+    const auto card = b->cardinality;
+    setBit(*b, v);
+    return b->cardinality != card;
+  }
+
+  auto&      runs = std::get<RunContainer>(c).runs;
+  const auto next = runs.begin() + (upperRun(std::get<RunContainer>(c), v) - runs.cbegin());
+  const auto prev = next == runs.begin() ? runs.end() : std::prev(next);
+  if(prev != runs.end() && v <= prev->last)
+  {
+    return false;
+  }
+
+  const bool joinsPrev = prev != runs.end() && prev->last + 1U == v;
+  const bool joinsNext = next != runs.end() && v + 1U == next->start;
+  if(joinsPrev && joinsNext)
+  {
+    prev->last = next->last;
+    runs.erase(next);
+  }
+  else if(joinsPrev)
+  {
+    prev->last = v;
+  }
+  else if(joinsNext)
+  {
+    next->start = v;
+  }
+  else
+  {
+    runs.insert(next, Run{v, v});
+  }
+  return true;
+}
+
+/**
+ * @brief  Removes v from c. A bitmap container dropping to arrayLimit values becomes an array container.
+ * @return true, if v was contained before.
+ */
+inline auto remove(Container& c, std::uint16_t v) -> bool
+{
+  if(auto* a = std::get_if<ArrayContainer>(&c))
+  {
+    const auto it = std::lower_bound(a->values.begin(), a->values.end(), v);
+    if(it == a->values.end() || *it != v)
+    {
+      return false;
+    }
+    a->values.erase(it);
+    return true;
+  }
+  else if(auto* b = std::get_if<BitmapContainer>(&c))
+  {
+    const auto card = b->cardinality;
+    clearBit(*b, v);
+    if(b->cardinality <= arrayLimit)
+    {
+      c = toArray(c);
+    }
+    return cardinality(c) != card;
+  }
+
+  auto&      runs = std::get<RunContainer>(c).runs;
+  const auto next = runs.begin() + (upperRun(std::get<RunContainer>(c), v) - runs.cbegin());
+  if(next == runs.begin() || v > std::prev(next)->last)
+  {
+    return false;
+  }
+
+  const auto run = std::prev(next);
+  if(run->start == run->last)
+  {
+    runs.erase(run);
+  }
+  else if(v == run->start)
+  {
+    ++run->start;
+  }
+  else if(v == run->last)
+  {
+    --run->last;
+  }
+  else
+  {
+    const Run upper{static_cast<std::uint16_t>(v + 1U), run->last};
+    run->last = static_cast<std::uint16_t>(v - 1U);
+    runs.insert(next, upper);
+  }
+  return true;
+}
+
+
+// ---------------------------------------------------
+// set operations
+
+template <typename Op>
+inline constexpr bool isCommutative = !std::is_same_v<Op, AndNotOp>;
+
+template <typename Op>
+auto combineArrays(ArrayContainer const& a, ArrayContainer const& b) -> Container
+{
+  ArrayContainer result;
+  auto           out = std::back_inserter(result.values);
+  if constexpr(std::is_same_v<Op, AndOp>)
+  {
+    result.values.reserve(std::min(a.values.size(), b.values.size()));
+    std::set_intersection(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), out);
+  }
+  else if constexpr(std::is_same_v<Op, OrOp>)
+  {
+    result.values.reserve(a.values.size() + b.values.size());
+    std::set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), out);
+  }
+  else if constexpr(std::is_same_v<Op, XorOp>)
+  {
+    result.values.reserve(a.values.size() + b.values.size());
+    std::set_symmetric_difference(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), out);
+  }
+  else
+  {
+    result.values.reserve(a.values.size());
+    std::set_difference(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), out);
+  }
+
+  return normalize(std::move(result));
+}
+
+template <typename Op>
+auto combineBitmaps(BitmapContainer const& a, BitmapContainer const& b) -> Container
+{
+  auto result = a;
+  transformBytes<Op>(reinterpret_cast<unsigned char*>(result.words.data()),
+                     reinterpret_cast<unsigned char const*>(b.words.data()), bitmapBytes);
+  recount(result);
+
+  return normalize(std::move(result));
+}
+
+/// filters the values of a by their bit in b
+template <bool Keep>
+auto filterArray(ArrayContainer const& a, BitmapContainer const& b) -> Container
+{
+  ArrayContainer result;
+  result.values.reserve(a.values.size());
+  std::copy_if(a.values.begin(), a.values.end(), std::back_inserter(result.values),
+               [&b](std::uint16_t v) { return testBit(b, v) == Keep; });
+  return result;
+}
+
+template <typename Op>
+auto combineArrayBitmap(ArrayContainer const& a, BitmapContainer const& b) -> Container
+{
+  if constexpr(std::is_same_v<Op, AndOp>)
+  {
+    return filterArray<true>(a, b);
+  }
+  else if constexpr(std::is_same_v<Op, AndNotOp>)
+  {
+    return filterArray<false>(a, b);
+  }
+  else
+  {
+    auto result = b;
+    for(const auto v : a.values)
+    {
+      if constexpr(std::is_same_v<Op, OrOp>)
+      {
+        setBit(result, v);
+      }
+      else
+      {
+        flipBit(result, v);
+      }
+    }
+    return normalize(std::move(result));
+  }
+}
+
+/// b andnot a, the other operations are commutative
+inline auto bitmapAndNotArray(BitmapContainer const& b, ArrayContainer const& a) -> Container
+{
+  auto result = b;
+  for(const auto v : a.values)
+  {
+    clearBit(result, v);
+  }
+  return normalize(std::move(result));
+}
+
+inline auto orRuns(RunContainer const& a, RunContainer const& b) -> Container
+{
+  RunContainer result;
+  result.runs.reserve(a.runs.size() + b.runs.size());
+
+  auto i = a.runs.begin();
+  auto j = b.runs.begin();
+  while(i != a.runs.end() || j != b.runs.end())
+  {
+    const auto& next = (j == b.runs.end() || (i != a.runs.end() && i->start < j->start)) ? *i++ : *j++;
+    if(!result.runs.empty() && next.start <= result.runs.back().last + 1U)
+    {
+      result.runs.back().last = std::max(result.runs.back().last, next.last);
+    }
+    else
+    {
+      result.runs.push_back(next);
+    }
+  }
+  return result;
+}
+
+inline auto andRuns(RunContainer const& a, RunContainer const& b) -> Container
+{
+  RunContainer result;
+
+  auto i = a.runs.begin();
+  auto j = b.runs.begin();
+  while(i != a.runs.end() && j != b.runs.end())
+  {
+    const auto start = std::max(i->start, j->start);
+    const auto last  = std::min(i->last, j->last);
+    if(start <= last)
+    {
+      result.runs.push_back(Run{start, last});
+    }
+    if(i->last < j->last)
+    {
+      ++i;
+    }
+    else
+    {
+      ++j;
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief  Combines two containers by means of Op. Run containers are combined directly by AND
+ *         and OR, for the other operations they are expanded to an array or a bitmap first.
+ * @tparam Op one of AndOp, OrOp, XorOp and AndNotOp.
+ * @return the result, which may be empty.
+ */
+template <typename Op>
+auto combine(Container const& a, Container const& b) -> Container
+{
+  const auto* runsA = std::get_if<RunContainer>(&a);
+  const auto* runsB = std::get_if<RunContainer>(&b);
+  if(runsA && runsB)
+  {
+    if constexpr(std::is_same_v<Op, AndOp>)
+    {
+      return andRuns(*runsA, *runsB);
+    }
+    else if constexpr(std::is_same_v<Op, OrOp>)
+    {
+      return orRuns(*runsA, *runsB);
+    }
+  }
+  if(runsA)
+  {
+    return combine<Op>(toArrayOrBitmap(a), b);
+  }
+  if(runsB)
+  {
+    return combine<Op>(a, toArrayOrBitmap(b));
+  }
+
+  const auto* arrayA = std::get_if<ArrayContainer>(&a);
+  const auto* arrayB = std::get_if<ArrayContainer>(&b);
+  if(arrayA && arrayB)
+  {
+    return combineArrays<Op>(*arrayA, *arrayB);
+  }
+  else if(arrayA)
+  {
+    return combineArrayBitmap<Op>(*arrayA, std::get<BitmapContainer>(b));
+  }
+  else if(arrayB)
+  {
+    if constexpr(isCommutative<Op>)
+    {
+      return combineArrayBitmap<Op>(*arrayB, std::get<BitmapContainer>(a));
+    }
+    else
+    {
+      return bitmapAndNotArray(std::get<BitmapContainer>(a), *arrayB);
+    }
+  }
+  else
+  {
+    return combineBitmaps<Op>(std::get<BitmapContainer>(a), std::get<BitmapContainer>(b));
+  }
+}
+
+/**
+ * @brief Compares the values of two containers, regardless of their representations.
+ */
+inline auto equal(Container const& a, Container const& b) -> bool
+{
+  if(a.index() == b.index())
+  {
+    if(const auto* arrayA = std::get_if<ArrayContainer>(&a))
+    {
+      return arrayA->values == std::get<ArrayContainer>(b).values;
+    }
+    else if(const auto* bitmapA = std::get_if<BitmapContainer>(&a))
+    {
+      return bitmapA->words == std::get<BitmapContainer>(b).words;
+    }
+    else
+    {
+      return std::get<RunContainer>(a).runs == std::get<RunContainer>(b).runs;
+    }
+  }
+
+  return cardinality(a) == cardinality(b) && toBitmap(a).words == toBitmap(b).words;
+}
+
+
+}   // namespace bws::details
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // BITMAPCONTAINERS_H_92837465019283746501928374650192837465019283
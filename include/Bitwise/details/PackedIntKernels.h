@@ -0,0 +1,88 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    PackedIntKernels.h
+ * @brief   bulk unpacking of bit packed integers. A block of 64 values of Bits bits each
+ *          occupies exactly Bits 64 bit words, so all word indices and shifts within a block
+ *          are known at compile time.
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef PACKEDINTKERNELS_H_29384756102938475610293847561029384756102938
+#define PACKEDINTKERNELS_H_29384756102938475610293847561029384756102938
+
+
+// includes
+#include <Bitwise/Bitwise.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+
+namespace bws::details {
+
+
+inline constexpr std::size_t packedBlockSize = 64ULL;
+
+/**
+ * @brief Extracts the value K of a block of values of Bits bits.
+ */
+template <std::size_t Bits, std::size_t K>
+inline auto extractPacked(std::uint64_t const* in) noexcept -> std::uint32_t
+{
+  constexpr std::size_t   bit    = K * Bits;
+  constexpr std::size_t   region = bit / 64ULL;
+  constexpr std::size_t   offset = bit % 64ULL;
+  constexpr std::uint64_t mask   = punchMask<std::uint64_t>(Bits);
+
+  if constexpr(offset + Bits <= 64ULL)
+  {
+    return static_cast<std::uint32_t>((in[region] >> offset) & mask);
+  }
+  else
+  {
+    return static_cast<std::uint32_t>(((in[region] >> offset) | (in[region + 1ULL] << (64ULL - offset))) & mask);
+  }
+}
+
+/**
+ * @brief  Decodes the 64 values packed into in[0, Bits) to out[0, 64).
+ * @remark The block is fully unrolled with constant shifts and masks, which leaves the compiler
+ *         free to vectorize it.
+ */
+template <std::size_t Bits>
+inline void unpackBlock(std::uint64_t const* in, std::uint32_t* out) noexcept
+{
+  [&]<std::size_t... K>(std::index_sequence<K...>) {
+    ((out[K] = extractPacked<Bits, K>(in)), ...);
+  }(std::make_index_sequence<packedBlockSize>{});
+}
+
+using UnpackBlockFunction = void (*)(std::uint64_t const*, std::uint32_t*) noexcept;
+
+template <std::size_t... I>
+constexpr auto makeUnpackBlockTable(std::index_sequence<I...>) noexcept -> std::array<UnpackBlockFunction, sizeof...(I)>
+{
+  return {&unpackBlock<I + 1ULL>...};
+}
+
+/// unpackBlock for the widths 1 to 32 chosen at runtime, the kernel of width w is found at w - 1
+inline constexpr auto unpackBlockTable = makeUnpackBlockTable(std::make_index_sequence<32ULL>{});
+
+
+}   // namespace bws::details
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // PACKEDINTKERNELS_H_29384756102938475610293847561029384756102938
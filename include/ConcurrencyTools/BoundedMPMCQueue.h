@@ -0,0 +1,616 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   BoundedMPMCQueue.h
+ * @brief  implementation of a lock-free bounded multi-producer multi-consumer queue
+ *         based on Vyukov's bounded MPMC queue
+ * @see    https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ *
+ * @author Lasse Rosenthal
+ * @date   16.10.2026
+ */
+
+#ifndef BOUNDEDMPMCQUEUE_H_27364510928374651029384756102938475610293
+#define BOUNDEDMPMCQUEUE_H_27364510928374651029384756102938475610293
+
+
+// includes
+#include "WaitStrategy.h"
+#include "detail/CacheLine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+
+namespace cctools {
+
+
+/**
+ * @class BoundedMPMCQueue
+ * @brief BoundedMPMCQueue is a fixed capacity ring buffer that allows for lock-free access
+ *        by an arbitrary number of producer and consumer threads. Every slot carries a sequence
+ *        number that tells producers and consumers whether the slot may be written or read.
+ *        The blocking methods fall back to a condition variable, which is only touched
+ *        if a thread actually has to wait.
+ * @remark The capacity is rounded up to the next power of two, but is at least two since
+ *         the sequence numbers of a single slot cannot distinguish a full from an empty queue.
+ */
+template <typename T>
+class BoundedMPMCQueue {
+
+  // ---------------------------------------------------
+  // internal types
+  using mutex      = std::mutex;
+  using lock       = std::lock_guard<mutex>;
+  using uniqueLock = std::unique_lock<mutex>;
+
+  struct Cell {
+    std::atomic<std::size_t> sequence;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+public:
+
+  // ---------------------------------------------------
+  // public types
+  using value_type      = T;
+  using size_type       = std::size_t;
+  using reference       = value_type&;
+  using const_reference = value_type const&;
+
+  // ---------------------------------------------------
+  // constructors & assignments
+  explicit BoundedMPMCQueue (size_type capacity = 1024ULL);
+  BoundedMPMCQueue          (BoundedMPMCQueue const&) = delete;
+  BoundedMPMCQueue          (BoundedMPMCQueue&&) = delete;
+  auto operator=            (BoundedMPMCQueue const&) -> BoundedMPMCQueue& = delete;
+  auto operator=            (BoundedMPMCQueue&&) -> BoundedMPMCQueue& = delete;
+  ~BoundedMPMCQueue         ();
+
+  // ---------------------------------------------------
+  // methods
+  auto empty      () const -> bool;
+  auto size       () const -> size_type;
+  auto capacity   () const noexcept -> size_type;
+  auto waitStrategy    () const noexcept -> WaitStrategy;
+  void setWaitStrategy (WaitStrategy strategy) noexcept;
+  void push       (value_type const& value);
+  void push       (value_type&& value);
+  auto tryPush    (value_type const& value) -> bool;
+  auto tryPush    (value_type&& value) -> bool;
+  template <typename Rep, typename Period>
+  auto tryPushFor (value_type const& value, std::chrono::duration<Rep, Period> const& timeOut) -> bool;
+  template <typename Rep, typename Period>
+  auto tryPushFor (value_type&& value, std::chrono::duration<Rep, Period> const& timeOut) -> bool;
+  void waitAndPop     (value_type& value);
+  template <typename OutputIt>
+  auto waitAndPopBulk (OutputIt out, size_type maxNumElements) -> size_type;
+  auto tryPop         (value_type& value) -> bool;
+  template <typename OutputIt>
+  auto tryPopBulk     (OutputIt out, size_type maxNumElements) -> size_type;
+  template <typename Rep, typename Period>
+  auto tryPopFor  (value_type& value, std::chrono::duration<Rep, Period> const& timeOut) -> bool;
+  void stopQueue  ();
+
+private:
+
+  // ---------------------------------------------------
+  // members
+  size_type                                       mask;
+  std::unique_ptr<Cell[]>                         cells;
+  alignas(detail::cacheLineSize) std::atomic<size_type> enqueuePos {0ULL};
+  alignas(detail::cacheLineSize) std::atomic<size_type> dequeuePos {0ULL};
+  alignas(detail::cacheLineSize) std::atomic<bool>      isActive {true};
+  std::atomic<size_type>                          numWaitingConsumers {0ULL};
+  std::atomic<size_type>                          numWaitingProducers {0ULL};
+  std::atomic<WaitStrategy>                       consumerWaitStrategy {WaitStrategy::blocking()};
+  mutex                                           waitMutex;
+  std::condition_variable                         dataCondVar;
+  std::condition_variable                         capacityCondVar;
+
+  // ---------------------------------------------------
+  // auxiliary methods
+  template <typename U>
+  auto tryPushImpl    (U&& value) -> bool;
+  template <typename U>
+  void pushImpl       (U&& value);
+  template <typename U, typename Rep, typename Period>
+  auto tryPushForImpl (U&& value, std::chrono::duration<Rep, Period> const& timeOut) -> bool;
+  auto hasData        () const -> bool;
+  auto hasSpace       () const -> bool;
+  void notifyConsumer ();
+  void notifyProducer ();
+};
+
+
+/**
+ * @brief Constructor. Allocates the ring buffer.
+ * @throw std::invalid_argument if the given capacity is zero.
+ */
+template <typename T>
+BoundedMPMCQueue<T>::BoundedMPMCQueue(size_type capacity)
+  : mask {detail::nextPowerOfTwo((std::max)(capacity, size_type{2ULL})) - 1ULL}
+{
+  if(capacity == 0ULL)
+  {
+    throw std::invalid_argument("capacity of a bounded queue must not be zero");
+  }
+
+  cells = std::make_unique<Cell[]>(mask + 1ULL);
+  for(size_type i = 0ULL; i <= mask; ++i)
+  {
+    cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * @brief Destructor. Deactivates the queue and destroys the remaining elements.
+ */
+template <typename T>
+BoundedMPMCQueue<T>::~BoundedMPMCQueue()
+{
+  stopQueue();
+
+  const auto last = enqueuePos.load(std::memory_order_acquire);
+  for(auto pos = dequeuePos.load(std::memory_order_acquire); pos != last; ++pos)
+  {
+    auto& cell = cells[pos & mask];
+    if(cell.sequence.load(std::memory_order_acquire) == pos + 1ULL)
+    {
+      std::launder(reinterpret_cast<value_type*>(cell.storage))->~value_type();
+    }
+  }
+}
+
+/**
+ * @brief checks whether the queue is empty. The result is only a snapshot.
+ */
+template <typename T>
+inline auto BoundedMPMCQueue<T>::empty() const -> bool
+{
+  return !hasData();
+}
+
+/**
+ * @brief returns the (approximate) number of elements.
+ */
+template <typename T>
+inline auto BoundedMPMCQueue<T>::size() const -> size_type
+{
+  const auto head = dequeuePos.load(std::memory_order_acquire);
+  const auto tail = enqueuePos.load(std::memory_order_acquire);
+  return tail > head ? tail - head : 0ULL;
+}
+
+/**
+ * @brief returns the capacity of the queue.
+ */
+template <typename T>
+inline auto BoundedMPMCQueue<T>::capacity() const noexcept -> size_type
+{
+  return mask + 1ULL;
+}
+
+/**
+ * @brief Returns the strategy of consumers waiting for data.
+ */
+template <typename T>
+inline auto BoundedMPMCQueue<T>::waitStrategy() const noexcept -> WaitStrategy
+{
+  return consumerWaitStrategy.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Sets the strategy of consumers waiting for data. Spinning consumers poll the ring
+ *        buffer directly before they block on the condition variable.
+ */
+template <typename T>
+inline void BoundedMPMCQueue<T>::setWaitStrategy(WaitStrategy strategy) noexcept
+{
+  consumerWaitStrategy.store(strategy, std::memory_order_relaxed);
+}
+
+/**
+ * @brief  Copies another element into the queue.
+ * @remark Blocks the calling thread until there is space or the queue is stopped.
+ */
+template <typename T>
+inline void BoundedMPMCQueue<T>::push(value_type const& value)
+{
+  pushImpl(value);
+}
+
+/**
+ * @brief  Moves another element into the queue.
+ * @remark Blocks the calling thread until there is space or the queue is stopped.
+ */
+template <typename T>
+inline void BoundedMPMCQueue<T>::push(value_type&& value)
+{
+  pushImpl(std::move(value));
+}
+
+/**
+ * @brief Attempts to copy another element into the queue. Returns false immediately
+ *        if the queue is full.
+ */
+template <typename T>
+inline auto BoundedMPMCQueue<T>::tryPush(value_type const& value) -> bool
+{
+  return tryPushImpl(value);
+}
+
+/**
+ * @brief Attempts to move another element into the queue. Returns false immediately
+ *        if the queue is full. In this case, value is left untouched.
+ */
+template <typename T>
+inline auto BoundedMPMCQueue<T>::tryPush(value_type&& value) -> bool
+{
+  return tryPushImpl(std::move(value));
+}
+
+/**
+ * @brief Attempts to copy a new element into the queue. Blocks until the specified time out
+ *        has elapsed or there is space in the queue.
+ */
+template <typename T>
+template <typename Rep, typename Period>
+inline auto BoundedMPMCQueue<T>::tryPushFor(value_type const& value,
+                                            std::chrono::duration<Rep, Period> const& timeOut) -> bool
+{
+  return tryPushForImpl(value, timeOut);
+}
+
+/**
+ * @brief Attempts to move a new element into the queue. Blocks until the specified time out
+ *        has elapsed or there is space in the queue.
+ */
+template <typename T>
+template <typename Rep, typename Period>
+inline auto BoundedMPMCQueue<T>::tryPushFor(value_type&& value,
+                                            std::chrono::duration<Rep, Period> const& timeOut) -> bool
+{
+  return tryPushForImpl(std::move(value), timeOut);
+}
+
+/**
+ * @brief blocks the calling thread until the queue is not empty
+ *        and moves the element at the front of the queue into the passed value.
+ *        Returns without touching value if the queue is stopped.
+ */
+template <typename T>
+void BoundedMPMCQueue<T>::waitAndPop(value_type& value)
+{
+  const auto strategy = consumerWaitStrategy.load(std::memory_order_relaxed);
+  while(isActive)
+  {
+    if(spinUntil(strategy, [this, &value] { return tryPop(value); }))
+    {
+      return;
+    }
+
+    // ------- begin critical section ------- //
+    uniqueLock lk(waitMutex);
+    ++numWaitingConsumers;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    dataCondVar.wait(lk, [this] { return hasData() || !isActive; });
+    --numWaitingConsumers;
+  }
+}
+
+/**
+ * @brief  blocks the calling thread until the queue is not empty and moves up to maxNumElements
+ *         elements into the given output iterator.
+ * @return The number of elements that have been popped. Zero, if the queue has been stopped.
+ */
+template <typename T>
+template <typename OutputIt>
+auto BoundedMPMCQueue<T>::waitAndPopBulk(OutputIt out, size_type maxNumElements) -> size_type
+{
+  const auto strategy = consumerWaitStrategy.load(std::memory_order_relaxed);
+  while(isActive && maxNumElements > 0ULL)
+  {
+    size_type numPoppedElements{};
+    if(spinUntil(strategy, [&] { return (numPoppedElements = tryPopBulk(out, maxNumElements)) > 0ULL; }))
+    {
+      return numPoppedElements;
+    }
+
+    // ------- begin critical section ------- //
+    uniqueLock lk(waitMutex);
+    ++numWaitingConsumers;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    dataCondVar.wait(lk, [this] { return hasData() || !isActive; });
+    --numWaitingConsumers;
+  }
+
+  return 0ULL;
+}
+
+/**
+ * @brief  Moves up to maxNumElements elements into the given output iterator without blocking.
+ * @return The number of elements that have been popped.
+ */
+template <typename T>
+template <typename OutputIt>
+auto BoundedMPMCQueue<T>::tryPopBulk(OutputIt out, size_type maxNumElements) -> size_type
+{
+  size_type  numPoppedElements{};
+  value_type value;
+  for(; numPoppedElements < maxNumElements && tryPop(value); ++numPoppedElements)
+  {
+    *out = std::move(value);
+    ++out;
+  }
+
+  return numPoppedElements;
+}
+
+/**
+ * @brief if the the queue is not empty, the first element at the front of the queue
+ *        is moved into the passed value and the method returns true.
+ *        If the queue is empty, the method returns false immediately.
+ */
+template <typename T>
+auto BoundedMPMCQueue<T>::tryPop(value_type& value) -> bool
+{
+  Cell* cell = nullptr;
+  auto  pos  = dequeuePos.load(std::memory_order_relaxed);
+  for(;;)
+  {
+    cell = &cells[pos & mask];
+    const auto seq  = cell->sequence.load(std::memory_order_acquire);
+    const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1ULL);
+    if(diff == 0)
+    {
+      if(dequeuePos.compare_exchange_weak(pos, pos + 1ULL, std::memory_order_relaxed))
+      {
+        break;
+      }
+    }
+    else if(diff < 0)
+    {
+      return false;
+    }
+    else
+    {
+      pos = dequeuePos.load(std::memory_order_relaxed);
+    }
+  }
+
+  auto* const elem = std::launder(reinterpret_cast<value_type*>(cell->storage));
+  value = std::move(*elem);
+  elem->~value_type();
+  cell->sequence.store(pos + mask + 1ULL, std::memory_order_release);
+
+  notifyProducer();
+  return true;
+}
+
+/**
+ * @brief Attempts to pop an element from the queue. Blocks until the specified time out
+ *        has elapsed or an element is available. Returns true if an element has been moved
+ *        into value.
+ */
+template <typename T>
+template <typename Rep, typename Period>
+auto BoundedMPMCQueue<T>::tryPopFor(value_type& value,
+                                    std::chrono::duration<Rep, Period> const& timeOut) -> bool
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeOut;
+  while(isActive)
+  {
+    if(tryPop(value))
+    {
+      return true;
+    }
+
+    // ------- begin critical section ------- //
+    uniqueLock lk(waitMutex);
+    ++numWaitingConsumers;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const bool ready = dataCondVar.wait_until(lk, deadline, [this] { return hasData() || !isActive; });
+    --numWaitingConsumers;
+    if(!ready)
+    {
+      return false;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * @brief stops all threads that might block on pop or push methods.
+ */
+template <typename T>
+void BoundedMPMCQueue<T>::stopQueue()
+{
+  isActive = false;
+  { lock lk(waitMutex); }
+  dataCondVar.notify_all();
+  capacityCondVar.notify_all();
+}
+
+/**
+ * @brief Claims a free slot and constructs the new element in it.
+ */
+template <typename T>
+template <typename U>
+auto BoundedMPMCQueue<T>::tryPushImpl(U&& value) -> bool
+{
+  Cell* cell = nullptr;
+  auto  pos  = enqueuePos.load(std::memory_order_relaxed);
+  for(;;)
+  {
+    cell = &cells[pos & mask];
+    const auto seq  = cell->sequence.load(std::memory_order_acquire);
+    const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+    if(diff == 0)
+    {
+      if(enqueuePos.compare_exchange_weak(pos, pos + 1ULL, std::memory_order_relaxed))
+      {
+        break;
+      }
+    }
+    else if(diff < 0)
+    {
+      return false;
+    }
+    else
+    {
+      pos = enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+
+  ::new(static_cast<void*>(cell->storage)) value_type(std::forward<U>(value));
+  cell->sequence.store(pos + 1ULL, std::memory_order_release);
+
+  notifyConsumer();
+  return true;
+}
+
+/**
+ * @brief Pushes a new element, blocking until there is space or the queue is stopped.
+ */
+template <typename T>
+template <typename U>
+void BoundedMPMCQueue<T>::pushImpl(U&& value)
+{
+  while(isActive)
+  {
+    if(tryPushImpl(std::forward<U>(value)))
+    {
+      return;
+    }
+
+    // ------- begin critical section ------- //
+    uniqueLock lk(waitMutex);
+    ++numWaitingProducers;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    capacityCondVar.wait(lk, [this] { return hasSpace() || !isActive; });
+    --numWaitingProducers;
+  }
+}
+
+/**
+ * @brief Pushes a new element, blocking until there is space, the time out has elapsed
+ *        or the queue is stopped.
+ */
+template <typename T>
+template <typename U, typename Rep, typename Period>
+auto BoundedMPMCQueue<T>::tryPushForImpl(U&& value, std::chrono::duration<Rep, Period> const& timeOut) -> bool
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeOut;
+  while(isActive)
+  {
+    if(tryPushImpl(std::forward<U>(value)))
+    {
+      return true;
+    }
+
+    // ------- begin critical section ------- //
+    uniqueLock lk(waitMutex);
+    ++numWaitingProducers;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const bool ready = capacityCondVar.wait_until(lk, deadline, [this] { return hasSpace() || !isActive; });
+    --numWaitingProducers;
+    if(!ready)
+    {
+      return false;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * @brief checks whether the slot at the current read position holds an element.
+ */
+template <typename T>
+auto BoundedMPMCQueue<T>::hasData() const -> bool
+{
+  for(;;)
+  {
+    const auto pos  = dequeuePos.load(std::memory_order_acquire);
+    const auto seq  = cells[pos & mask].sequence.load(std::memory_order_acquire);
+    const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1ULL);
+    if(diff <= 0)
+    {
+      return diff == 0;
+    }
+    // the element has been consumed concurrently, retry at the new read position.
+  }
+}
+
+/**
+ * @brief checks whether the slot at the current write position is free.
+ */
+template <typename T>
+auto BoundedMPMCQueue<T>::hasSpace() const -> bool
+{
+  for(;;)
+  {
+    const auto pos  = enqueuePos.load(std::memory_order_acquire);
+    const auto seq  = cells[pos & mask].sequence.load(std::memory_order_acquire);
+    const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+    if(diff <= 0)
+    {
+      return diff == 0;
+    }
+    // the slot has been claimed concurrently, retry at the new write position.
+  }
+}
+
+/**
+ * @brief Wakes up a waiting consumer if there is one.
+ * @remark The fence pairs with the fence in the waiting methods: either the waiting
+ *         thread observes the new element or this thread observes the waiting thread.
+ */
+template <typename T>
+inline void BoundedMPMCQueue<T>::notifyConsumer()
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if(numWaitingConsumers.load(std::memory_order_relaxed) > 0ULL)
+  {
+    { lock lk(waitMutex); }
+    dataCondVar.notify_one();
+  }
+}
+
+/**
+ * @brief Wakes up a waiting producer if there is one.
+ */
+template <typename T>
+inline void BoundedMPMCQueue<T>::notifyProducer()
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if(numWaitingProducers.load(std::memory_order_relaxed) > 0ULL)
+  {
+    { lock lk(waitMutex); }
+    capacityCondVar.notify_one();
+  }
+}
+
+
+}   // namespace cctools
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif   // BOUNDEDMPMCQUEUE_H_27364510928374651029384756102938475610293
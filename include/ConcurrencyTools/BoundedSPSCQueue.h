@@ -0,0 +1,725 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   BoundedSPSCQueue.h
+ * @brief  implementation of a lock-free bounded single-producer single-consumer queue,
+ *         the channel between two stages of a pipeline.
+ *
+ * @author Lasse Rosenthal
+ * @date   16.10.2026
+ */
+
+#ifndef BOUNDEDSPSCQUEUE_H_61928374650192837465019283746501928374650192
+#define BOUNDEDSPSCQUEUE_H_61928374650192837465019283746501928374650192
+
+
+// includes
+#include "WaitStrategy.h"
+#include "detail/CacheLine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+
+namespace cctools {
+
+
+/**
+ * @class  BoundedSPSCQueue
+ * @brief  BoundedSPSCQueue is a fixed capacity ring buffer connecting exactly one producer thread
+ *         with exactly one consumer thread. The producer only writes the tail index and the consumer
+ *         only writes the head index, so neither side needs a read-modify-write operation. Every side
+ *         keeps a cached copy of the index of the other side and only reloads it if the cached value
+ *         indicates a full or an empty queue (or too little room for a batch), which keeps the cache line
+ *         of the other side mostly untouched.
+ * @remark Batches are pushed and popped with a single update of the index. writeSpan/commitWrite and
+ *         readSpan/commitRead give direct access to the contiguous free or filled slots of the ring buffer.
+ * @remark The blocking methods fall back to a condition variable, which is only touched if a thread
+ *         actually has to wait. Consumers spin according to the wait strategy before.
+ * @remark The slots hold constructed elements, thus T must be default constructible and move assignable.
+ *         A popped element remains in its slot in moved-from state until the slot is written again.
+ * @remark The producer methods (push*, tryPush*, writeSpan, commitWrite) must only be called by the producer
+ *         thread, the consumer methods (*Pop*, readSpan, commitRead) only by the consumer thread.
+ */
+template <typename T>
+class BoundedSPSCQueue {
+
+  // ---------------------------------------------------
+  // internal types
+  using mutex      = std::mutex;
+  using lock       = std::lock_guard<mutex>;
+  using uniqueLock = std::unique_lock<mutex>;
+
+public:
+
+  // ---------------------------------------------------
+  // public types
+  using value_type      = T;
+  using size_type       = std::size_t;
+  using reference       = value_type&;
+  using const_reference = value_type const&;
+
+  // ---------------------------------------------------
+  // constructors & assignments
+  explicit BoundedSPSCQueue (size_type capacity = 1024ULL);
+  BoundedSPSCQueue          (BoundedSPSCQueue const&) = delete;
+  BoundedSPSCQueue          (BoundedSPSCQueue&&) = delete;
+  auto operator=            (BoundedSPSCQueue const&) -> BoundedSPSCQueue& = delete;
+  auto operator=            (BoundedSPSCQueue&&) -> BoundedSPSCQueue& = delete;
+  ~BoundedSPSCQueue         ();
+
+  // ---------------------------------------------------
+  // methods
+  auto empty           () const -> bool;
+  auto size            () const -> size_type;
+  auto capacity        () const noexcept -> size_type;
+  auto waitStrategy    () const noexcept -> WaitStrategy;
+  void setWaitStrategy (WaitStrategy strategy) noexcept;
+
+  // producer
+  void push        (value_type const& value);
+  void push        (value_type&& value);
+  auto tryPush     (value_type const& value) -> bool;
+  auto tryPush     (value_type&& value) -> bool;
+  template <typename Rep, typename Period>
+  auto tryPushFor  (value_type const& value, std::chrono::duration<Rep, Period> const& timeOut) -> bool;
+  template <typename Rep, typename Period>
+  auto tryPushFor  (value_type&& value, std::chrono::duration<Rep, Period> const& timeOut) -> bool;
+  template <typename InputIt>
+  auto tryPushBulk (InputIt first, InputIt last) -> size_type;
+  template <typename InputIt>
+  auto pushBulk    (InputIt first, InputIt last) -> size_type;
+  template <typename Range>
+  auto pushBulk    (Range&& range) -> size_type;
+  auto writeSpan   () -> std::span<value_type>;
+  void commitWrite (size_type numElements);
+
+  // consumer
+  void waitAndPop     (value_type& value);
+  template <typename OutputIt>
+  auto waitAndPopBulk (OutputIt out, size_type maxNumElements) -> size_type;
+  auto tryPop         (value_type& value) -> bool;
+  template <typename OutputIt>
+  auto tryPopBulk     (OutputIt out, size_type maxNumElements) -> size_type;
+  template <typename Rep, typename Period>
+  auto tryPopFor      (value_type& value, std::chrono::duration<Rep, Period> const& timeOut) -> bool;
+  auto readSpan       () -> std::span<value_type>;
+  void commitRead     (size_type numElements);
+
+  void stopQueue ();
+
+private:
+
+  // ---------------------------------------------------
+  // members
+  size_type                                             mask;
+  std::unique_ptr<value_type[]>                         slots;
+  alignas(detail::cacheLineSize) std::atomic<size_type> tail {0ULL};   // written by the producer
+  size_type                                             cachedHead {0ULL};
+  alignas(detail::cacheLineSize) std::atomic<size_type> head {0ULL};   // written by the consumer
+  size_type                                             cachedTail {0ULL};
+  alignas(detail::cacheLineSize) std::atomic<bool>      isActive {true};
+  std::atomic<size_type>                                numWaitingConsumers {0ULL};
+  std::atomic<size_type>                                numWaitingProducers {0ULL};
+  std::atomic<WaitStrategy>                             consumerWaitStrategy {WaitStrategy::blocking()};
+  mutex                                                 waitMutex;
+  std::condition_variable                               dataCondVar;
+  std::condition_variable                               capacityCondVar;
+
+  // ---------------------------------------------------
+  // auxiliary methods
+  template <typename U>
+  auto tryPushImpl    (U&& value) -> bool;
+  template <typename U>
+  void pushImpl       (U&& value);
+  template <typename U, typename Rep, typename Period>
+  auto tryPushForImpl (U&& value, std::chrono::duration<Rep, Period> const& timeOut) -> bool;
+  auto freeSlots      (size_type wanted = 1ULL) -> size_type;
+  auto filledSlots    (size_type wanted = 1ULL) -> size_type;
+  auto hasData        () const -> bool;
+  auto hasSpace       () const -> bool;
+  void waitForData    ();
+  void waitForSpace   ();
+  void notifyConsumer ();
+  void notifyProducer ();
+};
+
+
+/**
+ * @brief Constructor. Allocates the ring buffer. The capacity is rounded up to the next power of two.
+ * @throw std::invalid_argument if the given capacity is zero.
+ */
+template <typename T>
+BoundedSPSCQueue<T>::BoundedSPSCQueue(size_type capacity)
+  : mask {detail::nextPowerOfTwo(capacity) - 1ULL}
+{
+  if(capacity == 0ULL)
+  {
+    throw std::invalid_argument("capacity of a bounded queue must not be zero");
+  }
+
+  slots = std::make_unique<value_type[]>(mask + 1ULL);
+}
+
+/**
+ * @brief Destructor. Deactivates the queue.
+ */
+template <typename T>
+BoundedSPSCQueue<T>::~BoundedSPSCQueue()
+{
+  stopQueue();
+}
+
+/**
+ * @brief checks whether the queue is empty. The result is only a snapshot.
+ */
+template <typename T>
+inline auto BoundedSPSCQueue<T>::empty() const -> bool
+{
+  return !hasData();
+}
+
+/**
+ * @brief returns the (approximate) number of elements.
+ */
+template <typename T>
+inline auto BoundedSPSCQueue<T>::size() const -> size_type
+{
+  const auto first = head.load(std::memory_order_acquire);
+  const auto last  = tail.load(std::memory_order_acquire);
+  return last > first ? last - first : 0ULL;
+}
+
+/**
+ * @brief returns the capacity of the queue.
+ */
+template <typename T>
+inline auto BoundedSPSCQueue<T>::capacity() const noexcept -> size_type
+{
+  return mask + 1ULL;
+}
+
+/**
+ * @brief Returns the strategy of the consumer waiting for data.
+ */
+template <typename T>
+inline auto BoundedSPSCQueue<T>::waitStrategy() const noexcept -> WaitStrategy
+{
+  return consumerWaitStrategy.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Sets the strategy of the consumer waiting for data. A spinning consumer polls the
+ *        ring buffer directly before it blocks on the condition variable.
+ */
+template <typename T>
+inline void BoundedSPSCQueue<T>::setWaitStrategy(WaitStrategy strategy) noexcept
+{
+  consumerWaitStrategy.store(strategy, std::memory_order_relaxed);
+}
+
+/**
+ * @brief  Copies another element into the queue.
+ * @remark Blocks the calling thread until there is space or the queue is stopped.
+ */
+template <typename T>
+inline void BoundedSPSCQueue<T>::push(value_type const& value)
+{
+  pushImpl(value);
+}
+
+/**
+ * @brief  Moves another element into the queue.
+ * @remark Blocks the calling thread until there is space or the queue is stopped.
+ */
+template <typename T>
+inline void BoundedSPSCQueue<T>::push(value_type&& value)
+{
+  pushImpl(std::move(value));
+}
+
+/**
+ * @brief Attempts to copy another element into the queue. Returns false immediately
+ *        if the queue is full.
+ */
+template <typename T>
+inline auto BoundedSPSCQueue<T>::tryPush(value_type const& value) -> bool
+{
+  return tryPushImpl(value);
+}
+
+/**
+ * @brief Attempts to move another element into the queue. Returns false immediately
+ *        if the queue is full. In this case, value is left untouched.
+ */
+template <typename T>
+inline auto BoundedSPSCQueue<T>::tryPush(value_type&& value) -> bool
+{
+  return tryPushImpl(std::move(value));
+}
+
+/**
+ * @brief Attempts to copy a new element into the queue. Blocks until the specified time out
+ *        has elapsed or there is space in the queue.
+ */
+template <typename T>
+template <typename Rep, typename Period>
+inline auto BoundedSPSCQueue<T>::tryPushFor(value_type const& value,
+                                            std::chrono::duration<Rep, Period> const& timeOut) -> bool
+{
+  return tryPushForImpl(value, timeOut);
+}
+
+/**
+ * @brief Attempts to move a new element into the queue. Blocks until the specified time out
+ *        has elapsed or there is space in the queue.
+ */
+template <typename T>
+template <typename Rep, typename Period>
+inline auto BoundedSPSCQueue<T>::tryPushFor(value_type&& value,
+                                            std::chrono::duration<Rep, Period> const& timeOut) -> bool
+{
+  return tryPushForImpl(std::move(value), timeOut);
+}
+
+/**
+ * @brief  Copies as many elements of [first, last) into the queue as there is space for,
+ *         publishing them at once.
+ * @return The number of elements that have been pushed.
+ */
+template <typename T>
+template <typename InputIt>
+auto BoundedSPSCQueue<T>::tryPushBulk(InputIt first, InputIt last) -> size_type
+{
+  const auto pos = tail.load(std::memory_order_relaxed);
+  const auto num = freeSlots(capacity());
+
+  size_type numPushedElements = 0ULL;
+  for(; numPushedElements < num && first != last; ++numPushedElements, ++first)
+  {
+    slots[(pos + numPushedElements) & mask] = *first;
+  }
+
+  if(numPushedElements > 0ULL)
+  {
+    tail.store(pos + numPushedElements, std::memory_order_release);
+    notifyConsumer();
+  }
+  return numPushedElements;
+}
+
+/**
+ * @brief  Copies all elements of [first, last) into the queue, blocking while the queue is full.
+ * @return The number of elements that have been pushed. Less than the number of elements
+ *         in the range only if the queue has been stopped.
+ */
+template <typename T>
+template <typename InputIt>
+auto BoundedSPSCQueue<T>::pushBulk(InputIt first, InputIt last) -> size_type
+{
+  size_type numPushedElements = 0ULL;
+  while(first != last && isActive)
+  {
+    const auto num = tryPushBulk(first, last);
+    if(num == 0ULL)
+    {
+      waitForSpace();
+    }
+    numPushedElements += num;
+    std::advance(first, static_cast<typename std::iterator_traits<InputIt>::difference_type>(num));
+  }
+  return numPushedElements;
+}
+
+/**
+ * @brief  Copies all elements of the range into the queue, blocking while the queue is full.
+ * @return The number of elements that have been pushed.
+ */
+template <typename T>
+template <typename Range>
+inline auto BoundedSPSCQueue<T>::pushBulk(Range&& range) -> size_type
+{
+  return pushBulk(std::begin(range), std::end(range));
+}
+
+/**
+ * @brief  Returns the contiguous free slots at the write position. The producer assigns the
+ *         new elements to the front of the span and publishes them with commitWrite.
+ * @remark The span ends at the end of the ring buffer, so it may hold less than the free
+ *         slots. It is empty if the queue is full.
+ */
+template <typename T>
+auto BoundedSPSCQueue<T>::writeSpan() -> std::span<value_type>
+{
+  const auto pos   = tail.load(std::memory_order_relaxed);
+  const auto index = pos & mask;
+  return {slots.get() + index, (std::min)(freeSlots(capacity()), capacity() - index)};
+}
+
+/**
+ * @brief Publishes the first numElements elements of the last write span.
+ */
+template <typename T>
+void BoundedSPSCQueue<T>::commitWrite(size_type numElements)
+{
+  if(numElements > 0ULL)
+  {
+    tail.store(tail.load(std::memory_order_relaxed) + numElements, std::memory_order_release);
+    notifyConsumer();
+  }
+}
+
+/**
+ * @brief blocks the calling thread until the queue is not empty
+ *        and moves the element at the front of the queue into the passed value.
+ *        Returns without touching value if the queue is stopped.
+ */
+template <typename T>
+void BoundedSPSCQueue<T>::waitAndPop(value_type& value)
+{
+  const auto strategy = consumerWaitStrategy.load(std::memory_order_relaxed);
+  while(isActive)
+  {
+    if(spinUntil(strategy, [this, &value] { return tryPop(value); }))
+    {
+      return;
+    }
+    waitForData();
+  }
+}
+
+/**
+ * @brief  blocks the calling thread until the queue is not empty and moves up to maxNumElements
+ *         elements into the given output iterator.
+ * @return The number of elements that have been popped. Zero, if the queue has been stopped.
+ */
+template <typename T>
+template <typename OutputIt>
+auto BoundedSPSCQueue<T>::waitAndPopBulk(OutputIt out, size_type maxNumElements) -> size_type
+{
+  const auto strategy = consumerWaitStrategy.load(std::memory_order_relaxed);
+  while(isActive && maxNumElements > 0ULL)
+  {
+    size_type numPoppedElements{};
+    if(spinUntil(strategy, [&] { return (numPoppedElements = tryPopBulk(out, maxNumElements)) > 0ULL; }))
+    {
+      return numPoppedElements;
+    }
+    waitForData();
+  }
+
+  return 0ULL;
+}
+
+/**
+ * @brief if the the queue is not empty, the first element at the front of the queue
+ *        is moved into the passed value and the method returns true.
+ *        If the queue is empty, the method returns false immediately.
+ */
+template <typename T>
+auto BoundedSPSCQueue<T>::tryPop(value_type& value) -> bool
+{
+  if(filledSlots() == 0ULL)
+  {
+    return false;
+  }
+
+  const auto pos = head.load(std::memory_order_relaxed);
+  value = std::move(slots[pos & mask]);
+  head.store(pos + 1ULL, std::memory_order_release);
+  notifyProducer();
+  return true;
+}
+
+/**
+ * @brief  Moves up to maxNumElements elements into the given output iterator without blocking,
+ *         releasing their slots at once.
+ * @return The number of elements that have been popped.
+ */
+template <typename T>
+template <typename OutputIt>
+auto BoundedSPSCQueue<T>::tryPopBulk(OutputIt out, size_type maxNumElements) -> size_type
+{
+  const auto pos = head.load(std::memory_order_relaxed);
+  const auto num = (std::min)(filledSlots(maxNumElements), maxNumElements);
+  for(size_type i = 0ULL; i < num; ++i)
+  {
+    *out = std::move(slots[(pos + i) & mask]);
+    ++out;
+  }
+
+  if(num > 0ULL)
+  {
+    head.store(pos + num, std::memory_order_release);
+    notifyProducer();
+  }
+  return num;
+}
+
+/**
+ * @brief Attempts to pop an element from the queue. Blocks until the specified time out
+ *        has elapsed or an element is available. Returns true if an element has been moved
+ *        into value.
+ */
+template <typename T>
+template <typename Rep, typename Period>
+auto BoundedSPSCQueue<T>::tryPopFor(value_type& value,
+                                    std::chrono::duration<Rep, Period> const& timeOut) -> bool
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeOut;
+  while(isActive)
+  {
+    if(tryPop(value))
+    {
+      return true;
+    }
+
+    // ------- begin critical section ------- //
+    uniqueLock lk(waitMutex);
+    ++numWaitingConsumers;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const bool ready = dataCondVar.wait_until(lk, deadline, [this] { return hasData() || !isActive; });
+    --numWaitingConsumers;
+    if(!ready)
+    {
+      return false;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * @brief  Returns the contiguous filled slots at the read position. The consumer processes
+ *         the elements in place and releases them with commitRead.
+ * @remark The span ends at the end of the ring buffer, so it may hold less than all elements.
+ *         It is empty if the queue is empty.
+ */
+template <typename T>
+auto BoundedSPSCQueue<T>::readSpan() -> std::span<value_type>
+{
+  const auto pos   = head.load(std::memory_order_relaxed);
+  const auto index = pos & mask;
+  return {slots.get() + index, (std::min)(filledSlots(capacity()), capacity() - index)};
+}
+
+/**
+ * @brief Releases the first numElements elements of the last read span.
+ */
+template <typename T>
+void BoundedSPSCQueue<T>::commitRead(size_type numElements)
+{
+  if(numElements > 0ULL)
+  {
+    head.store(head.load(std::memory_order_relaxed) + numElements, std::memory_order_release);
+    notifyProducer();
+  }
+}
+
+/**
+ * @brief stops all threads that might block on pop or push methods.
+ */
+template <typename T>
+void BoundedSPSCQueue<T>::stopQueue()
+{
+  isActive = false;
+  { lock lk(waitMutex); }
+  dataCondVar.notify_all();
+  capacityCondVar.notify_all();
+}
+
+/**
+ * @brief Moves or copies the new element into the slot at the write position.
+ */
+template <typename T>
+template <typename U>
+auto BoundedSPSCQueue<T>::tryPushImpl(U&& value) -> bool
+{
+  if(freeSlots() == 0ULL)
+  {
+    return false;
+  }
+
+  const auto pos = tail.load(std::memory_order_relaxed);
+  slots[pos & mask] = std::forward<U>(value);
+  tail.store(pos + 1ULL, std::memory_order_release);
+  notifyConsumer();
+  return true;
+}
+
+/**
+ * @brief Pushes a new element, blocking until there is space or the queue is stopped.
+ */
+template <typename T>
+template <typename U>
+void BoundedSPSCQueue<T>::pushImpl(U&& value)
+{
+  while(isActive)
+  {
+    if(tryPushImpl(std::forward<U>(value)))
+    {
+      return;
+    }
+    waitForSpace();
+  }
+}
+
+/**
+ * @brief Pushes a new element, blocking until there is space, the time out has elapsed
+ *        or the queue is stopped.
+ */
+template <typename T>
+template <typename U, typename Rep, typename Period>
+auto BoundedSPSCQueue<T>::tryPushForImpl(U&& value, std::chrono::duration<Rep, Period> const& timeOut) -> bool
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeOut;
+  while(isActive)
+  {
+    if(tryPushImpl(std::forward<U>(value)))
+    {
+      return true;
+    }
+
+    // ------- begin critical section ------- //
+    uniqueLock lk(waitMutex);
+    ++numWaitingProducers;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const bool ready = capacityCondVar.wait_until(lk, deadline, [this] { return hasSpace() || !isActive; });
+    --numWaitingProducers;
+    if(!ready)
+    {
+      return false;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * @brief Returns the number of free slots as seen by the producer. The head index of the
+ *        consumer is only reloaded if the cached one indicates less than wanted free slots.
+ */
+template <typename T>
+inline auto BoundedSPSCQueue<T>::freeSlots(size_type wanted) -> size_type
+{
+  const auto pos = tail.load(std::memory_order_relaxed);
+  if(capacity() - (pos - cachedHead) < wanted)
+  {
+    cachedHead = head.load(std::memory_order_acquire);
+  }
+  return capacity() - (pos - cachedHead);
+}
+
+/**
+ * @brief Returns the number of filled slots as seen by the consumer. The tail index of the
+ *        producer is only reloaded if the cached one indicates less than wanted elements.
+ */
+template <typename T>
+inline auto BoundedSPSCQueue<T>::filledSlots(size_type wanted) -> size_type
+{
+  const auto pos = head.load(std::memory_order_relaxed);
+  if(cachedTail - pos < wanted)
+  {
+    cachedTail = tail.load(std::memory_order_acquire);
+  }
+  return cachedTail - pos;
+}
+
+/**
+ * @brief checks whether the queue holds an element.
+ */
+template <typename T>
+inline auto BoundedSPSCQueue<T>::hasData() const -> bool
+{
+  return tail.load(std::memory_order_acquire) != head.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief checks whether the queue has a free slot.
+ */
+template <typename T>
+inline auto BoundedSPSCQueue<T>::hasSpace() const -> bool
+{
+  return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire) < capacity();
+}
+
+/**
+ * @brief Blocks the consumer until the queue holds an element or is stopped.
+ */
+template <typename T>
+void BoundedSPSCQueue<T>::waitForData()
+{
+  // ------- begin critical section ------- //
+  uniqueLock lk(waitMutex);
+  ++numWaitingConsumers;
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  dataCondVar.wait(lk, [this] { return hasData() || !isActive; });
+  --numWaitingConsumers;
+}
+
+/**
+ * @brief Blocks the producer until the queue has a free slot or is stopped.
+ */
+template <typename T>
+void BoundedSPSCQueue<T>::waitForSpace()
+{
+  // ------- begin critical section ------- //
+  uniqueLock lk(waitMutex);
+  ++numWaitingProducers;
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  capacityCondVar.wait(lk, [this] { return hasSpace() || !isActive; });
+  --numWaitingProducers;
+}
+
+/**
+ * @brief Wakes up the waiting consumer if there is one.
+ * @remark The fence pairs with the fence in the waiting methods: either the waiting
+ *         thread observes the new element or this thread observes the waiting thread.
+ */
+template <typename T>
+inline void BoundedSPSCQueue<T>::notifyConsumer()
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if(numWaitingConsumers.load(std::memory_order_relaxed) > 0ULL)
+  {
+    { lock lk(waitMutex); }
+    dataCondVar.notify_one();
+  }
+}
+
+/**
+ * @brief Wakes up the waiting producer if there is one.
+ */
+template <typename T>
+inline void BoundedSPSCQueue<T>::notifyProducer()
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if(numWaitingProducers.load(std::memory_order_relaxed) > 0ULL)
+  {
+    { lock lk(waitMutex); }
+    capacityCondVar.notify_one();
+  }
+}
+
+
+}   // namespace cctools
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif   // BOUNDEDSPSCQUEUE_H_61928374650192837465019283746501928374650192
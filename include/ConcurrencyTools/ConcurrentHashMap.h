@@ -0,0 +1,960 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   ConcurrentHashMap.h
+ * @brief  open addressing hash map with lock striping and incremental rehashing
+ *
+ * @author Lasse Rosenthal
+ * @date   16.10.2026
+ */
+
+#ifndef CONCURRENTHASHMAP_H_40918273645019283746501928374650192837465
+#define CONCURRENTHASHMAP_H_40918273645019283746501928374650192837465
+
+
+// includes
+#include "ThreadingModel.h"
+#include "detail/CacheLine.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace cctools {
+
+
+/**
+ * @class  ConcurrentHashMapT
+ * @brief  ConcurrentHashMapT is a hash map storing its elements in flat tables using linear probing.
+ *         The elements are distributed over one segment per mutex of the threading policy, every
+ *         segment is a table of its own that is guarded by its mutex. A segment whose load factor
+ *         would exceed the maximum load factor doubles its table. The elements of the old table are
+ *         moved a few slots at a time by the subsequent write operations on the segment, hence a
+ *         rehash neither blocks the other segments nor stalls a single writer for a whole table.
+ * @remark Since elements move on rehashing, access to the mapped values is only given via
+ *         invoke, forEach and forEachValue, which hold the lock of the segment during the call.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash = std::hash<Key>, typename... AdditionalPolicyArgs>
+class ConcurrentHashMapT
+  : public ThreadingPolicy<ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>,
+                           AdditionalPolicyArgs...> {
+
+  using threadingPolicy = ThreadingPolicy<ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>,
+                                          AdditionalPolicyArgs...>;
+
+  // import the locking methods of the threading policy
+  using threadingPolicy::lockUnique;
+  using typename threadingPolicy::LockUnique;
+
+public:
+
+  // ---------------------------------------------------
+  // public types
+  using key_type    = Key;
+  using mapped_type = Value;
+  using value_type  = std::pair<key_type const, mapped_type>;
+  using hasher      = Hash;
+  using size_type   = std::size_t;
+
+  // ---------------------------------------------------
+  // public constants
+  static constexpr size_type numStripes           = threadingPolicy::numMutexes;
+  static constexpr size_type defaultCapacity      = 64ULL;
+  static constexpr float     defaultMaxLoadFactor = 0.75F;
+
+  // ---------------------------------------------------
+  // special member functions
+  explicit ConcurrentHashMapT (size_type capacity = defaultCapacity, float maxLoadFactor = defaultMaxLoadFactor,
+                               hasher const& hash = hasher());
+  ConcurrentHashMapT          (std::initializer_list<value_type> valueList, size_type capacity = defaultCapacity,
+                               float maxLoadFactor = defaultMaxLoadFactor, hasher const& hash = hasher());
+  ConcurrentHashMapT          (ConcurrentHashMapT const& src) = delete;
+  ConcurrentHashMapT          (ConcurrentHashMapT&& src);
+  auto operator=              (ConcurrentHashMapT const& src) -> ConcurrentHashMapT& = delete;
+  auto operator=              (ConcurrentHashMapT&& src) -> ConcurrentHashMapT&;
+  ~ConcurrentHashMapT         () = default;
+
+  // ---------------------------------------------------
+  // public methods
+  [[nodiscard]] auto size          () const -> size_type;
+  [[nodiscard]] auto empty         () const -> bool;
+  [[nodiscard]] auto capacity      () const -> size_type;
+  [[nodiscard]] auto loadFactor    () const -> float;
+  [[nodiscard]] auto maxLoadFactor () const noexcept -> float;
+  [[nodiscard]] auto contains      (key_type const& key) const -> bool;
+
+  auto insertOrReplace             (key_type const& key, mapped_type const& value) -> size_type;
+  auto insertOrReplace             (key_type const& key, mapped_type&& value) -> size_type;
+  template <typename... Args>
+  auto emplace                     (key_type const& key, Args&&... args) -> size_type;
+  auto erase                       (key_type const& key) -> size_type;
+  template <typename F>
+  auto forEach                     (F&& f) -> F&&;
+  template <typename F>
+  auto forEachValue                (F&& f) -> F&&;
+  template <typename F>
+  auto forEachValue                (F&& f) const -> F&&;
+  template <typename F>
+  auto invoke                      (key_type const& key, F&& f) -> std::invoke_result_t<F, mapped_type&>;
+
+private:
+
+  class Segment;
+
+  // ---------------------------------------------------
+  // private constants
+  static constexpr size_type minSegmentCapacity    = 8ULL;
+  static constexpr size_type slotsMigratedPerWrite = 8ULL;
+
+  // ---------------------------------------------------
+  // private data
+  hasher               elemHash;
+  float                maxLoad;
+  std::vector<Segment> segments;
+
+  // ---------------------------------------------------
+  // auxiliary methods
+  template <typename Mapped>
+  auto insertOrReplaceImpl (key_type const& key, Mapped&& value) -> size_type;
+  auto locate              (key_type const& key) const -> std::pair<size_type, size_type>;
+  auto lockRead            (size_type stripe) const;
+  auto lockAll             () const -> std::array<LockUnique, numStripes>;
+  void moveFromOther       (ConcurrentHashMapT&& src);
+
+  static auto makeSegments      (size_type capacity, float maxLoadFactor) -> std::vector<Segment>;
+  static constexpr auto mixHash (size_type h) noexcept -> size_type;
+};
+
+
+/**
+ * @class ConcurrentHashMapT::Segment
+ * @brief Segment is an open addressing table with linear probing. It holds the table the
+ *        elements are inserted into and, while a rehash is in progress, the previous table
+ *        whose elements have not been moved yet. A segment doesn't lock, this is done by the map.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+class alignas(detail::cacheLineSize) ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::Segment {
+
+  // ---------------------------------------------------
+  // slot states
+  enum class slotState : char {
+    empty,    ///< never used, terminates a probe sequence
+    occupied, ///< holds an element
+    erased    ///< element was erased or migrated, probing continues
+  };
+
+  struct Slot {
+    std::optional<value_type> entry;
+    size_type                 hash {0ULL};
+    slotState                 state {slotState::empty};
+  };
+
+  struct Table {
+    Table () = default;
+    explicit Table (size_type n)
+      : slots (n)
+      , mask  {n - 1ULL}
+    {}
+
+    std::vector<Slot> slots;
+    size_type         mask {0ULL};
+  };
+
+public:
+
+  // ---------------------------------------------------
+  // special member functions
+  Segment (size_type capacity, float maxLoadFactor);
+
+  // ---------------------------------------------------
+  // public api
+  auto size     () const noexcept -> size_type;
+  auto capacity () const noexcept -> size_type;
+  auto find     (key_type const& key, size_type h) -> value_type*;
+  auto find     (key_type const& key, size_type h) const -> value_type const*;
+  template <typename... Args>
+  void insert   (size_type h, Args&&... args);
+  auto erase    (key_type const& key, size_type h) -> size_type;
+  void migrate  (size_type numSlots);
+  template <typename F>
+  void forEach  (F& f);
+  template <typename F>
+  void forEach  (F& f) const;
+
+private:
+
+  // ---------------------------------------------------
+  // private data
+  Table     current;
+  Table     previous;
+  size_type migrationCursor {0ULL};
+  size_type count {0ULL};
+  float     maxLoad;
+
+  // ---------------------------------------------------
+  // auxiliary methods
+  void grow           ();
+  void eraseFromTable (size_type i);
+
+  static auto findIndex (Table const& table, key_type const& key, size_type h) -> size_type;
+  static auto freeSlot  (Table& table, size_type h) -> Slot&;
+};
+
+
+/**
+ * @brief Constructor.
+ * @param capacity the initial number of slots, which is distributed over the segments.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::Segment::Segment(size_type capacity,
+                                                                                                       float maxLoadFactor)
+  : current {detail::nextPowerOfTwo(std::max(capacity, minSegmentCapacity))}
+  , maxLoad {maxLoadFactor}
+{}
+
+/**
+ * @brief Returns the number of elements stored in both tables.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::Segment::size() const noexcept -> size_type
+{
+  return count;
+}
+
+/**
+ * @brief Returns the number of slots of the current table.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::Segment::capacity() const noexcept -> size_type
+{
+  return current.slots.size();
+}
+
+/**
+ * @brief Returns a pointer to the element with a given key or nullptr, if no such element exists.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::Segment::find(key_type const& key, size_type h)
+  -> value_type*
+{
+  if(auto const i = findIndex(current, key, h); i != current.slots.size())
+  {
+    return &*current.slots[i].entry;
+  }
+  if(auto const i = findIndex(previous, key, h); i != previous.slots.size())
+  {
+    return &*previous.slots[i].entry;
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Returns a pointer to the element with a given key or nullptr, if no such element exists.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::Segment::find(key_type const& key, size_type h) const
+  -> value_type const*
+{
+  if(auto const i = findIndex(current, key, h); i != current.slots.size())
+  {
+    return &*current.slots[i].entry;
+  }
+  if(auto const i = findIndex(previous, key, h); i != previous.slots.size())
+  {
+    return &*previous.slots[i].entry;
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Constructs a new element from the given arguments. The key must not be present yet.
+ *        If the insertion would exceed the maximum load factor, the table is grown first.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+template <typename... Args>
+void ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::Segment::insert(size_type h, Args&&... args)
+{
+  while(static_cast<float>(count + 1ULL) > maxLoad * static_cast<float>(current.slots.size()))
+  {
+    grow();
+  }
+
+  auto& slot = freeSlot(current, h);
+  slot.entry.emplace(std::forward<Args>(args)...);
+  slot.hash  = h;
+  slot.state = slotState::occupied;
+  ++count;
+}
+
+/**
+ * @brief  Erases the element with a given key.
+ * @return the number of erased elements.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::Segment::erase(key_type const& key, size_type h)
+  -> size_type
+{
+  if(auto const i = findIndex(current, key, h); i != current.slots.size())
+  {
+    eraseFromTable(i);
+    --count;
+    return 1ULL;
+  }
+
+  // the previous table is never inserted into, so a tombstone keeps its probe sequences intact
+  if(auto const i = findIndex(previous, key, h); i != previous.slots.size())
+  {
+    previous.slots[i].entry.reset();
+    previous.slots[i].state = slotState::erased;
+    --count;
+    return 1ULL;
+  }
+
+  return 0ULL;
+}
+
+/**
+ * @brief Moves the elements of the next numSlots slots of the previous table into the current one.
+ *        The previous table is released as soon as all of its slots have been visited.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+void ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::Segment::migrate(size_type numSlots)
+{
+  if(previous.slots.empty())
+  {
+    return;
+  }
+
+  auto const last = std::min(migrationCursor + numSlots, previous.slots.size());
+  for(; migrationCursor < last; ++migrationCursor)
+  {
+    auto& slot = previous.slots[migrationCursor];
+    if(slot.state == slotState::occupied)
+    {
+      auto& target = freeSlot(current, slot.hash);
+      target.entry.emplace(std::move(*slot.entry));
+      target.hash  = slot.hash;
+      target.state = slotState::occupied;
+      slot.entry.reset();
+      slot.state = slotState::erased;
+    }
+  }
+
+  if(migrationCursor == previous.slots.size())
+  {
+    previous        = Table{};
+    migrationCursor = 0ULL;
+  }
+}
+
+/**
+ * @brief Applies a given function to every element of the segment.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+template <typename F>
+void ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::Segment::forEach(F& f)
+{
+  for(auto* table : {&previous, &current})
+  {
+    for(auto& slot : table->slots)
+    {
+      if(slot.state == slotState::occupied)
+      {
+        f(*slot.entry);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Applies a given function to every element of the segment.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+template <typename F>
+void ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::Segment::forEach(F& f) const
+{
+  for(auto const* table : {&previous, &current})
+  {
+    for(auto const& slot : table->slots)
+    {
+      if(slot.state == slotState::occupied)
+      {
+        f(*slot.entry);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Replaces the current table by a table of twice the size. A pending migration is
+ *        completed first, so that there are never more than two tables.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+void ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::Segment::grow()
+{
+  migrate(previous.slots.size());
+
+  const auto newCapacity = 2ULL * current.slots.size();
+  previous        = std::move(current);
+  current         = Table{newCapacity};
+  migrationCursor = 0ULL;
+}
+
+/**
+ * @brief Erases the element in slot i of the current table. The following elements of the
+ *        probe sequence are shifted backwards, so that the current table never contains tombstones.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+void ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::Segment::eraseFromTable(size_type i)
+{
+  auto& slots = current.slots;
+  for(auto j = (i + 1ULL) & current.mask; slots[j].state == slotState::occupied; j = (j + 1ULL) & current.mask)
+  {
+    // an element may fill the gap only if its home slot doesn't lie cyclically in (i, j]
+    auto const home = slots[j].hash & current.mask;
+    if(i <= j ? (i < home && home <= j) : (i < home || home <= j))
+    {
+      continue;
+    }
+
+    slots[i].entry.emplace(std::move(*slots[j].entry));
+    slots[i].hash = slots[j].hash;
+    i             = j;
+  }
+
+  slots[i].entry.reset();
+  slots[i].state = slotState::empty;
+}
+
+/**
+ * @brief Returns the index of the slot holding the given key or the size of the table, if the key
+ *        is not contained. The probing terminates since a table always has empty slots.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::Segment::findIndex(Table const& table,
+                                                                                                       key_type const& key,
+                                                                                                       size_type h) -> size_type
+{
+  if(table.slots.empty())
+  {
+    return 0ULL;
+  }
+
+  for(auto i = h & table.mask;; i = (i + 1ULL) & table.mask)
+  {
+    auto const& slot = table.slots[i];
+    if(slot.state == slotState::empty)
+    {
+      return table.slots.size();
+    }
+    if(slot.state == slotState::occupied && slot.hash == h && slot.entry->first == key)
+    {
+      return i;
+    }
+  }
+}
+
+/**
+ * @brief Returns the first empty slot of the probe sequence for a given hash.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::Segment::freeSlot(Table& table, size_type h)
+  -> Slot&
+{
+  auto i = h & table.mask;
+  while(table.slots[i].state == slotState::occupied)
+  {
+    i = (i + 1ULL) & table.mask;
+  }
+  return table.slots[i];
+}
+
+
+/**
+ * @brief Constructor.
+ * @param capacity      the initial number of slots. It is distributed over the segments, each of
+ *                      which is rounded up to a power of two.
+ * @param maxLoadFactor the maximum ratio of elements to slots of a segment. It must lie in (0, 1).
+ * @throw std::invalid_argument
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::ConcurrentHashMapT(size_type capacity,
+                                                                                                   float maxLoadFactor,
+                                                                                                   hasher const& hash)
+  : elemHash {hash}
+  , maxLoad  {maxLoadFactor}
+{
+  if(!(maxLoadFactor > 0.F && maxLoadFactor < 1.F))
+  {
+    throw std::invalid_argument("maximum load factor must lie in (0, 1)");
+  }
+
+  segments = makeSegments(capacity, maxLoadFactor);
+}
+
+/**
+ * @brief Constructs the map with the contents of the given initializer list.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::ConcurrentHashMapT(std::initializer_list<value_type> valueList,
+                                                                                                   size_type capacity,
+                                                                                                   float maxLoadFactor,
+                                                                                                   hasher const& hash)
+  : ConcurrentHashMapT(capacity, maxLoadFactor, hash)
+{
+  for(auto const& [key, value] : valueList)
+  {
+    insertOrReplace(key, value);
+  }
+}
+
+/**
+ * @brief Move Constructor.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::ConcurrentHashMapT(ConcurrentHashMapT&& src)
+{
+  // ------- begin critical section ------- //
+  auto lckOther = src.lockAll();
+
+  moveFromOther(std::move(src));
+}
+
+/**
+ * @brief Move Assignment. The stripes of both maps are locked in the order of their addresses.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::operator=(ConcurrentHashMapT&& src)
+  -> ConcurrentHashMapT&
+{
+  if(this != &src)
+  {
+    auto const thisFirst = std::less<ConcurrentHashMapT const*>{}(this, &src);
+
+    // ------- begin critical section ------- //
+    auto lckFirst  = thisFirst ? lockAll() : src.lockAll();
+    auto lckSecond = thisFirst ? src.lockAll() : lockAll();
+
+    moveFromOther(std::move(src));
+  }
+
+  return *this;
+}
+
+/**
+ * @brief Returns the number of elements stored in the map.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline [[nodiscard]] auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::size() const -> size_type
+{
+  size_type n {0ULL};
+  for(size_type i {}; i < segments.size(); ++i)
+  {
+    // ------- begin critical section ------- //
+    auto lck = lockRead(i);
+    n += segments[i].size();
+  }
+  return n;
+}
+
+/**
+ * @brief Checks if the hash map is empty.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline [[nodiscard]] auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::empty() const -> bool
+{
+  return size() == 0ULL;
+}
+
+/**
+ * @brief Returns the number of slots of the current tables of all segments.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline [[nodiscard]] auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::capacity() const -> size_type
+{
+  size_type n {0ULL};
+  for(size_type i {}; i < segments.size(); ++i)
+  {
+    // ------- begin critical section ------- //
+    auto lck = lockRead(i);
+    n += segments[i].capacity();
+  }
+  return n;
+}
+
+/**
+ * @brief Returns the ratio of the number of elements to the number of slots.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline [[nodiscard]] auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::loadFactor() const -> float
+{
+  auto const slots = capacity();
+  return slots == 0ULL ? 0.F : static_cast<float>(size()) / static_cast<float>(slots);
+}
+
+/**
+ * @brief Returns the maximum load factor, which triggers the growth of a segment.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline [[nodiscard]] auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::maxLoadFactor() const noexcept
+  -> float
+{
+  return maxLoad;
+}
+
+/**
+ * @brief Checks if the container stores an element with a given key.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline [[nodiscard]] auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::contains(key_type const& key) const
+  -> bool
+{
+  auto const [stripe, h] = locate(key);
+
+  // ------- begin critical section ------- //
+  auto lck = lockRead(stripe);
+  return segments[stripe].find(key, h) != nullptr;
+}
+
+/**
+ * @brief  Inserts a new element into the container. If there is already an element with the given key,
+ *         its value is replaced by the given value.
+ * @return 1 if a new element was inserted, 0 if a value was replaced.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::insertOrReplace(key_type const& key,
+                                                                                                            mapped_type const& value)
+  -> size_type
+{
+  return insertOrReplaceImpl(key, value);
+}
+
+/**
+ * @brief  Inserts a new element into the container. If there is already an element with the given key,
+ *         its value is replaced by the given value.
+ * @return 1 if a new element was inserted, 0 if a value was replaced.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::insertOrReplace(key_type const& key,
+                                                                                                            mapped_type&& value)
+  -> size_type
+{
+  return insertOrReplaceImpl(key, std::move(value));
+}
+
+/**
+ * @brief  Inserts a new element constructed in place if no such element with a key
+ *         equal to key can be found. Otherwise, the existing element is replaced by a new constructed element.
+ * @params args... the parameters forwarded to the constructor of the new element.
+ * @return 1 if a new element was inserted, 0 if a value was replaced.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+template <typename... Args>
+auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::emplace(key_type const& key, Args&&... args)
+  -> size_type
+{
+  auto const [stripe, h] = locate(key);
+  auto& segment          = segments[stripe];
+
+  // ------- begin critical section ------- //
+  auto lck = lockUnique(stripe);
+  segment.migrate(slotsMigratedPerWrite);
+
+  if(auto* const entry = segment.find(key, h); entry)
+  {
+    entry->second = mapped_type{std::forward<Args>(args)...};
+    return 0ULL;
+  }
+
+  segment.insert(h, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+  return 1ULL;
+}
+
+/**
+ * @brief  Removes the element with a given key.
+ * @return the number of removed elements.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::erase(key_type const& key) -> size_type
+{
+  auto const [stripe, h] = locate(key);
+  auto& segment          = segments[stripe];
+
+  // ------- begin critical section ------- //
+  auto lck = lockUnique(stripe);
+  segment.migrate(slotsMigratedPerWrite);
+  return segment.erase(key, h);
+}
+
+/**
+ * @brief Applies a given function to every element in the map. The segments are locked one after another.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+template <typename F>
+auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::forEach(F&& f) -> F&&
+{
+  auto applyToValue = [&f](value_type& entry) { f(entry.second); };
+  for(size_type i {}; i < segments.size(); ++i)
+  {
+    // ------- begin critical section ------- //
+    auto lck = lockUnique(i);
+    segments[i].forEach(applyToValue);
+  }
+
+  return std::forward<F>(f);
+}
+
+/**
+ * @brief Applies a given function to every key-value pair in the map. The segments are locked one after another.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+template <typename F>
+auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::forEachValue(F&& f) -> F&&
+{
+  for(size_type i {}; i < segments.size(); ++i)
+  {
+    // ------- begin critical section ------- //
+    auto lck = lockUnique(i);
+    segments[i].forEach(f);
+  }
+
+  return std::forward<F>(f);
+}
+
+/**
+ * @brief Applies a given function to every key-value pair in the map. The segments are locked
+ *        for reading one after another.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+template <typename F>
+auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::forEachValue(F&& f) const -> F&&
+{
+  for(size_type i {}; i < segments.size(); ++i)
+  {
+    // ------- begin critical section ------- //
+    auto lck = lockRead(i);
+    segments[i].forEach(f);
+  }
+
+  return std::forward<F>(f);
+}
+
+/**
+ * @brief Applies a given function to the element with a specified key. If no such element exists,
+ *        an exception is thrown.
+ * @throw std::out_of_range
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+template <typename F>
+auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::invoke(key_type const& key, F&& f)
+  -> std::invoke_result_t<F, mapped_type&>
+{
+  auto const [stripe, h] = locate(key);
+  auto& segment          = segments[stripe];
+
+  // ------- begin critical section ------- //
+  auto lck = lockUnique(stripe);
+  segment.migrate(slotsMigratedPerWrite);
+
+  auto* const entry = segment.find(key, h);
+  if(entry == nullptr)
+  {
+    throw std::out_of_range("entry with given key not found");
+  }
+
+  return std::forward<F>(f)(entry->second);
+}
+
+/**
+ * @brief Inserts or replaces the value of a given key.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+template <typename Mapped>
+auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::insertOrReplaceImpl(key_type const& key,
+                                                                                                         Mapped&& value) -> size_type
+{
+  auto const [stripe, h] = locate(key);
+  auto& segment          = segments[stripe];
+
+  // ------- begin critical section ------- //
+  auto lck = lockUnique(stripe);
+  segment.migrate(slotsMigratedPerWrite);
+
+  if(auto* const entry = segment.find(key, h); entry)
+  {
+    entry->second = std::forward<Mapped>(value);
+    return 0ULL;
+  }
+
+  segment.insert(h, key, std::forward<Mapped>(value));
+  return 1ULL;
+}
+
+/**
+ * @brief Returns the stripe of a given key and the hash used inside its segment.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::locate(key_type const& key) const
+  -> std::pair<size_type, size_type>
+{
+  auto const h = mixHash(elemHash(key));
+  return {h % numStripes, h / numStripes};
+}
+
+/**
+ * @brief Locks the mutex of a given stripe for reading. Without shared locking, the lock is exclusive.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::lockRead(size_type stripe) const
+{
+  if constexpr(threadingPolicy::hasSharedLocking)
+  {
+    return this->lockShared(stripe);
+  }
+  else
+  {
+    return this->lockUnique(stripe);
+  }
+}
+
+/**
+ * @brief Locks the mutexes of all stripes in ascending order.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::lockAll() const -> std::array<LockUnique, numStripes>
+{
+  std::array<LockUnique, numStripes> locks;
+  for(size_type i {}; i < numStripes; ++i)
+  {
+    locks[i] = lockUnique(i);
+  }
+  return locks;
+}
+
+/**
+ * @brief Takes over the segments of another map, which is left empty with freshly constructed
+ *        segments, so that it stays usable.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+void ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::moveFromOther(ConcurrentHashMapT&& src)
+{
+  auto emptySegments = makeSegments(defaultCapacity, src.maxLoad);
+
+  elemHash = src.elemHash;
+  maxLoad  = src.maxLoad;
+  segments = std::exchange(src.segments, std::move(emptySegments));
+}
+
+/**
+ * @brief Creates numStripes empty segments, over which capacity slots are distributed.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::makeSegments(size_type capacity,
+                                                                                                  float maxLoadFactor)
+  -> std::vector<Segment>
+{
+  std::vector<Segment> result;
+  result.reserve(numStripes);
+  for(size_type i {}; i < numStripes; ++i)
+  {
+    result.emplace_back(capacity / numStripes, maxLoadFactor);
+  }
+  return result;
+}
+
+/**
+ * @brief Finalizer of MurmurHash3. Linear probing needs well distributed low bits, which
+ *        e.g. the identity hash of the integral types doesn't provide.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline constexpr auto ConcurrentHashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::mixHash(size_type h) noexcept
+  -> size_type
+{
+  auto x = static_cast<std::uint64_t>(h);
+  x ^= x >> 33U;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33U;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33U;
+  return static_cast<size_type>(x);
+}
+
+
+/**
+ * @brief convenience template alias for an open addressing hash map without locking.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+using FlatHashMap = ConcurrentHashMapT<Key, Value, SingleThreaded, Hash>;
+
+/**
+ * @brief convenience template alias for an open addressing hash map with NumStripes independently
+ *        locked segments.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Mutex = std::shared_mutex,
+          std::size_t NumStripes = 16ULL>
+using ConcurrentHashMap = ConcurrentHashMapT<Key, Value, ObjectLevelLockableT, Hash, Mutex,
+                                             std::integral_constant<std::size_t, NumStripes>>;
+
+
+}   // namespace cctools
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // CONCURRENTHASHMAP_H_40918273645019283746501928374650192837465
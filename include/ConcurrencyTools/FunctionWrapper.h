@@ -1,7 +1,7 @@
-/* -------------------------------------------------------------------------- 
- * Copyright (c) 2019-2020 Heidelberger Druckmaschinen AG 
- * Reproduction or disclosure of this file or its contents without the prior 
- * written consent of Heidelberger Druckmaschinen AG is prohibited. 
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2019-2020 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
  * -------------------------------------------------------------------------- */
 
 /**
@@ -9,97 +9,167 @@
  * @brief  FunctionWrapper is a type-erase class for callable objects.
  *         for an explanation of type-erasure classes see
  *         https://en.wikibooks.org/wiki/More_C%2B%2B_Idioms/Type_Erasure
- *         
+ *
  * @author Lasse Rosenthal
  * @date   21.01.2020
  */
 
-#ifndef FUNCTIONWRAPPER_H_29803210782190253302196619340169112028611706 
-#define FUNCTIONWRAPPER_H_29803210782190253302196619340169112028611706 
- 
- 
-// includes 
-#include <memory>
+#ifndef FUNCTIONWRAPPER_H_29803210782190253302196619340169112028611706
+#define FUNCTIONWRAPPER_H_29803210782190253302196619340169112028611706
+
+
+// includes
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 
 namespace cctools {
- 
- 
+
+
 /**
- * @class FunctionWrapper
- * @brief
+ * @class  FunctionWrapper
+ * @brief  FunctionWrapper is a move-only wrapper for callable objects without arguments.
+ * @remark Callables of up to inlineSize bytes that are nothrow move constructible are stored
+ *         inside the wrapper itself, larger ones are allocated on the heap. Instead of a virtual
+ *         call, the type erasure is done by two plain function pointers which are instantiated
+ *         for every stored type.
  */
 class FunctionWrapper {
 
   // ---------------------------------------------------
-  // type erasure base type
-  struct CallableBase {
-
-    virtual ~CallableBase () = default;
-    virtual void call () = 0;
+  // type erasure operations
+  enum class operation : char {
+    move,
+    destroy
   };
 
+  using invokerType = void (*)(void*);
+  using managerType = void (*)(operation, void* dst, void* src) noexcept;
+
+public:
+
+  // ---------------------------------------------------
+  // public constants
+  static constexpr std::size_t inlineSize = 48ULL;
+
+private:
+
   // ---------------------------------------------------
-  // the polymorphic type erasure type
+  // internal SFINAE alias definitions
   template <typename Fun>
-  struct Callable : CallableBase {
-    Callable  (Fun&&); 
-    void call () override;
-    Fun fun; 
-  };
+  static constexpr bool isStoredInline = sizeof(Fun) <= inlineSize &&
+                                         alignof(Fun) <= alignof(std::max_align_t) &&
+                                         std::is_nothrow_move_constructible_v<Fun>;
+
+  template <typename Fun>
+  using requiresCallable = std::enable_if_t<!std::is_same_v<std::decay_t<Fun>, FunctionWrapper>>;
 
 public:
 
   // ---------------------------------------------------
   // special member functions
-  FunctionWrapper () = default;
-  FunctionWrapper (const FunctionWrapper&) = delete;
-  FunctionWrapper (FunctionWrapper&&) = default;
-  auto operator=  (const FunctionWrapper&) -> FunctionWrapper& = delete;
-  auto operator=  (FunctionWrapper&&) -> FunctionWrapper& = default;
+  FunctionWrapper  () = default;
+  FunctionWrapper  (const FunctionWrapper&) = delete;
+  FunctionWrapper  (FunctionWrapper&&) noexcept;
+  auto operator=   (const FunctionWrapper&) -> FunctionWrapper& = delete;
+  auto operator=   (FunctionWrapper&&) noexcept -> FunctionWrapper&;
+  ~FunctionWrapper ();
 
-  template <typename Fun>
+  template <typename Fun, typename = requiresCallable<Fun>>
   FunctionWrapper (Fun&&, int priority = 0);
 
   // ---------------------------------------------------
   // public api
   void operator ()();
+  explicit operator bool () const noexcept;
+
+  template <typename Fun>
+  static constexpr bool storesInline () noexcept;
 
   friend auto operator< (FunctionWrapper const& f1, FunctionWrapper const& f2) -> bool;
 
 private:
 
-  // --------------------------------------------------- 
-  // a pointer to the callable
-  std::unique_ptr<CallableBase> callable;
-  int                           priority {0};
+  // ---------------------------------------------------
+  // the callable or a pointer to it
+  alignas(std::max_align_t) unsigned char storage[inlineSize];
+  invokerType                             invoker {nullptr};
+  managerType                             manager {nullptr};
+  int                                     priority {0};
+
+  // ---------------------------------------------------
+  // type specific operations
+  template <typename Fun>
+  static void invokeInline (void* src);
+  template <typename Fun>
+  static void manageInline (operation op, void* dst, void* src) noexcept;
+  template <typename Fun>
+  static void invokeHeap   (void* src);
+  template <typename Fun>
+  static void manageHeap   (operation op, void* dst, void* src) noexcept;
+
+  void moveFrom (FunctionWrapper& other) noexcept;
+  void reset    () noexcept;
 };
 
 
+static_assert(FunctionWrapper::inlineSize >= sizeof(void*));
+
+
 /**
- * @brief Constructor. Moves the provided function into the Callable.
+ * @brief Constructor. Moves the provided function into the inline storage if it fits,
+ *        otherwise onto the heap.
  */
-template <typename Fun>
-inline FunctionWrapper::Callable<Fun>::Callable(Fun&& f) :
-  fun {std::move(f)}
-{}
+template <typename Fun, typename>
+inline FunctionWrapper::FunctionWrapper(Fun&& fun, int priority)
+  : priority {priority}
+{
+  using F = std::decay_t<Fun>;
+  if constexpr(isStoredInline<F>)
+  {
+    ::new(static_cast<void*>(storage)) F(std::forward<Fun>(fun));
+    invoker = &invokeInline<F>;
+    manager = &manageInline<F>;
+  }
+  else
+  {
+    ::new(static_cast<void*>(storage)) F*(new F(std::forward<Fun>(fun)));
+    invoker = &invokeHeap<F>;
+    manager = &manageHeap<F>;
+  }
+}
 
 /**
- * @brief Constructor. Creates the internal callable object from the given function.
+ * @brief Move constructor.
  */
-template <typename Fun>
-inline FunctionWrapper::FunctionWrapper(Fun&& fun, int priority)
-  : callable {std::make_unique<Callable<Fun>>(std::forward<Fun>(fun))}
-  , priority {priority}
-{}
+inline FunctionWrapper::FunctionWrapper(FunctionWrapper&& other) noexcept
+  : priority {other.priority}
+{
+  moveFrom(other);
+}
 
 /**
- * @brief Calls the stored function.
+ * @brief Move assignment.
  */
-template <typename Fun>
-inline void FunctionWrapper::Callable<Fun>::call()
+inline auto FunctionWrapper::operator=(FunctionWrapper&& other) noexcept -> FunctionWrapper&
+{
+  if(this != &other)
+  {
+    reset();
+    priority = other.priority;
+    moveFrom(other);
+  }
+  return *this;
+}
+
+/**
+ * @brief Destructor. Destroys the stored callable.
+ */
+inline FunctionWrapper::~FunctionWrapper()
 {
-  fun();
+  reset();
 }
 
 /**
@@ -107,7 +177,89 @@ inline void FunctionWrapper::Callable<Fun>::call()
  */
 inline void FunctionWrapper::operator()()
 {
-  callable->call();
+  invoker(storage);
+}
+
+/**
+ * @brief Checks whether a callable is stored.
+ */
+inline FunctionWrapper::operator bool() const noexcept
+{
+  return invoker != nullptr;
+}
+
+/**
+ * @brief Returns true if callables of the given type are stored without heap allocation.
+ */
+template <typename Fun>
+inline constexpr bool FunctionWrapper::storesInline() noexcept
+{
+  return isStoredInline<std::decay_t<Fun>>;
+}
+
+template <typename Fun>
+void FunctionWrapper::invokeInline(void* src)
+{
+  (*std::launder(static_cast<Fun*>(src)))();
+}
+
+template <typename Fun>
+void FunctionWrapper::manageInline(operation op, void* dst, void* src) noexcept
+{
+  auto* const fun = std::launder(static_cast<Fun*>(src));
+  if(op == operation::move)
+  {
+    ::new(dst) Fun(std::move(*fun));
+  }
+  fun->~Fun();
+}
+
+template <typename Fun>
+void FunctionWrapper::invokeHeap(void* src)
+{
+  (**std::launder(static_cast<Fun**>(src)))();
+}
+
+template <typename Fun>
+void FunctionWrapper::manageHeap(operation op, void* dst, void* src) noexcept
+{
+  auto* const fun = *std::launder(static_cast<Fun**>(src));
+  if(op == operation::move)
+  {
+    ::new(dst) Fun*(fun);
+  }
+  else
+  {
+    delete fun;
+  }
+}
+
+/**
+ * @brief Takes over the callable of other, which is left empty.
+ */
+inline void FunctionWrapper::moveFrom(FunctionWrapper& other) noexcept
+{
+  if(other.manager)
+  {
+    other.manager(operation::move, storage, other.storage);
+    invoker       = other.invoker;
+    manager       = other.manager;
+    other.invoker = nullptr;
+    other.manager = nullptr;
+  }
+}
+
+/**
+ * @brief Destroys the stored callable.
+ */
+inline void FunctionWrapper::reset() noexcept
+{
+  if(manager)
+  {
+    manager(operation::destroy, nullptr, storage);
+    invoker = nullptr;
+    manager = nullptr;
+  }
 }
 
 /**
@@ -122,8 +274,8 @@ inline auto operator<(FunctionWrapper const& f1, FunctionWrapper const& f2) -> b
 }   // namespace cctools
 
 
-// *************************************************************************** // 
-// ******************************* END OF FILE ******************************* // 
-// *************************************************************************** // 
- 
-#endif // FUNCTIONWRAPPER_H_29803210782190253302196619340169112028611706 
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // FUNCTIONWRAPPER_H_29803210782190253302196619340169112028611706
@@ -0,0 +1,1012 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   Future.h
+ * @brief  futures and promises with continuations that are scheduled on a thread pool
+ *         instead of blocking a thread.
+ *
+ * @author Lasse Rosenthal
+ * @date   16.10.2026
+ */
+
+#ifndef FUTURE_H_37465019283746501928374650192837465019283746
+#define FUTURE_H_37465019283746501928374650192837465019283746
+
+
+// includes
+#include "FunctionWrapper.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace cctools {
+
+
+template <typename T>
+class Future;
+
+template <typename T>
+class Promise;
+
+
+namespace detail {
+
+
+/**
+ * @class Executor
+ * @brief Executor is a non-owning handle to a thread pool that runs continuations. An empty
+ *        executor runs them inline on the thread completing the future.
+ */
+class Executor {
+
+  using postType = bool (*)(void*, FunctionWrapper&&);
+
+public:
+
+  // ---------------------------------------------------
+  // construction
+  Executor () = default;
+
+  template <typename Pool>
+  static auto of (Pool& pool) noexcept -> Executor;
+
+  // ---------------------------------------------------
+  // public api
+  auto execute (FunctionWrapper&& task) const -> bool;
+  explicit operator bool () const noexcept;
+
+private:
+
+  // ---------------------------------------------------
+  // private data
+  void*    context {nullptr};
+  postType post {nullptr};
+};
+
+
+/// stored in place of the value of a future of void
+struct VoidResult {};
+
+
+/**
+ * @class FutureState
+ * @brief FutureState is the shared state of a Future and its Promise. It holds the result,
+ *        which is either a value or an exception, and at most one continuation.
+ */
+template <typename T>
+class FutureState {
+
+  using storageType = std::conditional_t<std::is_void_v<T>, VoidResult, T>;
+
+public:
+
+  // ---------------------------------------------------
+  // construction
+  explicit FutureState (Executor executor);
+  FutureState          (FutureState const&) = delete;
+  auto operator=       (FutureState const&) -> FutureState& = delete;
+
+  // ---------------------------------------------------
+  // public api
+  template <typename... Args>
+  void setValue        (Args&&... args);
+  void setException    (std::exception_ptr exPtr);
+  auto isReady         () const -> bool;
+  void wait            () const;
+  auto takeValue       () -> T;
+  auto copyValue       () const -> T;
+  auto exception       () const -> std::exception_ptr;
+  void setContinuation (FunctionWrapper&& task, Executor taskExecutor);
+  auto addContinuation (FunctionWrapper&& task, Executor taskExecutor) -> bool;
+  auto executor        () const noexcept -> Executor;
+
+  std::atomic<bool> futureRetrieved {false};
+
+private:
+
+  // ---------------------------------------------------
+  // private data
+  mutable std::mutex              mutex;
+  mutable std::condition_variable readyCondVar;
+  bool                            ready {false};
+  std::optional<storageType>      value;
+  std::exception_ptr              exPtr;
+  FunctionWrapper                 continuation;
+  Executor                        continuationExecutor;
+  Executor                        defaultExecutor;
+
+  // ---------------------------------------------------
+  // auxiliary methods
+  template <typename Setter>
+  void complete (Setter&& setter);
+};
+
+
+/**
+ * @brief FutureAccess grants the free functions of this file access to the shared state of a future.
+ */
+struct FutureAccess {
+  template <typename T>
+  static auto state (Future<T>& future) -> std::shared_ptr<FutureState<T>>;
+};
+
+
+template <typename T>
+struct IsFutureT : std::false_type {};
+
+template <typename T>
+struct IsFutureT<Future<T>> : std::true_type {};
+
+/**
+ * @brief ContinuationResult is the result type of a continuation invoked with the value
+ *        of a future of T. A continuation returning a future is unwrapped.
+ */
+template <typename T, typename F>
+struct InvokeResultT {
+  using type = std::invoke_result_t<F, T>;
+};
+
+template <typename F>
+struct InvokeResultT<void, F> {
+  using type = std::invoke_result_t<F>;
+};
+
+template <typename R>
+struct UnwrapFutureT {
+  using type = R;
+};
+
+template <typename R>
+struct UnwrapFutureT<Future<R>> {
+  using type = R;
+};
+
+template <typename T, typename F>
+using ContinuationResult = typename UnwrapFutureT<typename InvokeResultT<T, std::decay_t<F>>::type>::type;
+
+
+template <typename T, typename F, typename... Args>
+void fulfil (Promise<T>& promise, F& f, Args&&... args) noexcept;
+
+template <typename T>
+void forwardResult (std::shared_ptr<FutureState<T>> const& source, Promise<T>& promise) noexcept;
+
+
+}   // namespace detail
+
+
+/**
+ * @class  Future
+ * @brief  Future provides access to the result of an asynchronous operation. Instead of
+ *         blocking a thread, a continuation can be attached with then, which is scheduled
+ *         on a thread pool as soon as the result is available.
+ * @remark A future created by ThreadPool::async runs its continuations on the same pool,
+ *         unless another pool is passed to then. Futures without a pool run their
+ *         continuations inline on the thread that completes them.
+ */
+template <typename T>
+class Future {
+
+  friend class Promise<T>;
+  friend struct detail::FutureAccess;
+
+public:
+
+  // ---------------------------------------------------
+  // public types
+  using value_type = T;
+
+  // ---------------------------------------------------
+  // special member functions
+  Future         () = default;
+  Future         (Future const&) = delete;
+  Future         (Future&&) noexcept = default;
+  auto operator= (Future const&) -> Future& = delete;
+  auto operator= (Future&&) noexcept -> Future& = default;
+  ~Future        () = default;
+
+  // ---------------------------------------------------
+  // public api
+  [[nodiscard]] auto valid   () const noexcept -> bool;
+  [[nodiscard]] auto isReady () const -> bool;
+  void               wait    () const;
+  auto               get     () -> T;
+
+  template <typename F>
+  auto then (F&& f) -> Future<detail::ContinuationResult<T, F>>;
+  template <typename Pool, typename F>
+  auto then (Pool& pool, F&& f) -> Future<detail::ContinuationResult<T, F>>;
+
+private:
+
+  // ---------------------------------------------------
+  // private data
+  std::shared_ptr<detail::FutureState<T>> state;
+
+  // ---------------------------------------------------
+  // auxiliary methods
+  explicit Future (std::shared_ptr<detail::FutureState<T>> state) noexcept;
+
+  auto checkState () const -> detail::FutureState<T>&;
+  template <typename F>
+  auto thenImpl   (detail::Executor executor, F&& f) -> Future<detail::ContinuationResult<T, F>>;
+};
+
+
+/**
+ * @class  Promise
+ * @brief  Promise is the producing side of a Future.
+ * @remark If a promise is destroyed before a result has been set, the future receives a
+ *         std::future_error with the error code broken_promise.
+ */
+template <typename T>
+class Promise {
+
+  template <typename Pool>
+  using requiresPool = std::enable_if_t<!std::is_same_v<std::decay_t<Pool>, Promise>>;
+
+public:
+
+  // ---------------------------------------------------
+  // special member functions
+  Promise        ();
+  template <typename Pool, typename = requiresPool<Pool>>
+  explicit Promise (Pool& pool);
+  Promise        (Promise const&) = delete;
+  Promise        (Promise&&) noexcept = default;
+  auto operator= (Promise const&) -> Promise& = delete;
+  auto operator= (Promise&& src) noexcept -> Promise&;
+  ~Promise       ();
+
+  // ---------------------------------------------------
+  // public api
+  auto getFuture    () -> Future<T>;
+  template <typename... Args>
+  void setValue     (Args&&... args);
+  void setException (std::exception_ptr exPtr);
+
+private:
+
+  // ---------------------------------------------------
+  // private data
+  std::shared_ptr<detail::FutureState<T>> state;
+
+  // ---------------------------------------------------
+  // auxiliary methods
+  explicit Promise (detail::Executor executor);
+
+  auto checkState   () const -> detail::FutureState<T>&;
+  void breakPromise () noexcept;
+
+  template <typename U>
+  friend class Future;
+};
+
+
+// ---------------------------------------------------
+// combinators
+template <typename T>
+auto whenAll (std::vector<Future<T>> futures)
+  -> Future<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>>;
+
+template <typename T>
+auto whenAny (std::vector<Future<T>> futures)
+  -> Future<std::conditional_t<std::is_void_v<T>, std::size_t, std::pair<std::size_t, T>>>;
+
+
+// ---------------------------------------------------
+// implementation of Executor
+
+/**
+ * @brief Returns an executor posting its tasks to a given pool, which must provide a method post
+ *        taking a FunctionWrapper. If post returns a bool, false means that the pool rejected the task.
+ */
+template <typename Pool>
+inline auto detail::Executor::of(Pool& pool) noexcept -> Executor
+{
+  Executor executor;
+  executor.context = &pool;
+  executor.post    = [](void* context, FunctionWrapper&& task) -> bool {
+    if constexpr(std::is_void_v<decltype(static_cast<Pool*>(context)->post(std::move(task)))>)
+    {
+      static_cast<Pool*>(context)->post(std::move(task));
+      return true;
+    }
+    else
+    {
+      return static_cast<Pool*>(context)->post(std::move(task));
+    }
+  };
+  return executor;
+}
+
+/**
+ * @brief  Posts a task to the pool or runs it inline if the executor is empty.
+ * @return false, if the pool rejected the task, e.g. because it has been deactivated.
+ */
+inline auto detail::Executor::execute(FunctionWrapper&& task) const -> bool
+{
+  if(post != nullptr)
+  {
+    return post(context, std::move(task));
+  }
+
+  task();
+  return true;
+}
+
+/**
+ * @brief Checks whether the executor refers to a pool.
+ */
+inline detail::Executor::operator bool() const noexcept
+{
+  return post != nullptr;
+}
+
+
+// ---------------------------------------------------
+// implementation of FutureState
+
+/**
+ * @brief Constructor.
+ * @param executor the default executor of continuations attached to the future.
+ */
+template <typename T>
+inline detail::FutureState<T>::FutureState(Executor executor)
+  : defaultExecutor {executor}
+{}
+
+/**
+ * @brief Stores a value constructed from given arguments and runs the continuation.
+ * @throw std::future_error if a result has already been set.
+ */
+template <typename T>
+template <typename... Args>
+inline void detail::FutureState<T>::setValue(Args&&... args)
+{
+  complete([this, &args...] { value.emplace(std::forward<Args>(args)...); });
+}
+
+/**
+ * @brief Stores an exception and runs the continuation.
+ * @throw std::future_error if a result has already been set.
+ */
+template <typename T>
+inline void detail::FutureState<T>::setException(std::exception_ptr exception)
+{
+  complete([this, &exception] { exPtr = std::move(exception); });
+}
+
+/**
+ * @brief Checks whether a result has been set.
+ */
+template <typename T>
+inline auto detail::FutureState<T>::isReady() const -> bool
+{
+  // ------- begin critical section ------- //
+  std::lock_guard lck(mutex);
+  return ready;
+}
+
+/**
+ * @brief Blocks until a result has been set.
+ */
+template <typename T>
+inline void detail::FutureState<T>::wait() const
+{
+  // ------- begin critical section ------- //
+  std::unique_lock lck(mutex);
+  readyCondVar.wait(lck, [this] { return ready; });
+}
+
+/**
+ * @brief Moves the value out of the state or rethrows the stored exception.
+ *        Must only be called once after the result has been set.
+ */
+template <typename T>
+inline auto detail::FutureState<T>::takeValue() -> T
+{
+  if(exPtr)
+  {
+    std::rethrow_exception(exPtr);
+  }
+  if constexpr(!std::is_void_v<T>)
+  {
+    return std::move(*value);
+  }
+}
+
+/**
+ * @brief Returns a copy of the value or rethrows the stored exception, leaving the value in
+ *        the state. Must only be called after the result has been set.
+ */
+template <typename T>
+inline auto detail::FutureState<T>::copyValue() const -> T
+{
+  if(exPtr)
+  {
+    std::rethrow_exception(exPtr);
+  }
+  if constexpr(!std::is_void_v<T>)
+  {
+    return *value;
+  }
+}
+
+/**
+ * @brief Returns the stored exception, which is empty if a value has been set.
+ *        Must only be called after the result has been set.
+ */
+template <typename T>
+inline auto detail::FutureState<T>::exception() const -> std::exception_ptr
+{
+  return exPtr;
+}
+
+/**
+ * @brief Attaches a continuation that is handed to a given executor as soon as the result is set.
+ *        If the result is already available, the continuation is executed immediately.
+ */
+template <typename T>
+void detail::FutureState<T>::setContinuation(FunctionWrapper&& task, Executor taskExecutor)
+{
+  if(!addContinuation(std::move(task), taskExecutor))
+  {
+    taskExecutor.execute(std::move(task));
+  }
+}
+
+/**
+ * @brief  Attaches a continuation that is handed to a given executor as soon as the result is set,
+ *         unless the result is already available.
+ * @return false, if the result is already available. The task is left untouched in that case.
+ */
+template <typename T>
+auto detail::FutureState<T>::addContinuation(FunctionWrapper&& task, Executor taskExecutor) -> bool
+{
+  // ------- begin critical section ------- //
+  std::lock_guard lck(mutex);
+  if(ready)
+  {
+    return false;
+  }
+  continuation         = std::move(task);
+  continuationExecutor = taskExecutor;
+  return true;
+}
+
+/**
+ * @brief Returns the executor of continuations for which no executor has been specified.
+ */
+template <typename T>
+inline auto detail::FutureState<T>::executor() const noexcept -> Executor
+{
+  return defaultExecutor;
+}
+
+/**
+ * @brief Sets the result by means of a given setter, wakes up all waiting threads
+ *        and hands over the continuation to its executor.
+ */
+template <typename T>
+template <typename Setter>
+void detail::FutureState<T>::complete(Setter&& setter)
+{
+  FunctionWrapper task;
+  Executor        taskExecutor;
+  {
+    // ------- begin critical section ------- //
+    std::lock_guard lck(mutex);
+    if(ready)
+    {
+      throw std::future_error(std::future_errc::promise_already_satisfied);
+    }
+    setter();
+    ready        = true;
+    task         = std::move(continuation);
+    taskExecutor = continuationExecutor;
+  }
+  // -------- end critical section -------- //
+
+  readyCondVar.notify_all();
+  if(task)
+  {
+    taskExecutor.execute(std::move(task));
+  }
+}
+
+
+// ---------------------------------------------------
+// implementation of Future
+
+/**
+ * @brief Constructor. Takes over a given shared state.
+ */
+template <typename T>
+inline Future<T>::Future(std::shared_ptr<detail::FutureState<T>> state) noexcept
+  : state {std::move(state)}
+{}
+
+/**
+ * @brief Checks if the future refers to a shared state.
+ */
+template <typename T>
+inline auto Future<T>::valid() const noexcept -> bool
+{
+  return state != nullptr;
+}
+
+/**
+ * @brief Checks if the result is available.
+ * @throw std::future_error if the future has no shared state.
+ */
+template <typename T>
+inline auto Future<T>::isReady() const -> bool
+{
+  return checkState().isReady();
+}
+
+/**
+ * @brief Blocks until the result is available.
+ * @throw std::future_error if the future has no shared state.
+ */
+template <typename T>
+inline void Future<T>::wait() const
+{
+  checkState().wait();
+}
+
+/**
+ * @brief Blocks until the result is available and returns it. Afterwards, the future is invalid.
+ * @throw std::future_error if the future has no shared state, or the exception stored in the state.
+ */
+template <typename T>
+auto Future<T>::get() -> T
+{
+  checkState().wait();
+  auto current = std::move(state);
+  return current->takeValue();
+}
+
+/**
+ * @brief Attaches a continuation, which is invoked with the value of this future. It runs on the
+ *        pool this future belongs to. If this future holds an exception, the continuation is
+ *        skipped and the exception is passed on. Afterwards, this future is invalid.
+ * @return a future holding the result of the continuation. If the continuation returns a future
+ *         itself, the returned future completes along with it.
+ */
+template <typename T>
+template <typename F>
+inline auto Future<T>::then(F&& f) -> Future<detail::ContinuationResult<T, F>>
+{
+  return thenImpl(checkState().executor(), std::forward<F>(f));
+}
+
+/**
+ * @brief Attaches a continuation, which runs on a given pool. See then(f).
+ */
+template <typename T>
+template <typename Pool, typename F>
+inline auto Future<T>::then(Pool& pool, F&& f) -> Future<detail::ContinuationResult<T, F>>
+{
+  return thenImpl(detail::Executor::of(pool), std::forward<F>(f));
+}
+
+/**
+ * @brief Returns the shared state.
+ * @throw std::future_error if the future has no shared state.
+ */
+template <typename T>
+inline auto Future<T>::checkState() const -> detail::FutureState<T>&
+{
+  if(!state)
+  {
+    throw std::future_error(std::future_errc::no_state);
+  }
+  return *state;
+}
+
+/**
+ * @brief Attaches a continuation executed by a given executor.
+ */
+template <typename T>
+template <typename F>
+auto Future<T>::thenImpl(detail::Executor executor, F&& f) -> Future<detail::ContinuationResult<T, F>>
+{
+  using resultType = detail::ContinuationResult<T, F>;
+
+  checkState();
+  Promise<resultType> promise(executor);
+  auto result = promise.getFuture();
+
+  // the continuation keeps the state alive, the cycle is broken as soon as the state runs it
+  auto source        = std::move(state);
+  auto* const shared = source.get();
+  shared->setContinuation(
+    [source = std::move(source), promise = std::move(promise), f = std::forward<F>(f)]() mutable {
+      if(auto exPtr = source->exception())
+      {
+        promise.setException(std::move(exPtr));
+      }
+      else if constexpr(std::is_void_v<T>)
+      {
+        detail::fulfil(promise, f);
+      }
+      else
+      {
+        detail::fulfil(promise, f, source->takeValue());
+      }
+    },
+    executor);
+
+  return result;
+}
+
+
+// ---------------------------------------------------
+// implementation of Promise
+
+/**
+ * @brief Constructor. Continuations of the future run inline.
+ */
+template <typename T>
+inline Promise<T>::Promise()
+  : Promise(detail::Executor{})
+{}
+
+/**
+ * @brief Constructor. Continuations of the future run on a given pool by default.
+ */
+template <typename T>
+template <typename Pool, typename>
+inline Promise<T>::Promise(Pool& pool)
+  : Promise(detail::Executor::of(pool))
+{}
+
+/**
+ * @brief Constructor. Creates the shared state.
+ */
+template <typename T>
+inline Promise<T>::Promise(detail::Executor executor)
+  : state {std::make_shared<detail::FutureState<T>>(executor)}
+{}
+
+/**
+ * @brief Move assignment. The promise held before is broken if it hasn't been satisfied.
+ */
+template <typename T>
+inline auto Promise<T>::operator=(Promise&& src) noexcept -> Promise&
+{
+  if(this != &src)
+  {
+    breakPromise();
+    state = std::move(src.state);
+  }
+  return *this;
+}
+
+/**
+ * @brief Destructor. Breaks the promise if it hasn't been satisfied.
+ */
+template <typename T>
+inline Promise<T>::~Promise()
+{
+  breakPromise();
+}
+
+/**
+ * @brief Returns the future associated with this promise.
+ * @throw std::future_error if the future has already been retrieved or the promise has no state.
+ */
+template <typename T>
+inline auto Promise<T>::getFuture() -> Future<T>
+{
+  if(checkState().futureRetrieved.exchange(true))
+  {
+    throw std::future_error(std::future_errc::future_already_retrieved);
+  }
+  return Future<T>(state);
+}
+
+/**
+ * @brief Stores a value constructed from given arguments. Continuations are scheduled.
+ * @throw std::future_error if a result has already been set or the promise has no state.
+ */
+template <typename T>
+template <typename... Args>
+inline void Promise<T>::setValue(Args&&... args)
+{
+  checkState().setValue(std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Stores an exception. Continuations are scheduled.
+ * @throw std::future_error if a result has already been set or the promise has no state.
+ */
+template <typename T>
+inline void Promise<T>::setException(std::exception_ptr exPtr)
+{
+  checkState().setException(std::move(exPtr));
+}
+
+/**
+ * @brief Returns the shared state.
+ * @throw std::future_error if the promise has no shared state.
+ */
+template <typename T>
+inline auto Promise<T>::checkState() const -> detail::FutureState<T>&
+{
+  if(!state)
+  {
+    throw std::future_error(std::future_errc::no_state);
+  }
+  return *state;
+}
+
+/**
+ * @brief Stores a broken_promise error if no result has been set yet.
+ */
+template <typename T>
+void Promise<T>::breakPromise() noexcept
+{
+  if(state && !state->isReady())
+  {
+    try
+    {
+      state->setException(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+    }
+    catch(...) // a result may have been set concurrently
+    {}
+  }
+  state.reset();
+}
+
+
+// ---------------------------------------------------
+// implementation of the detail functions
+
+/**
+ * @brief Returns the shared state of a future.
+ */
+template <typename T>
+inline auto detail::FutureAccess::state(Future<T>& future) -> std::shared_ptr<FutureState<T>>
+{
+  future.checkState();
+  return std::move(future.state);
+}
+
+/**
+ * @brief Invokes a given function with given arguments and stores its result or the thrown exception
+ *        in a given promise. If the function returns a future, the promise is satisfied by that future.
+ */
+template <typename T, typename F, typename... Args>
+void detail::fulfil(Promise<T>& promise, F& f, Args&&... args) noexcept
+{
+  using invokeResult = std::invoke_result_t<F&, Args...>;
+  try
+  {
+    if constexpr(IsFutureT<invokeResult>::value)
+    {
+      auto inner = std::invoke(f, std::forward<Args>(args)...);
+      auto state = FutureAccess::state(inner);
+      auto* const shared = state.get();
+      shared->setContinuation([state = std::move(state), promise = std::move(promise)]() mutable {
+        forwardResult(state, promise);
+      }, Executor{});
+    }
+    else if constexpr(std::is_void_v<invokeResult>)
+    {
+      std::invoke(f, std::forward<Args>(args)...);
+      promise.setValue();
+    }
+    else
+    {
+      promise.setValue(std::invoke(f, std::forward<Args>(args)...));
+    }
+  }
+  catch(...)
+  {
+    promise.setException(std::current_exception());
+  }
+}
+
+/**
+ * @brief Passes the result of a ready shared state to a given promise.
+ */
+template <typename T>
+void detail::forwardResult(std::shared_ptr<FutureState<T>> const& source, Promise<T>& promise) noexcept
+{
+  try
+  {
+    if(auto exPtr = source->exception())
+    {
+      promise.setException(std::move(exPtr));
+    }
+    else if constexpr(std::is_void_v<T>)
+    {
+      promise.setValue();
+    }
+    else
+    {
+      promise.setValue(source->takeValue());
+    }
+  }
+  catch(...)
+  {
+    promise.setException(std::current_exception());
+  }
+}
+
+
+// ---------------------------------------------------
+// implementation of the combinators
+
+/**
+ * @brief  Returns a future that becomes ready when all given futures are ready. It holds the values
+ *         in the order of the given futures, or the exception of the first future holding one.
+ * @remark The returned future runs its continuations inline.
+ */
+template <typename T>
+auto whenAll(std::vector<Future<T>> futures)
+  -> Future<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>>
+{
+  using resultType  = std::conditional_t<std::is_void_v<T>, void, std::vector<T>>;
+  using storageType = std::conditional_t<std::is_void_v<T>, detail::VoidResult, T>;
+
+  struct Collector {
+    std::mutex                              mutex;
+    std::vector<std::optional<storageType>> values;
+    std::exception_ptr                      exPtr;
+    std::atomic<std::size_t>                numPending;
+    Promise<resultType>                     promise;
+  };
+
+  auto collector        = std::make_shared<Collector>();
+  auto result           = collector->promise.getFuture();
+  collector->numPending = futures.size();
+  collector->values.resize(futures.size());
+
+  if(futures.empty())
+  {
+    if constexpr(std::is_void_v<T>)
+    {
+      collector->promise.setValue();
+    }
+    else
+    {
+      collector->promise.setValue(resultType{});
+    }
+    return result;
+  }
+
+  for(std::size_t i {}; i < futures.size(); ++i)
+  {
+    auto state         = detail::FutureAccess::state(futures[i]);
+    auto* const shared = state.get();
+    shared->setContinuation([collector, i, state = std::move(state)]() mutable {
+      {
+        // ------- begin critical section ------- //
+        std::lock_guard lck(collector->mutex);
+        if(auto exPtr = state->exception())
+        {
+          if(!collector->exPtr)
+          {
+            collector->exPtr = std::move(exPtr);
+          }
+        }
+        else if constexpr(std::is_void_v<T>)
+        {
+          collector->values[i].emplace();
+        }
+        else
+        {
+          collector->values[i].emplace(state->takeValue());
+        }
+      }
+      // -------- end critical section -------- //
+
+      if(--collector->numPending == 0ULL)
+      {
+        if(collector->exPtr)
+        {
+          collector->promise.setException(collector->exPtr);
+        }
+        else if constexpr(std::is_void_v<T>)
+        {
+          collector->promise.setValue();
+        }
+        else
+        {
+          std::vector<T> values;
+          values.reserve(collector->values.size());
+          for(auto& value : collector->values)
+          {
+            values.push_back(std::move(*value));
+          }
+          collector->promise.setValue(std::move(values));
+        }
+      }
+    }, detail::Executor{});
+  }
+
+  return result;
+}
+
+/**
+ * @brief  Returns a future that becomes ready as soon as one of the given futures is ready.
+ *         It holds the index of that future and its value, or its exception.
+ * @remark The returned future runs its continuations inline.
+ * @throw  std::invalid_argument if no future is given.
+ */
+template <typename T>
+auto whenAny(std::vector<Future<T>> futures)
+  -> Future<std::conditional_t<std::is_void_v<T>, std::size_t, std::pair<std::size_t, T>>>
+{
+  using resultType = std::conditional_t<std::is_void_v<T>, std::size_t, std::pair<std::size_t, T>>;
+
+  if(futures.empty())
+  {
+    throw std::invalid_argument("whenAny requires at least one future");
+  }
+
+  struct Selector {
+    std::atomic<bool>   done {false};
+    Promise<resultType> promise;
+  };
+
+  auto selector = std::make_shared<Selector>();
+  auto result   = selector->promise.getFuture();
+
+  for(std::size_t i {}; i < futures.size(); ++i)
+  {
+    auto state         = detail::FutureAccess::state(futures[i]);
+    auto* const shared = state.get();
+    shared->setContinuation([selector, i, state = std::move(state)]() mutable {
+      if(selector->done.exchange(true))
+      {
+        return;
+      }
+
+      if(auto exPtr = state->exception())
+      {
+        selector->promise.setException(std::move(exPtr));
+      }
+      else if constexpr(std::is_void_v<T>)
+      {
+        selector->promise.setValue(i);
+      }
+      else
+      {
+        selector->promise.setValue(i, state->takeValue());
+      }
+    }, detail::Executor{});
+  }
+
+  return result;
+}
+
+
+}   // namespace cctools
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // FUTURE_H_37465019283746501928374650192837465019283746
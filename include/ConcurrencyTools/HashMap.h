@@ -22,11 +22,14 @@
 #include "detail/FunctionTraits.h"
 
 #include <algorithm>
+#include <atomic>
 #include <initializer_list>
+#include <iterator>
 #include <list>
 #include <memory>
 #include <mutex>
-#include <numeric>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -36,8 +39,14 @@ namespace cctools {
  
 /**
  * @class HashMapT
- * @brief HashMapT is a queue that allows access to its elements
- *        according to specified threading policy
+ * @brief  HashMapT is a queue that allows access to its elements
+ *         according to specified threading policy
+ * @remark If the threading policy provides more than one mutex, the map runs in striped mode:
+ *         bucket i is guarded by mutex i % numMutexes of the map and the buckets themselves
+ *         don't hold a mutex.
+ * @remark If the threading policy publishes snapshots (ReadMostly), every bucket is an immutable
+ *         version that is replaced by the writers. Lookups don't lock at all. Since the elements
+ *         of a version are never modified, operator[] and at aren't available.
  */
 template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
           typename Hash = std::hash<Key>, typename... AdditionalPolicyArgs>
@@ -61,15 +70,11 @@ class HashMapT : public ThreadingPolicy<HashMapT<Key, Value, ThreadingPolicy, Ha
   // import the locking methods of the threading policy
   using threadingPolicy::lock;
   using threadingPolicy::lockUnique;
-  using threadingPolicy::lockShared;
 
 public:
 
   class Bucket;
-
-  // ---------------------------------------------------
-  // private types
-  using bucketContainer = std::vector<std::unique_ptr<Bucket>>;
+  class SnapshotBucket;
 
 public:
 
@@ -81,6 +86,23 @@ public:
   using hasher      = Hash;
   using size_type   = std::size_t;
 
+private:
+
+  // ---------------------------------------------------
+  // in striped mode, the mutexes of the map guard the buckets, which don't lock on their own
+  static constexpr bool isStriped = threadingPolicy::isStriped;
+  using bucketThreadingPolicy     = std::conditional_t<isStriped, SingleThreaded<Bucket>, ThreadingPolicy<Bucket, AdditionalPolicyArgs...>>;
+
+  // a policy publishing snapshots requires buckets that are replaced instead of modified
+  using bucketType      = std::conditional_t<publishesSnapshots<threadingPolicy>, SnapshotBucket, Bucket>;
+  using bucketContainer = std::vector<std::unique_ptr<bucketType>>;
+
+  // the element counter is only atomic if the map is accessed concurrently
+  using counterType = std::conditional_t<std::is_same_v<typename threadingPolicy::LockUnique, EmptyLock>, size_type,
+                                         std::atomic<size_type>>;
+
+public:
+
   // ---------------------------------------------------
   // special member functions
   HashMapT       (size_type nBuckets = 19ULL, hasher const& hash = hasher());
@@ -118,6 +140,8 @@ public:
   auto invoke                 (key_type const& key, F&& f) -> typename detail::FunctionTraits<F>::result_type;
   template <typename F, typename = requiresVoid<F>>
   void invoke                 (key_type const& key, F&& f);
+  template <typename F>
+  auto invoke                 (key_type const& key, F&& f) const -> std::invoke_result_t<F, mapped_type const&>;
 
 private:
 
@@ -126,14 +150,15 @@ private:
   size_type       numBuckets;
   hasher          elemHash;
   bucketContainer buckets;
+  counterType     numElements {0ULL};
 
   // ---------------------------------------------------
   // auxiliary methods
-  auto findBucket    (key_type const&) -> Bucket&;
-  auto findBucket    (key_type const&) const -> Bucket const&;
-  auto bucketIndex   (key_type const& key) const -> size_type;
-  void setupBuckets  ();
-  void moveFromOther (HashMapT&& src);
+  auto bucketIndex      (key_type const& key) const -> size_type;
+  auto lockBucket       (size_type i) const;
+  auto lockBucketShared (size_type i) const;
+  void setupBuckets     ();
+  void moveFromOther    (HashMapT&& src);
 };
 
 
@@ -143,10 +168,10 @@ private:
 template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
           typename Hash, typename... AdditionalPolicyArgs>
 class HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::Bucket
-  : public ThreadingPolicy<Bucket, AdditionalPolicyArgs...> {
+  : public HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::bucketThreadingPolicy {
 
   using hashmapType     = HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>;
-  using threadingPolicy = ThreadingPolicy<Bucket, AdditionalPolicyArgs...>;
+  using threadingPolicy = typename hashmapType::bucketThreadingPolicy;
 
   // import the locking methods of the threading policy
   using threadingPolicy::lock;
@@ -164,12 +189,12 @@ public:
   using size_type        = typename dataContainer::size_type;
   using iterator         = typename dataContainer::iterator;
   using const_iterator   = typename dataContainer::const_iterator;
-  using threading_policy = ThreadingPolicy<Bucket, AdditionalPolicyArgs...>;
+  using threading_policy = threadingPolicy;
 
   // ---------------------------------------------------
   // public api
   auto size            () const -> size_type;
-  auto get             (key_type const& key) -> mapped_type&;
+  auto get             (key_type const& key) -> std::pair<mapped_type&, bool>;
   auto getOrThrow      (key_type const& key) -> mapped_type&;
   auto contains        (key_type const& key) const -> bool;
   auto insertOrReplace (key_type const& key, mapped_type const& value) -> size_type;
@@ -187,6 +212,8 @@ public:
   auto invoke          (key_type const& key, F&& f) -> typename detail::FunctionTraits<F>::result_type;
   template <typename F, typename = hashmapType::template requiresVoid<F>>
   void invoke          (key_type const& key, F&& f);
+  template <typename F>
+  auto invoke          (key_type const& key, F&& f) const -> std::invoke_result_t<F, mapped_type const&>;
 
 private:
 
@@ -216,22 +243,23 @@ inline auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>
 
 /**
  * @brief Returns a reference to an element with a key equal to key. If no such element exists,
- *        a new element with the specified key is inserted.
+ *        a new element with the specified key is inserted. The flag tells whether an insertion took place.
  */
 template <typename Key, typename Value, template <typename...> class ThreadingPolicy, 
           typename Hash, typename... AdditionalPolicyArgs>
-auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::Bucket::get(key_type const& key) -> mapped_type&
+auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::Bucket::get(key_type const& key)
+  -> std::pair<mapped_type&, bool>
 {
   // ------- begin critical section ------- //
   auto lck = lockUnique();
 
   if(auto val = find(key); data.end() != val)
   {
-    return val->second;
+    return {val->second, false};
   }
 
   data.emplace_back(std::make_pair(key, mapped_type{}));
-  return data.back().second;
+  return {data.back().second, true};
 }
 
 /**
@@ -421,7 +449,7 @@ auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::Bucke
 {
   // ------- begin critical section ------- //
   {
-    auto lck = lockUnique();
+    auto lck = lockShared();
 
     for(auto& entry : data)
     {
@@ -463,6 +491,28 @@ inline void HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>
   std::forward<F>(f)(getOrThrowImpl(key));
 }
 
+/**
+ * @brief Applies a given function to the element with a specified key without modifying it.
+ *        If no such element exists, an exception is thrown.
+ * @throw std::out_of_range
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+template <typename F>
+auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::Bucket::invoke(key_type const& key, F&& f) const
+  -> std::invoke_result_t<F, mapped_type const&>
+{
+  // ------- begin critical section ------- //
+  auto lck = lockShared();
+
+  auto const val = find(key);
+  if(val == data.end())
+  {
+    throw std::out_of_range("entry with given key not found");
+  }
+  return std::forward<F>(f)(val->second);
+}
+
 /**
  * @brief Returns an iterator to the first element with a specified key.
  */
@@ -501,6 +551,375 @@ auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::Bucke
 }
 
 
+/**
+ * @class HashMapT::SnapshotBucket
+ * @brief SnapshotBucket is the bucket used with a threading policy that publishes snapshots.
+ *        Its elements are stored in an immutable version. Writers copy the current version,
+ *        modify the copy and publish it, readers access the version they loaded without locking.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+class HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::SnapshotBucket
+  : public ThreadingPolicy<SnapshotBucket, AdditionalPolicyArgs...> {
+
+  using hashmapType     = HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>;
+  using threadingPolicy = ThreadingPolicy<SnapshotBucket, AdditionalPolicyArgs...>;
+
+  // import the locking methods of the threading policy
+  using threadingPolicy::lockUnique;
+  using threadingPolicy::lockShared;
+  using threadingPolicy::retire;
+
+public:
+
+  // ---------------------------------------------------
+  // public types
+  using key_type         = typename hashmapType::key_type;
+  using mapped_type      = typename hashmapType::mapped_type;
+  using value_type       = typename hashmapType::value_type;
+  using dataContainer    = std::vector<value_type>;
+  using size_type        = typename dataContainer::size_type;
+  using const_iterator   = typename dataContainer::const_iterator;
+  using threading_policy = threadingPolicy;
+
+  // ---------------------------------------------------
+  // special member functions
+  SnapshotBucket  ();
+  SnapshotBucket  (SnapshotBucket const&) = delete;
+  auto operator=  (SnapshotBucket const&) -> SnapshotBucket& = delete;
+  ~SnapshotBucket ();
+
+  // ---------------------------------------------------
+  // public api
+  auto size            () const -> size_type;
+  auto contains        (key_type const& key) const -> bool;
+  auto insertOrReplace (key_type const& key, mapped_type const& value) -> size_type;
+  auto insertOrReplace (key_type const& key, mapped_type&& value) -> size_type;
+  template <typename... Args>
+  auto emplace         (key_type const& key, Args&&... args) -> size_type;
+  auto removeMapping   (key_type const& key) -> size_type;
+  template <typename F>
+  auto forEach         (F&& f) -> F&&;
+  template <typename F>
+  auto forEachValue    (F&& f) -> F&&;
+  template <typename F>
+  auto forEachValue    (F&& f) const -> F&&;
+  template <typename F>
+  auto invoke          (key_type const& key, F&& f) -> std::invoke_result_t<F, mapped_type&>;
+  template <typename F>
+  auto invoke          (key_type const& key, F&& f) const -> std::invoke_result_t<F, mapped_type const&>;
+
+private:
+
+  // ---------------------------------------------------
+  // private data
+  std::atomic<dataContainer const*> version;
+
+  // ---------------------------------------------------
+  // auxiliary methods
+  template <typename Mapped>
+  auto insertOrReplaceImpl (key_type const& key, Mapped&& value) -> size_type;
+  void publish             (std::unique_ptr<dataContainer> next);
+
+  static auto find (dataContainer const& data, key_type const& key) -> const_iterator;
+};
+
+
+/**
+ * @brief Constructor. Publishes an empty version.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::SnapshotBucket::SnapshotBucket()
+  : version {new dataContainer{}}
+{}
+
+/**
+ * @brief Destructor. Versions replaced earlier are deleted by the EpochDomain.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::SnapshotBucket::~SnapshotBucket()
+{
+  delete version.load();
+}
+
+/**
+ * @brief Returns the number of elements of the current version. Doesn't block.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::SnapshotBucket::size() const -> size_type
+{
+  // ------- begin read-side critical section ------- //
+  auto lck = lockShared();
+  return version.load()->size();
+}
+
+/**
+ * @brief Checks if an element with a given key is present. Doesn't block.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::SnapshotBucket::contains(key_type const& key) const -> bool
+{
+  // ------- begin read-side critical section ------- //
+  auto lck         = lockShared();
+  auto const& data = *version.load();
+  return find(data, key) != data.end();
+}
+
+/**
+ * @brief Inserts a new element into the bucket. If there is already an element with the given key,
+ *        its value is replaced by the given value.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::SnapshotBucket::insertOrReplace(key_type const& key, mapped_type const& value) -> size_type
+{
+  return insertOrReplaceImpl(key, value);
+}
+
+/**
+ * @brief Inserts a new element into the bucket. If there is already an element with the given key,
+ *        its value is replaced by the given value.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::SnapshotBucket::insertOrReplace(key_type const& key, mapped_type&& value) -> size_type
+{
+  return insertOrReplaceImpl(key, std::move(value));
+}
+
+/**
+ * @brief  Inserts a new element constructed in place if no such element with a key equal to key
+ *         can be found. Otherwise, the existing element is replaced by a new constructed element.
+ * @params args... the parameters forwarded to the constructor of the new element.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+template <typename... Args>
+auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::SnapshotBucket::emplace(key_type const& key, Args&&... args) -> size_type
+{
+  // ------- begin critical section ------- //
+  auto lck  = lockUnique();
+  auto next = std::make_unique<dataContainer>(*version.load());
+
+  size_type inserted {0ULL};
+  if(auto const val = find(*next, key); val != next->cend())
+  {
+    (*next)[static_cast<size_type>(val - next->cbegin())].second = mapped_type{std::forward<Args>(args)...};
+  }
+  else
+  {
+    next->emplace_back(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+    inserted = 1ULL;
+  }
+
+  publish(std::move(next));
+  return inserted;
+}
+
+/**
+ * @brief Searches for an element with a key equal to key and erases it.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::SnapshotBucket::removeMapping(key_type const& key) -> size_type
+{
+  // ------- begin critical section ------- //
+  auto lck           = lockUnique();
+  auto const& actual = *version.load();
+
+  auto const val = find(actual, key);
+  if(val == actual.end())
+  {
+    return 0ULL;
+  }
+
+  // value_type has a const key and is not assignable, hence the remaining elements are copied
+  auto next = std::make_unique<dataContainer>();
+  next->reserve(actual.size() - 1ULL);
+  std::copy_if(actual.begin(), actual.end(), std::back_inserter(*next),
+               [&val](value_type const& v) { return &v != &*val; });
+
+  publish(std::move(next));
+  return 1ULL;
+}
+
+/**
+ * @brief Applies a given function to every value in the bucket and publishes the result.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+template <typename F>
+auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::SnapshotBucket::forEach(F&& f) -> F&&
+{
+  // ------- begin critical section ------- //
+  {
+    auto lck  = lockUnique();
+    auto next = std::make_unique<dataContainer>(*version.load());
+    for(auto& [key, val] : *next)
+    {
+      std::forward<F>(f)(val);
+    }
+    publish(std::move(next));
+  }
+  // -------- end critical section -------- //
+
+  return std::forward<F>(f);
+}
+
+/**
+ * @brief Applies a given function to every key-value pair in the bucket and publishes the result.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+template <typename F>
+auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::SnapshotBucket::forEachValue(F&& f) -> F&&
+{
+  // ------- begin critical section ------- //
+  {
+    auto lck  = lockUnique();
+    auto next = std::make_unique<dataContainer>(*version.load());
+    for(auto& entry : *next)
+    {
+      std::forward<F>(f)(entry);
+    }
+    publish(std::move(next));
+  }
+  // -------- end critical section -------- //
+
+  return std::forward<F>(f);
+}
+
+/**
+ * @brief Applies a given function to every key-value pair of the current version. Doesn't block.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+template <typename F>
+auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::SnapshotBucket::forEachValue(F&& f) const -> F&&
+{
+  // ------- begin read-side critical section ------- //
+  {
+    auto lck = lockShared();
+    for(auto const& entry : *version.load())
+    {
+      std::forward<F>(f)(entry);
+    }
+  }
+  // -------- end read-side critical section -------- //
+
+  return std::forward<F>(f);
+}
+
+/**
+ * @brief Applies a given function to the element with a specified key and publishes the result.
+ *        If no such element exists, an exception is thrown.
+ * @throw std::out_of_range
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+template <typename F>
+auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::SnapshotBucket::invoke(key_type const& key, F&& f) -> std::invoke_result_t<F, mapped_type&>
+{
+  // ------- begin critical section ------- //
+  auto lck  = lockUnique();
+  auto next = std::make_unique<dataContainer>(*version.load());
+
+  auto const val = find(*next, key);
+  if(val == next->cend())
+  {
+    throw std::out_of_range("entry with given key not found");
+  }
+
+  auto& value = (*next)[static_cast<size_type>(val - next->cbegin())].second;
+  if constexpr(std::is_void_v<std::invoke_result_t<F, mapped_type&>>)
+  {
+    std::forward<F>(f)(value);
+    publish(std::move(next));
+  }
+  else
+  {
+    auto result = std::forward<F>(f)(value);
+    publish(std::move(next));
+    return result;
+  }
+}
+
+/**
+ * @brief Applies a given function to the element with a specified key of the current version.
+ *        Doesn't block. If no such element exists, an exception is thrown.
+ * @throw std::out_of_range
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+template <typename F>
+auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::SnapshotBucket::invoke(key_type const& key, F&& f) const -> std::invoke_result_t<F, mapped_type const&>
+{
+  // ------- begin read-side critical section ------- //
+  auto lck         = lockShared();
+  auto const& data = *version.load();
+
+  auto const val = find(data, key);
+  if(val == data.end())
+  {
+    throw std::out_of_range("entry with given key not found");
+  }
+  return std::forward<F>(f)(val->second);
+}
+
+/**
+ * @brief Inserts a new element or replaces the value of an existing one.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+template <typename Mapped>
+auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::SnapshotBucket::insertOrReplaceImpl(key_type const& key, Mapped&& value) -> size_type
+{
+  // ------- begin critical section ------- //
+  auto lck  = lockUnique();
+  auto next = std::make_unique<dataContainer>(*version.load());
+
+  size_type inserted {0ULL};
+  if(auto const val = find(*next, key); val != next->cend())
+  {
+    (*next)[static_cast<size_type>(val - next->cbegin())].second = std::forward<Mapped>(value);
+  }
+  else
+  {
+    next->emplace_back(key, std::forward<Mapped>(value));
+    inserted = 1ULL;
+  }
+
+  publish(std::move(next));
+  return inserted;
+}
+
+/**
+ * @brief Replaces the current version by a given one and retires the old version, which
+ *        may still be accessed by readers that loaded it before. Must be called by a writer.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline void HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::SnapshotBucket::publish(std::unique_ptr<dataContainer> next)
+{
+  retire(version.exchange(next.release()));
+}
+
+/**
+ * @brief Returns a const iterator to the element with a specified key.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::SnapshotBucket::find(dataContainer const& data, key_type const& key) -> const_iterator
+{
+  return std::find_if(data.begin(), data.end(),
+                      [&key](value_type const& v) { return v.first == key; });
+}
+
+
 /**
  * @brief Constructor.
  * @param nBuckets the number of buckets used for the has map. Default is 19. It's a good
@@ -563,16 +982,14 @@ auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::opera
 }
 
 /**
- * @brief Returns the number of elements stored in the map.
+ * @brief Returns the number of elements stored in the map. The counter is maintained by the
+ *        modifying operations, hence no bucket needs to be locked.
  */
 template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
           typename Hash, typename... AdditionalPolicyArgs>
 inline [[nodiscard]] auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::size() const -> size_type
 {
-  // ------- begin critical section ------- //
-  auto lck = lockShared();
-  return std::accumulate(buckets.begin(), buckets.end(), 0ULL,
-                         [](size_type n, auto const& b) { return n + b->size(); });
+  return numElements;
 }
 
 /**
@@ -582,8 +999,6 @@ template <typename Key, typename Value, template <typename...> class ThreadingPo
           typename Hash, typename... AdditionalPolicyArgs>
 inline [[nodiscard]] auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::empty() const -> bool
 {
-  // ------- begin critical section ------- //
-  auto lck = lockShared();
   return size() == 0ULL;
 }
 
@@ -595,9 +1010,11 @@ template <typename Key, typename Value, template <typename...> class ThreadingPo
           typename Hash, typename... AdditionalPolicyArgs>
 inline [[nodiscard]] auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::contains(key_type const& key) const -> bool
 {
+  auto const i = bucketIndex(key);
+
   // ------- begin critical section ------- //
-  auto lck = lockShared();
-  return findBucket(key).contains(key);
+  auto lck = lockBucketShared(i);
+  return buckets[i]->contains(key);
 }
 
 /**
@@ -609,7 +1026,16 @@ template <typename Key, typename Value, template <typename...> class ThreadingPo
 template <typename>
 inline auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::operator[](key_type const& key) -> mapped_type&
 {
-  return findBucket(key).get(key);
+  auto const i = bucketIndex(key);
+
+  // ------- begin critical section ------- //
+  auto lck               = lockBucket(i);
+  auto [value, inserted] = buckets[i]->get(key);
+  if(inserted)
+  {
+    ++numElements;
+  }
+  return value;
 }
 
 /**
@@ -622,7 +1048,7 @@ template <typename Key, typename Value, template <typename...> class ThreadingPo
 template <typename, typename>
 inline auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::operator[](key_type const& key) -> mapped_type&
 {
-  return findBucket(key).getOrThrow(key);
+  return at(key);
 }
 
 /**
@@ -634,7 +1060,11 @@ template <typename Key, typename Value, template <typename...> class ThreadingPo
           typename Hash, typename... AdditionalPolicyArgs>
 inline auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::at(key_type const& key) -> mapped_type&
 {
-  return findBucket(key).getOrThrow(key);
+  auto const i = bucketIndex(key);
+
+  // ------- begin critical section ------- //
+  auto lck = lockBucketShared(i);
+  return buckets[i]->getOrThrow(key);
 }
 
 /**
@@ -646,7 +1076,11 @@ template <typename Key, typename Value, template <typename...> class ThreadingPo
 inline auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::insertOrReplace(key_type const& key,
                                                                                                   mapped_type const& value)
 {
-  findBucket(key).insertOrReplace(key, value);
+  auto const i = bucketIndex(key);
+
+  // ------- begin critical section ------- //
+  auto lck = lockBucket(i);
+  numElements += buckets[i]->insertOrReplace(key, value);
 }
 
 /**
@@ -658,7 +1092,11 @@ template <typename Key, typename Value, template <typename...> class ThreadingPo
 inline auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::insertOrReplace(key_type const& key,
                                                                                                   mapped_type&& value)
 {
-  findBucket(key).insertOrReplace(key, std::move(value));
+  auto const i = bucketIndex(key);
+
+  // ------- begin critical section ------- //
+  auto lck = lockBucket(i);
+  numElements += buckets[i]->insertOrReplace(key, std::move(value));
 }
 
 /**
@@ -671,7 +1109,13 @@ template <typename Key, typename Value, template <typename...> class ThreadingPo
 template <typename... Args>
 inline auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::emplace(key_type const& key, Args&&... args) -> size_type
 {
-  return findBucket(key).emplace(key, std::forward<Args>(args)...);
+  auto const i = bucketIndex(key);
+
+  // ------- begin critical section ------- //
+  auto lck = lockBucket(i);
+  auto const n = buckets[i]->emplace(key, std::forward<Args>(args)...);
+  numElements += n;
+  return n;
 }
 
 /**
@@ -682,7 +1126,13 @@ template <typename Key, typename Value, template <typename...> class ThreadingPo
           typename Hash, typename... AdditionalPolicyArgs>
 inline auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::erase(key_type const& key) -> size_type
 {
-  return findBucket(key).removeMapping(key);
+  auto const i = bucketIndex(key);
+
+  // ------- begin critical section ------- //
+  auto lck = lockBucket(i);
+  auto const n = buckets[i]->removeMapping(key);
+  numElements -= n;
+  return n;
 }
 
 /**
@@ -693,9 +1143,11 @@ template <typename Key, typename Value, template <typename...> class ThreadingPo
 template <typename F>
 auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::forEach(F&& f) -> F&&
 {
-  for(auto& bucket : buckets)
+  for(size_type i {}; i < buckets.size(); ++i)
   {
-    bucket->forEach(std::forward<F>(f));
+    // ------- begin critical section ------- //
+    auto lck = lockBucket(i);
+    buckets[i]->forEach(std::forward<F>(f));
   }
 
   return std::forward<F>(f);
@@ -709,9 +1161,11 @@ template <typename Key, typename Value, template <typename...> class ThreadingPo
 template <typename F>
 auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::forEachValue(F&& f) -> F&&
 {
-  for(auto& bucket : buckets)
+  for(size_type i {}; i < buckets.size(); ++i)
   {
-    bucket->forEachValue(std::forward<F>(f));
+    // ------- begin critical section ------- //
+    auto lck = lockBucket(i);
+    buckets[i]->forEachValue(std::forward<F>(f));
   }
 
   return std::forward<F>(f);
@@ -725,9 +1179,11 @@ template <typename Key, typename Value, template <typename...> class ThreadingPo
 template <typename F>
 auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::forEachValue(F&& f) const -> F&&
 {
-  for(auto& bucket : buckets)
+  for(size_type i {}; i < buckets.size(); ++i)
   {
-    bucket->forEachValue(std::forward<F>(f));
+    // ------- begin critical section ------- //
+    auto lck = lockBucketShared(i);
+    std::as_const(*buckets[i]).forEachValue(std::forward<F>(f));
   }
 
   return std::forward<F>(f);
@@ -744,7 +1200,11 @@ template <typename F, typename>
 inline auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::invoke(key_type const& key, F&& f)
   -> typename detail::FunctionTraits<F>::result_type
 {
-  return findBucket(key).invoke(key, std::forward<F>(f));
+  auto const i = bucketIndex(key);
+
+  // ------- begin critical section ------- //
+  auto lck = lockBucket(i);
+  return buckets[i]->invoke(key, std::forward<F>(f));
 }
 
 /**
@@ -757,37 +1217,75 @@ template <typename Key, typename Value, template <typename...> class ThreadingPo
 template <typename F, typename>
 inline void HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::invoke(key_type const& key, F&& f)
 {
-  findBucket(key).invoke(key, std::forward<F>(f));
+  auto const i = bucketIndex(key);
+
+  // ------- begin critical section ------- //
+  auto lck = lockBucket(i);
+  buckets[i]->invoke(key, std::forward<F>(f));
 }
 
 /**
- * @brief Returns a reference to the bucket for given key.
+ * @brief Applies a given function to the element with a specified key without modifying it.
+ *        If no such element exists, an exception is thrown.
+ * @throw std::out_of_range
  */
 template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
           typename Hash, typename... AdditionalPolicyArgs>
-inline auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::findBucket(key_type const& key) -> Bucket&
+template <typename F>
+inline auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::invoke(key_type const& key, F&& f) const
+  -> std::invoke_result_t<F, mapped_type const&>
 {
-  return *buckets[bucketIndex(key)];
+  auto const i = bucketIndex(key);
+
+  // ------- begin critical section ------- //
+  auto lck = lockBucketShared(i);
+  return std::as_const(*buckets[i]).invoke(key, std::forward<F>(f));
 }
 
 /**
- * @brief Returns a const reference to the bucket for given key.
+ * @brief Calculates the bucket index for a given key.
  */
-template <typename Key, typename Value, template <typename...> class ThreadingPolicy, 
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
           typename Hash, typename... AdditionalPolicyArgs>
-inline auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::findBucket(key_type const& key) const -> Bucket const&
+inline auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::bucketIndex(key_type const& key) const -> size_type
 {
-  return *buckets[bucketIndex(key)];
+  return elemHash(key) % numBuckets;
 }
 
 /**
- * @brief Calculates the bucket index for a given key.
+ * @brief Locks the stripe guarding the bucket with a given index. Without striping,
+ *        the buckets lock on their own and nothing is done.
  */
 template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
           typename Hash, typename... AdditionalPolicyArgs>
-inline auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::bucketIndex(key_type const& key) const -> size_type
+inline auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::lockBucket(size_type i) const
 {
-  return elemHash(key) % numBuckets;
+  if constexpr(isStriped)
+  {
+    return lockUnique(i % threadingPolicy::numMutexes);
+  }
+  else
+  {
+    return EmptyLock{};
+  }
+}
+
+/**
+ * @brief Locks the stripe guarding the bucket with a given index for reading. Without striping,
+ *        the buckets lock on their own and nothing is done.
+ */
+template <typename Key, typename Value, template <typename...> class ThreadingPolicy,
+          typename Hash, typename... AdditionalPolicyArgs>
+inline auto HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::lockBucketShared(size_type i) const
+{
+  if constexpr(isStriped && threadingPolicy::hasSharedLocking)
+  {
+    return this->lockShared(i % threadingPolicy::numMutexes);
+  }
+  else
+  {
+    return lockBucket(i);
+  }
 }
 
 /**
@@ -799,7 +1297,7 @@ void HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::setup
   buckets.reserve(numBuckets);
   for(std::size_t i{}; i < numBuckets; ++i)
   {
-    buckets.push_back(std::make_unique<Bucket>());
+    buckets.push_back(std::make_unique<bucketType>());
   }
 }
 
@@ -809,9 +1307,12 @@ void HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::setup
 template <typename Key, typename Value, template <typename...> class ThreadingPolicy, typename Hash, typename... AdditionalPolicyArgs>
 void HashMapT<Key, Value, ThreadingPolicy, Hash, AdditionalPolicyArgs...>::moveFromOther(HashMapT&& src)
 {
-  numBuckets = std::move(src.numBuckets);
-  elemHash   = std::move(src.elemHash);
-  buckets    = std::move(src.buckets);
+  numBuckets  = std::move(src.numBuckets);
+  elemHash    = std::move(src.elemHash);
+  buckets     = std::move(src.buckets);
+  numElements = static_cast<size_type>(src.numElements);
+
+  src.numElements = 0ULL;
 }
 
 
@@ -825,7 +1326,22 @@ using HashMap = HashMapT<Key, Value, SingleThreaded, Hash>;
  * @brief convenience template alias for a hash map offering threadsafe access to its elements.
  */
 template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Mutex = std::shared_mutex>
-using ThreadsafeHashMap = HashMapT<Key, Value, ObjectLevelLockable, Hash, Mutex>;
+using ThreadsafeHashMap = HashMapT<Key, Value, ObjectLevelLockableT, Hash, Mutex, std::integral_constant<std::size_t, 1ULL>>;
+
+/**
+ * @brief convenience template alias for a threadsafe hash map whose buckets are guarded by
+ *        NumStripes mutexes instead of one mutex per bucket.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Mutex = std::shared_mutex,
+          std::size_t NumStripes = 8ULL>
+using StripedHashMap = HashMapT<Key, Value, ObjectLevelLockableT, Hash, Mutex, std::integral_constant<std::size_t, NumStripes>>;
+
+/**
+ * @brief convenience template alias for a hash map for read-mostly workloads. Lookups never
+ *        block, every modification copies the affected bucket.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Mutex = std::mutex>
+using ReadMostlyHashMap = HashMapT<Key, Value, ReadMostly, Hash, Mutex>;
 
 
 }   // namespace cctools
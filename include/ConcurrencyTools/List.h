@@ -6,7 +6,7 @@
  
 /** 
  * @file    List.h 
- * @brief 
+ * @brief   singly linked list with one lock per node 
  * 
  * @author  Lasse Rosenthal 
  * @date    30.06.2021 
@@ -18,22 +18,40 @@
  
 // includes
 #include "ConcurrencyTools/ThreadingModel.h"
+#include "ConcurrencyTools/detail/NodePool.h"
 
+#include <atomic>
 #include <cstddef>
 #include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
 
 
 namespace cctools {
 
 
 /**
- * @class ListT
- * @brief
+ * @class  ListT
+ * @brief  ListT is a singly linked list that allows access to its elements according to
+ *         a specified threading policy. Every node is guarded by a lock of its own, a thread
+ *         traversing the list locks the next node before it releases the current one
+ *         (hand-over-hand locking). Hence threads working on different parts of the list
+ *         don't block each other.
+ * @remark The nodes are taken from a pool owned by the list, so an insertion allocates
+ *         at most once per chunk of nodes. The memory is released by the destructor.
+ * @remark The tail of the list only changes while the lock of the last node is held,
+ *         which allows push_back without traversing the list.
  */
 template <typename T, template <typename...> class ThreadingPolicy,
           typename... AdditionalPolicyArgs>
 class ListT {
 
+  struct Node;
+
+  using nodePool = detail::NodePool<Node, ThreadingPolicy, AdditionalPolicyArgs...>;
+
 public:
 
   // ---------------------------------------------------
@@ -42,46 +60,57 @@ public:
   using size_type  = std::size_t;
 
   // ---------------------------------------------------
-  // construction
-  ListT ();
+  // special member functions
+  explicit ListT (size_type nodesPerChunk = nodePool::defaultChunkSize);
+  ListT          (ListT const&) = delete;
+  auto operator= (ListT const&) -> ListT& = delete;
+  ~ListT         ();
 
   // ---------------------------------------------------
   // public api
+  [[nodiscard]] auto empty () const -> bool;
+
   void push_front    (value_type const& value);
   void push_front    (value_type&& value);
   template <typename... ValueArgs>
   void emplace_front (ValueArgs&&... valueArgs);
 
   void push_back     (value_type const& value);
-  void push_back     (value_type&& value);   
+  void push_back     (value_type&& value);
+  template <typename... ValueArgs>
+  void emplace_back  (ValueArgs&&... valueArgs);
 
   template <typename Predicate>
-  void remove_if     (Predicate&& p);
+  auto remove_if     (Predicate&& pred) -> size_type;
 
   template <typename F>
-  void for_each      (F&& f);
-  
+  auto for_each      (F&& f) -> F&&;
 
+  template <typename Predicate>
+  auto find_first_if (Predicate&& pred) const -> std::optional<value_type>;
 
 private:
 
-  struct Node;
-
   // ---------------------------------------------------
   // private data
-  Node head;
-  std::shared_ptr<Node> tail;
+  Node               head;
+  std::atomic<Node*> tail {&head};
+  nodePool           pool;
 
   // ---------------------------------------------------
   // auxiliary methods
-  void insertNodeAtFront (std::shared_ptr<Node>&&);
-  void insertNodeAtBack  (std::shared_ptr<Node>&&);
-
+  template <typename... ValueArgs>
+  auto createNode        (ValueArgs&&... valueArgs) -> Node*;
+  void destroyNode       (Node* node) noexcept;
+  void insertNodeAtFront (Node* newNode);
+  void insertNodeAtBack  (Node* newNode);
 };
 
 
 /**
  * @class ListT::Node
+ * @brief Node holds the storage for one element. The element is constructed and destroyed
+ *        by the list, so a node can be handed back to the pool and reused.
  */
 template <typename T, template <typename...> class ThreadingPolicy,
           typename... AdditionalPolicyArgs>
@@ -92,63 +121,101 @@ struct ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::Node
 
   // ---------------------------------------------------
   // public types
-  using value_type = T;
+  using value_type      = T;
   using threadingPolicy = ThreadingPolicy<Node, AdditionalPolicyArgs...>;
 
   // ---------------------------------------------------
-  // construction
-  Node () = default;
-  Node (value_type const& value);
-  Node (value_type&& value);
-  //template <typename... ValueArgs>
-  //Node (ValueArgs&&...);
+  // element access
+  template <typename... ValueArgs>
+  void construct (ValueArgs&&... valueArgs);
+  void destroy   () noexcept;
+  auto value     () noexcept -> value_type&;
+  auto value     () const noexcept -> value_type const&;
 
   // ---------------------------------------------------
   // data
-  std::unique_ptr<value_type> data;
-  std::shared_ptr<Node>       next;
-  Node*                       prev {nullptr};
+  alignas(value_type) unsigned char storage[sizeof(value_type)];
+  Node*                             next {nullptr};
 };
 
 
 /**
- * @brief copy constructs a node from a given value.
+ * @brief Constructs the element of the node from a given set of constructor arguments.
  */
 template <typename T, template <typename...> class ThreadingPolicy,
           typename... AdditionalPolicyArgs>
-inline ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::Node::Node(value_type const& value)
-  : data {std::make_unique<value_type>(value)}
-{}
+template <typename... ValueArgs>
+inline void ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::Node::construct(ValueArgs&&... valueArgs)
+{
+  ::new(static_cast<void*>(storage)) value_type(std::forward<ValueArgs>(valueArgs)...);
+  next = nullptr;
+}
 
 /**
- * @brief move constructs a node from a given value.
+ * @brief Destroys the element of the node.
  */
 template <typename T, template <typename...> class ThreadingPolicy,
           typename... AdditionalPolicyArgs>
-inline ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::Node::Node(value_type&& value)
-  : data {std::make_unique<value_type>(std::move(value))}
-{}
+inline void ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::Node::destroy() noexcept
+{
+  value().~value_type();
+}
 
 /**
- * @brief Constructs a node element from a given set of constructor arguments
- *        for the value.
+ * @brief Returns a reference to the element of the node.
  */
-//template <typename T, template <typename...> class ThreadingPolicy,
-//          typename... AdditionalPolicyArgs>
-//template <typename... ValueArgs>
-//inline ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::Node::Node(ValueArgs&&... valueArgs)
-//  : data {std::make_unique<value_type>(std::forward<ValueArgs>(valueArgs)...)}
-//{}
+template <typename T, template <typename...> class ThreadingPolicy,
+          typename... AdditionalPolicyArgs>
+inline auto ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::Node::value() noexcept -> value_type&
+{
+  return *std::launder(reinterpret_cast<value_type*>(storage));
+}
 
 /**
- * @brief Default constructor. Constructs the tail object
+ * @brief Returns a const reference to the element of the node.
  */
 template <typename T, template <typename...> class ThreadingPolicy,
           typename... AdditionalPolicyArgs>
-inline ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::ListT()
-  : tail {std::make_shared<Node>()}
+inline auto ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::Node::value() const noexcept -> value_type const&
+{
+  return *std::launder(reinterpret_cast<value_type const*>(storage));
+}
+
+/**
+ * @brief Constructor.
+ * @param nodesPerChunk the number of nodes the pool allocates at once.
+ */
+template <typename T, template <typename...> class ThreadingPolicy,
+          typename... AdditionalPolicyArgs>
+inline ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::ListT(size_type nodesPerChunk)
+  : pool {nodesPerChunk}
 {}
 
+/**
+ * @brief Destructor. Destroys all elements, the nodes are released together with the pool.
+ */
+template <typename T, template <typename...> class ThreadingPolicy,
+          typename... AdditionalPolicyArgs>
+ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::~ListT()
+{
+  for(Node* node = head.next; node != nullptr; node = node->next)
+  {
+    node->destroy();
+  }
+}
+
+/**
+ * @brief Checks if the list contains no elements.
+ */
+template <typename T, template <typename...> class ThreadingPolicy,
+          typename... AdditionalPolicyArgs>
+inline auto ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::empty() const -> bool
+{
+  // ------- begin critical section ------- //
+  auto lck = head.lockUnique();
+  return head.next == nullptr;
+}
+
 /**
  * @brief Inserts a copy of a given value at the front of the list.
  */
@@ -156,7 +223,7 @@ template <typename T, template <typename...> class ThreadingPolicy,
           typename... AdditionalPolicyArgs>
 inline void ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::push_front(value_type const& value)
 {
-  insertNodeAtFront(std::make_shared<Node>(value));
+  insertNodeAtFront(createNode(value));
 }
 
 /**
@@ -166,7 +233,7 @@ template <typename T, template <typename...> class ThreadingPolicy,
           typename... AdditionalPolicyArgs>
 inline void ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::push_front(value_type&& value)
 {
-  insertNodeAtFront(std::make_shared<Node>(std::move(value)));
+  insertNodeAtFront(createNode(std::move(value)));
 }
 
 /**
@@ -178,11 +245,9 @@ template <typename T, template <typename...> class ThreadingPolicy,
 template <typename... ValueArgs>
 inline void ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::emplace_front(ValueArgs&&... valueArgs)
 {
-  insertNodeAtFront(std::make_shared<Node>(std::forward(valueArgs)...));
+  insertNodeAtFront(createNode(std::forward<ValueArgs>(valueArgs)...));
 }
 
-
-
 /**
  * @brief Inserts a copy of a given value at the end of the list.
  */
@@ -190,7 +255,7 @@ template <typename T, template <typename...> class ThreadingPolicy,
           typename... AdditionalPolicyArgs>
 inline void ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::push_back(value_type const& value)
 {
-  insertNodeAtBack(std::make_shared<Node>(value));
+  insertNodeAtBack(createNode(value));
 }
 
 /**
@@ -200,115 +265,191 @@ template <typename T, template <typename...> class ThreadingPolicy,
           typename... AdditionalPolicyArgs>
 inline void ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::push_back(value_type&& value)
 {
-  insertNodeAtBack(std::make_shared<Node>(std::move(value)));
+  insertNodeAtBack(createNode(std::move(value)));
 }
 
-
 /**
- * @brief Inserts a node at the front of the list.
+ * @brief Constructs a new list element from a list of constructor arguments and
+ *        and inserts it at the end of the list.
  */
 template <typename T, template <typename...> class ThreadingPolicy,
           typename... AdditionalPolicyArgs>
-void ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::insertNodeAtFront(std::shared_ptr<Node>&& newNode)
+template <typename... ValueArgs>
+inline void ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::emplace_back(ValueArgs&&... valueArgs)
 {
-  auto lockHead = head.lock();
-  newNode->prev = &head;
-  if(head.next)
-  {
-    newNode->next = std::move(head.next);
-    auto lockNext = newNode->next->lock();
-    newNode->next->prev = newNode.get();
-  }
-  else
-  {
-    tail = newNode;
-  }
-
-  head.next = std::move(newNode);
+  insertNodeAtBack(createNode(std::forward<ValueArgs>(valueArgs)...));
 }
 
 /**
- * @brief Inserts a node at the end of the list.
+ * @brief Removes all elements satisfying a given predicate. Returns the number of removed elements.
  */
 template <typename T, template <typename...> class ThreadingPolicy,
           typename... AdditionalPolicyArgs>
-void ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::insertNodeAtBack(std::shared_ptr<Node>&& newNode)
+template <typename Predicate>
+auto ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::remove_if(Predicate&& pred) -> size_type
 {
-  auto lockTail = tail->lock();
-  newNode->prev = tail.get();
-  tail->next = newNode;
+  size_type numRemoved {0ULL};
+
+  Node* current = &head;
+  auto lock     = head.lockUnique();
 
-  if(!tail->prev)
+  //  ... -> current -> next -> ...
+  while(Node* const next = current->next)
   {
-    auto lockHead = head.lock();
-    head.next = newNode;
+    auto lockNext = next->lockUnique();
+    if(pred(next->value()))
+    {
+      // remove next by updating current->next
+      current->next = next->next;
+      if(current->next == nullptr)
+      {
+        tail.store(current, std::memory_order_release);
+      }
+
+      // next can't be reached anymore, only a pending push_back may still wait for its lock
+      lockNext.unlock();
+      destroyNode(next);
+      ++numRemoved;
+      // don't update current because we have to check the new next node.
+    }
+    else
+    {
+      lock.unlock();
+      // update current to point the next node
+      current = next;
+      lock    = std::move(lockNext);
+    }
   }
-  
-  // the new node is always the tail
-  tail = std::move(newNode);
+
+  return numRemoved;
 }
 
+/**
+ * @brief Applies a given function to every element of the list.
+ */
 template <typename T, template <typename...> class ThreadingPolicy,
           typename... AdditionalPolicyArgs>
 template <typename F>
-void ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::for_each(F&& f)
+auto ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::for_each(F&& f) -> F&&
 {
   Node* current = &head;
-  auto lock = head.lockUnique();
+  auto lock     = head.lockUnique();
 
-  while(Node* next = current->next.get())
+  while(Node* const next = current->next)
   {
     auto lockNext = next->lockUnique();
     lock.unlock();
-    std::forward<F>(f)(*next->data);
+    std::forward<F>(f)(next->value());
     current = next;
-    lock = std::move(lockNext);
+    lock    = std::move(lockNext);
   }
+
+  return std::forward<F>(f);
 }
 
+/**
+ * @brief Returns a copy of the first element satisfying a given predicate,
+ *        or an empty optional if there is no such element.
+ */
 template <typename T, template <typename...> class ThreadingPolicy,
           typename... AdditionalPolicyArgs>
 template <typename Predicate>
-void ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::remove_if(Predicate&& pred)
+auto ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::find_first_if(Predicate&& pred) const -> std::optional<value_type>
 {
-  Node* current = &head;
-  auto lock = head.lockUnique();
+  Node const* current = &head;
+  auto lock           = head.lockUnique();
 
-  Node* next = current->next.get();
-  //  ... <-> current <-> next <-> ...
-  while(next != nullptr)
+  while(Node const* const next = current->next)
   {
     auto lockNext = next->lockUnique();
-    if(pred(*next->data))
+    lock.unlock();
+    if(pred(next->value()))
     {
-      std::shared_ptr<Node> oldNext = std::move(current->next);
+      return next->value();
+    }
+    current = next;
+    lock    = std::move(lockNext);
+  }
 
-      // remove next by updating current->next
-      if(next->next)
-      {
-        current->next = std::move(next->next);
+  return std::nullopt;
+}
 
-        auto lockNextNext = current->next->lockUnique();
-        current->next->prev = current;
-      }
-      // we can unlock lockNext since next will be deleted when oldNext goes out of scope
-      lockNext.unlock();
-      // don't update current because we have to check the new next node.
-    }
-    else
-    {
-      lock.unlock();
-      // update current to point the next node
-      current = next;
-      lock = std::move(lockNext);
-    }
+/**
+ * @brief Takes a node from the pool and constructs its element from a given set of arguments.
+ */
+template <typename T, template <typename...> class ThreadingPolicy,
+          typename... AdditionalPolicyArgs>
+template <typename... ValueArgs>
+auto ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::createNode(ValueArgs&&... valueArgs) -> Node*
+{
+  Node* const node = pool.acquire();
+  try
+  {
+    node->construct(std::forward<ValueArgs>(valueArgs)...);
+  }
+  catch(...)
+  {
+    pool.release(node);
+    throw;
+  }
+  return node;
+}
+
+/**
+ * @brief Destroys the element of a node that is no longer part of the list and
+ *        returns the node to the pool.
+ */
+template <typename T, template <typename...> class ThreadingPolicy,
+          typename... AdditionalPolicyArgs>
+inline void ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::destroyNode(Node* node) noexcept
+{
+  node->destroy();
+  pool.release(node);
+}
+
+/**
+ * @brief Inserts a node at the front of the list.
+ */
+template <typename T, template <typename...> class ThreadingPolicy,
+          typename... AdditionalPolicyArgs>
+void ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::insertNodeAtFront(Node* newNode)
+{
+  // ------- begin critical section ------- //
+  auto lockHead = head.lockUnique();
+  newNode->next = head.next;
+  head.next     = newNode;
 
-    next = current->next.get();
+  // the head is the last node of an empty list, hence its lock guards the tail
+  if(newNode->next == nullptr)
+  {
+    tail.store(newNode, std::memory_order_release);
   }
 }
 
+/**
+ * @brief Inserts a node at the end of the list.
+ */
+template <typename T, template <typename...> class ThreadingPolicy,
+          typename... AdditionalPolicyArgs>
+void ListT<T, ThreadingPolicy, AdditionalPolicyArgs...>::insertNodeAtBack(Node* newNode)
+{
+  for(;;)
+  {
+    Node* const last = tail.load(std::memory_order_acquire);
 
+    // ------- begin critical section ------- //
+    auto lockLast = last->lockUnique();
 
+    // the tail may have changed before the lock was acquired. last may even have been removed,
+    // which is harmless since removed nodes stay alive in the pool.
+    if(tail.load(std::memory_order_acquire) == last)
+    {
+      last->next = newNode;
+      tail.store(newNode, std::memory_order_release);
+      return;
+    }
+  }
+}
 
 
 /**
@@ -318,10 +459,11 @@ template <typename T>
 using List = ListT<T, SingleThreaded>;
 
 /**
- * @brief convenience template alias for a list threadsafe access to its elements.
+ * @brief convenience template alias for a list with threadsafe access to its elements.
+ *        Every node holds a mutex of its own.
  */
-template <typename T, typename Mutex = std::shared_mutex>
-using ThreadsafeList = ListT<T, ObjectLevelLockable, Mutex>;
+template <typename T, typename Mutex = std::mutex>
+using ThreadsafeList = ListT<T, ObjectLevelLockableT, Mutex, std::integral_constant<std::size_t, 1ULL>>;
 
 
 }   // namespace cctools
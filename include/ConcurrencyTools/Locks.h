@@ -0,0 +1,367 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   Locks.h
+ * @brief  mutex types for short critical sections, which can be passed as Mutex parameter
+ *         to the threading policies, e.g. ThreadsafeHashMap<Key, Value, Hash, SpinLock>.
+ *
+ * @author Lasse Rosenthal
+ * @date   16.10.2026
+ */
+
+#ifndef LOCKS_H_61029384756102938475610293847561029384756102
+#define LOCKS_H_61029384756102938475610293847561029384756102
+
+
+// includes
+#include "WaitStrategy.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+
+namespace cctools {
+
+
+/**
+ * @class Backoff
+ * @brief Backoff is an unbounded busy waiting helper for spin locks. Every call doubles the
+ *        number of pause instructions up to a limit, after that the thread yields its time slice.
+ */
+class Backoff {
+
+  static constexpr std::uint32_t maxPauses = 64U;
+
+public:
+
+  void pause () noexcept;
+
+private:
+
+  std::uint32_t numPauses {1U};
+};
+
+
+/**
+ * @class  SpinLock
+ * @brief  SpinLock is a test and test-and-set lock. Waiting threads only read the flag, which
+ *         keeps the cache line shared until the owner releases it, and back off in between.
+ *         It satisfies the Lockable requirements.
+ * @remark A waiting thread never parks, so SpinLock only pays off for critical sections of a
+ *         few hundred cycles. Use HybridMutex if a section may take longer.
+ */
+class SpinLock {
+
+public:
+
+  // ---------------------------------------------------
+  // special member functions
+  SpinLock       () = default;
+  SpinLock       (SpinLock const&) = delete;
+  auto operator= (SpinLock const&) -> SpinLock& = delete;
+
+  // ---------------------------------------------------
+  // Lockable
+  void lock     () noexcept;
+  auto try_lock () noexcept -> bool;
+  void unlock   () noexcept;
+
+private:
+
+  std::atomic<bool> locked {false};
+};
+
+
+/**
+ * @class  SharedSpinLock
+ * @brief  SharedSpinLock is a writer-preferring reader-writer spin lock. The owner and the readers
+ *         are counted in a single word, so an uncontended lock or lock_shared is one atomic
+ *         read-modify-write. A waiting writer announces itself, which stops new readers from
+ *         entering until it got the lock. Hence a steady stream of readers can't starve writers.
+ *         It satisfies the SharedLockable requirements.
+ * @remark Like SpinLock it never parks, it beats std::shared_mutex for short critical sections only.
+ */
+class SharedSpinLock {
+
+  static constexpr std::uint32_t writerLocked  = 1U;
+  static constexpr std::uint32_t writerWaiting = 2U;
+  static constexpr std::uint32_t oneReader     = 4U;
+
+public:
+
+  // ---------------------------------------------------
+  // special member functions
+  SharedSpinLock () = default;
+  SharedSpinLock (SharedSpinLock const&) = delete;
+  auto operator= (SharedSpinLock const&) -> SharedSpinLock& = delete;
+
+  // ---------------------------------------------------
+  // Lockable
+  void lock     () noexcept;
+  auto try_lock () noexcept -> bool;
+  void unlock   () noexcept;
+
+  // ---------------------------------------------------
+  // SharedLockable
+  void lock_shared     () noexcept;
+  auto try_lock_shared () noexcept -> bool;
+  void unlock_shared   () noexcept;
+
+private:
+
+  std::atomic<std::uint32_t> state {0U};
+};
+
+
+/**
+ * @class  HybridMutex
+ * @brief  HybridMutex spins for a while following its WaitStrategy and only then parks the
+ *         thread on the futex of its state word. Releasing an uncontended HybridMutex doesn't
+ *         call into the kernel. It satisfies the Lockable requirements.
+ * @remark The state is 0 if unlocked, 1 if locked and 2 if locked and threads may be parked.
+ */
+class HybridMutex {
+
+  static constexpr std::uint32_t unlocked  = 0U;
+  static constexpr std::uint32_t locked    = 1U;
+  static constexpr std::uint32_t contended = 2U;
+
+public:
+
+  // ---------------------------------------------------
+  // special member functions
+  HybridMutex           () noexcept = default;
+  explicit HybridMutex  (WaitStrategy strategy) noexcept;
+  HybridMutex           (HybridMutex const&) = delete;
+  auto operator=        (HybridMutex const&) -> HybridMutex& = delete;
+
+  // ---------------------------------------------------
+  // Lockable
+  void lock     () noexcept;
+  auto try_lock () noexcept -> bool;
+  void unlock   () noexcept;
+
+private:
+
+  std::atomic<std::uint32_t> state {unlocked};
+  WaitStrategy               strategy {WaitStrategy::adaptive()};
+};
+
+
+// ---------------------------------------------------
+// Backoff
+
+/**
+ * @brief Performs the next busy waiting step.
+ */
+inline void Backoff::pause() noexcept
+{
+  if(numPauses <= maxPauses)
+  {
+    for(std::uint32_t i = 0U; i < numPauses; ++i)
+    {
+      cpuRelax();
+    }
+    numPauses <<= 1U;
+  }
+  else
+  {
+    std::this_thread::yield();
+  }
+}
+
+
+// ---------------------------------------------------
+// SpinLock
+
+/**
+ * @brief Acquires the lock, spins while it is held by another thread.
+ */
+inline void SpinLock::lock() noexcept
+{
+  Backoff backoff;
+  while(locked.exchange(true, std::memory_order_acquire))
+  {
+    while(locked.load(std::memory_order_relaxed))
+    {
+      backoff.pause();
+    }
+  }
+}
+
+/**
+ * @brief  Tries to acquire the lock without waiting.
+ * @return true, if the lock was acquired.
+ */
+inline auto SpinLock::try_lock() noexcept -> bool
+{
+  return !locked.load(std::memory_order_relaxed) && !locked.exchange(true, std::memory_order_acquire);
+}
+
+/**
+ * @brief Releases the lock.
+ */
+inline void SpinLock::unlock() noexcept
+{
+  locked.store(false, std::memory_order_release);
+}
+
+
+// ---------------------------------------------------
+// SharedSpinLock
+
+/**
+ * @brief Acquires the lock exclusively. Announces the writer while readers are still inside,
+ *        so no new readers enter in the meantime.
+ */
+inline void SharedSpinLock::lock() noexcept
+{
+  Backoff backoff;
+  for(;;)
+  {
+    auto s = state.load(std::memory_order_relaxed);
+    // the waiting flag is cleared when a writer takes over, other waiting writers set it again
+    if((s & ~writerWaiting) == 0U)
+    {
+      if(state.compare_exchange_weak(s, writerLocked, std::memory_order_acquire, std::memory_order_relaxed))
+      {
+        return;
+      }
+    }
+    else if((s & writerWaiting) == 0U)
+    {
+      state.fetch_or(writerWaiting, std::memory_order_relaxed);
+    }
+    backoff.pause();
+  }
+}
+
+/**
+ * @brief  Tries to acquire the lock exclusively without waiting.
+ * @return true, if the lock was acquired.
+ */
+inline auto SharedSpinLock::try_lock() noexcept -> bool
+{
+  auto s = state.load(std::memory_order_relaxed);
+  return (s & ~writerWaiting) == 0U
+      && state.compare_exchange_strong(s, writerLocked, std::memory_order_acquire, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Releases the exclusive lock. A flag of another waiting writer is kept.
+ */
+inline void SharedSpinLock::unlock() noexcept
+{
+  state.fetch_and(~writerLocked, std::memory_order_release);
+}
+
+/**
+ * @brief Acquires the lock shared, waits while a writer owns the lock or waits for it.
+ */
+inline void SharedSpinLock::lock_shared() noexcept
+{
+  Backoff backoff;
+  while(!try_lock_shared())
+  {
+    backoff.pause();
+  }
+}
+
+/**
+ * @brief  Tries to acquire the lock shared without waiting.
+ * @return true, if the lock was acquired.
+ */
+inline auto SharedSpinLock::try_lock_shared() noexcept -> bool
+{
+  auto s = state.load(std::memory_order_relaxed);
+  while((s & (writerLocked | writerWaiting)) == 0U)
+  {
+    if(state.compare_exchange_weak(s, s + oneReader, std::memory_order_acquire, std::memory_order_relaxed))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Releases the shared lock.
+ */
+inline void SharedSpinLock::unlock_shared() noexcept
+{
+  state.fetch_sub(oneReader, std::memory_order_release);
+}
+
+
+// ---------------------------------------------------
+// HybridMutex
+
+/**
+ * @brief Constructor.
+ * @param strategy determines how long lock spins before the thread is parked.
+ */
+inline HybridMutex::HybridMutex(WaitStrategy s) noexcept
+  : strategy {s}
+{}
+
+/**
+ * @brief Acquires the lock. Spins following the wait strategy first, parks the thread afterwards.
+ */
+inline void HybridMutex::lock() noexcept
+{
+  if(try_lock())
+  {
+    return;
+  }
+
+  SpinWaiter waiter(strategy);
+  while(waiter.wait())
+  {
+    if(state.load(std::memory_order_relaxed) == unlocked && try_lock())
+    {
+      return;
+    }
+  }
+
+  // from now on the state claims contention, so the owner wakes up a parked thread on unlock
+  while(state.exchange(contended, std::memory_order_acquire) != unlocked)
+  {
+    state.wait(contended, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * @brief  Tries to acquire the lock without waiting.
+ * @return true, if the lock was acquired.
+ */
+inline auto HybridMutex::try_lock() noexcept -> bool
+{
+  auto expected = unlocked;
+  return state.compare_exchange_strong(expected, locked, std::memory_order_acquire, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Releases the lock and wakes up one parked thread if there might be one.
+ */
+inline void HybridMutex::unlock() noexcept
+{
+  if(state.exchange(unlocked, std::memory_order_release) == contended)
+  {
+    state.notify_one();
+  }
+}
+
+
+}   // namespace cctools
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif   // LOCKS_H_61029384756102938475610293847561029384756102
@@ -0,0 +1,414 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   Metrics.h
+ * @brief  runtime metrics of thread pools and threadsafe queues: latency histograms,
+ *         counters and the snapshots they are exported with.
+ *
+ * @author Lasse Rosenthal
+ * @date   16.10.2026
+ */
+
+#ifndef METRICS_H_20192837465019283746501928374650192837465019283746
+#define METRICS_H_20192837465019283746501928374650192837465019283746
+
+
+// includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace cctools {
+
+
+/**
+ * @brief Policy switching the collection of runtime metrics on or off. Disabled metrics
+ *        are removed at compile time and cost neither memory nor time.
+ */
+enum class metricsPolicy : char {
+  disabled,
+  enabled
+};
+
+
+/**
+ * @class  HistogramSnapshot
+ * @brief  HistogramSnapshot is a copy of the counts of a LatencyHistogram.
+ * @remark Durations are counted in log-linear buckets (HDR style): every power of two
+ *         is split into 16 buckets, so a bucket covers at most 1/16 of its lower bound.
+ *         Durations below 16ns are counted exactly, durations beyond 2^48ns (~3 days)
+ *         end up in the last bucket.
+ */
+class HistogramSnapshot {
+
+  static constexpr std::uint32_t subBucketBits = 4U;
+  static constexpr std::uint32_t numSubBuckets = 1U << subBucketBits;
+  static constexpr std::uint32_t maxExponent   = 47U;
+
+public:
+
+  // ---------------------------------------------------
+  // public types & constants
+  using size_type     = std::size_t;
+  using duration_type = std::chrono::nanoseconds;
+
+  static constexpr size_type numBuckets = (maxExponent - subBucketBits + 2U) * numSubBuckets;
+
+  // ---------------------------------------------------
+  // constructor
+  HistogramSnapshot ();
+
+  // ---------------------------------------------------
+  // api
+  auto count         () const noexcept -> std::uint64_t;
+  auto mean          () const noexcept -> duration_type;
+  auto max           () const noexcept -> duration_type;
+  auto percentile    (double p) const noexcept -> duration_type;
+  void merge         (HistogramSnapshot const& other);
+  template <typename F>
+  void forEachBucket (F&& f) const;
+
+  // ---------------------------------------------------
+  // bucket layout
+  static constexpr auto bucketIndex (std::uint64_t nanoseconds) noexcept -> size_type;
+  static constexpr auto lowerBound  (size_type bucket) noexcept -> std::uint64_t;
+  static constexpr auto upperBound  (size_type bucket) noexcept -> std::uint64_t;
+
+private:
+
+  friend class LatencyHistogram;
+
+  // ---------------------------------------------------
+  // private data
+  std::vector<std::uint64_t> counts;
+  std::uint64_t              total {0ULL};
+  std::uint64_t              sum {0ULL};
+};
+
+inline HistogramSnapshot::HistogramSnapshot()
+  : counts(numBuckets, 0ULL)
+{}
+
+/**
+ * @brief Returns the number of recorded durations.
+ */
+inline auto HistogramSnapshot::count() const noexcept -> std::uint64_t
+{
+  return total;
+}
+
+/**
+ * @brief Returns the exact mean of the recorded durations.
+ */
+inline auto HistogramSnapshot::mean() const noexcept -> duration_type
+{
+  return duration_type{total == 0ULL ? 0LL : static_cast<long long>(sum / total)};
+}
+
+/**
+ * @brief Returns the upper bound of the highest non-empty bucket.
+ */
+inline auto HistogramSnapshot::max() const noexcept -> duration_type
+{
+  for(auto bucket = numBuckets; bucket > 0ULL; --bucket)
+  {
+    if(counts[bucket - 1ULL] != 0ULL)
+    {
+      return duration_type{static_cast<long long>(upperBound(bucket - 1ULL))};
+    }
+  }
+  return duration_type::zero();
+}
+
+/**
+ * @brief Returns the upper bound of the bucket holding the p-th percentile, p in [0, 100].
+ */
+inline auto HistogramSnapshot::percentile(double p) const noexcept -> duration_type
+{
+  if(total == 0ULL)
+  {
+    return duration_type::zero();
+  }
+
+  const auto rank = (std::max)(static_cast<std::uint64_t>(std::ceil(std::clamp(p, 0.0, 100.0) / 100.0 * static_cast<double>(total))),
+                               std::uint64_t{1ULL});
+  std::uint64_t cumulated = 0ULL;
+  for(size_type bucket = 0ULL; bucket < numBuckets; ++bucket)
+  {
+    cumulated += counts[bucket];
+    if(cumulated >= rank)
+    {
+      return duration_type{static_cast<long long>(upperBound(bucket))};
+    }
+  }
+  return max();
+}
+
+/**
+ * @brief Adds the counts of the other snapshot.
+ */
+inline void HistogramSnapshot::merge(HistogramSnapshot const& other)
+{
+  for(size_type bucket = 0ULL; bucket < numBuckets; ++bucket)
+  {
+    counts[bucket] += other.counts[bucket];
+  }
+  total += other.total;
+  sum   += other.sum;
+}
+
+/**
+ * @brief Calls f(lowerBound, upperBound, count) for every non-empty bucket in ascending order.
+ *        The bounds are inclusive and given in nanoseconds.
+ */
+template <typename F>
+void HistogramSnapshot::forEachBucket(F&& f) const
+{
+  for(size_type bucket = 0ULL; bucket < numBuckets; ++bucket)
+  {
+    if(counts[bucket] != 0ULL)
+    {
+      f(lowerBound(bucket), upperBound(bucket), counts[bucket]);
+    }
+  }
+}
+
+constexpr auto HistogramSnapshot::bucketIndex(std::uint64_t nanoseconds) noexcept -> size_type
+{
+  if(nanoseconds < numSubBuckets)
+  {
+    return static_cast<size_type>(nanoseconds);
+  }
+
+  const auto exponent = static_cast<std::uint32_t>(std::bit_width(nanoseconds)) - 1U;
+  if(exponent > maxExponent)
+  {
+    return numBuckets - 1ULL;
+  }
+  const auto subBucket = (nanoseconds >> (exponent - subBucketBits)) & (numSubBuckets - 1U);
+  return static_cast<size_type>((exponent - subBucketBits + 1U) * numSubBuckets + subBucket);
+}
+
+constexpr auto HistogramSnapshot::lowerBound(size_type bucket) noexcept -> std::uint64_t
+{
+  if(bucket < numSubBuckets)
+  {
+    return bucket;
+  }
+
+  const auto exponent  = static_cast<std::uint32_t>(bucket / numSubBuckets) + subBucketBits - 1U;
+  const auto subBucket = static_cast<std::uint64_t>(bucket % numSubBuckets);
+  return (numSubBuckets + subBucket) << (exponent - subBucketBits);
+}
+
+constexpr auto HistogramSnapshot::upperBound(size_type bucket) noexcept -> std::uint64_t
+{
+  if(bucket < numSubBuckets)
+  {
+    return bucket;
+  }
+
+  const auto exponent = static_cast<std::uint32_t>(bucket / numSubBuckets) + subBucketBits - 1U;
+  return lowerBound(bucket) + (std::uint64_t{1ULL} << (exponent - subBucketBits)) - 1ULL;
+}
+
+
+/**
+ * @class  LatencyHistogram
+ * @brief  LatencyHistogram counts durations in the buckets of a HistogramSnapshot.
+ * @remark Recording is wait-free, a single relaxed increment. Concurrent recording is
+ *         allowed, but histograms should be kept per thread to avoid sharing cache lines.
+ */
+class LatencyHistogram {
+
+public:
+
+  // ---------------------------------------------------
+  // api
+  void record   (std::chrono::nanoseconds duration) noexcept;
+  void addTo    (HistogramSnapshot& snapshot) const;
+  auto snapshot () const -> HistogramSnapshot;
+
+private:
+
+  // ---------------------------------------------------
+  // private data
+  std::array<std::atomic<std::uint64_t>, HistogramSnapshot::numBuckets> counts {};
+  std::atomic<std::uint64_t>                                            sum {0ULL};
+};
+
+inline void LatencyHistogram::record(std::chrono::nanoseconds duration) noexcept
+{
+  const auto nanoseconds = duration.count() > 0 ? static_cast<std::uint64_t>(duration.count()) : 0ULL;
+  counts[HistogramSnapshot::bucketIndex(nanoseconds)].fetch_add(1ULL, std::memory_order_relaxed);
+  sum.fetch_add(nanoseconds, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Adds the current counts to the passed snapshot.
+ */
+inline void LatencyHistogram::addTo(HistogramSnapshot& snapshot) const
+{
+  for(std::size_t bucket = 0ULL; bucket < HistogramSnapshot::numBuckets; ++bucket)
+  {
+    const auto n = counts[bucket].load(std::memory_order_relaxed);
+    snapshot.counts[bucket] += n;
+    snapshot.total          += n;
+  }
+  snapshot.sum += sum.load(std::memory_order_relaxed);
+}
+
+inline auto LatencyHistogram::snapshot() const -> HistogramSnapshot
+{
+  HistogramSnapshot result;
+  addTo(result);
+  return result;
+}
+
+
+/**
+ * @brief Metrics of a single working thread of a ThreadPool.
+ */
+struct WorkerMetrics {
+  std::uint64_t            tasksRun {0ULL};
+  std::uint64_t            steals {0ULL};     ///< tasks taken from the local queue of another worker
+  std::chrono::nanoseconds busyTime {0};      ///< time spent running tasks
+  std::chrono::nanoseconds idleTime {0};      ///< lifetime of the thread minus busyTime
+};
+
+/**
+ * @brief Snapshot of the metrics of a ThreadPool.
+ * @remark Tasks run by threads outside the pool (see ThreadPool::runPendingTask) are contained
+ *         in the totals and histograms, but not in the metrics of the workers.
+ */
+struct ThreadPoolMetrics {
+  std::uint64_t              tasksSubmitted {0ULL};
+  std::uint64_t              tasksCompleted {0ULL};
+  std::uint64_t              tasksCancelled {0ULL};   ///< tasks dropped without running, included in tasksCompleted
+  std::uint64_t              steals {0ULL};
+  std::size_t                queueDepth {0ULL};   ///< tasks submitted but not started yet
+  std::chrono::nanoseconds   uptime {0};
+  std::vector<WorkerMetrics> workers;
+  HistogramSnapshot          waitLatency;         ///< time between submission and start of the tasks
+  HistogramSnapshot          runTime;             ///< time the tasks ran
+};
+
+/**
+ * @brief Snapshot of the metrics of a threadsafe queue.
+ */
+struct QueueMetrics {
+  std::uint64_t     pushes {0ULL};
+  std::uint64_t     pops {0ULL};
+  std::size_t       depth {0ULL};
+  std::size_t       maxDepth {0ULL};   ///< high water mark of the number of elements
+  HistogramSnapshot consumerWait;      ///< time consumers spent in waitAndPop, waitAndPopBulk and tryPopFor
+  HistogramSnapshot producerWait;      ///< time producers spent in blocking pushes
+};
+
+
+namespace detail {
+
+/**
+ * @brief Stopwatch measures the time since its construction. Without metrics it is empty
+ *        and does not read the clock at all.
+ */
+template <metricsPolicy>
+class Stopwatch {
+public:
+  auto elapsed () const noexcept -> std::chrono::nanoseconds
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+  }
+
+private:
+  std::chrono::steady_clock::time_point start {std::chrono::steady_clock::now()};
+};
+
+template <>
+class Stopwatch<metricsPolicy::disabled> {
+public:
+  constexpr auto elapsed () const noexcept -> std::chrono::nanoseconds
+  {
+    return std::chrono::nanoseconds::zero();
+  }
+};
+
+
+/**
+ * @brief Counters of a threadsafe queue. push and pop counters are protected by the
+ *        queue's mutex, the wait histograms are recorded without holding it.
+ */
+template <metricsPolicy>
+struct QueueCounters {
+  std::uint64_t    pushes {0ULL};
+  std::uint64_t    pops {0ULL};
+  std::size_t      maxDepth {0ULL};
+  LatencyHistogram consumerWait;
+  LatencyHistogram producerWait;
+
+  void pushed (std::size_t depth, std::size_t n = 1ULL) noexcept
+  {
+    pushes  += n;
+    maxDepth = (std::max)(maxDepth, depth);
+  }
+  void popped (std::size_t n = 1ULL) noexcept
+  {
+    pops += n;
+  }
+  void consumerWaited (Stopwatch<metricsPolicy::enabled> const& watch) noexcept
+  {
+    consumerWait.record(watch.elapsed());
+  }
+  void producerWaited (Stopwatch<metricsPolicy::enabled> const& watch) noexcept
+  {
+    producerWait.record(watch.elapsed());
+  }
+  void producerWaited (std::chrono::nanoseconds duration) noexcept
+  {
+    producerWait.record(duration);
+  }
+};
+
+template <>
+struct QueueCounters<metricsPolicy::disabled> {
+  constexpr void pushed         (std::size_t, std::size_t = 1ULL) noexcept {}
+  constexpr void popped         (std::size_t = 1ULL) noexcept {}
+  constexpr void consumerWaited (Stopwatch<metricsPolicy::disabled> const&) noexcept {}
+  constexpr void producerWaited (Stopwatch<metricsPolicy::disabled> const&) noexcept {}
+  constexpr void producerWaited (std::chrono::nanoseconds) noexcept {}
+};
+
+
+/**
+ * @brief Counters of a single working thread of a thread pool, kept on their own cache lines.
+ */
+struct alignas(64) WorkerCounters {
+  std::atomic<std::uint64_t> tasksRun {0ULL};
+  std::atomic<std::uint64_t> steals {0ULL};
+  std::atomic<std::uint64_t> busyTime {0ULL};
+  LatencyHistogram           waitLatency;
+  LatencyHistogram           runTime;
+};
+
+}   // namespace detail
+
+
+}   // namespace cctools
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif   // METRICS_H_20192837465019283746501928374650192837465019283746
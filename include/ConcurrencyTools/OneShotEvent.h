@@ -18,10 +18,16 @@
  
  
 // includes 
+#include "Future.h"
+
 #include <chrono>
 #include <future>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 
 namespace cctools {
@@ -34,9 +40,34 @@ enum class eventPolicy : char {
 };
 
 
+namespace detail {
+
+
+/**
+ * @brief  EventState is the shared state of a OneShotEvent. It holds the result of the event and,
+ *         once requested by getFuture, the promise of a cctools::Future linked to the event.
+ * @remark The linked promise is created on request only, so notify copies the value only
+ *         if a future has been retrieved before.
+ */
+template <typename T>
+struct EventState {
+  FutureState<T>            result {Executor{}};
+  std::mutex                linkMutex;
+  bool                      notified {false};          // guarded by linkMutex
+  bool                      futureRetrieved {false};   // guarded by linkMutex
+  std::optional<Promise<T>> linked;                    // guarded by linkMutex
+};
+
+
+}   // namespace detail
+
+
 /**
- * @brief Class OneShotEvent provides a simple facility
- *        for one-shot event communication.
+ * @brief  Class OneShotEvent provides a simple facility
+ *         for one-shot event communication.
+ * @remark getFuture returns a cctools::Future that is completed by the event as well. Since
+ *         continuations can be attached to it, an event can start work on a thread pool
+ *         without parking a thread. getFuture may be called concurrently with or after notify.
  */
 template <typename T, eventPolicy EventPolicy = eventPolicy::nonShared>
 class OneShotEvent {
@@ -64,13 +95,20 @@ public:
   auto get          () -> data_type;
   void wait         () const;
   auto setException (std::exception_ptr exPtr) -> bool;
+  auto getFuture    () -> Future<data_type>;
 
 private:
 
   // ---------------------------------------------------
   // private data
-  std::promise<data_type> prom;
-  future_type             fut;
+  std::shared_ptr<detail::EventState<data_type>> shared;
+  bool                                           retrieved {false};   // value taken by get, non shared events only
+
+  // ---------------------------------------------------
+  // auxiliary methods
+  template <typename U>
+  void setValue   (U&& value);
+  auto checkState () const -> detail::EventState<data_type>&;
 };
 
 
@@ -88,11 +126,11 @@ using SharedOneShotEvent = OneShotEvent<T, eventPolicy::shared>;
 
 
 /**
- * @brief constructor. Retrieves the future from the promise.
+ * @brief constructor. Creates the shared state.
  */
 template <typename T, eventPolicy EventPolicy>
 inline OneShotEvent <T, EventPolicy>::OneShotEvent()
-  : fut {prom.get_future()}
+  : shared {std::make_shared<detail::EventState<data_type>>()}
 {}
 
 /**
@@ -103,19 +141,20 @@ auto OneShotEvent<T, EventPolicy>::operator=(OneShotEvent&& src) -> OneShotEvent
 {
   if(this != &src)
   {
-    prom = std::move(src.prom);
-    fut = std::move(src.fut);
+    shared    = std::move(src.shared);
+    retrieved = std::exchange(src.retrieved, false);
   }
   return *this;
 }
 
 /**
- * @brief Stores (moves) the value into the shared state.
+ * @brief  Stores (moves) the value into the shared state.
+ * @remark The future returned by getFuture receives a copy, if it has been retrieved already.
  */
 template <typename T, eventPolicy EventPolicy>
 inline void OneShotEvent<T, EventPolicy>::notify(data_type&& value)
 {
-  prom.set_value(std::move(value));
+  setValue(std::move(value));
 }
 
 /**
@@ -124,20 +163,31 @@ inline void OneShotEvent<T, EventPolicy>::notify(data_type&& value)
 template <typename T, eventPolicy EventPolicy>
 inline void OneShotEvent<T, EventPolicy>::notify(data_type const& value)
 {
-  prom.set_value(value);
+  setValue(value);
 }
 
 /**
- * @brief Returns the value associated with the shared state.
+ * @brief Returns the value associated with the shared state. A non shared event hands over
+ *        its value, so get may be called only once.
  */
 template <typename T, eventPolicy EventPolicy>
 inline auto OneShotEvent<T, EventPolicy>::get() -> data_type
 {
-  if(!fut.valid())
+  if(!shared || retrieved)
   {
     throw std::runtime_error("future is not associated with a shared state.");
   }
-  return fut.get();
+
+  shared->result.wait();
+  if constexpr(EventPolicy == eventPolicy::nonShared)
+  {
+    retrieved = true;
+    return shared->result.takeValue();
+  }
+  else
+  {
+    return shared->result.copyValue();
+  }
 }
 
 /**
@@ -146,11 +196,11 @@ inline auto OneShotEvent<T, EventPolicy>::get() -> data_type
 template <typename T, eventPolicy EventPolicy>
 inline void OneShotEvent<T, EventPolicy>::wait() const
 {
-  if(!fut.valid())
+  if(!shared || retrieved)
   {
     throw std::runtime_error("future is not associated with a shared state.");
   }
-  return fut.wait();
+  shared->result.wait();
 }
 
 /**
@@ -159,15 +209,115 @@ inline void OneShotEvent<T, EventPolicy>::wait() const
 template <typename T, eventPolicy EventPolicy>
 inline bool OneShotEvent<T, EventPolicy>::setException(std::exception_ptr exPtr)
 {
+  std::optional<Promise<data_type>> linked;
   try
   {
-    prom.set_exception(exPtr);
-    return true;
+    auto& state = checkState();
+
+    // ------- begin critical section ------- //
+    std::lock_guard lck(state.linkMutex);
+    state.result.setException(exPtr);
+    state.notified = true;
+    linked         = std::exchange(state.linked, std::nullopt);
   }
   catch(...) // set_exception may throw too
   {
     return false;
   }
+  // -------- end critical section -------- //
+
+  if(linked)
+  {
+    linked->setException(exPtr);
+  }
+  return true;
+}
+
+/**
+ * @brief Returns a future that becomes ready when the event is notified, or is ready already
+ *        if it has been notified before. Can only be called once. The future receives a copy
+ *        of the value.
+ * @throw std::future_error if the future has already been retrieved, or the value has been
+ *        taken by get.
+ */
+template <typename T, eventPolicy EventPolicy>
+inline auto OneShotEvent<T, EventPolicy>::getFuture() -> Future<data_type>
+{
+  static_assert(std::is_copy_constructible_v<data_type>, "the value is copied into the future");
+
+  auto& state = checkState();
+
+  if(retrieved)
+  {
+    throw std::future_error(std::future_errc::no_state);
+  }
+
+  // ------- begin critical section ------- //
+  std::lock_guard lck(state.linkMutex);
+  if(state.futureRetrieved)
+  {
+    throw std::future_error(std::future_errc::future_already_retrieved);
+  }
+  state.futureRetrieved = true;
+
+  if(!state.notified)
+  {
+    return state.linked.emplace().getFuture();
+  }
+
+  Promise<data_type> promise;
+  auto copy = [&state] { return state.result.copyValue(); };
+  detail::fulfil(promise, copy);
+  return promise.getFuture();
+}
+
+/**
+ * @brief Stores the value into the shared state and completes the linked future with a copy.
+ */
+template <typename T, eventPolicy EventPolicy>
+template <typename U>
+void OneShotEvent<T, EventPolicy>::setValue(U&& value)
+{
+  auto&                             state = checkState();
+  std::optional<Promise<data_type>> linked;
+  std::optional<data_type>          copy;
+  {
+    // ------- begin critical section ------- //
+    std::lock_guard lck(state.linkMutex);
+    if constexpr(std::is_copy_constructible_v<data_type>)
+    {
+      if(state.linked)
+      {
+        copy.emplace(value);
+      }
+    }
+    state.result.setValue(std::forward<U>(value));
+    state.notified = true;
+    linked         = std::exchange(state.linked, std::nullopt);
+  }
+  // -------- end critical section -------- //
+
+  if constexpr(std::is_copy_constructible_v<data_type>)
+  {
+    if(linked)
+    {
+      linked->setValue(std::move(*copy));
+    }
+  }
+}
+
+/**
+ * @brief Returns the shared state.
+ * @throw std::future_error if the event has been moved from.
+ */
+template <typename T, eventPolicy EventPolicy>
+inline auto OneShotEvent<T, EventPolicy>::checkState() const -> detail::EventState<data_type>&
+{
+  if(!shared)
+  {
+    throw std::future_error(std::future_errc::no_state);
+  }
+  return *shared;
 }
 
 
@@ -200,22 +350,26 @@ public:
   void get          ();
   void wait         () const;
   auto setException (std::exception_ptr exPtr) -> bool;
+  auto getFuture    () -> Future<data_type>;
 
 private:
 
   // ---------------------------------------------------
   // private data
-  std::promise<data_type> prom;
-  future_type             fut;
+  std::shared_ptr<detail::EventState<void>> shared;
+
+  // ---------------------------------------------------
+  // auxiliary methods
+  auto checkState () const -> detail::EventState<void>&;
 };
 
 
 /**
- * @brief Constructor. Retrieves the future from the promise.
+ * @brief Constructor. Creates the shared state.
  */
 template <eventPolicy EventPolicy>
 inline OneShotEvent<void, EventPolicy>::OneShotEvent()
-  : fut {prom.get_future()}
+  : shared {std::make_shared<detail::EventState<void>>()}
 {}
 
 /**
@@ -226,8 +380,7 @@ inline auto OneShotEvent<void, EventPolicy>::operator=(OneShotEvent&& src) -> On
 {
   if(this != &src)
   {
-    prom = std::move(src.prom);
-    fut = std::move(src.fut);
+    shared = std::move(src.shared);
   }
   return *this;
 }
@@ -238,7 +391,21 @@ inline auto OneShotEvent<void, EventPolicy>::operator=(OneShotEvent&& src) -> On
 template <eventPolicy EventPolicy>
 inline void OneShotEvent<void, EventPolicy>::notify()
 {
-  prom.set_value();
+  auto&                        state = checkState();
+  std::optional<Promise<void>> linked;
+  {
+    // ------- begin critical section ------- //
+    std::lock_guard lck(state.linkMutex);
+    state.result.setValue();
+    state.notified = true;
+    linked         = std::exchange(state.linked, std::nullopt);
+  }
+  // -------- end critical section -------- //
+
+  if(linked)
+  {
+    linked->setValue();
+  }
 }
 
 /**
@@ -247,7 +414,9 @@ inline void OneShotEvent<void, EventPolicy>::notify()
 template <eventPolicy EventPolicy>
 inline void OneShotEvent<void, EventPolicy>::get()
 {
-  fut.get();
+  auto& state = checkState();
+  state.result.wait();
+  state.result.copyValue();
 }
 
 /**
@@ -256,7 +425,7 @@ inline void OneShotEvent<void, EventPolicy>::get()
 template <eventPolicy EventPolicy>
 inline void OneShotEvent<void, EventPolicy>::wait() const
 {
-  fut.wait();
+  checkState().result.wait();
 }
 
 /**
@@ -265,15 +434,71 @@ inline void OneShotEvent<void, EventPolicy>::wait() const
 template <eventPolicy EventPolicy>
 inline bool OneShotEvent<void, EventPolicy>::setException(std::exception_ptr exPtr)
 {
+  std::optional<Promise<void>> linked;
   try
   {
-    prom.set_exception(exPtr);
-    return true;
+    auto& state = checkState();
+
+    // ------- begin critical section ------- //
+    std::lock_guard lck(state.linkMutex);
+    state.result.setException(exPtr);
+    state.notified = true;
+    linked         = std::exchange(state.linked, std::nullopt);
   }
   catch(...) // set_exception may throw too
   {
     return false;
   }
+  // -------- end critical section -------- //
+
+  if(linked)
+  {
+    linked->setException(exPtr);
+  }
+  return true;
+}
+
+/**
+ * @brief Returns a future that becomes ready when the event is notified, or is ready already
+ *        if it has been notified before. Can only be called once.
+ * @throw std::future_error if the future has already been retrieved.
+ */
+template <eventPolicy EventPolicy>
+inline auto OneShotEvent<void, EventPolicy>::getFuture() -> Future<data_type>
+{
+  auto& state = checkState();
+
+  // ------- begin critical section ------- //
+  std::lock_guard lck(state.linkMutex);
+  if(state.futureRetrieved)
+  {
+    throw std::future_error(std::future_errc::future_already_retrieved);
+  }
+  state.futureRetrieved = true;
+
+  if(!state.notified)
+  {
+    return state.linked.emplace().getFuture();
+  }
+
+  Promise<void> promise;
+  auto copy = [&state] { state.result.copyValue(); };
+  detail::fulfil(promise, copy);
+  return promise.getFuture();
+}
+
+/**
+ * @brief Returns the shared state.
+ * @throw std::future_error if the event has been moved from.
+ */
+template <eventPolicy EventPolicy>
+inline auto OneShotEvent<void, EventPolicy>::checkState() const -> detail::EventState<void>&
+{
+  if(!shared)
+  {
+    throw std::future_error(std::future_errc::no_state);
+  }
+  return *shared;
 }
 
 
@@ -0,0 +1,301 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   ParallelAlgorithms.h
+ * @brief  parallel for and parallel reduce on top of a ThreadPool using recursive range splitting.
+ *
+ * @author Lasse Rosenthal
+ * @date   16.10.2026
+ */
+
+#ifndef PARALLELALGORITHMS_H_58203746192837465019283746501928374650192
+#define PARALLELALGORITHMS_H_58203746192837465019283746501928374650192
+
+
+// includes
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace cctools {
+
+
+/**
+ * @brief The type of the pool shared by the parallel algorithms if no pool is passed.
+ */
+using SharedThreadPool = NonWaitableThreadPool<queuePolicy::workStealing>;
+
+/**
+ * @brief Returns the pool shared by the parallel algorithms. It is created on first use
+ *        with one thread per hardware thread.
+ */
+inline auto sharedThreadPool() -> SharedThreadPool&
+{
+  static SharedThreadPool pool((std::max)(std::thread::hardware_concurrency(), 1U));
+  return pool;
+}
+
+
+namespace detail {
+
+
+/**
+ * @class ForkJoinState
+ * @brief ForkJoinState counts the subranges of a parallel for that are still being processed
+ *        and keeps the first exception thrown by one of them.
+ */
+class ForkJoinState {
+
+public:
+
+  // ---------------------------------------------------
+  // api
+  void fork       () noexcept;
+  void join       () noexcept;
+  auto isFinished () const noexcept -> bool;
+  auto failed     () const noexcept -> bool;
+  void setError   (std::exception_ptr e) noexcept;
+  void rethrow    () const;
+
+private:
+
+  // ---------------------------------------------------
+  // private data
+  std::atomic<std::size_t> pendingRanges {1ULL};
+  std::atomic<bool>        hasError {false};
+  std::exception_ptr       error;
+};
+
+inline void ForkJoinState::fork() noexcept
+{
+  pendingRanges.fetch_add(1ULL, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Marks one subrange as finished. This has to be the last access of a task to the state,
+ *        since the waiting thread may destroy it as soon as the counter drops to zero.
+ */
+inline void ForkJoinState::join() noexcept
+{
+  pendingRanges.fetch_sub(1ULL, std::memory_order_acq_rel);
+}
+
+inline auto ForkJoinState::isFinished() const noexcept -> bool
+{
+  return pendingRanges.load(std::memory_order_acquire) == 0ULL;
+}
+
+inline auto ForkJoinState::failed() const noexcept -> bool
+{
+  return hasError.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Stores the passed exception, if no other exception has been stored before.
+ */
+inline void ForkJoinState::setError(std::exception_ptr e) noexcept
+{
+  if(!hasError.exchange(true, std::memory_order_acq_rel))
+  {
+    error = std::move(e);
+  }
+}
+
+inline void ForkJoinState::rethrow() const
+{
+  if(error)
+  {
+    std::rethrow_exception(error);
+  }
+}
+
+/**
+ * @brief Processes the range [first, last) by repeatedly splitting off its upper half
+ *        and posting it to the pool, until the remaining range is not larger than grainSize.
+ *        The remaining lower part is processed on the calling thread.
+ */
+template <typename Pool, typename Index, typename Fun>
+void forkRange(Pool& pool, ForkJoinState& state, Index first, Index last, Index grainSize, Fun& fun)
+{
+  try
+  {
+    while(last - first > grainSize && !state.failed())
+    {
+      const Index middle = first + (last - first) / 2;
+      state.fork();
+      try
+      {
+        pool.post([&pool, &state, middle, last, grainSize, &fun] {
+          forkRange(pool, state, middle, last, grainSize, fun);
+        });
+      }
+      catch(...)
+      {
+        state.join();
+        throw;
+      }
+      last = middle;
+    }
+
+    if(!state.failed())
+    {
+      fun(first, last);
+    }
+  }
+  catch(...)
+  {
+    state.setError(std::current_exception());
+  }
+  state.join();
+}
+
+
+}   // namespace detail
+
+
+/**
+ * @brief  Invokes fun(begin, end) for disjoint subranges covering [first, last) on the passed pool.
+ *         The range is split recursively into halves until a subrange holds at most grainSize indices.
+ * @remark The calling thread processes a share of the range itself and then helps processing
+ *         pending tasks of the pool until all subranges are finished. Hence, calls may be nested
+ *         and may be issued from working threads of the pool without deadlocking.
+ * @remark If one of the invocations throws, the remaining subranges are skipped and the first
+ *         exception is rethrown after all running invocations have finished.
+ * @remark The pool must not be deactivated before the call returns.
+ * @param  grainSize the maximal number of indices of a subrange. Ranges not larger than grainSize
+ *         are processed on the calling thread without touching the pool.
+ */
+template <typename Pool, typename Index, typename Fun>
+void parallelFor(Pool& pool, Index first, Index last, std::type_identity_t<Index> grainSize, Fun&& fun)
+{
+  static_assert(std::is_integral_v<Index>, "parallelFor requires an integral index type");
+  if(last <= first)
+  {
+    return;
+  }
+
+  grainSize = (std::max)(grainSize, Index{1});
+  if(last - first <= grainSize)
+  {
+    fun(first, last);
+    return;
+  }
+
+  detail::ForkJoinState state;
+  detail::forkRange(pool, state, first, last, grainSize, fun);
+  while(!state.isFinished())
+  {
+    if(!pool.runPendingTask())
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  state.rethrow();
+}
+
+/**
+ * @brief Invokes fun(begin, end) for disjoint subranges covering [first, last) on the shared pool.
+ */
+template <typename Index, typename Fun>
+void parallelFor(Index first, Index last, std::type_identity_t<Index> grainSize, Fun&& fun)
+{
+  if(last <= first)
+  {
+    return;
+  }
+
+  if(last - first <= grainSize)
+  {
+    fun(first, last);
+    return;
+  }
+
+  parallelFor(sharedThreadPool(), first, last, grainSize, std::forward<Fun>(fun));
+}
+
+/**
+ * @brief  Reduces the range [first, last) on the passed pool. The range is divided into chunks of
+ *         grainSize indices, fun(begin, end) computes the partial result of a chunk and the partial
+ *         results are combined with reduce starting from identity.
+ * @remark The partial results are combined in the order of their chunks, so the result does not
+ *         depend on the scheduling. This keeps floating point sums reproducible.
+ * @return the combined value, identity for an empty range.
+ */
+template <typename Pool, typename Index, typename T, typename Fun, typename Reduce>
+auto parallelReduce(Pool& pool, Index first, Index last, std::type_identity_t<Index> grainSize,
+                    T identity, Fun&& fun, Reduce&& reduce) -> T
+{
+  if(last <= first)
+  {
+    return identity;
+  }
+
+  grainSize = (std::max)(grainSize, Index{1});
+  const auto numChunks = static_cast<std::size_t>((last - first + grainSize - 1) / grainSize);
+
+  // the chunks write their results concurrently, so each needs an object of its own, which the
+  // bits of a std::vector<bool> are not
+  struct PartialResult {
+    T value;
+  };
+  std::vector<PartialResult> partialResults(numChunks, PartialResult{identity});
+
+  parallelFor(pool, std::size_t{0ULL}, numChunks, 1ULL, [&](std::size_t begin, std::size_t end) {
+    for(; begin != end; ++begin)
+    {
+      const auto chunkFirst = static_cast<Index>(first + static_cast<Index>(begin) * grainSize);
+      const auto chunkLast  = static_cast<Index>(chunkFirst + (std::min)(static_cast<Index>(last - chunkFirst), grainSize));
+      partialResults[begin].value = fun(chunkFirst, chunkLast);
+    }
+  });
+
+  for(auto& partial : partialResults)
+  {
+    identity = reduce(std::move(identity), std::move(partial.value));
+  }
+  return identity;
+}
+
+/**
+ * @brief Reduces the range [first, last) on the shared pool.
+ */
+template <typename Index, typename T, typename Fun, typename Reduce>
+auto parallelReduce(Index first, Index last, std::type_identity_t<Index> grainSize, T identity, Fun&& fun,
+                    Reduce&& reduce) -> T
+{
+  if(last <= first)
+  {
+    return identity;
+  }
+
+  if(last - first <= grainSize)
+  {
+    return reduce(std::move(identity), fun(first, last));
+  }
+
+  return parallelReduce(sharedThreadPool(), first, last, grainSize, std::move(identity),
+                        std::forward<Fun>(fun), std::forward<Reduce>(reduce));
+}
+
+
+}   // namespace cctools
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif   // PARALLELALGORITHMS_H_58203746192837465019283746501928374650192
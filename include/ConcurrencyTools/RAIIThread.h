@@ -19,7 +19,10 @@
 
 
 // includes
+#include "ThreadPlacement.h"
+
 #include <functional>
+#include <string>
 #include <thread>
 
 
@@ -88,6 +91,8 @@ public:
   [[nodiscard]] auto joinable () const noexcept -> bool;
   auto getId                  () const noexcept -> id;
   auto nativeHandle           () -> native_handle_type;
+  auto setName                (std::string const& name) -> bool;
+  auto setAffinity            (CpuSet const& cpus) -> bool;
   void swap                   (RAIIThread& other) noexcept;
 
 private:
@@ -170,6 +175,26 @@ inline auto RAIIThread<CleanUp, Thread>::nativeHandle() -> native_handle_type
   return raiiThread.native_handle();
 }
 
+/**
+ * @brief Sets the name of the thread as shown by debuggers and profilers.
+ * @return false, if the platform does not support thread names.
+ */
+template <threadcleanup CleanUp, typename Thread>
+inline auto RAIIThread<CleanUp, Thread>::setName(std::string const& name) -> bool
+{
+  return raiiThread.joinable() && setThreadName(nativeHandle(), name);
+}
+
+/**
+ * @brief Restricts the thread to the passed cpus.
+ * @return false, if the cpus are invalid or the platform does not support thread affinities.
+ */
+template <threadcleanup CleanUp, typename Thread>
+inline auto RAIIThread<CleanUp, Thread>::setAffinity(CpuSet const& cpus) -> bool
+{
+  return raiiThread.joinable() && setThreadAffinity(nativeHandle(), cpus);
+}
+
 
 }   // namespace cctools
 
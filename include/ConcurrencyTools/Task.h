@@ -0,0 +1,696 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   Task.h
+ * @brief  coroutine tasks, which run on a thread pool and don't hold a thread while suspended.
+ *
+ * @author Lasse Rosenthal
+ * @date   16.10.2026
+ */
+
+#ifndef TASK_H_83746501928374650192837465019283746501928374
+#define TASK_H_83746501928374650192837465019283746501928374
+
+
+// includes
+#include "FunctionWrapper.h"
+#include "Future.h"
+#include "OneShotEvent.h"
+
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+
+namespace cctools {
+
+
+template <typename T = void>
+class Task;
+
+
+namespace detail {
+
+
+/**
+ * @class TaskPromiseBase
+ * @brief TaskPromiseBase holds everything of the promise of a Task that doesn't depend on its result:
+ *        the coroutine awaiting the task and the executor, on which the task resumes after waiting.
+ */
+class TaskPromiseBase {
+
+  /// transfers control to the awaiting coroutine when the task is done
+  struct FinalAwaiter {
+    auto await_ready () const noexcept -> bool { return false; }
+    template <typename Promise>
+    auto await_suspend (std::coroutine_handle<Promise> handle) noexcept -> std::coroutine_handle<>;
+    void await_resume () const noexcept {}
+  };
+
+public:
+
+  // ---------------------------------------------------
+  // coroutine interface
+  auto initial_suspend     () const noexcept -> std::suspend_always { return {}; }
+  auto final_suspend       () const noexcept -> FinalAwaiter { return {}; }
+  void unhandled_exception () noexcept;
+
+  // ---------------------------------------------------
+  // public data
+  std::coroutine_handle<> continuation;
+  Executor                executor;
+
+protected:
+
+  std::exception_ptr exPtr;
+};
+
+
+/**
+ * @class TaskPromise
+ * @brief TaskPromise is the promise type of Task<T>, which stores the result of the coroutine.
+ */
+template <typename T>
+class TaskPromise : public TaskPromiseBase {
+
+  static_assert(!std::is_reference_v<T>, "a task returns its result by value");
+
+public:
+
+  auto get_return_object () noexcept -> Task<T>;
+  template <typename U>
+  void return_value      (U&& value);
+  auto result            () -> T;
+
+private:
+
+  std::optional<T> value;
+};
+
+template <>
+class TaskPromise<void> : public TaskPromiseBase {
+
+public:
+
+  auto get_return_object () noexcept -> Task<void>;
+  void return_void       () const noexcept {}
+  void result            () const;
+};
+
+
+/**
+ * @brief TaskAccess grants the free functions of this file access to the coroutine of a task.
+ */
+struct TaskAccess {
+  template <typename T>
+  static auto promise (Task<T>& task) -> TaskPromise<T>&;
+};
+
+
+/**
+ * @class ScheduleAwaiter
+ * @brief ScheduleAwaiter suspends the awaiting coroutine and resumes it on an executor.
+ *        A Task remembers the executor and resumes on it after every later suspension.
+ */
+class ScheduleAwaiter {
+
+public:
+
+  explicit ScheduleAwaiter (Executor executor) noexcept;
+
+  auto await_ready () const noexcept -> bool { return false; }
+  template <typename Promise>
+  auto await_suspend (std::coroutine_handle<Promise> handle) -> bool;
+  void await_resume () const noexcept {}
+
+private:
+
+  Executor executor;
+};
+
+
+/**
+ * @class FutureAwaiter
+ * @brief FutureAwaiter suspends the awaiting coroutine until a Future is ready.
+ */
+template <typename T>
+class FutureAwaiter {
+
+public:
+
+  explicit FutureAwaiter (Future<T>&& future);
+
+  auto await_ready () const -> bool;
+  template <typename Promise>
+  auto await_suspend (std::coroutine_handle<Promise> handle) -> bool;
+  auto await_resume () -> T;
+
+private:
+
+  std::shared_ptr<FutureState<T>> state;
+};
+
+
+/**
+ * @class TaskAwaiter
+ * @brief TaskAwaiter starts a Task and suspends the awaiting coroutine until the task is done.
+ */
+template <typename T>
+class TaskAwaiter {
+
+public:
+
+  explicit TaskAwaiter (std::coroutine_handle<TaskPromise<T>> task) noexcept;
+
+  auto await_ready () const noexcept -> bool;
+  template <typename Promise>
+  auto await_suspend (std::coroutine_handle<Promise> awaiting) noexcept -> std::coroutine_handle<>;
+  auto await_resume () -> T;
+
+private:
+
+  std::coroutine_handle<TaskPromise<T>> task;
+};
+
+
+/**
+ * @brief DetachedTask is a coroutine that starts right away and destroys itself when it is done.
+ */
+struct DetachedTask {
+  struct promise_type {
+    auto get_return_object   () const noexcept -> DetachedTask { return {}; }
+    auto initial_suspend     () const noexcept -> std::suspend_never { return {}; }
+    auto final_suspend       () const noexcept -> std::suspend_never { return {}; }
+    void return_void         () const noexcept {}
+    void unhandled_exception () const noexcept { std::terminate(); }
+  };
+};
+
+template <typename Promise>
+auto executorOf  (std::coroutine_handle<Promise> handle) noexcept -> Executor;
+void resumeOn    (Executor executor, std::coroutine_handle<> handle);
+template <typename T>
+auto runDetached (Executor executor, Task<T> task, Promise<T> promise) -> DetachedTask;
+
+
+}   // namespace detail
+
+
+/**
+ * @class  Task
+ * @brief  Task is a lazily started coroutine returning a T. It starts when it is awaited and resumes
+ *         its awaiting coroutine when it is done, so a chain of tasks runs without any thread waiting.
+ *         A task moves to a pool with co_await pool.schedule(). Afterwards, every co_await on a
+ *         Future, a OneShotEvent or ThreadsafeQueueT::asyncPop resumes it on that pool. A task
+ *         awaited by another task inherits its pool.
+ * @remark A suspended task holds no thread. Use spawn to start a task from ordinary code and
+ *         syncWait to block until it is done.
+ * @remark A task must not be destroyed while it is suspended.
+ */
+template <typename T>
+class [[nodiscard]] Task {
+
+  friend class detail::TaskPromise<T>;
+  friend struct detail::TaskAccess;
+
+public:
+
+  // ---------------------------------------------------
+  // public types
+  using value_type   = T;
+  using promise_type = detail::TaskPromise<T>;
+
+  // ---------------------------------------------------
+  // special member functions
+  Task           () noexcept = default;
+  Task           (Task const&) = delete;
+  Task           (Task&& src) noexcept;
+  auto operator= (Task const&) -> Task& = delete;
+  auto operator= (Task&& src) noexcept -> Task&;
+  ~Task          ();
+
+  // ---------------------------------------------------
+  // public api
+  [[nodiscard]] auto valid   () const noexcept -> bool;
+  [[nodiscard]] auto isReady () const noexcept -> bool;
+
+  auto operator co_await () && -> detail::TaskAwaiter<T>;
+
+private:
+
+  // ---------------------------------------------------
+  // private data
+  std::coroutine_handle<promise_type> handle;
+
+  // ---------------------------------------------------
+  // auxiliary methods
+  explicit Task (std::coroutine_handle<promise_type> handle) noexcept;
+};
+
+
+// ---------------------------------------------------
+// awaiting futures and events
+template <typename T>
+auto operator co_await (Future<T>&& future) -> detail::FutureAwaiter<T>;
+template <typename T>
+auto operator co_await (Future<T>& future) -> detail::FutureAwaiter<T>;
+template <typename T, eventPolicy EventPolicy>
+auto operator co_await (OneShotEvent<T, EventPolicy>& event) -> detail::FutureAwaiter<T>;
+
+// ---------------------------------------------------
+// starting tasks
+template <typename T>
+auto spawn    (Task<T> task) -> Future<T>;
+template <typename Pool, typename T>
+auto spawn    (Pool& pool, Task<T> task) -> Future<T>;
+template <typename T>
+auto syncWait (Task<T> task) -> T;
+
+
+// ---------------------------------------------------
+// implementation of the promise types
+
+/**
+ * @brief Resumes the awaiting coroutine. A task, which nobody awaits, stays suspended
+ *        and is destroyed by its owner.
+ */
+template <typename Promise>
+inline auto detail::TaskPromiseBase::FinalAwaiter::await_suspend(std::coroutine_handle<Promise> handle) noexcept
+  -> std::coroutine_handle<>
+{
+  const auto awaiting = handle.promise().continuation;
+  return awaiting ? awaiting : std::noop_coroutine();
+}
+
+/**
+ * @brief Stores the exception, which leaves the coroutine. It is rethrown to the awaiting coroutine.
+ */
+inline void detail::TaskPromiseBase::unhandled_exception() noexcept
+{
+  exPtr = std::current_exception();
+}
+
+/**
+ * @brief Returns the task owning the coroutine.
+ */
+template <typename T>
+inline auto detail::TaskPromise<T>::get_return_object() noexcept -> Task<T>
+{
+  return Task<T>{std::coroutine_handle<TaskPromise>::from_promise(*this)};
+}
+
+/**
+ * @brief Stores the value passed to co_return.
+ */
+template <typename T>
+template <typename U>
+inline void detail::TaskPromise<T>::return_value(U&& result)
+{
+  value.emplace(std::forward<U>(result));
+}
+
+/**
+ * @brief Moves the value out of the promise or rethrows the stored exception.
+ */
+template <typename T>
+inline auto detail::TaskPromise<T>::result() -> T
+{
+  if(exPtr)
+  {
+    std::rethrow_exception(exPtr);
+  }
+  return std::move(*value);
+}
+
+/**
+ * @brief Returns the task owning the coroutine.
+ */
+inline auto detail::TaskPromise<void>::get_return_object() noexcept -> Task<void>
+{
+  return Task<void>{std::coroutine_handle<TaskPromise>::from_promise(*this)};
+}
+
+/**
+ * @brief Rethrows the stored exception, if any.
+ */
+inline void detail::TaskPromise<void>::result() const
+{
+  if(exPtr)
+  {
+    std::rethrow_exception(exPtr);
+  }
+}
+
+/**
+ * @brief Returns the promise of the coroutine of a given task.
+ * @throw std::future_error if the task has no coroutine.
+ */
+template <typename T>
+inline auto detail::TaskAccess::promise(Task<T>& task) -> TaskPromise<T>&
+{
+  if(!task.handle)
+  {
+    throw std::future_error(std::future_errc::no_state);
+  }
+  return task.handle.promise();
+}
+
+
+// ---------------------------------------------------
+// implementation of the awaiters
+
+/**
+ * @brief Returns the executor of the coroutine, which is empty if it isn't a task.
+ */
+template <typename Promise>
+inline auto detail::executorOf(std::coroutine_handle<Promise> handle) noexcept -> Executor
+{
+  if constexpr(std::is_base_of_v<TaskPromiseBase, Promise>)
+  {
+    return handle.promise().executor;
+  }
+  else
+  {
+    return Executor{};
+  }
+}
+
+/**
+ * @brief  Resumes a suspended coroutine by means of a given executor. An empty executor
+ *         resumes it inline, as does a pool which rejects the task.
+ * @remark Must not be called by the coroutine itself, which would nest its resumption.
+ */
+inline void detail::resumeOn(Executor executor, std::coroutine_handle<> handle)
+{
+  if(!executor.execute(FunctionWrapper([handle] { handle.resume(); })))
+  {
+    handle.resume();
+  }
+}
+
+/**
+ * @brief Constructor.
+ */
+inline detail::ScheduleAwaiter::ScheduleAwaiter(Executor e) noexcept
+  : executor {e}
+{}
+
+/**
+ * @brief  Makes the executor the executor of the awaiting task and hands the coroutine over to it.
+ * @return false, if the executor rejected the coroutine, which then continues on the calling thread.
+ */
+template <typename Promise>
+inline auto detail::ScheduleAwaiter::await_suspend(std::coroutine_handle<Promise> handle) -> bool
+{
+  if constexpr(std::is_base_of_v<TaskPromiseBase, Promise>)
+  {
+    handle.promise().executor = executor;
+  }
+  return executor && executor.execute(FunctionWrapper([handle] { handle.resume(); }));
+}
+
+/**
+ * @brief Constructor. Takes over the shared state of the future, which is invalid afterwards.
+ * @throw std::future_error if the future has no shared state.
+ */
+template <typename T>
+inline detail::FutureAwaiter<T>::FutureAwaiter(Future<T>&& future)
+  : state {FutureAccess::state(future)}
+{}
+
+/**
+ * @brief Checks if the result is already available.
+ */
+template <typename T>
+inline auto detail::FutureAwaiter<T>::await_ready() const -> bool
+{
+  return state->isReady();
+}
+
+/**
+ * @brief  Resumes the coroutine on its executor as soon as the result is set. A coroutine
+ *         without executor, or whose executor rejects it, resumes on the thread setting the result.
+ * @return false, if the result has been set meanwhile and the coroutine continues right away.
+ */
+template <typename T>
+template <typename Promise>
+inline auto detail::FutureAwaiter<T>::await_suspend(std::coroutine_handle<Promise> handle) -> bool
+{
+  // the coroutine might be resumed and destroyed before addContinuation returns
+  const auto keepAlive = state;
+  return keepAlive->addContinuation(FunctionWrapper([executor = executorOf(handle), handle] { resumeOn(executor, handle); }),
+                                    Executor{});
+}
+
+/**
+ * @brief Returns the value of the future or rethrows its exception.
+ */
+template <typename T>
+inline auto detail::FutureAwaiter<T>::await_resume() -> T
+{
+  return state->takeValue();
+}
+
+/**
+ * @brief Constructor.
+ */
+template <typename T>
+inline detail::TaskAwaiter<T>::TaskAwaiter(std::coroutine_handle<TaskPromise<T>> t) noexcept
+  : task {t}
+{}
+
+/**
+ * @brief Checks if the task is done already.
+ */
+template <typename T>
+inline auto detail::TaskAwaiter<T>::await_ready() const noexcept -> bool
+{
+  return task.done();
+}
+
+/**
+ * @brief Registers the awaiting coroutine as continuation and transfers control to the task.
+ */
+template <typename T>
+template <typename Promise>
+inline auto detail::TaskAwaiter<T>::await_suspend(std::coroutine_handle<Promise> awaiting) noexcept
+  -> std::coroutine_handle<>
+{
+  auto& promise        = task.promise();
+  promise.continuation = awaiting;
+  if(!promise.executor)
+  {
+    promise.executor = executorOf(awaiting);
+  }
+  return task;
+}
+
+/**
+ * @brief Returns the result of the task or rethrows its exception.
+ */
+template <typename T>
+inline auto detail::TaskAwaiter<T>::await_resume() -> T
+{
+  return task.promise().result();
+}
+
+/**
+ * @brief Awaits a given task and passes its result to a promise.
+ */
+template <typename T>
+auto detail::runDetached(Executor executor, Task<T> task, Promise<T> promise) -> DetachedTask
+{
+  try
+  {
+    if(executor)
+    {
+      TaskAccess::promise(task).executor = executor;
+      co_await ScheduleAwaiter{executor};
+    }
+    if constexpr(std::is_void_v<T>)
+    {
+      co_await std::move(task);
+      promise.setValue();
+    }
+    else
+    {
+      promise.setValue(co_await std::move(task));
+    }
+  }
+  catch(...)
+  {
+    promise.setException(std::current_exception());
+  }
+}
+
+
+// ---------------------------------------------------
+// implementation of Task
+
+/**
+ * @brief Constructor. Takes over a coroutine.
+ */
+template <typename T>
+inline Task<T>::Task(std::coroutine_handle<promise_type> h) noexcept
+  : handle {h}
+{}
+
+/**
+ * @brief Move constructor.
+ */
+template <typename T>
+inline Task<T>::Task(Task&& src) noexcept
+  : handle {std::exchange(src.handle, nullptr)}
+{}
+
+/**
+ * @brief Move assignment. Destroys the own coroutine.
+ */
+template <typename T>
+inline auto Task<T>::operator=(Task&& src) noexcept -> Task&
+{
+  if(this != &src)
+  {
+    if(handle)
+    {
+      handle.destroy();
+    }
+    handle = std::exchange(src.handle, nullptr);
+  }
+  return *this;
+}
+
+/**
+ * @brief Destructor. Destroys the coroutine.
+ */
+template <typename T>
+inline Task<T>::~Task()
+{
+  if(handle)
+  {
+    handle.destroy();
+  }
+}
+
+/**
+ * @brief Checks if the task owns a coroutine.
+ */
+template <typename T>
+inline auto Task<T>::valid() const noexcept -> bool
+{
+  return static_cast<bool>(handle);
+}
+
+/**
+ * @brief Checks if the coroutine is done.
+ */
+template <typename T>
+inline auto Task<T>::isReady() const noexcept -> bool
+{
+  return handle && handle.done();
+}
+
+/**
+ * @brief Starts the coroutine and suspends the awaiting one until it is done. The task
+ *        inherits the executor of the awaiting task unless it has been scheduled itself.
+ * @throw std::future_error if the task has no coroutine.
+ */
+template <typename T>
+inline auto Task<T>::operator co_await() && -> detail::TaskAwaiter<T>
+{
+  if(!handle)
+  {
+    throw std::future_error(std::future_errc::no_state);
+  }
+  return detail::TaskAwaiter<T>{handle};
+}
+
+
+// ---------------------------------------------------
+// implementation of the free functions
+
+/**
+ * @brief Suspends the awaiting coroutine until the future is ready. The future is invalid afterwards.
+ * @throw std::future_error if the future has no shared state.
+ */
+template <typename T>
+inline auto operator co_await(Future<T>&& future) -> detail::FutureAwaiter<T>
+{
+  return detail::FutureAwaiter<T>{std::move(future)};
+}
+
+/**
+ * @brief Suspends the awaiting coroutine until the future is ready. The future is invalid afterwards.
+ * @throw std::future_error if the future has no shared state.
+ */
+template <typename T>
+inline auto operator co_await(Future<T>& future) -> detail::FutureAwaiter<T>
+{
+  return detail::FutureAwaiter<T>{std::move(future)};
+}
+
+/**
+ * @brief  Suspends the awaiting coroutine until the event is notified.
+ * @remark Awaiting retrieves the future of the event, like getFuture this may happen only once.
+ *         If the event has been notified already, the coroutine continues without suspending.
+ */
+template <typename T, eventPolicy EventPolicy>
+inline auto operator co_await(OneShotEvent<T, EventPolicy>& event) -> detail::FutureAwaiter<T>
+{
+  return detail::FutureAwaiter<T>{event.getFuture()};
+}
+
+/**
+ * @brief  Starts a task on the calling thread, which runs it until its first suspension.
+ * @return a future holding the result of the task.
+ */
+template <typename T>
+inline auto spawn(Task<T> task) -> Future<T>
+{
+  Promise<T> promise;
+  auto result = promise.getFuture();
+  detail::runDetached(detail::Executor{}, std::move(task), std::move(promise));
+  return result;
+}
+
+/**
+ * @brief  Starts a task on a given pool, which becomes the executor of the task.
+ * @return a future holding the result of the task, its continuations run on the pool.
+ */
+template <typename Pool, typename T>
+inline auto spawn(Pool& pool, Task<T> task) -> Future<T>
+{
+  Promise<T> promise(pool);
+  auto result = promise.getFuture();
+  detail::runDetached(detail::Executor::of(pool), std::move(task), std::move(promise));
+  return result;
+}
+
+/**
+ * @brief Starts a task on the calling thread and blocks until it is done.
+ * @return the result of the task.
+ * @throw the exception thrown by the task.
+ */
+template <typename T>
+inline auto syncWait(Task<T> task) -> T
+{
+  return spawn(std::move(task)).get();
+}
+
+
+}   // namespace cctools
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif   // TASK_H_83746501928374650192837465019283746501928374
@@ -0,0 +1,122 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   TaskOptions.h
+ * @brief  priority, cancellation token and deadline of a task submitted to a thread pool.
+ *
+ * @author Lasse Rosenthal
+ * @date   16.10.2026
+ */
+
+#ifndef TASKOPTIONS_H_50192837465019283746501928374650192837465019
+#define TASKOPTIONS_H_50192837465019283746501928374650192837465019
+
+
+// includes
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <stop_token>
+
+
+namespace cctools {
+
+
+/**
+ * @brief The reason a queued task was dropped without running.
+ */
+enum class cancelReason : char {
+  cancelled, ///< a stop was requested on the cancellation token of the task.
+  expired    ///< the deadline of the task passed before a worker picked it up.
+};
+
+
+/**
+ * @class TaskCancelled
+ * @brief TaskCancelled is stored in the future of a task, which was dropped without running.
+ */
+class TaskCancelled : public std::runtime_error {
+
+public:
+
+  explicit TaskCancelled (cancelReason reason);
+
+  auto reason () const noexcept -> cancelReason;
+
+private:
+
+  cancelReason why;
+};
+
+
+/**
+ * @brief  TaskOptions describe how a submitted task is scheduled. Tasks are checked right before
+ *         they would run: if a stop was requested on the cancellation token or the deadline passed,
+ *         the task is dropped and its future receives a TaskCancelled exception.
+ * @remark A task, which already started, is not interrupted. Tasks that want to react to a stop
+ *         request while running have to poll the token themselves.
+ */
+struct TaskOptions {
+  using clock = std::chrono::steady_clock;
+
+  int               priority {0};
+  std::stop_token   cancellation;
+  clock::time_point deadline {clock::time_point::max()};
+
+  /// options of a task, which expires after timeOut from now.
+  template <typename Rep, typename Period>
+  static auto expiringAfter (std::chrono::duration<Rep, Period> const& timeOut, int priority = 0) -> TaskOptions
+  {
+    return TaskOptions{priority, std::stop_token{}, clock::now() + std::chrono::duration_cast<clock::duration>(timeOut)};
+  }
+
+  auto dropReason () const -> std::optional<cancelReason>;
+};
+
+
+/**
+ * @brief Constructor.
+ */
+inline TaskCancelled::TaskCancelled(cancelReason reason)
+  : std::runtime_error {reason == cancelReason::cancelled ? "task cancelled" : "task expired"}
+  , why                {reason}
+{}
+
+/**
+ * @brief Returns why the task was dropped.
+ */
+inline auto TaskCancelled::reason() const noexcept -> cancelReason
+{
+  return why;
+}
+
+/**
+ * @brief Returns the reason to drop the task if it must not run anymore. The clock is only
+ *        read for tasks with a deadline.
+ */
+inline auto TaskOptions::dropReason() const -> std::optional<cancelReason>
+{
+  if(cancellation.stop_requested())
+  {
+    return cancelReason::cancelled;
+  }
+  if(deadline != clock::time_point::max() && clock::now() > deadline)
+  {
+    return cancelReason::expired;
+  }
+  return std::nullopt;
+}
+
+
+}   // namespace cctools
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif   // TASKOPTIONS_H_50192837465019283746501928374650192837465019
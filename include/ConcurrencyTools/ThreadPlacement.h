@@ -0,0 +1,438 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   ThreadPlacement.h
+ * @brief  cpu sets, numa topology and the placement of the working threads of a thread pool.
+ *
+ * @author Lasse Rosenthal
+ * @date   16.10.2026
+ */
+
+#ifndef THREADPLACEMENT_H_71928374650192837465019283746501928374650193
+#define THREADPLACEMENT_H_71928374650192837465019283746501928374650193
+
+
+// includes
+#include "WaitStrategy.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32) || defined(_WIN64)
+#  include <Windows.h>
+#elif defined(__linux__)
+#  include <pthread.h>
+#  include <sched.h>
+#  include <fstream>
+#endif
+
+
+namespace cctools {
+
+
+/**
+ * @class CpuSet
+ * @brief CpuSet is an ordered set of logical cpu indices.
+ */
+class CpuSet {
+
+public:
+
+  // ---------------------------------------------------
+  // public types
+  using value_type     = unsigned;
+  using size_type      = std::size_t;
+  using const_iterator = std::vector<value_type>::const_iterator;
+
+  // ---------------------------------------------------
+  // constructors
+  CpuSet () = default;
+  CpuSet (std::initializer_list<value_type> cpus);
+
+  // ---------------------------------------------------
+  // factories
+  static auto range (value_type first, value_type last) -> CpuSet;
+  static auto parse (std::string_view cpuList) -> CpuSet;
+
+  // ---------------------------------------------------
+  // api
+  void add      (value_type cpu);
+  auto contains (value_type cpu) const -> bool;
+  auto empty    () const noexcept -> bool;
+  auto size     () const noexcept -> size_type;
+  auto operator[] (size_type i) const -> value_type;
+  auto begin    () const noexcept -> const_iterator;
+  auto end      () const noexcept -> const_iterator;
+
+  friend auto operator==(CpuSet const& a, CpuSet const& b) -> bool
+  {
+    return a.cpus == b.cpus;
+  }
+
+private:
+
+  // ---------------------------------------------------
+  // private data
+  std::vector<value_type> cpus;
+};
+
+inline CpuSet::CpuSet(std::initializer_list<value_type> cpuList)
+{
+  for(auto const cpu : cpuList)
+  {
+    add(cpu);
+  }
+}
+
+/**
+ * @brief Returns the set holding the cpus first, ..., last - 1.
+ */
+inline auto CpuSet::range(value_type first, value_type last) -> CpuSet
+{
+  CpuSet set;
+  for(; first < last; ++first)
+  {
+    set.cpus.push_back(first);
+  }
+  return set;
+}
+
+/**
+ * @brief Parses a cpu list in the format used by the linux kernel, e.g. "0-3,8,10-11".
+ *        Malformed entries are skipped.
+ */
+inline auto CpuSet::parse(std::string_view cpuList) -> CpuSet
+{
+  const auto toNumber = [](std::string_view s, value_type& value) {
+    if(s.empty())
+    {
+      return false;
+    }
+    value = 0U;
+    for(auto const c : s)
+    {
+      if(c < '0' || c > '9')
+      {
+        return false;
+      }
+      value = value * 10U + static_cast<value_type>(c - '0');
+    }
+    return true;
+  };
+
+  CpuSet set;
+  while(!cpuList.empty())
+  {
+    const auto comma = cpuList.find(',');
+    auto entry = cpuList.substr(0ULL, comma);
+    cpuList.remove_prefix(comma == std::string_view::npos ? cpuList.size() : comma + 1ULL);
+    while(!entry.empty() && (entry.back() == '\n' || entry.back() == ' '))
+    {
+      entry.remove_suffix(1ULL);
+    }
+
+    value_type first = 0U;
+    value_type last  = 0U;
+    if(const auto dash = entry.find('-'); dash == std::string_view::npos)
+    {
+      if(toNumber(entry, first))
+      {
+        set.add(first);
+      }
+    }
+    else if(toNumber(entry.substr(0ULL, dash), first) && toNumber(entry.substr(dash + 1ULL), last))
+    {
+      for(; first <= last; ++first)
+      {
+        set.add(first);
+      }
+    }
+  }
+  return set;
+}
+
+inline void CpuSet::add(value_type cpu)
+{
+  if(const auto pos = std::lower_bound(cpus.begin(), cpus.end(), cpu); pos == cpus.end() || *pos != cpu)
+  {
+    cpus.insert(pos, cpu);
+  }
+}
+
+inline auto CpuSet::contains(value_type cpu) const -> bool
+{
+  return std::binary_search(cpus.begin(), cpus.end(), cpu);
+}
+
+inline auto CpuSet::empty() const noexcept -> bool
+{
+  return cpus.empty();
+}
+
+inline auto CpuSet::size() const noexcept -> size_type
+{
+  return cpus.size();
+}
+
+inline auto CpuSet::operator[](size_type i) const -> value_type
+{
+  return cpus[i];
+}
+
+inline auto CpuSet::begin() const noexcept -> const_iterator
+{
+  return cpus.begin();
+}
+
+inline auto CpuSet::end() const noexcept -> const_iterator
+{
+  return cpus.end();
+}
+
+
+/**
+ * @brief Returns the cpus of every numa node of the machine. If the topology cannot be
+ *        determined, a single node holding all hardware threads is returned.
+ */
+inline auto numaNodes() -> std::vector<CpuSet>
+{
+  std::vector<CpuSet> nodes;
+#if defined(_WIN32) || defined(_WIN64)
+  ULONG highestNode = 0UL;
+  if(GetNumaHighestNodeNumber(&highestNode))
+  {
+    for(ULONG node = 0UL; node <= highestNode; ++node)
+    {
+      ULONGLONG mask = 0ULL;
+      if(GetNumaNodeProcessorMask(static_cast<UCHAR>(node), &mask) && mask != 0ULL)
+      {
+        CpuSet cpus;
+        for(unsigned cpu = 0U; cpu < 64U; ++cpu)
+        {
+          if(mask & (1ULL << cpu))
+          {
+            cpus.add(cpu);
+          }
+        }
+        nodes.push_back(std::move(cpus));
+      }
+    }
+  }
+#elif defined(__linux__)
+  for(unsigned node = 0U;; ++node)
+  {
+    std::ifstream cpuList("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    if(!cpuList)
+    {
+      break;
+    }
+    std::string line;
+    std::getline(cpuList, line);
+    if(auto cpus = CpuSet::parse(line); !cpus.empty())
+    {
+      nodes.push_back(std::move(cpus));
+    }
+  }
+#endif
+
+  if(nodes.empty())
+  {
+    nodes.push_back(CpuSet::range(0U, (std::max)(std::thread::hardware_concurrency(), 1U)));
+  }
+  return nodes;
+}
+
+/**
+ * @brief Restricts the thread identified by the passed handle to the given cpus.
+ * @return false, if the affinity could not be set or is not supported by the platform.
+ */
+inline auto setThreadAffinity(std::thread::native_handle_type handle, CpuSet const& cpus) -> bool
+{
+  if(cpus.empty())
+  {
+    return false;
+  }
+#if defined(_WIN32) || defined(_WIN64)
+  DWORD_PTR mask = 0ULL;
+  for(auto const cpu : cpus)
+  {
+    if(cpu >= sizeof(DWORD_PTR) * 8U)
+    {
+      return false;
+    }
+    mask |= DWORD_PTR{1} << cpu;
+  }
+  return SetThreadAffinityMask(handle, mask) != 0ULL;
+#elif defined(__linux__)
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for(auto const cpu : cpus)
+  {
+    if(cpu >= CPU_SETSIZE)
+    {
+      return false;
+    }
+    CPU_SET(cpu, &cpuSet);
+  }
+  return pthread_setaffinity_np(handle, sizeof(cpu_set_t), &cpuSet) == 0;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief Sets the name of the thread identified by the passed handle as shown by debuggers
+ *        and profilers. On linux, names are truncated to 15 characters.
+ * @return false, if the name could not be set or is not supported by the platform.
+ */
+inline auto setThreadName(std::thread::native_handle_type handle, std::string const& name) -> bool
+{
+#if defined(_WIN32) || defined(_WIN64)
+  return SUCCEEDED(SetThreadDescription(handle, std::wstring(name.begin(), name.end()).c_str()));
+#elif defined(__linux__)
+  static constexpr std::size_t maxNameLength = 15ULL;
+  return pthread_setname_np(handle, name.substr(0ULL, maxNameLength).c_str()) == 0;
+#else
+  return false;
+#endif
+}
+
+
+/**
+ * @brief WorkerGroup describes a group of working threads sharing the same cpus, e.g. a numa node.
+ */
+struct WorkerGroup {
+  std::size_t numThreads {0ULL};
+  CpuSet      cpus;                  ///< the cpus of the group. An empty set leaves the placement to the OS.
+  bool        pinEachWorker {false}; ///< pins the workers one by one to the cpus of the group (round robin).
+};
+
+/**
+ * @class ThreadPoolConfig
+ * @brief ThreadPoolConfig describes the placement and the names of the working threads of a ThreadPool.
+ * @remark Workers are numbered consecutively group by group. If a name is given, worker i is named
+ *         "<name>-<i>". In work stealing mode, idle workers steal from workers of their own group first.
+ *         Idle workers wait according to waitStrategy.
+ * @remark By default the pool starts numThreads() workers and keeps them. An elastic configuration
+ *         (maxThreads > 0) lets the pool grow up to maxWorkers() under load and retire workers idle for
+ *         idleTimeout down to minWorkers(). Workers beyond numThreads() inherit the placement of worker
+ *         i % numThreads().
+ */
+struct ThreadPoolConfig {
+
+  // ---------------------------------------------------
+  // data
+  std::vector<WorkerGroup>  groups;
+  std::string               name;
+  WaitStrategy              waitStrategy;
+  std::size_t               minThreads {0ULL};  ///< lower bound of an elastic pool (at least one worker).
+  std::size_t               maxThreads {0ULL};  ///< upper bound of an elastic pool. Zero disables elasticity.
+  std::chrono::milliseconds idleTimeout {std::chrono::seconds{30}};
+
+  // ---------------------------------------------------
+  // factories
+  static auto uniform     (std::size_t numThreads) -> ThreadPoolConfig;
+  static auto perNumaNode (std::size_t threadsPerNode = 0ULL, bool pinEachWorker = false) -> ThreadPoolConfig;
+
+  // ---------------------------------------------------
+  // api
+  auto withName   (std::string threadName) && -> ThreadPoolConfig&&;
+  auto elastic    (std::size_t minNumThreads, std::size_t maxNumThreads,
+                   std::chrono::milliseconds timeOut = std::chrono::seconds{30}) && -> ThreadPoolConfig&&;
+  auto numThreads () const noexcept -> std::size_t;
+  auto minWorkers () const noexcept -> std::size_t;
+  auto maxWorkers () const noexcept -> std::size_t;
+};
+
+/**
+ * @brief Returns a configuration of numThreads workers without any placement.
+ */
+inline auto ThreadPoolConfig::uniform(std::size_t numThreads) -> ThreadPoolConfig
+{
+  ThreadPoolConfig config;
+  config.groups.push_back(WorkerGroup{numThreads, CpuSet{}, false});
+  return config;
+}
+
+/**
+ * @brief Returns a configuration with one group per numa node, whose workers are restricted to
+ *        the cpus of the node. If threadsPerNode is zero, every node gets one thread per cpu.
+ */
+inline auto ThreadPoolConfig::perNumaNode(std::size_t threadsPerNode, bool pinEachWorker) -> ThreadPoolConfig
+{
+  ThreadPoolConfig config;
+  for(auto& cpus : numaNodes())
+  {
+    const auto numThreads = threadsPerNode == 0ULL ? cpus.size() : threadsPerNode;
+    config.groups.push_back(WorkerGroup{numThreads, std::move(cpus), pinEachWorker});
+  }
+  return config;
+}
+
+inline auto ThreadPoolConfig::withName(std::string threadName) && -> ThreadPoolConfig&&
+{
+  name = std::move(threadName);
+  return std::move(*this);
+}
+
+/**
+ * @brief Makes the pool elastic. It keeps at least minNumThreads and at most maxNumThreads workers and
+ *        retires workers that found no task for timeOut.
+ */
+inline auto ThreadPoolConfig::elastic(std::size_t minNumThreads, std::size_t maxNumThreads,
+                                      std::chrono::milliseconds timeOut) && -> ThreadPoolConfig&&
+{
+  minThreads  = minNumThreads;
+  maxThreads  = maxNumThreads;
+  idleTimeout = timeOut;
+  return std::move(*this);
+}
+
+/**
+ * @brief Returns the total number of workers of all groups.
+ */
+inline auto ThreadPoolConfig::numThreads() const noexcept -> std::size_t
+{
+  std::size_t n = 0ULL;
+  for(auto const& group : groups)
+  {
+    n += group.numThreads;
+  }
+  return n;
+}
+
+/**
+ * @brief Returns the least number of workers the pool keeps.
+ */
+inline auto ThreadPoolConfig::minWorkers() const noexcept -> std::size_t
+{
+  return maxThreads == 0ULL ? numThreads() : std::clamp(minThreads, std::size_t{1ULL}, maxWorkers());
+}
+
+/**
+ * @brief Returns the greatest number of workers the pool may run.
+ */
+inline auto ThreadPoolConfig::maxWorkers() const noexcept -> std::size_t
+{
+  return (std::max)(maxThreads, numThreads());
+}
+
+
+}   // namespace cctools
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif   // THREADPLACEMENT_H_71928374650192837465019283746501928374650193
@@ -16,12 +16,32 @@
  
  
 // includes
+#include "BoundedMPMCQueue.h"
 #include "FunctionWrapper.h"
+#include "Future.h"
+#include "Metrics.h"
 #include "RAIIThread.h"
+#include "Task.h"
+#include "TaskOptions.h"
+#include "ThreadPlacement.h"
 #include "ThreadsafeQueue.h"
+#include "WaitStrategy.h"
+#include "WorkStealingQueue.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <future>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <thread>
 #include <type_traits>
 #include <vector>
 
@@ -42,7 +62,10 @@ enum class threadPoolPolicy : char {
  */
 enum class queuePolicy : char {
   fifo,
-  prioritized
+  prioritized,
+  heapPrioritized, ///< prioritized binary heap. Tasks of equal priority are not executed in submission order.
+  workStealing,    ///< per worker queues with stealing. Priorities are ignored.
+  boundedLockFree  ///< lock-free fixed capacity fifo queue. Priorities are ignored.
 };
  
 
@@ -53,6 +76,8 @@ struct PoolQueueT;
 
 template <>
 struct PoolQueueT<queuePolicy::fifo> {
+  static constexpr std::size_t defaultCapacity = (std::numeric_limits<std::size_t>::max)();
+
   template <typename T>
   struct QueueType {
     using type = Queue<T>;
@@ -61,35 +86,132 @@ struct PoolQueueT<queuePolicy::fifo> {
 
 template <>
 struct PoolQueueT<queuePolicy::prioritized> {
+  static constexpr std::size_t defaultCapacity = (std::numeric_limits<std::size_t>::max)();
+
   template <typename T>
   struct QueueType {
     using type = PriorityQueue<T>;
   };
 };
 
+template <>
+struct PoolQueueT<queuePolicy::heapPrioritized> {
+  static constexpr std::size_t defaultCapacity = (std::numeric_limits<std::size_t>::max)();
+
+  template <typename T>
+  struct QueueType {
+    using type = HeapPriorityQueue<T>;
+  };
+};
+
+template <>
+struct PoolQueueT<queuePolicy::workStealing> {
+  static constexpr std::size_t defaultCapacity = (std::numeric_limits<std::size_t>::max)();
+
+  template <typename T>
+  struct QueueType {
+    using type = Queue<T>;
+  };
+};
+
+template <>
+struct PoolQueueT<queuePolicy::boundedLockFree> {
+  static constexpr std::size_t defaultCapacity = 4096ULL;
+
+  template <typename T>
+  struct QueueType {
+    using type = BoundedMPMCQueue<T>;
+  };
+};
+
 template <queuePolicy p, typename T>
 using PoolQueue = typename PoolQueueT<p>::template QueueType<T>::type;
 
+template <queuePolicy p>
+constexpr std::size_t PoolQueueCapacity = PoolQueueT<p>::defaultCapacity;
 
-}   // namespace detail
 
+/**
+ * @brief A task stamped with its submission time, which the queues of pools collecting
+ *        metrics hold instead of plain tasks.
+ */
+struct TimedTask {
+  FunctionWrapper                       fun;
+  std::chrono::steady_clock::time_point submitted;
+
+  void operator()()
+  {
+    fun();
+  }
+
+  explicit operator bool() const noexcept
+  {
+    return static_cast<bool>(fun);
+  }
+
+  friend auto operator<(TimedTask const& t1, TimedTask const& t2) -> bool
+  {
+    return t1.fun < t2.fun;
+  }
+};
+
+template <metricsPolicy>
+struct PoolCounters {
+  using task_type = TimedTask;
+
+  std::unique_ptr<WorkerCounters[]>     workers;   // one per worker and one for all other threads
+  std::atomic<std::uint64_t>            tasksSubmitted {0ULL};
+  std::atomic<std::uint64_t>            tasksCancelled {0ULL};
+  std::chrono::steady_clock::time_point startTime {std::chrono::steady_clock::now()};
+};
+
+template <>
+struct PoolCounters<metricsPolicy::disabled> {
+  using task_type = FunctionWrapper;
+};
+
+
+}   // namespace detail
 
-//#define USE_YIELD_IN_LOOP 
 
 /**
  * @class ThreadPool
  * @brief ThreadPool is a threadpool
+ * @remark In work stealing mode every working thread owns a local queue. Tasks submitted from
+ *         within a working thread are pushed into its local queue, all other tasks go into the pool queue.
+ *         Idle threads steal tasks from the local queues of the other threads. The capacity
+ *         only applies to the pool queue.
+ * @remark If tasksPerWakeUp is greater than one, a working thread takes several tasks at once out of
+ *         the queue, which reduces the contention on the queue for many small tasks. Since these
+ *         tasks are not available to the other threads anymore, it should be kept small for long
+ *         running tasks. It is ignored in work stealing mode.
+ * @remark A ThreadPoolConfig places the working threads in groups on given cpus (e.g. one group per
+ *         numa node) and names them. In work stealing mode, idle threads first steal from the
+ *         local queues of their own group, so tasks spawned on a node preferably stay there.
+ * @remark Idle threads wait according to a WaitStrategy, which can be changed at runtime. By default
+ *         they block immediately; a spinning strategy reduces the latency of bursts of short tasks.
+ * @remark With metricsPolicy::enabled, the pool stamps every task with its submission time and
+ *         records wait latencies, run times, busy times and steals in per worker counters. metrics()
+ *         returns a snapshot of them. Disabled metrics are removed at compile time.
+ * @remark The pool reserves a slot (thread, local queue, counters) for up to maxSize() workers. resize()
+ *         starts or retires workers within [minSize(), maxSize()]. An elastic pool additionally starts a
+ *         worker whenever a task is submitted while all workers are busy, and retires workers that did
+ *         not find a task for the idle timeout. A retiring worker finishes its current task and moves
+ *         the tasks of its local queue to the pool queue, so no task gets lost.
+ * @remark Tasks submitted with TaskOptions are dropped without running if they were cancelled or
+ *         expired before a worker picked them up. Their futures receive a TaskCancelled exception.
+ * @remark A coroutine moves to the pool with co_await pool.schedule(). A Task remembers the pool
+ *         and resumes on it whenever it has been suspended, see Task.h.
  */
-template <threadPoolPolicy Policy, queuePolicy QueuePolicy = queuePolicy::prioritized>
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy = queuePolicy::prioritized,
+          metricsPolicy Metrics = metricsPolicy::disabled>
 class ThreadPool {
 
-#ifdef USE_YIELD_IN_LOOP
-  static constexpr std::chrono::microseconds loopTimeOut {50};
-#endif
-
   // ---------------------------------------------------
   // private constants & types
-  static constexpr bool isWaitable = Policy == threadPoolPolicy::waitable;
+  static constexpr bool isWaitable     = Policy == threadPoolPolicy::waitable;
+  static constexpr bool isWorkStealing = QueuePolicy == queuePolicy::workStealing;
+  static constexpr bool hasMetrics     = Metrics == metricsPolicy::enabled;
 
   template <typename Fun>
   using waitableResultType = std::enable_if_t<isWaitable, std::future<std::invoke_result_t<Fun>>>;
@@ -105,7 +227,10 @@ public:
 
   // ---------------------------------------------------
   // constructors & dtor
-  ThreadPool     (size_type numThreads, size_type capacity = (std::numeric_limits<size_type>::max)());
+  ThreadPool     (size_type numThreads, size_type capacity = detail::PoolQueueCapacity<QueuePolicy>,
+                  size_type tasksPerWakeUp = 1ULL);
+  ThreadPool     (ThreadPoolConfig const& config, size_type capacity = detail::PoolQueueCapacity<QueuePolicy>,
+                  size_type tasksPerWakeUp = 1ULL);
   ThreadPool     () = delete;
   ThreadPool     (ThreadPool const&) = delete;
   ThreadPool     (ThreadPool&&) = delete;
@@ -115,123 +240,804 @@ public:
 
   // ---------------------------------------------------
   // api
-  auto size       () const noexcept -> size_type;
+  auto size           () const noexcept -> size_type;
+  auto minSize        () const noexcept -> size_type;
+  auto maxSize        () const noexcept -> size_type;
+  void resize         (size_type numThreads);
+  auto waitStrategy   () const noexcept -> WaitStrategy;
+  void setWaitStrategy(WaitStrategy strategy) noexcept;
+  auto metrics        () const -> ThreadPoolMetrics;
   template <typename Fun>
-  auto submit     (Fun&& fun, int priority = 0) -> waitableResultType<Fun>;
+  auto submit         (Fun&& fun, int priority = 0) -> waitableResultType<Fun>;
+  template <typename Fun>
+  auto submit         (Fun&& fun, TaskOptions const& options) -> waitableResultType<Fun>;
+  template <typename Fun, typename = std::enable_if_t<!isWaitable>>
+  void submit         (Fun&& fun, int priority = 0);
   template <typename Fun, typename = std::enable_if_t<!isWaitable>>
-  void submit     (Fun&& fun, int priority = 0);
-  void deactivate ();
+  void submit         (Fun&& fun, TaskOptions const& options);
+  template <typename Fun>
+  auto async          (Fun&& fun, int priority = 0) -> Future<detail::ContinuationResult<void, Fun>>;
+  template <typename Fun>
+  auto async          (Fun&& fun, TaskOptions const& options) -> Future<detail::ContinuationResult<void, Fun>>;
+  template <typename Fun>
+  auto post           (Fun&& fun, int priority = 0) -> bool;
+  template <typename Fun>
+  auto post           (Fun&& fun, TaskOptions const& options) -> bool;
+  auto schedule       () noexcept -> detail::ScheduleAwaiter;
+  auto runPendingTask () -> bool;
+  void deactivate     ();
 
 private:
 
   // ---------------------------------------------------
-  // an alias for the queue type
-  using queue = detail::PoolQueue<QueuePolicy, callable>;
+  // aliases for the queue types
+  using counters   = detail::PoolCounters<Metrics>;
+  using task_type  = typename counters::task_type;
+  using queue      = detail::PoolQueue<QueuePolicy, task_type>;
+  using localQueue = WorkStealingQueue<task_type>;
+
+  /**
+   * @brief Everything belonging to one worker. A slot is reused when a worker is started
+   *        after the previous one retired.
+   */
+  struct WorkerSlot {
+    JoinThread                  thread;
+    std::unique_ptr<localQueue> tasks;         // work stealing mode only
+    std::vector<size_type>      stealOrder;    // work stealing mode only
+    CpuSet                      cpus;
+    std::string                 name;
+    std::atomic<bool>           placed {false};
+    std::atomic<bool>           running {false};
+  };
 
   // ---------------------------------------------------
   // private data
-  bool                    isActive {true};
-  const size_type         numberOfThreads;
-  const size_type         queueCapacity {(std::numeric_limits<size_type>::max)()};
-  queue                   scheduledTasks;
-  std::vector<JoinThread> workingThreads;
+  std::atomic<bool>               isActive {true};
+  const size_type                 minNumThreads;
+  const size_type                 maxNumThreads;
+  const bool                      isElastic;
+  const std::chrono::milliseconds idleTimeout;
+  const size_type                 queueCapacity {detail::PoolQueueCapacity<QueuePolicy>};
+  const size_type                 maxTasksPerWakeUp {1ULL};
+  queue                           scheduledTasks;
+  std::atomic<size_type>          numPendingTasks {0ULL};
+  std::atomic<size_type>          numSleepingThreads {0ULL};
+  std::atomic<size_type>          numActiveThreads {0ULL};   // started and not retiring
+  std::atomic<size_type>          numBusyThreads {0ULL};     // only maintained by elastic pools
+  std::atomic<size_type>          targetNumThreads;
+  std::mutex                      sleepMutex;
+  std::condition_variable         wakeUpCondVar;
+  std::uint32_t                   wakeUpEpoch {0U};          // guarded by sleepMutex
+  std::mutex                      resizeMutex;
+  std::atomic<WaitStrategy>       idleWaitStrategy {WaitStrategy::blocking()};
+  counters                        poolCounters;
+  std::unique_ptr<WorkerSlot[]>   workerSlots;
+
+  // ---------------------------------------------------
+  // thread specific data of the working threads
+  inline static thread_local ThreadPool const* owningPool {nullptr};
+  inline static thread_local localQueue*       ownLocalQueue {nullptr};
+  inline static thread_local size_type         ownIndex {0ULL};
+  inline static thread_local size_type         taskDepth {0ULL};
 
   // ---------------------------------------------------
-  void workThread ();
+  void initWorkerSlots    (ThreadPoolConfig const& config);
+  void startWorkers       ();
+  void startWorker        (size_type index);
+  void joinWorkers        ();
+  void workThread         (size_type index);
+  void workStealingThread (size_type index);
+  void finishWorker       (size_type index);
+  auto retireIfSurplus    () -> bool;
+  void shrinkIdle         ();
+  void growIfSaturated    ();
+  void wakeUpSurplus      ();
+  void schedule           (callable&& task);
+  auto popTask            (task_type& task) -> bool;
+  auto dropReason         (TaskOptions const& options) -> std::optional<cancelReason>;
+  void execute            (task_type& task);
+  auto callingCounters    () -> detail::WorkerCounters&;
+  auto waitForTasks       () -> bool;
+  void wakeUpThread       ();
 };
 
 
 /**
  * @brief Convenient alias for waitable thread pools.
  */
-template <queuePolicy p>
-using WaitableThreadPool = ThreadPool<threadPoolPolicy::waitable, p>;
+template <queuePolicy p, metricsPolicy m = metricsPolicy::disabled>
+using WaitableThreadPool = ThreadPool<threadPoolPolicy::waitable, p, m>;
 
 /**
  * @brief Convenient alias for non-waitable thread pools.
  */
-template <queuePolicy p>
-using NonWaitableThreadPool = ThreadPool<threadPoolPolicy::nonwaitable, p>;
+template <queuePolicy p, metricsPolicy m = metricsPolicy::disabled>
+using NonWaitableThreadPool = ThreadPool<threadPoolPolicy::nonwaitable, p, m>;
+
+
+/**
+ * @brief Constructor. Starts numThreads working threads without any placement.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+inline ThreadPool<Policy, QueuePolicy, Metrics>::ThreadPool(size_type numThreads, size_type capacity, size_type tasksPerWakeUp)
+  : ThreadPool(ThreadPoolConfig::uniform(numThreads), capacity, tasksPerWakeUp)
+{}
 
+/**
+ * @brief Constructor. Starts the working threads described by the passed configuration.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+ThreadPool<Policy, QueuePolicy, Metrics>::ThreadPool(ThreadPoolConfig const& config, size_type capacity,
+                                            size_type tasksPerWakeUp)
+  : minNumThreads     {config.minWorkers()}
+  , maxNumThreads     {config.maxWorkers()}
+  , isElastic         {minNumThreads < maxNumThreads}
+  , idleTimeout       {config.idleTimeout}
+  , queueCapacity     {capacity}
+  , maxTasksPerWakeUp {(std::max)(tasksPerWakeUp, size_type{1ULL})}
+  , scheduledTasks    {queueCapacity}
+  , targetNumThreads  {std::clamp(config.numThreads(), minNumThreads, maxNumThreads)}
+  , workerSlots       {std::make_unique<WorkerSlot[]>(maxNumThreads)}
+{
+  if constexpr(hasMetrics)
+  {
+    poolCounters.workers = std::make_unique<detail::WorkerCounters[]>(maxNumThreads + 1ULL);
+  }
+
+  try
+  {
+    setWaitStrategy(config.waitStrategy);
+    initWorkerSlots(config);
+
+    std::lock_guard<std::mutex> lock(resizeMutex);
+    startWorkers();
+  }
+  catch(...)
+  {
+    deactivate();
+    joinWorkers();
+    throw;
+  }
+}
+
+/**
+ * @brief Assigns the cpus, names and (in work stealing mode) local queues and steal orders to the
+ *        worker slots. Slots beyond the workers of the configuration inherit the placement of slot
+ *        i % numThreads(). Every worker steals from the workers of its own group first, starting
+ *        with its successor.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+void ThreadPool<Policy, QueuePolicy, Metrics>::initWorkerSlots(ThreadPoolConfig const& config)
+{
+  std::vector<size_type> groupOf(maxNumThreads, 0ULL);
+  size_type index = 0ULL;
+  for(size_type g = 0ULL; g < config.groups.size(); ++g)
+  {
+    auto const& group = config.groups[g];
+    for(size_type i = 0ULL; i < group.numThreads; ++i, ++index)
+    {
+      if(!group.cpus.empty())
+      {
+        workerSlots[index].cpus = group.pinEachWorker ? CpuSet{group.cpus[i % group.cpus.size()]} : group.cpus;
+      }
+      groupOf[index] = g;
+    }
+  }
+
+  const auto numConfigured = index;
+  for(; numConfigured > 0ULL && index < maxNumThreads; ++index)
+  {
+    workerSlots[index].cpus = workerSlots[index % numConfigured].cpus;
+    groupOf[index]          = groupOf[index % numConfigured];
+  }
+
+  for(index = 0ULL; index < maxNumThreads; ++index)
+  {
+    auto& slot = workerSlots[index];
+    if(!config.name.empty())
+    {
+      slot.name = config.name + '-' + std::to_string(index);
+    }
+
+    if constexpr(isWorkStealing)
+    {
+      slot.tasks = std::make_unique<localQueue>();
+      slot.stealOrder.reserve(maxNumThreads - 1ULL);
+      for(size_type i = 1ULL; i < maxNumThreads; ++i)
+      {
+        if(const auto other = (index + i) % maxNumThreads; groupOf[other] == groupOf[index])
+        {
+          slot.stealOrder.push_back(other);
+        }
+      }
+      for(size_type i = 1ULL; i < maxNumThreads; ++i)
+      {
+        if(const auto other = (index + i) % maxNumThreads; groupOf[other] != groupOf[index])
+        {
+          slot.stealOrder.push_back(other);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Starts workers in free slots until the target number of workers is reached.
+ *        Requires the resize mutex.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+void ThreadPool<Policy, QueuePolicy, Metrics>::startWorkers()
+{
+  // slots of retiring workers are released as soon as they handed over their local tasks
+  for(size_type index = 0ULL; numActiveThreads.load() < targetNumThreads.load(); index = (index + 1ULL) % maxNumThreads)
+  {
+    if(!workerSlots[index].running.load(std::memory_order_acquire))
+    {
+      startWorker(index);
+    }
+    else if(index + 1ULL == maxNumThreads)
+    {
+      std::this_thread::yield();
+    }
+  }
+}
 
 /**
- * @brief Constructor. Starts the working threads.
+ * @brief Starts a worker in the passed slot, restricts it to the cpus of the slot and names it.
+ *        The worker does not process any task before it is placed. A thread that retired from the
+ *        slot before is joined first. Placement is done on a best effort basis, i.e. cpus that are
+ *        not available are silently ignored. Requires the resize mutex.
  */
-template <threadPoolPolicy Policy, queuePolicy QueuePolicy>
-ThreadPool<Policy, QueuePolicy>::ThreadPool(size_type numThreads, size_type capacity)
-  : numberOfThreads {numThreads}
-  , queueCapacity   {capacity}
-  , scheduledTasks  {queueCapacity}
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+void ThreadPool<Policy, QueuePolicy, Metrics>::startWorker(size_type index)
 {
+  auto& slot = workerSlots[index];
+  JoinThread{}.swap(slot.thread);
+
+  slot.placed.store(false);
+  slot.running.store(true);
+  ++numActiveThreads;
   try
   {
-    workingThreads.reserve(numberOfThreads);
-    for(std::size_t i = 0ULL; i < numberOfThreads; ++i)
+    if constexpr(isWorkStealing)
+    {
+      slot.thread = JoinThread(&ThreadPool::workStealingThread, this, index);
+    }
+    else
     {
-      workingThreads.emplace_back(&ThreadPool::workThread, this);
+      slot.thread = JoinThread(&ThreadPool::workThread, this, index);
     }
   }
   catch(...)
   {
-    isActive = false;
+    --numActiveThreads;
+    slot.running.store(false);
     throw;
   }
+
+  if(!slot.cpus.empty())
+  {
+    slot.thread.setAffinity(slot.cpus);
+  }
+  if(!slot.name.empty())
+  {
+    slot.thread.setName(slot.name);
+  }
+  slot.placed.store(true);
+  slot.placed.notify_one();
 }
 
 /**
- * @brief The actual working method
+ * @brief Joins all workers. Requires a deactivated pool.
  */
-template <threadPoolPolicy Policy, queuePolicy QueuePolicy>
-void ThreadPool<Policy, QueuePolicy>::workThread()
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+void ThreadPool<Policy, QueuePolicy, Metrics>::joinWorkers()
 {
-  while(isActive)
+  std::lock_guard<std::mutex> lock(resizeMutex);
+  for(size_type index = 0ULL; index < maxNumThreads; ++index)
   {
-    callable task;
-#ifdef USE_YIELD_IN_LOOP
-    if(scheduledTasks.tryPop(task))
+    auto& slot = workerSlots[index];
+    slot.placed.store(true);
+    slot.placed.notify_one();
+    JoinThread{}.swap(slot.thread);
+  }
+}
+
+/**
+ * @brief The actual working method. Every wake up drains up to maxTasksPerWakeUp tasks
+ *        from the queue, which are then processed one after another. Workers of elastic pools
+ *        wait at most for the idle timeout.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+void ThreadPool<Policy, QueuePolicy, Metrics>::workThread(size_type index)
+{
+  owningPool = this;
+  ownIndex   = index;
+
+  std::vector<task_type> tasks;
+  tasks.reserve(maxTasksPerWakeUp);
+
+  workerSlots[index].placed.wait(false);
+  while(isActive && !retireIfSurplus())
+  {
+    tasks.clear();
+    if(isElastic)
     {
-      task();
+      task_type task;
+      if(!scheduledTasks.tryPopFor(task, idleTimeout))
+      {
+        shrinkIdle();
+        continue;
+      }
+      tasks.push_back(std::move(task));
+      if(maxTasksPerWakeUp > 1ULL)
+      {
+        scheduledTasks.tryPopBulk(std::back_inserter(tasks), maxTasksPerWakeUp - 1ULL);
+      }
+      ++numBusyThreads;
     }
     else
     {
-      std::this_thread::yield();
-      std::this_thread::sleep_for(loopTimeOut);
+      scheduledTasks.waitAndPopBulk(std::back_inserter(tasks), maxTasksPerWakeUp);
     }
-#else
-    scheduledTasks.waitAndPop(task);
+
+    for(auto& task : tasks)
+    {
+      if(!isActive)
+      {
+        break;
+      }
+      if(task)
+      {
+        execute(task);
+      }
+    }
+
+    if(isElastic)
+    {
+      --numBusyThreads;
+    }
+  }
+  finishWorker(index);
+}
+
+/**
+ * @brief The working method in work stealing mode. Every thread first processes its own
+ *        local queue, then the pool queue and finally tries to steal tasks from the other threads.
+ *        If none of the queues hold a task, the thread is put to sleep until a new task is scheduled.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+void ThreadPool<Policy, QueuePolicy, Metrics>::workStealingThread(size_type index)
+{
+  owningPool    = this;
+  ownLocalQueue = workerSlots[index].tasks.get();
+  ownIndex      = index;
+
+  workerSlots[index].placed.wait(false);
+  while(isActive && !retireIfSurplus())
+  {
+    task_type task;
+    if(popTask(task))
+    {
+      if(isElastic)
+      {
+        ++numBusyThreads;
+        execute(task);
+        --numBusyThreads;
+      }
+      else
+      {
+        execute(task);
+      }
+    }
+    else if(!spinUntil(idleWaitStrategy.load(std::memory_order_relaxed),
+                       [this] { return numPendingTasks.load() > 0ULL || !isActive; }) &&
+            !waitForTasks())
+    {
+      shrinkIdle();
+    }
+  }
+  finishWorker(index);
+}
+
+/**
+ * @brief Releases the slot of a worker leaving its loop. If the pool is still active, the worker
+ *        retires and hands the tasks of its local queue over to the pool queue.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+void ThreadPool<Policy, QueuePolicy, Metrics>::finishWorker(size_type index)
+{
+  if constexpr(isWorkStealing)
+  {
     if(isActive)
     {
-      task();
+      task_type task;
+      while(ownLocalQueue->tryPop(task))
+      {
+        scheduledTasks.push(std::move(task));
+      }
+      wakeUpThread();
     }
-#endif
+  }
+
+  owningPool    = nullptr;
+  ownLocalQueue = nullptr;
+  workerSlots[index].running.store(false, std::memory_order_release);
+}
+
+/**
+ * @brief Lets the calling worker retire if more workers than the target number are active.
+ * @return true, if the calling worker has to retire.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+inline auto ThreadPool<Policy, QueuePolicy, Metrics>::retireIfSurplus() -> bool
+{
+  auto active = numActiveThreads.load(std::memory_order_relaxed);
+  while(active > targetNumThreads.load(std::memory_order_relaxed))
+  {
+    if(numActiveThreads.compare_exchange_weak(active, active - 1ULL))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Called by a worker, which did not find a task for the idle timeout. Lowers the target
+ *        number of workers by one unless the minimum is reached, so the worker retires.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+void ThreadPool<Policy, QueuePolicy, Metrics>::shrinkIdle()
+{
+  auto target = targetNumThreads.load();
+  while(target > minNumThreads && !targetNumThreads.compare_exchange_weak(target, target - 1ULL))
+  {}
+}
+
+/**
+ * @brief Starts another worker of an elastic pool if all workers are busy. Growing is skipped
+ *        while another thread resizes the pool and is done on a best effort basis, since the
+ *        running workers process the backlog anyway.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+void ThreadPool<Policy, QueuePolicy, Metrics>::growIfSaturated()
+{
+  const auto active = numActiveThreads.load(std::memory_order_relaxed);
+  if(active >= maxNumThreads || numBusyThreads.load(std::memory_order_relaxed) < active)
+  {
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(resizeMutex, std::try_to_lock);
+  if(lock && isActive)
+  {
+    auto target = targetNumThreads.load();
+    while(target < maxNumThreads && target <= numActiveThreads &&
+          !targetNumThreads.compare_exchange_weak(target, target + 1ULL))
+    {}
+
+    try
+    {
+      startWorkers();
+    }
+    catch(std::system_error const&)
+    {}
+  }
+}
+
+/**
+ * @brief Wakes up idle workers, so the workers exceeding the target number retire.
+ *        Blocked workers of the other queue policies are woken up by empty tasks.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+void ThreadPool<Policy, QueuePolicy, Metrics>::wakeUpSurplus()
+{
+  const auto active = numActiveThreads.load();
+  const auto target = targetNumThreads.load();
+  if(active <= target)
+  {
+    return;
+  }
+
+  if constexpr(isWorkStealing)
+  {
+    {
+      std::lock_guard<std::mutex> lock(sleepMutex);
+      ++wakeUpEpoch;
+    }
+    wakeUpCondVar.notify_all();
+  }
+  else
+  {
+    for(auto i = target; i < active && scheduledTasks.tryPush(task_type{}); ++i)
+    {}
+  }
+}
+
+/**
+ * @brief Pushes a task into the local queue if called from one of the pool's working threads
+ *        in work stealing mode. Otherwise, the task is pushed into the pool queue.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+inline void ThreadPool<Policy, QueuePolicy, Metrics>::schedule(callable&& fun)
+{
+  task_type task;
+  if constexpr(hasMetrics)
+  {
+    poolCounters.tasksSubmitted.fetch_add(1ULL, std::memory_order_relaxed);
+    task = task_type{std::move(fun), std::chrono::steady_clock::now()};
+  }
+  else
+  {
+    task = std::move(fun);
+  }
+
+  if constexpr(isWorkStealing)
+  {
+    ++numPendingTasks;
+    if(owningPool == this)
+    {
+      ownLocalQueue->push(std::move(task));
+    }
+    else
+    {
+      scheduledTasks.push(std::move(task));
+    }
+    wakeUpThread();
+  }
+  else
+  {
+    scheduledTasks.push(std::move(task));
+  }
+
+  if(isElastic)
+  {
+    growIfSaturated();
+  }
+}
+
+/**
+ * @brief Attempts to retrieve a task from the local queue, the pool queue or
+ *        the local queues of the other threads (in this order). The threads of the
+ *        own group are visited first, slots without a worker are skipped.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+auto ThreadPool<Policy, QueuePolicy, Metrics>::popTask(task_type& task) -> bool
+{
+  auto const& stealOrder = workerSlots[ownIndex].stealOrder;
+  bool found = ownLocalQueue->tryPop(task) || scheduledTasks.tryPop(task);
+  for(auto it = stealOrder.cbegin(), end = stealOrder.cend(); !found && it != end; ++it)
+  {
+    auto& victim = workerSlots[*it];
+    found = victim.running.load(std::memory_order_relaxed) && victim.tasks->trySteal(task);
+    if constexpr(hasMetrics)
+    {
+      if(found)
+      {
+        poolCounters.workers[ownIndex].steals.fetch_add(1ULL, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  if(found)
+  {
+    --numPendingTasks;
+  }
+
+  return found;
+}
+
+/**
+ * @brief Runs the task. With metrics, its wait latency and run time are recorded in the counters
+ *        of the calling thread. Tasks run by a task, e.g. while it helps in runPendingTask, do not
+ *        add to the busy time a second time.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+inline void ThreadPool<Policy, QueuePolicy, Metrics>::execute(task_type& task)
+{
+  if constexpr(hasMetrics)
+  {
+    using clock = std::chrono::steady_clock;
+
+    auto& workerCounters = callingCounters();
+    const auto start = clock::now();
+    workerCounters.waitLatency.record(start - task.submitted);
+
+    ++taskDepth;
+    task();
+    --taskDepth;
+
+    const auto runTime = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+    workerCounters.runTime.record(runTime);
+    workerCounters.tasksRun.fetch_add(1ULL, std::memory_order_relaxed);
+    if(taskDepth == 0ULL)
+    {
+      workerCounters.busyTime.fetch_add(static_cast<std::uint64_t>(runTime.count()), std::memory_order_relaxed);
+    }
+  }
+  else
+  {
+    task();
+  }
+}
+
+/**
+ * @brief Returns the counters of the calling working thread. Threads outside the pool share the last counters.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+inline auto ThreadPool<Policy, QueuePolicy, Metrics>::callingCounters() -> detail::WorkerCounters&
+{
+  return poolCounters.workers[owningPool == this ? ownIndex : maxNumThreads];
+}
+
+/**
+ * @brief Puts the calling thread to sleep until a new task is scheduled or the pool is deactivated.
+ *        Workers of elastic pools sleep at most for the idle timeout.
+ * @return false, if the idle timeout expired.
+ * @remark The sleeping threads counter is incremented before the pending tasks counter is checked,
+ *         whereas schedule increments the pending tasks before the sleeping threads counter is checked.
+ *         Thus, at least one side is guaranteed to observe the other. Since the epoch is read before
+ *         and only changed under the sleep mutex, no wake up gets lost.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+auto ThreadPool<Policy, QueuePolicy, Metrics>::waitForTasks() -> bool
+{
+  std::unique_lock<std::mutex> lock(sleepMutex);
+  const auto epoch = wakeUpEpoch;
+  ++numSleepingThreads;
+
+  bool wokenUp = true;
+  if(numPendingTasks == 0ULL && isActive)
+  {
+    const auto epochChanged = [this, epoch] { return wakeUpEpoch != epoch; };
+    if(isElastic)
+    {
+      wokenUp = wakeUpCondVar.wait_for(lock, idleTimeout, epochChanged);
+    }
+    else
+    {
+      wakeUpCondVar.wait(lock, epochChanged);
+    }
+  }
+
+  --numSleepingThreads;
+  return wokenUp;
+}
+
+/**
+ * @brief Wakes up a sleeping thread if there is one.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+inline void ThreadPool<Policy, QueuePolicy, Metrics>::wakeUpThread()
+{
+  if(numSleepingThreads > 0ULL)
+  {
+    {
+      std::lock_guard<std::mutex> lock(sleepMutex);
+      ++wakeUpEpoch;
+    }
+    wakeUpCondVar.notify_one();
   }
 }
 
 /**
  * @brief Deactivates the thread pool to ensure that the working
- *        threads don't continue to process possibly remaining tasks.
+ *        threads don't continue to process possibly remaining tasks
+ *        and joins them.
  */
-template <threadPoolPolicy Policy, queuePolicy QueuePolicy>
-inline ThreadPool<Policy, QueuePolicy>::~ThreadPool()
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+inline ThreadPool<Policy, QueuePolicy, Metrics>::~ThreadPool()
 {
   deactivate();
-  //  isActive = false;
-//#if !USE_YIELD_IN_LOOP
-//  for(size_type i{}; i < numberOfThreads; ++i)
-//  {
-//    // this is a hack to ensure that every thread gets one last task to process.
-//    submit([]{});
-//  }
-//#endif
+  joinWorkers();
 }
 
 /**
- * @brief Returns the number threads in the pool.
+ * @brief Returns the number of working threads, which are not retiring.
  */
-template <threadPoolPolicy Policy, queuePolicy QueuePolicy>
-inline auto ThreadPool<Policy, QueuePolicy>::size() const noexcept -> size_type
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+inline auto ThreadPool<Policy, QueuePolicy, Metrics>::size() const noexcept -> size_type
 {
-  return numberOfThreads;
+  return numActiveThreads.load();
+}
+
+/**
+ * @brief Returns the least number of working threads the pool keeps.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+inline auto ThreadPool<Policy, QueuePolicy, Metrics>::minSize() const noexcept -> size_type
+{
+  return minNumThreads;
+}
+
+/**
+ * @brief Returns the greatest number of working threads the pool may run.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+inline auto ThreadPool<Policy, QueuePolicy, Metrics>::maxSize() const noexcept -> size_type
+{
+  return maxNumThreads;
+}
+
+/**
+ * @brief Sets the number of working threads, clamped to [minSize(), maxSize()]. Missing workers
+ *        are started immediately, surplus workers retire as soon as they finished their current task.
+ *        Elastic pools keep growing and shrinking with the load afterwards.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+void ThreadPool<Policy, QueuePolicy, Metrics>::resize(size_type numThreads)
+{
+  std::lock_guard<std::mutex> lock(resizeMutex);
+  if(!isActive)
+  {
+    return;
+  }
+
+  targetNumThreads = std::clamp(numThreads, minNumThreads, maxNumThreads);
+  startWorkers();
+  wakeUpSurplus();
+}
+
+/**
+ * @brief Returns the strategy of idle threads waiting for new tasks.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+inline auto ThreadPool<Policy, QueuePolicy, Metrics>::waitStrategy() const noexcept -> WaitStrategy
+{
+  return idleWaitStrategy.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Sets the strategy of idle threads waiting for new tasks. Takes effect with the next wait.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+inline void ThreadPool<Policy, QueuePolicy, Metrics>::setWaitStrategy(WaitStrategy strategy) noexcept
+{
+  idleWaitStrategy.store(strategy, std::memory_order_relaxed);
+  if constexpr(!isWorkStealing)
+  {
+    scheduledTasks.setWaitStrategy(strategy);
+  }
+}
+
+/**
+ * @brief Returns a snapshot of the metrics of the pool. Requires metricsPolicy::enabled.
+ *        The counters are read one by one while the pool keeps running, so the snapshot
+ *        is not taken at a single instant.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+auto ThreadPool<Policy, QueuePolicy, Metrics>::metrics() const -> ThreadPoolMetrics
+{
+  static_assert(hasMetrics, "metrics are only collected with metricsPolicy::enabled");
+
+  ThreadPoolMetrics result;
+  result.uptime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                       poolCounters.startTime);
+  for(size_type i = 0ULL; i <= maxNumThreads; ++i)
+  {
+    auto const& workerCounters = poolCounters.workers[i];
+    WorkerMetrics worker;
+    worker.tasksRun = workerCounters.tasksRun.load(std::memory_order_relaxed);
+    worker.steals   = workerCounters.steals.load(std::memory_order_relaxed);
+    worker.busyTime = std::chrono::nanoseconds{static_cast<long long>(workerCounters.busyTime.load(std::memory_order_relaxed))};
+    worker.idleTime = (std::max)(result.uptime - worker.busyTime, std::chrono::nanoseconds::zero());
+    workerCounters.waitLatency.addTo(result.waitLatency);
+    workerCounters.runTime.addTo(result.runTime);
+
+    result.tasksCompleted += worker.tasksRun;
+    result.steals         += worker.steals;
+    if(i < maxNumThreads)
+    {
+      result.workers.push_back(worker);
+    }
+  }
+
+  result.tasksSubmitted = poolCounters.tasksSubmitted.load(std::memory_order_relaxed);
+  result.tasksCancelled = poolCounters.tasksCancelled.load(std::memory_order_relaxed);
+  const auto tasksStarted = result.waitLatency.count();
+  result.queueDepth = result.tasksSubmitted > tasksStarted ? static_cast<size_type>(result.tasksSubmitted - tasksStarted) : 0ULL;
+  return result;
 }
 
 /**
@@ -239,13 +1045,54 @@ inline auto ThreadPool<Policy, QueuePolicy>::size() const noexcept -> size_type
  *        a future associated with a shared state holding the
  *        result of the method.
  */
-template <threadPoolPolicy Policy, queuePolicy QueuePolicy>
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
 template <typename Fun>
-auto ThreadPool<Policy, QueuePolicy>::submit(Fun&& fun, int priority) -> waitableResultType<Fun>
+auto ThreadPool<Policy, QueuePolicy, Metrics>::submit(Fun&& fun, int priority) -> waitableResultType<Fun>
 {
   std::packaged_task<std::invoke_result_t<Fun>()> task(std::forward<Fun>(fun));
   auto result = task.get_future();
-  scheduledTasks.push(callable(std::move(task), priority));
+  schedule(callable(std::move(task), priority));
+
+  return result;
+}
+
+/**
+ * @brief Schedules the passed function with the given options and returns a future associated
+ *        with a shared state holding the result of the method. If the task is dropped, the
+ *        future holds a TaskCancelled exception.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+template <typename Fun>
+auto ThreadPool<Policy, QueuePolicy, Metrics>::submit(Fun&& fun, TaskOptions const& options) -> waitableResultType<Fun>
+{
+  using result_type = std::invoke_result_t<Fun>;
+
+  std::promise<result_type> promise;
+  auto result = promise.get_future();
+  schedule(callable([this, promise = std::move(promise), fun = std::forward<Fun>(fun), options]() mutable {
+    if(const auto reason = dropReason(options))
+    {
+      promise.set_exception(std::make_exception_ptr(TaskCancelled(*reason)));
+      return;
+    }
+
+    try
+    {
+      if constexpr(std::is_void_v<result_type>)
+      {
+        fun();
+        promise.set_value();
+      }
+      else
+      {
+        promise.set_value(fun());
+      }
+    }
+    catch(...)
+    {
+      promise.set_exception(std::current_exception());
+    }
+  }, options.priority));
 
   return result;
 }
@@ -253,23 +1100,205 @@ auto ThreadPool<Policy, QueuePolicy>::submit(Fun&& fun, int priority) -> waitabl
 /**
  * @brief Schedules the passed function for processing.
  */
-template <threadPoolPolicy Policy, queuePolicy QueuePolicy>
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+template <typename Fun, typename>
+inline void ThreadPool<Policy, QueuePolicy, Metrics>::submit(Fun&& fun, int priority)
+{
+  schedule(callable(std::forward<Fun>(fun), priority));
+}
+
+/**
+ * @brief Schedules the passed function with the given options for processing.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
 template <typename Fun, typename>
-inline void ThreadPool<Policy, QueuePolicy>::submit(Fun&& fun, int priority)
+inline void ThreadPool<Policy, QueuePolicy, Metrics>::submit(Fun&& fun, TaskOptions const& options)
 {
-  scheduledTasks.push(callable(std::forward<Fun>(fun), priority));
+  post(std::forward<Fun>(fun), options);
+}
+
+/**
+ * @brief Schedules the passed function for processing and returns a Future, whose
+ *        continuations are scheduled on this pool as well. Available for both policies.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+template <typename Fun>
+auto ThreadPool<Policy, QueuePolicy, Metrics>::async(Fun&& fun, int priority) -> Future<detail::ContinuationResult<void, Fun>>
+{
+  Promise<detail::ContinuationResult<void, Fun>> promise(*this);
+  auto result = promise.getFuture();
+  post([promise = std::move(promise), fun = std::forward<Fun>(fun)]() mutable { detail::fulfil(promise, fun); },
+       priority);
+
+  return result;
+}
+
+/**
+ * @brief Schedules the passed function with the given options and returns a Future, whose
+ *        continuations are scheduled on this pool as well. If the task is dropped, the Future
+ *        holds a TaskCancelled exception.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+template <typename Fun>
+auto ThreadPool<Policy, QueuePolicy, Metrics>::async(Fun&& fun, TaskOptions const& options) -> Future<detail::ContinuationResult<void, Fun>>
+{
+  Promise<detail::ContinuationResult<void, Fun>> promise(*this);
+  auto result = promise.getFuture();
+  post([this, promise = std::move(promise), fun = std::forward<Fun>(fun), options]() mutable {
+         if(const auto reason = dropReason(options))
+         {
+           promise.setException(std::make_exception_ptr(TaskCancelled(*reason)));
+         }
+         else
+         {
+           detail::fulfil(promise, fun);
+         }
+       },
+       options.priority);
+
+  return result;
+}
+
+/**
+ * @brief  Schedules the passed function for processing without providing a result.
+ *         Tasks posted to a deactivated pool are discarded.
+ * @return false, if the pool has been deactivated and the function is left untouched.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+template <typename Fun>
+inline auto ThreadPool<Policy, QueuePolicy, Metrics>::post(Fun&& fun, int priority) -> bool
+{
+  if(!isActive)
+  {
+    return false;
+  }
+
+  if constexpr(std::is_same_v<std::decay_t<Fun>, callable>)
+  {
+    schedule(callable(std::forward<Fun>(fun)));
+  }
+  else
+  {
+    schedule(callable(std::forward<Fun>(fun), priority));
+  }
+  return true;
+}
+
+/**
+ * @brief  Schedules the passed function with the given options for processing without
+ *         providing a result. Dropped tasks are silently discarded.
+ * @return false, if the pool has been deactivated.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+template <typename Fun>
+inline auto ThreadPool<Policy, QueuePolicy, Metrics>::post(Fun&& fun, TaskOptions const& options) -> bool
+{
+  return post([this, fun = std::forward<Fun>(fun), options]() mutable {
+                if(!dropReason(options))
+                {
+                  fun();
+                }
+              },
+              options.priority);
+}
+
+/**
+ * @brief  Returns an awaitable, which suspends the awaiting coroutine and resumes it on a thread
+ *         of this pool. A Task keeps running on this pool after later suspensions.
+ * @remark co_await pool.schedule() inside a Task started on the calling thread moves it to the pool.
+ *         A deactivated pool rejects the coroutine and it continues on the calling thread without
+ *         being suspended. A coroutine still queued when the pool is deactivated is not resumed.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+inline auto ThreadPool<Policy, QueuePolicy, Metrics>::schedule() noexcept -> detail::ScheduleAwaiter
+{
+  return detail::ScheduleAwaiter{detail::Executor::of(*this)};
+}
+
+/**
+ * @brief Returns the reason to drop a task submitted with the passed options, if any, and counts
+ *        dropped tasks in the metrics.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+inline auto ThreadPool<Policy, QueuePolicy, Metrics>::dropReason(TaskOptions const& options) -> std::optional<cancelReason>
+{
+  auto reason = options.dropReason();
+  if constexpr(hasMetrics)
+  {
+    if(reason)
+    {
+      poolCounters.tasksCancelled.fetch_add(1ULL, std::memory_order_relaxed);
+    }
+  }
+  return reason;
+}
+
+/**
+ * @brief Takes one pending task out of the queues and processes it on the calling thread.
+ *        Threads waiting for the completion of tasks they scheduled themselves use this
+ *        to help instead of blocking, which also prevents working threads from deadlocking.
+ * @return false, if no task was pending.
+ */
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+auto ThreadPool<Policy, QueuePolicy, Metrics>::runPendingTask() -> bool
+{
+  task_type task;
+  bool found = false;
+  if constexpr(isWorkStealing)
+  {
+    if(owningPool == this)
+    {
+      found = popTask(task);
+    }
+    else
+    {
+      found = scheduledTasks.tryPop(task);
+      for(size_type i = 0ULL; !found && i < maxNumThreads; ++i)
+      {
+        found = workerSlots[i].running.load(std::memory_order_relaxed) && workerSlots[i].tasks->trySteal(task);
+        if constexpr(hasMetrics)
+        {
+          if(found)
+          {
+            poolCounters.workers[maxNumThreads].steals.fetch_add(1ULL, std::memory_order_relaxed);
+          }
+        }
+      }
+      if(found)
+      {
+        --numPendingTasks;
+      }
+    }
+  }
+  else
+  {
+    found = scheduledTasks.tryPop(task);
+  }
+
+  if(found && task && isActive)
+  {
+    execute(task);
+  }
+  return found;
 }
 
 /**
  * @brief Deactivates the thread pool.
  */
-template <threadPoolPolicy Policy, queuePolicy QueuePolicy>
-inline void ThreadPool<Policy, QueuePolicy>::deactivate()
+template <threadPoolPolicy Policy, queuePolicy QueuePolicy, metricsPolicy Metrics>
+inline void ThreadPool<Policy, QueuePolicy, Metrics>::deactivate()
 {
-  if(isActive)
+  if(isActive.exchange(false))
   {
-    isActive = false;
     scheduledTasks.stopQueue();
+    if constexpr(isWorkStealing)
+    {
+      {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        ++wakeUpEpoch;
+      }
+      wakeUpCondVar.notify_all();
+    }
   }
 }
 
@@ -22,6 +22,8 @@
 // includes 
 #include "ConcurrencyToolsConfig.h"
 #include "TMPUtils.h"
+#include "detail/CacheLine.h"
+#include "detail/EpochDomain.h"
 
 #include <Utils/CRTP.h>
 
@@ -64,18 +66,25 @@ protected:
   // types
   using Lock       = GuardType<Mutex, lockingPolicy::standard>;
   using LockUnique = GuardType<Mutex, lockingPolicy::unique>;
+  using LockShared = Lock;
 
   // ---------------------------------------------------
   // constants
   static constexpr bool hasSharedLocking  = false;
   static constexpr std::size_t numMutexes = SizeConstant::value;
+  static constexpr bool isStriped         = numMutexes > 1ULL;
 
   // ---------------------------------------------------
   // convenience methods for locking
   [[nodiscard]] auto lock       (std::size_t const i = 0ULL) const -> Lock       { return Lock{mutexes[i]};       };
   [[nodiscard]] auto lockUnique (std::size_t const i = 0ULL) const -> LockUnique { return LockUnique{mutexes[i]}; };
+  // without shared locking, readers lock exclusively
+  [[nodiscard]] auto lockShared (std::size_t const i = 0ULL) const -> LockShared { return LockShared{mutexes[i]}; };
 
-  mutable Mutex mutexes[numMutexes];
+  // in striped mode every mutex guards its own part of the data and gets a cache line of its own
+  using StripeType = std::conditional_t<isStriped, detail::PaddedMutex<Mutex>, Mutex>;
+
+  mutable StripeType mutexes[numMutexes];
 };
 
 template <typename Host, typename Mutex, typename SizeConstant>
@@ -94,6 +103,7 @@ protected:
   // constants
   static constexpr bool hasSharedLocking  = true;
   static constexpr std::size_t numMutexes = SizeConstant::value;
+  static constexpr bool isStriped         = numMutexes > 1ULL;
 
   // ---------------------------------------------------
   // convenience methods for locking
@@ -101,7 +111,10 @@ protected:
   [[nodiscard]] auto lockUnique (std::size_t const i = 0ULL) const -> LockUnique { return LockUnique{mutexes[i]}; };
   [[nodiscard]] auto lockShared (std::size_t const i = 0ULL) const -> LockShared { return LockShared{mutexes[i]}; };
 
-  mutable Mutex mutexes[numMutexes];
+  // in striped mode every mutex guards its own part of the data and gets a cache line of its own
+  using StripeType = std::conditional_t<isStriped, detail::PaddedMutex<Mutex>, Mutex>;
+
+  mutable StripeType mutexes[numMutexes];
 };
 
 template <typename Host, typename Mutex = std::mutex, std::size_t Size = 1ULL>
@@ -120,18 +133,25 @@ protected:
   // types
   using Lock       = GuardType<Mutex, lockingPolicy::standard>;
   using LockUnique = GuardType<Mutex, lockingPolicy::unique>;
+  using LockShared = Lock;
 
   // ---------------------------------------------------
   // constants
   static constexpr bool hasSharedLocking  = false;
   static constexpr std::size_t numMutexes = SizeConstant::value;
+  static constexpr bool isStriped         = numMutexes > 1ULL;
 
   // ---------------------------------------------------
   // convenience methods for locking
   [[nodiscard]] auto lock       (std::size_t const i = 0ULL) const -> Lock       { return Lock{mutexes[i]};       };
   [[nodiscard]] auto lockUnique (std::size_t const i = 0ULL) const -> LockUnique { return LockUnique{mutexes[i]}; };
+  // without shared locking, readers lock exclusively
+  [[nodiscard]] auto lockShared (std::size_t const i = 0ULL) const -> LockShared { return LockShared{mutexes[i]}; };
+
+  // in striped mode every mutex guards its own part of the data and gets a cache line of its own
+  using StripeType = std::conditional_t<isStriped, detail::PaddedMutex<Mutex>, Mutex>;
 
-  inline static Mutex mutexes[numMutexes];
+  inline static StripeType mutexes[numMutexes];
 };
 
 template <typename Host, typename Mutex, typename SizeConstant>
@@ -150,6 +170,7 @@ protected:
   // constants
   static constexpr bool hasSharedLocking  = true;
   static constexpr std::size_t numMutexes = SizeConstant::value;
+  static constexpr bool isStriped         = numMutexes > 1ULL;
 
   // ---------------------------------------------------
   // convenience methods for locking
@@ -157,7 +178,10 @@ protected:
   [[nodiscard]] auto lockUnique (std::size_t const i = 0ULL) const -> LockUnique { return LockUnique{mutexes[i]}; };
   [[nodiscard]] auto lockShared (std::size_t const i = 0ULL) const -> LockShared { return LockShared{mutexes[i]}; };
 
-  inline static Mutex mutexes[numMutexes];
+  // in striped mode every mutex guards its own part of the data and gets a cache line of its own
+  using StripeType = std::conditional_t<isStriped, detail::PaddedMutex<Mutex>, Mutex>;
+
+  inline static StripeType mutexes[numMutexes];
 };
 
 
@@ -188,15 +212,67 @@ protected:
 
   // ---------------------------------------------------
   // constants
-  static constexpr bool hasSharedLocking = false;
+  static constexpr bool hasSharedLocking  = false;
+  static constexpr std::size_t numMutexes = 1ULL;
+  static constexpr bool isStriped         = false;
+
+  // ---------------------------------------------------
+  // convenience methods for locking
+  [[nodiscard]] constexpr auto lock       (std::size_t const = 0ULL) const noexcept -> Lock       { return {}; };
+  [[nodiscard]] constexpr auto lockUnique (std::size_t const = 0ULL) const noexcept -> LockUnique { return {}; };
+  [[nodiscard]] constexpr auto lockShared (std::size_t const = 0ULL) const noexcept -> LockShared { return {}; };
+};
+
+
+/**
+ * @brief  ReadMostly is a policy for data that is read far more often than it is modified.
+ *         Writers are serialized by a mutex and never modify data in place, instead they publish
+ *         a new version and retire the old one. lockShared only announces a reader to the
+ *         EpochDomain, which is wait-free and never blocks a writer. A retired version is
+ *         deleted as soon as no reader can still access it.
+ * @remark A host can check for this policy with \link #publishesSnapshots \endlink.
+ */
+template <typename Host, typename Mutex = std::mutex>
+class ReadMostly {
+
+protected:
+
+  // ---------------------------------------------------
+  // types
+  using Lock       = GuardType<Mutex, lockingPolicy::standard>;
+  using LockUnique = GuardType<Mutex, lockingPolicy::unique>;
+  using LockShared = detail::EpochGuard;
+
+  // ---------------------------------------------------
+  // constants
+  static constexpr bool hasSharedLocking  = true;
+  static constexpr std::size_t numMutexes = 1ULL;
+  static constexpr bool isStriped         = false;
 
   // ---------------------------------------------------
   // convenience methods for locking
-  [[nodiscard]] constexpr auto lock       () const noexcept -> Lock       { return {}; };
-  [[nodiscard]] constexpr auto lockUnique () const noexcept -> LockUnique { return {}; };
-  [[nodiscard]] constexpr auto lockShared () const noexcept -> LockShared { return {}; };
+  [[nodiscard]] auto lock       (std::size_t const = 0ULL) const -> Lock       { return Lock{mutexes[0]};       };
+  [[nodiscard]] auto lockUnique (std::size_t const = 0ULL) const -> LockUnique { return LockUnique{mutexes[0]}; };
+  [[nodiscard]] auto lockShared (std::size_t const = 0ULL) const -> LockShared { return LockShared{};           };
+
+  // ---------------------------------------------------
+  // deferred deletion of replaced versions
+  template <typename T>
+  static void retire (T const* version) { detail::EpochDomain::instance().retire(version); };
+
+  mutable Mutex mutexes[numMutexes];
 };
 
+/**
+ * @brief publishesSnapshots is true if a threading policy requires its host to publish new
+ *        versions of its data instead of modifying it in place.
+ */
+template <typename Policy>
+inline constexpr bool publishesSnapshots = false;
+
+template <typename Host, typename Mutex>
+inline constexpr bool publishesSnapshots<ReadMostly<Host, Mutex>> = true;
+
 
 }  // namespace cctools
 
@@ -18,19 +18,27 @@
 
 
 // includes
+#include <ConcurrencyTools/Metrics.h>
+#include <ConcurrencyTools/Task.h>
+#include <ConcurrencyTools/WaitStrategy.h>
 #include <ConcurrencyTools/detail/FunctionTraits.h>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <coroutine>
+#include <cstdint>
 #include <iterator>
 #include <limits>
 #include <list>
+#include <mutex>
 #include <optional>
 #include <queue>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 
 namespace cctools {
@@ -39,7 +47,8 @@ namespace cctools {
 /// insertion policy for queue classes.
 enum class insertionPolicy : char {
   prioritized,  ///< insertion policy for riority queues
-  fifo          ///< unprioritized insertion, first in first out
+  fifo,         ///< unprioritized insertion, first in first out
+  heap          ///< prioritized insertion into a binary heap, elements of equal priority are not kept in insertion order
 };
 
 
@@ -94,6 +103,10 @@ public:
   auto end    () -> iterator;
   auto begin  () const -> const_iterator;
   auto end    () const -> const_iterator;
+  template <typename Predicate>
+  void removeIf  (Predicate&& predicate);
+  template <typename Predicate>
+  auto extractIf (Predicate&& predicate) -> std::list<value_type>;
 
 private :
 
@@ -172,8 +185,6 @@ inline auto QueueAccessor<Container, insertionPolicy::prioritized, Compare>::end
   return container.rend();
 }
 
-
-
 template <typename Container, typename Compare>
 inline auto QueueAccessor<Container, insertionPolicy::prioritized, Compare>::begin() const -> const_iterator
 {
@@ -186,6 +197,30 @@ inline auto QueueAccessor<Container, insertionPolicy::prioritized, Compare>::end
   return container.crend();
 }
 
+template <typename Container, typename Compare>
+template <typename Predicate>
+inline void QueueAccessor<Container, insertionPolicy::prioritized, Compare>::removeIf(Predicate&& predicate)
+{
+  container.remove_if(std::forward<Predicate>(predicate));
+}
+
+template <typename Container, typename Compare>
+template <typename Predicate>
+auto QueueAccessor<Container, insertionPolicy::prioritized, Compare>::extractIf(Predicate&& predicate) -> std::list<value_type>
+{
+  std::list<value_type> extractedElements;
+
+  auto elem = std::find_if(container.begin(), container.end(), predicate);
+  while(elem != container.end())
+  {
+    extractedElements.push_front(std::move(*elem));
+    elem = container.erase(elem);
+    elem = std::find_if(elem, container.end(), predicate);
+  }
+
+  return extractedElements;
+}
+
 template <typename Container, typename Compare>
 inline auto QueueAccessor<Container, insertionPolicy::prioritized, Compare>::insertPosition(value_type const& value)
   -> typename Container::const_iterator
@@ -240,6 +275,10 @@ public:
   auto end     () -> iterator;
   auto begin   () const -> const_iterator;
   auto end     () const -> const_iterator;
+  template <typename Predicate>
+  void removeIf  (Predicate&& predicate);
+  template <typename Predicate>
+  auto extractIf (Predicate&& predicate) -> std::list<value_type>;
 
 private:
 
@@ -334,6 +373,332 @@ inline auto QueueAccessor<Container, insertionPolicy::fifo, void>::end() const -
 }
 
 
+template <typename Container>
+template <typename Predicate>
+inline void QueueAccessor<Container, insertionPolicy::fifo, void>::removeIf(Predicate&& predicate)
+{
+  container.remove_if(std::forward<Predicate>(predicate));
+}
+
+template <typename Container>
+template <typename Predicate>
+auto QueueAccessor<Container, insertionPolicy::fifo, void>::extractIf(Predicate&& predicate) -> std::list<value_type>
+{
+  std::list<value_type> extractedElements;
+
+  auto elem = std::find_if(container.begin(), container.end(), predicate);
+  while(elem != container.end())
+  {
+    extractedElements.push_front(std::move(*elem));
+    elem = container.erase(elem);
+    elem = std::find_if(elem, container.end(), predicate);
+  }
+
+  return extractedElements;
+}
+
+
+/**
+ * @brief  Partial specialization of QueueAccessor for prioritized queues that are organized
+ *         as a binary heap on a random access container. Insertion and removal of the top element
+ *         are O(log n) instead of the linear search of the list based prioritized accessor.
+ * @remark Iteration visits the elements in heap order, i.e. only the first element is guaranteed to be
+ *         the one with the highest priority.
+ */
+template <typename Container, typename Compare>
+class QueueAccessor<Container, insertionPolicy::heap, Compare> {
+
+public:
+
+  // ---------------------------------------------------
+  // types
+  using value_type      = typename Container::value_type;
+  using size_type       = typename Container::size_type;
+  using const_reference = typename Container::const_reference;
+  using reference       = typename Container::reference;
+  using iterator        = typename Container::iterator;
+  using const_iterator  = typename Container::const_iterator;
+
+  // ---------------------------------------------------
+  // ctor & dtor
+  QueueAccessor  (Container& cont);
+  QueueAccessor  () = delete;
+  QueueAccessor  (QueueAccessor const&) = delete;
+  QueueAccessor  (QueueAccessor&&) = delete;
+  auto operator= (QueueAccessor const&) -> QueueAccessor& = delete;
+  auto operator= (QueueAccessor&&) -> QueueAccessor& = delete;
+  ~QueueAccessor () = default;
+
+  // ---------------------------------------------------
+  // access methods
+  void push      (value_type const& value);
+  void push      (value_type&& value);
+  void pop       (value_type& value);
+  auto front     () const -> const_reference;
+  auto front     () -> reference;
+  void erase     (iterator elem);
+  auto cbegin    () const -> const_iterator;
+  auto cend      () const -> const_iterator;
+  auto begin     () -> iterator;
+  auto end       () -> iterator;
+  auto begin     () const -> const_iterator;
+  auto end       () const -> const_iterator;
+  template <typename Predicate>
+  void removeIf  (Predicate&& predicate);
+  template <typename Predicate>
+  auto extractIf (Predicate&& predicate) -> std::list<value_type>;
+
+private:
+
+  void siftUp   (size_type pos);
+  void siftDown (size_type pos);
+
+  // ---------------------------------------------------
+  // member
+  Compare    compare;
+  Container& container;
+};
+
+template <typename Container, typename Compare>
+inline QueueAccessor<Container, insertionPolicy::heap, Compare>::QueueAccessor(Container& cont)
+  : container{cont}
+{}
+
+template <typename Container, typename Compare>
+inline void QueueAccessor<Container, insertionPolicy::heap, Compare>::push(value_type const& value)
+{
+  container.push_back(value);
+  std::push_heap(container.begin(), container.end(), compare);
+}
+
+template <typename Container, typename Compare>
+inline void QueueAccessor<Container, insertionPolicy::heap, Compare>::push(value_type&& value)
+{
+  container.push_back(std::move(value));
+  std::push_heap(container.begin(), container.end(), compare);
+}
+
+template <typename Container, typename Compare>
+inline void QueueAccessor<Container, insertionPolicy::heap, Compare>::pop(value_type& value)
+{
+  std::pop_heap(container.begin(), container.end(), compare);
+  value = std::move(container.back());
+  container.pop_back();
+}
+
+template <typename Container, typename Compare>
+inline auto QueueAccessor<Container, insertionPolicy::heap, Compare>::front() const -> const_reference
+{
+  return container.front();
+}
+
+template <typename Container, typename Compare>
+inline auto QueueAccessor<Container, insertionPolicy::heap, Compare>::front() -> reference
+{
+  return container.front();
+}
+
+/**
+ * @brief Removes an arbitrary element by replacing it with the last element of the heap,
+ *        which is then moved up or down to restore the heap property.
+ */
+template <typename Container, typename Compare>
+void QueueAccessor<Container, insertionPolicy::heap, Compare>::erase(iterator elem)
+{
+  const auto pos = static_cast<size_type>(std::distance(container.begin(), elem));
+  if(pos + 1ULL == container.size())
+  {
+    container.pop_back();
+    return;
+  }
+
+  *elem = std::move(container.back());
+  container.pop_back();
+  if(pos > 0ULL && compare(container[(pos - 1ULL) / 2ULL], container[pos]))
+  {
+    siftUp(pos);
+  }
+  else
+  {
+    siftDown(pos);
+  }
+}
+
+template <typename Container, typename Compare>
+inline auto QueueAccessor<Container, insertionPolicy::heap, Compare>::cbegin() const -> const_iterator
+{
+  return container.cbegin();
+}
+
+template <typename Container, typename Compare>
+inline auto QueueAccessor<Container, insertionPolicy::heap, Compare>::cend() const -> const_iterator
+{
+  return container.cend();
+}
+
+template <typename Container, typename Compare>
+inline auto QueueAccessor<Container, insertionPolicy::heap, Compare>::begin() -> iterator
+{
+  return container.begin();
+}
+
+template <typename Container, typename Compare>
+inline auto QueueAccessor<Container, insertionPolicy::heap, Compare>::end() -> iterator
+{
+  return container.end();
+}
+
+template <typename Container, typename Compare>
+inline auto QueueAccessor<Container, insertionPolicy::heap, Compare>::begin() const -> const_iterator
+{
+  return container.cbegin();
+}
+
+template <typename Container, typename Compare>
+inline auto QueueAccessor<Container, insertionPolicy::heap, Compare>::end() const -> const_iterator
+{
+  return container.cend();
+}
+
+template <typename Container, typename Compare>
+template <typename Predicate>
+void QueueAccessor<Container, insertionPolicy::heap, Compare>::removeIf(Predicate&& predicate)
+{
+  container.erase(std::remove_if(container.begin(), container.end(), std::forward<Predicate>(predicate)),
+                  container.end());
+  std::make_heap(container.begin(), container.end(), compare);
+}
+
+/**
+ * @brief Moves all elements satisfying the given predicate into a list, which is sorted
+ *        in the order the elements would have been popped from the queue.
+ */
+template <typename Container, typename Compare>
+template <typename Predicate>
+auto QueueAccessor<Container, insertionPolicy::heap, Compare>::extractIf(Predicate&& predicate) -> std::list<value_type>
+{
+  std::list<value_type> extractedElements;
+
+  const auto firstExtracted = std::partition(container.begin(), container.end(),
+                                             [&predicate](const_reference value) { return !predicate(value); });
+  if(firstExtracted != container.end())
+  {
+    std::move(firstExtracted, container.end(), std::back_inserter(extractedElements));
+    container.erase(firstExtracted, container.end());
+    std::make_heap(container.begin(), container.end(), compare);
+    extractedElements.sort([this](const_reference lhs, const_reference rhs) { return compare(rhs, lhs); });
+  }
+
+  return extractedElements;
+}
+
+template <typename Container, typename Compare>
+inline void QueueAccessor<Container, insertionPolicy::heap, Compare>::siftUp(size_type pos)
+{
+  // [begin, begin + pos) is a valid heap, hence push_heap moves the element at pos up
+  std::push_heap(container.begin(), std::next(container.begin(), static_cast<std::ptrdiff_t>(pos + 1ULL)), compare);
+}
+
+template <typename Container, typename Compare>
+void QueueAccessor<Container, insertionPolicy::heap, Compare>::siftDown(size_type pos)
+{
+  const auto size = container.size();
+  for(auto child = 2ULL * pos + 1ULL; child < size; child = 2ULL * pos + 1ULL)
+  {
+    if(child + 1ULL < size && compare(container[child], container[child + 1ULL]))
+    {
+      ++child;
+    }
+    if(!compare(container[pos], container[child]))
+    {
+      return;
+    }
+    std::swap(container[pos], container[child]);
+    pos = child;
+  }
+}
+
+
+/**
+ * @brief AwaitingPop is a coroutine suspended in ThreadsafeQueueT::asyncPop. The awaiting pops of a
+ *        queue form an intrusive list, a producer moves its element directly into the first one.
+ */
+template <typename T>
+struct AwaitingPop {
+  std::optional<T>        value;
+  std::coroutine_handle<> handle;
+  Executor                executor;
+  AwaitingPop*            next {nullptr};
+};
+
+/**
+ * @class PopAwaiter
+ * @brief PopAwaiter is returned by ThreadsafeQueueT::asyncPop. Awaiting it pops the front element
+ *        of the queue or suspends the coroutine until there is one.
+ */
+template <typename Queue>
+class PopAwaiter {
+
+  using value_type = typename Queue::value_type;
+
+public:
+
+  PopAwaiter (Queue& queue, Executor executor) noexcept;
+
+  auto await_ready () const noexcept -> bool { return false; }
+  template <typename Promise>
+  auto await_suspend (std::coroutine_handle<Promise> handle) -> bool;
+  auto await_resume () -> std::optional<value_type>;
+
+private:
+
+  Queue&                  queue;
+  AwaitingPop<value_type> waiter;
+};
+
+
+/**
+ * @brief Constructor.
+ */
+template <typename Queue>
+inline PopAwaiter<Queue>::PopAwaiter(Queue& q, Executor executor) noexcept
+  : queue {q}
+{
+  waiter.executor = executor;
+}
+
+/**
+ * @brief  Pops the front element right away if there is one, otherwise the coroutine is added to
+ *         the awaiting pops of the queue.
+ * @return true, if the coroutine stays suspended.
+ * @throw  std::logic_error if neither the awaiter nor the awaiting coroutine has an executor.
+ */
+template <typename Queue>
+template <typename Promise>
+inline auto PopAwaiter<Queue>::await_suspend(std::coroutine_handle<Promise> handle) -> bool
+{
+  if(!waiter.executor)
+  {
+    waiter.executor = executorOf(handle);
+  }
+  if(!waiter.executor)
+  {
+    throw std::logic_error("an awaited pop resumes on a thread pool, schedule the task on one or pass a pool");
+  }
+  waiter.handle = handle;
+  return queue.suspendPop(waiter);
+}
+
+/**
+ * @brief Returns the popped element, which is empty if the queue has been stopped.
+ */
+template <typename Queue>
+inline auto PopAwaiter<Queue>::await_resume() -> std::optional<value_type>
+{
+  return std::move(waiter.value);
+}
+
+
 }   // namespace detail
 
 
@@ -341,17 +706,27 @@ inline auto QueueAccessor<Container, insertionPolicy::fifo, void>::end() const -
  * @class ThreadsafeQueueT
  * @brief ThreadsafeQueueT is a queue that allows threadsafe access to its elements
  *        according to specified insertion policy.
+ * @remark With metricsPolicy::enabled, the queue counts pushes and pops, tracks its
+ *         high water mark and the time consumers and producers are blocked. See metrics().
+ * @remark A coroutine awaiting asyncPop doesn't hold a thread while the queue is empty. A producer
+ *         moves its element directly into the first awaiting pop and resumes the coroutine on its
+ *         pool. Awaiting pops are served before threads blocked in waitAndPop.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare = void>
+          insertionPolicy InsertionPolicy, typename Compare = void,
+          metricsPolicy Metrics = metricsPolicy::disabled>
 class ThreadsafeQueueT {
 
+  template <typename Queue>
+  friend class detail::PopAwaiter;
+
   // ---------------------------------------------------
   // internal types
   using mutex         = std::mutex;
   using lock          = std::lock_guard<mutex>;
   using uniqueLock    = std::unique_lock<mutex>;
   using queueAccessor = detail::QueueAccessor<Container<T>, InsertionPolicy, Compare>; 
+  using stopwatch     = detail::Stopwatch<Metrics>;
 
   // ---------------------------------------------------
   // internal SFINAE alias definitions
@@ -377,6 +752,8 @@ public:
   using reference       = typename container_type::reference;
   using const_reference = typename container_type::const_reference;
 
+  static constexpr bool hasMetrics = Metrics == metricsPolicy::enabled;
+
   // ---------------------------------------------------
   // constructors & assignments
   ThreadsafeQueueT  (size_type capacity = (std::numeric_limits<size_type>::max)());
@@ -391,6 +768,9 @@ public:
   auto empty                () const -> bool;
   auto size                 () const -> size_type;
   auto capacity             () const noexcept -> size_type;
+  auto waitStrategy         () const noexcept -> WaitStrategy;
+  void setWaitStrategy      (WaitStrategy strategy) noexcept;
+  auto metrics              () const -> QueueMetrics;
   void push                 (value_type const& value);
   void push                 (value_type&& value);
   auto tryPush              (value_type const& value) -> bool;
@@ -401,11 +781,22 @@ public:
   template <typename Rep, typename Period>
   auto tryPushFor           (value_type&& value, 
                              std::chrono::duration<Rep, Period> const& timeOut) -> bool;
+  template <typename InputIt>
+  auto pushBulk             (InputIt first, InputIt last) -> size_type;
+  template <typename Range>
+  auto pushBulk             (Range&& range) -> size_type;
   void waitAndPop           (value_type& value);
+  template <typename OutputIt>
+  auto waitAndPopBulk       (OutputIt out, size_type maxNumElements) -> size_type;
   auto tryPop               (value_type& value) -> bool;
+  template <typename OutputIt>
+  auto tryPopBulk           (OutputIt out, size_type maxNumElements) -> size_type;
   template <typename Rep, typename Period>
   auto tryPopFor            (value_type& value,
                              std::chrono::duration<Rep, Period> const& timeOut) -> bool;
+  auto asyncPop             () -> detail::PopAwaiter<ThreadsafeQueueT>;
+  template <typename Pool>
+  auto asyncPop             (Pool& pool) -> detail::PopAwaiter<ThreadsafeQueueT>;
   template <typename... Args, typename = requiresFIFO<InsertionPolicy>>
   void emplace              (Args&&... args);
   void swap                 (ThreadsafeQueueT& other) noexcept;
@@ -438,10 +829,15 @@ private:
   container_type          data;
   size_type               dataCapacity{(std::numeric_limits<size_type>::max)()};
   queueAccessor           accessor;
-  mutable bool            isActive{true};
-  mutable mutex           dataMutex;
-  std::condition_variable dataCondVar;
-  std::condition_variable capacityCondVar;
+  mutable bool               isActive{true};
+  mutable mutex              dataMutex;
+  std::condition_variable    dataCondVar;
+  std::condition_variable    capacityCondVar;
+  std::atomic<WaitStrategy>  consumerWaitStrategy{WaitStrategy::blocking()};
+  std::atomic<std::uint64_t> dataEpoch{0ULL};
+  detail::QueueCounters<Metrics> counters;
+  detail::AwaitingPop<value_type>* firstAwaitingPop{nullptr};
+  detail::AwaitingPop<value_type>* lastAwaitingPop{nullptr};
 
   // ---------------------------------------------------
   // auxiliary methods
@@ -449,27 +845,45 @@ private:
   auto hasData             () const -> bool;
   template <typename Predicate>
   auto extractIfImpl       (Predicate&& predicate) -> std::list<value_type>;
+  template <typename OutputIt>
+  auto popBulkImpl         (OutputIt out, size_type maxNumElements) -> size_type;
+  template <typename TryPop>
+  auto spinAndTryPop       (TryPop&& tryPopActive) -> bool;
+  [[nodiscard]] auto notifyConsumer     () -> detail::AwaitingPop<value_type>*;
+  [[nodiscard]] auto notifyAllConsumers () -> detail::AwaitingPop<value_type>*;
+  auto suspendPop                        (detail::AwaitingPop<value_type>& waiter) -> bool;
+  auto serveAwaitingPops                 () -> detail::AwaitingPop<value_type>*;
+  static void resumeAwaitingPops         (detail::AwaitingPop<value_type>* waiter);
 };
 
 
 /**
  * @brief Alias template for prioritized queues.
  */
-template <typename T, typename Compare = std::less<T>, template <typename...> typename Container = std::list>
-using PriorityQueue = ThreadsafeQueueT<T, Container, insertionPolicy::prioritized, Compare>;
+template <typename T, typename Compare = std::less<T>, template <typename...> typename Container = std::list,
+          metricsPolicy Metrics = metricsPolicy::disabled>
+using PriorityQueue = ThreadsafeQueueT<T, Container, insertionPolicy::prioritized, Compare, Metrics>;
+
+/**
+ * @brief Alias template for prioritized queues organized as a binary heap.
+ */
+template <typename T, typename Compare = std::less<T>, template <typename...> typename Container = std::vector,
+          metricsPolicy Metrics = metricsPolicy::disabled>
+using HeapPriorityQueue = ThreadsafeQueueT<T, Container, insertionPolicy::heap, Compare, Metrics>;
 
 /**
  * @brief Alias template for fifo queues.
  */
-template <typename T, template <typename...> typename Container = std::list>
-using Queue = ThreadsafeQueueT<T, Container, insertionPolicy::fifo>;
+template <typename T, template <typename...> typename Container = std::list,
+          metricsPolicy Metrics = metricsPolicy::disabled>
+using Queue = ThreadsafeQueueT<T, Container, insertionPolicy::fifo, void, Metrics>;
 
 /**
  * @brief constructor. Sets the data capacity.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
-ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::ThreadsafeQueueT(size_type capacity)
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::ThreadsafeQueueT(size_type capacity)
   : dataCapacity {capacity}
   , accessor     {data}
 {}
@@ -478,8 +892,8 @@ ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::ThreadsafeQueueT(size_
  * @brief Copy constructor.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
-ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::ThreadsafeQueueT(ThreadsafeQueueT const& src)
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::ThreadsafeQueueT(ThreadsafeQueueT const& src)
   : dataCapacity {src.dataCapacity}
   , accessor     {data}
 {
@@ -492,8 +906,8 @@ ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::ThreadsafeQueueT(Threa
  * @brief Move constructor.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
-ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::ThreadsafeQueueT(ThreadsafeQueueT&& src)
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::ThreadsafeQueueT(ThreadsafeQueueT&& src)
   : dataCapacity {src.dataCapacity}
   , accessor     {data}
 {
@@ -506,8 +920,8 @@ ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::ThreadsafeQueueT(Threa
  * @brief Copy assignment.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
-auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::operator=(ThreadsafeQueueT const& src) -> ThreadsafeQueueT&
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::operator=(ThreadsafeQueueT const& src) -> ThreadsafeQueueT&
 {
   ThreadsafeQueueT copy(src);
   swap(copy);
@@ -518,8 +932,8 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::operator=(Threads
  * @brief Move assignment.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
-auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::operator=(ThreadsafeQueueT&& src) -> ThreadsafeQueueT&
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::operator=(ThreadsafeQueueT&& src) -> ThreadsafeQueueT&
 {
   // ------- begin critical section ------- //
   lock lkThis(dataMutex);
@@ -533,8 +947,8 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::operator=(Threads
  * @brief Destructor. Deactivates the queue.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
-inline ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::~ThreadsafeQueueT()
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+inline ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::~ThreadsafeQueueT()
 {
   if(isActive)
   {
@@ -546,8 +960,8 @@ inline ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::~ThreadsafeQueu
  * @brief checks whether the underlying container is empty.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
-inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::empty() const -> bool
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::empty() const -> bool
 {
   // ------- begin critical section ------- //
   lock lk(dataMutex);
@@ -558,8 +972,8 @@ inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::empty() co
  * @brief returns the number of elements.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
-inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::size() const -> size_type
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::size() const -> size_type
 {
   // ------- begin critical section ------- //
   lock lk(dataMutex);
@@ -570,29 +984,78 @@ inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::size() con
  * @brief returns the capacity of the queue.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
-inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::capacity() const noexcept -> size_type
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::capacity() const noexcept -> size_type
 {
   return dataCapacity;
 }
 
+/**
+ * @brief Returns the strategy of consumers waiting for data in waitAndPop and waitAndPopBulk.
+ */
+template <typename T, template <typename...> typename Container,
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::waitStrategy() const noexcept -> WaitStrategy
+{
+  return consumerWaitStrategy.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Sets the strategy of consumers waiting for data. Takes effect with the next wait.
+ *        By default, waiting consumers block immediately.
+ */
+template <typename T, template <typename...> typename Container,
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+inline void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::setWaitStrategy(WaitStrategy strategy) noexcept
+{
+  consumerWaitStrategy.store(strategy, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns a snapshot of the metrics of the queue. Requires metricsPolicy::enabled.
+ */
+template <typename T, template <typename...> typename Container,
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::metrics() const -> QueueMetrics
+{
+  static_assert(hasMetrics, "metrics are only collected with metricsPolicy::enabled");
+
+  QueueMetrics result;
+  {
+    // ------- begin critical section ------- //
+    lock lk(dataMutex);
+    result.pushes   = counters.pushes;
+    result.pops     = counters.pops;
+    result.depth    = data.size();
+    result.maxDepth = counters.maxDepth;
+  }
+  counters.consumerWait.addTo(result.consumerWait);
+  counters.producerWait.addTo(result.producerWait);
+  return result;
+}
+
 /**
  * @brief  Attempts to copy another element into the queue.
  * @remark Blocks the calling thread until the size of the queue allows
  *         for insertion or the queue is stopped.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
-inline void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::push(value_type const& value)
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+inline void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::push(value_type const& value)
 {
+  const stopwatch watch;
   // ------- begin critical section ------- //
   uniqueLock lk(dataMutex);
   capacityCondVar.wait(lk, [this] { return sizeIsBelowCapacity() || !isActive; });
+  counters.producerWaited(watch);
 
   if(isActive)
   {
     accessor.push(value);
-    dataCondVar.notify_one();
+    counters.pushed(data.size());
+    auto* const served = notifyConsumer();
+    lk.unlock();
+    resumeAwaitingPops(served);
   }
 }
 
@@ -602,17 +1065,22 @@ inline void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::push(value
  *         for insertion or the queue is stopped.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
-inline void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::push(value_type&& value)
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+inline void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::push(value_type&& value)
 {
+  const stopwatch watch;
   // ------- begin critical section ------- //
   uniqueLock lk(dataMutex);
   capacityCondVar.wait(lk, [this] { return sizeIsBelowCapacity() || !isActive; });
+  counters.producerWaited(watch);
 
   if(isActive)
   {
     accessor.push(std::move(value));
-    dataCondVar.notify_one();
+    counters.pushed(data.size());
+    auto* const served = notifyConsumer();
+    lk.unlock();
+    resumeAwaitingPops(served);
   }
 }
 
@@ -622,9 +1090,10 @@ inline void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::push(value
  *        the return value is true. Otherwise, it is false.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
-auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::tryPush(value_type const& value) -> bool
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::tryPush(value_type const& value) -> bool
 {
+  detail::AwaitingPop<value_type>* served = nullptr;
   // ------- begin critical section ------- //
   {
     lock lk(dataMutex);
@@ -634,10 +1103,12 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::tryPush(value_typ
     }
 
     accessor.push(value);
-    dataCondVar.notify_one();
+    counters.pushed(data.size());
+    served = notifyConsumer();
   }
   // -------- end critical section -------- //
 
+  resumeAwaitingPops(served);
   return true;
 }
 
@@ -647,9 +1118,10 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::tryPush(value_typ
  *        the return value is true. Otherwise, it is false.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
-auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::tryPush(value_type&& value) -> bool
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::tryPush(value_type&& value) -> bool
 {
+  detail::AwaitingPop<value_type>* served = nullptr;
   // ------- begin critical section ------- //
   {
     lock lk(dataMutex);
@@ -659,10 +1131,12 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::tryPush(value_typ
     }
 
     accessor.push(std::move(value));
-    dataCondVar.notify_one();
+    counters.pushed(data.size());
+    served = notifyConsumer();
   }
   // -------- end critical section -------- //
 
+  resumeAwaitingPops(served);
   return true;
 }
 
@@ -673,9 +1147,9 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::tryPush(value_typ
  *        Otherwise, false is returned.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
 template <typename Rep, typename Period>
-auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::tryPushFor(value_type const& value,
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::tryPushFor(value_type const& value,
                                                                           std::chrono::duration<Rep, Period> const& timeOut) -> bool
 {
   // ------- begin critical section ------- //
@@ -686,7 +1160,10 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::tryPushFor(value_
       if(isActive)
       {
         accessor.push(value);
-        dataCondVar.notify_one();
+        counters.pushed(data.size());
+        auto* const served = notifyConsumer();
+        lk.unlock();
+        resumeAwaitingPops(served);
         return true;
       }
     }
@@ -703,9 +1180,9 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::tryPushFor(value_
  *        Otherwise, false is returned.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
 template <typename Rep, typename Period>
-auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::tryPushFor(value_type&& value,
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::tryPushFor(value_type&& value,
                                                                           std::chrono::duration<Rep, Period> const& timeOut) -> bool
 {
   // ------- begin critical section ------- //
@@ -716,7 +1193,10 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::tryPushFor(value_
       if(isActive)
       {
         accessor.push(std::move(value));
-        dataCondVar.notify_one();
+        counters.pushed(data.size());
+        auto* const served = notifyConsumer();
+        lk.unlock();
+        resumeAwaitingPops(served);
         return true;
       }
     }
@@ -726,22 +1206,101 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::tryPushFor(value_
   return false;
 }
 
+/**
+ * @brief  Copies the elements of the range [first, last) into the queue. Use std::move_iterator
+ *         to move the elements instead. The lock is acquired once for all elements that fit into
+ *         the queue and the consumers are notified once per such batch.
+ * @remark Blocks the calling thread whenever the capacity is exhausted until either there is space
+ *         again or the queue is stopped.
+ * @return The number of elements that have been inserted, which is less than the size of the range
+ *         only if the queue has been stopped.
+ */
+template <typename T, template <typename...> typename Container,
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+template <typename InputIt>
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::pushBulk(InputIt first, InputIt last) -> size_type
+{
+  size_type                numPushedElements{};
+  std::chrono::nanoseconds waited{};
+
+  // ------- begin critical section ------- //
+  uniqueLock lk(dataMutex);
+  while(first != last)
+  {
+    const stopwatch watch;
+    capacityCondVar.wait(lk, [this] { return sizeIsBelowCapacity() || !isActive; });
+    waited += watch.elapsed();
+    if(!isActive)
+    {
+      break;
+    }
+
+    size_type batchSize{};
+    for(; first != last && sizeIsBelowCapacity(); ++first, ++batchSize)
+    {
+      accessor.push(*first);
+    }
+    numPushedElements += batchSize;
+    counters.pushed(data.size(), batchSize);
+
+    // the served coroutines may be the ones freeing capacity, so they are resumed before waiting again
+    if(auto* const served = batchSize == 1ULL ? notifyConsumer() : notifyAllConsumers(); served != nullptr)
+    {
+      lk.unlock();
+      resumeAwaitingPops(served);
+      lk.lock();
+    }
+  }
+  lk.unlock();
+
+  // only the time blocked on the capacity counts, not the time spent inserting the elements
+  counters.producerWaited(waited);
+  return numPushedElements;
+}
+
+/**
+ * @brief  Inserts all elements of a given range into the queue. The elements of an rvalue range
+ *         are moved, otherwise they are copied.
+ * @return The number of elements that have been inserted.
+ */
+template <typename T, template <typename...> typename Container,
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+template <typename Range>
+inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::pushBulk(Range&& range) -> size_type
+{
+  using std::begin;
+  using std::end;
+  if constexpr(std::is_lvalue_reference_v<Range>)
+  {
+    return pushBulk(begin(range), end(range));
+  }
+  else
+  {
+    return pushBulk(std::make_move_iterator(begin(range)), std::make_move_iterator(end(range)));
+  }
+}
+
 /**
  * @brief constructs a new element in-place.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
 template <typename... Args, typename>
-void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::emplace(Args&&... args)
+void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::emplace(Args&&... args)
 {
+  const stopwatch watch;
   // ------- begin critical section ------- //
   uniqueLock lk(dataMutex);
   capacityCondVar.wait(lk, [this] { return sizeIsBelowCapacity() || !isActive;});
+  counters.producerWaited(watch);
 
   if(isActive)
   {
     accessor.emplace(std::forward<Args>(args)...);
-    dataCondVar.notify_one();
+    counters.pushed(data.size());
+    auto* const served = notifyConsumer();
+    lk.unlock();
+    resumeAwaitingPops(served);
   }
 }
 
@@ -750,9 +1309,28 @@ void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::emplace(Args&&...
  *        and moves the element at the front of the queue into the passed value.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
-void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::waitAndPop(value_type& value)
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::waitAndPop(value_type& value)
 {
+  const stopwatch watch;
+  const auto popped = spinAndTryPop([this, &value] {
+    // ------- begin critical section ------- //
+    lock lk(dataMutex);
+    if(!isActive || data.empty())
+    {
+      return false;
+    }
+    accessor.pop(value);
+    counters.popped();
+    capacityCondVar.notify_all();
+    return true;
+  });
+  if(popped)
+  {
+    counters.consumerWaited(watch);
+    return;
+  }
+
   // ------- begin critical section ------- //
   uniqueLock lk(dataMutex);
   dataCondVar.wait(lk, [this] { return hasData() || !isActive; });
@@ -760,8 +1338,53 @@ void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::waitAndPop(value_
   if(isActive)
   {
     accessor.pop(value);
+    counters.popped();
     capacityCondVar.notify_all();
   }
+  lk.unlock();
+  counters.consumerWaited(watch);
+}
+
+/**
+ * @brief  blocks the calling thread until the queue is not empty and moves up to maxNumElements elements
+ *         from the front of the queue into the given output iterator.
+ * @return The number of elements that have been popped. Zero, if the queue has been stopped.
+ */
+template <typename T, template <typename...> typename Container,
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+template <typename OutputIt>
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::waitAndPopBulk(OutputIt out, size_type maxNumElements) -> size_type
+{
+  const stopwatch watch;
+  size_type numPoppedElements{};
+  const auto popped = spinAndTryPop([this, &out, &numPoppedElements, maxNumElements] {
+    // ------- begin critical section ------- //
+    lock lk(dataMutex);
+    if(!isActive)
+    {
+      return false;
+    }
+    numPoppedElements = popBulkImpl(out, maxNumElements);
+    return numPoppedElements > 0ULL;
+  });
+  if(popped)
+  {
+    counters.consumerWaited(watch);
+    return numPoppedElements;
+  }
+
+  // ------- begin critical section ------- //
+  uniqueLock lk(dataMutex);
+  dataCondVar.wait(lk, [this] { return hasData() || !isActive; });
+
+  if(isActive)
+  {
+    numPoppedElements = popBulkImpl(out, maxNumElements);
+  }
+  lk.unlock();
+
+  counters.consumerWaited(watch);
+  return numPoppedElements;
 }
 
 /**
@@ -770,8 +1393,8 @@ void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::waitAndPop(value_
  *        If the queue is empty, the method returns false immediately
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
-auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::tryPop(value_type& value) -> bool
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::tryPop(value_type& value) -> bool
 {
   // ------- begin critical section ------- //
   {
@@ -781,6 +1404,7 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::tryPop(value_type
       return false;
     }
     accessor.pop(value);
+    counters.popped();
     capacityCondVar.notify_all();
   }
   // -------- end critical section -------- //
@@ -788,41 +1412,83 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::tryPop(value_type
   return true;
 }
 
+/**
+ * @brief  Moves up to maxNumElements elements from the front of the queue into the given
+ *         output iterator without blocking.
+ * @return The number of elements that have been popped.
+ */
+template <typename T, template <typename...> typename Container,
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+template <typename OutputIt>
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::tryPopBulk(OutputIt out, size_type maxNumElements) -> size_type
+{
+  // ------- begin critical section ------- //
+  lock lk(dataMutex);
+  return popBulkImpl(out, maxNumElements);
+}
+
 /**
  * @brief Attempts to pop an element from the queue. If the specified time out
  *        elapses and the queue is not empty, the first element of the queue is moved
  *        into the given value and true is returned. Otherwise, this method return returns false.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
 template <typename Rep, typename Period>
-auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::tryPopFor(value_type& value,
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::tryPopFor(value_type& value,
                                                                          std::chrono::duration<Rep, Period> const& timeOut) -> bool
 {
+  const stopwatch watch;
+  bool popped = false;
   // ------- begin critical section ------- //
   {
     uniqueLock lk(dataMutex);
-    if(dataCondVar.wait_for(lk, timeOut, [this] { return hasData() || !isActive; }))
+    if(dataCondVar.wait_for(lk, timeOut, [this] { return hasData() || !isActive; }) && isActive)
     {
-      if(isActive)
-      {
-        accessor.pop(value);
-        capacityCondVar.notify_all();
-        return true;
-      }
+      accessor.pop(value);
+      counters.popped();
+      capacityCondVar.notify_all();
+      popped = true;
     }
   }
   // -------- end critical section -------- //
 
-  return false;
+  counters.consumerWaited(watch);
+  return popped;
+}
+
+/**
+ * @brief  Returns an awaitable, which pops the front element of the queue. If the queue is empty,
+ *         the awaiting coroutine is suspended without holding a thread until an element arrives.
+ *         It resumes on the pool of the awaiting task.
+ * @return co_await yields the element or std::nullopt if the queue has been stopped.
+ * @throw  co_await throws std::logic_error if the awaiting coroutine doesn't run on a pool.
+ */
+template <typename T, template <typename...> typename Container,
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::asyncPop() -> detail::PopAwaiter<ThreadsafeQueueT>
+{
+  return detail::PopAwaiter<ThreadsafeQueueT>{*this, detail::Executor{}};
+}
+
+/**
+ * @brief  Returns an awaitable, which pops the front element of the queue. See asyncPop().
+ *         A suspended coroutine resumes on the given pool.
+ */
+template <typename T, template <typename...> typename Container,
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+template <typename Pool>
+inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::asyncPop(Pool& pool) -> detail::PopAwaiter<ThreadsafeQueueT>
+{
+  return detail::PopAwaiter<ThreadsafeQueueT>{*this, detail::Executor::of(pool)};
 }
 
 /**
  * @brief Exchanges the contents of the container with those of other.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
-void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::swap(ThreadsafeQueueT& other) noexcept
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::swap(ThreadsafeQueueT& other) noexcept
 {
   // ------- begin critical section ------- //
   lock lkThis(dataMutex);
@@ -835,21 +1501,32 @@ void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::swap(ThreadsafeQu
  * @brief stops all threads that might block on pop or push methods.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
-void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::stopQueue()
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::stopQueue()
 {
-  isActive = false;
+  detail::AwaitingPop<value_type>* waiter = nullptr;
+  {
+    // ------- begin critical section ------- //
+    lock lk(dataMutex);
+    isActive = false;
+    dataEpoch.fetch_add(1ULL, std::memory_order_release);
+    waiter          = std::exchange(firstAwaitingPop, nullptr);
+    lastAwaitingPop = nullptr;
+  }
   dataCondVar.notify_all();
   capacityCondVar.notify_all();
+
+  // the awaiting pops resume without an element
+  resumeAwaitingPops(waiter);
 }
 
 /**
  * @brief checks whether the queue contains an element which fulfills a given propery.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
 template <typename Predicate>
-auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::contains(Predicate&& predicate) const -> bool
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::contains(Predicate&& predicate) const -> bool
 {
   // ------- begin critical section ------- //
   lock lk(dataMutex);
@@ -861,9 +1538,9 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::contains(Predicat
  *        fulfills a given propery.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
 template <typename Predicate>
-auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::hasTopProperty(Predicate&& predicate) const -> bool
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::hasTopProperty(Predicate&& predicate) const -> bool
 {
   // ------- begin critical section ------- //
   lock lk(dataMutex);
@@ -875,9 +1552,9 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::hasTopProperty(Pr
  * @return The number of elements that have been removed.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
 template <typename Predicate>
-auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::removeIf(Predicate&& predicate) -> size_type
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::removeIf(Predicate&& predicate) -> size_type
 {
   size_type numRemovedElements{};
 
@@ -885,7 +1562,7 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::removeIf(Predicat
   {
     lock lk(dataMutex);
     const auto sizeBefore = data.size();
-    data.remove_if(std::forward<Predicate>(predicate)), data.end();
+    accessor.removeIf(std::forward<Predicate>(predicate));
 
     numRemovedElements = sizeBefore - data.size();
     if(numRemovedElements > 0ULL)
@@ -904,9 +1581,9 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::removeIf(Predicat
  * @returns true, if an element has been found. False otherwise.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
 template <typename Predicate>
-auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::extractIf(value_type& value, Predicate&& predicate) -> bool
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::extractIf(value_type& value, Predicate&& predicate) -> bool
 {
   // ------- begin critical section ------- //
   {
@@ -931,9 +1608,9 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::extractIf(value_t
  *        into a list.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
 template <typename Predicate>
-inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::extractIf(Predicate&& predicate) -> std::list<value_type>
+inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::extractIf(Predicate&& predicate) -> std::list<value_type>
 {
   // ------- begin critical section ------- //
   lock lk(dataMutex);
@@ -941,35 +1618,11 @@ inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::extractIf(
 }
 
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
 template <typename Predicate>
-auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::extractIfImpl(Predicate&& predicate) -> std::list<value_type>
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::extractIfImpl(Predicate&& predicate) -> std::list<value_type>
 {
-  std::list<value_type> extractedElements;
-
-  //const auto firstRemoved = std::remove_if(data.begin(), data.end(), predicate);
-  //std::move(firstRemoved, data.end(), std::back_inserter(extractedElements));
-  //data.erase(firstRemoved, data.end());
-
-  //auto elem = std::find_if(accessor.begin(), accessor.end(), predicate);
-  //while(elem != accessor.end())
-  //{
-  //  extractedElements.push_back(std::move(*elem));
-  //  const auto toErase = elem;
-  //  std::advance(elem, 1ULL);
-  //  accessor.erase(toErase);
-  //  elem = std::find_if(elem, accessor.end(), predicate);
-  //}
-
-  auto elem = std::find_if(data.begin(), data.end(), predicate);
-  while(elem != data.end())
-  {
-    extractedElements.push_front(std::move(*elem));
-    const auto toErase = elem;
-    std::advance(elem, 1ULL);
-    data.erase(toErase);
-    elem = std::find_if(elem, data.end(), predicate);
-  }
+  auto extractedElements = accessor.extractIf(std::forward<Predicate>(predicate));
 
   if(!extractedElements.empty())
   {
@@ -984,9 +1637,9 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::extractIfImpl(Pre
  * @returns the passed function object.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
 template <typename F>
-auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::forEach(F&& f) const -> F
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::forEach(F&& f) const -> F
 {
   // ------- begin critical section ------- //
   {
@@ -1007,9 +1660,9 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::forEach(F&& f) co
  * @throw std::out_of_range.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
 template <typename V, typename>
-void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::visitTop(V&& visitor)
+void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::visitTop(V&& visitor)
 {
   // ------- begin critical section ------- //
   {
@@ -1030,9 +1683,9 @@ void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::visitTop(V&& visi
  *        If the queue is the provided default value is returned.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
 template <typename V, typename Res, typename>
-auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::visitTop(V&& visitor, Res const& defaultValue) -> Res
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::visitTop(V&& visitor, Res const& defaultValue) -> Res
 {
   // ------- begin critical section ------- //
   {
@@ -1052,9 +1705,9 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::visitTop(V&& visi
  *        and reinserts them afterwards.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
 template <typename V, typename Predicate, typename>
-auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::extractVisitReinsert(V&& visitor, Predicate&& predicate) -> size_type
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::extractVisitReinsert(V&& visitor, Predicate&& predicate) -> size_type
 {
   size_type numHosts{};
   // ------- begin critical section ------- //
@@ -1081,9 +1734,9 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::extractVisitReins
  *         or a std::nullopt. 
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
 template <typename V, typename Predicate, typename Res, typename>
-auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::extractVisitReinsert(V&& visitor, Predicate&& predicate) 
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::extractVisitReinsert(V&& visitor, Predicate&& predicate) 
   -> std::optional<Res>
 {
   // ------- begin critical section ------- //
@@ -1117,12 +1770,194 @@ auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::extractVisitReins
   return std::nullopt;
 }
 
+/**
+ * @brief Pops up to maxNumElements elements into the given output iterator and notifies
+ *        the waiting producers once. Must be called while holding the lock.
+ */
+template <typename T, template <typename...> typename Container,
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+template <typename OutputIt>
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::popBulkImpl(OutputIt out, size_type maxNumElements) -> size_type
+{
+  size_type numPoppedElements{};
+  if(hasData() && maxNumElements > 0ULL)
+  {
+    value_type value;
+    for(; numPoppedElements < maxNumElements && hasData(); ++numPoppedElements)
+    {
+      accessor.pop(value);
+      *out = std::move(value);
+      ++out;
+    }
+    counters.popped(numPoppedElements);
+    capacityCondVar.notify_all();
+  }
+
+  return numPoppedElements;
+}
+
+/**
+ * @brief  Busy waits for data according to the wait strategy before a consumer blocks.
+ *         Instead of polling the lock, the consumer spins on the data epoch, which producers
+ *         increment whenever they notify, and calls tryPopActive only if it has changed.
+ * @return true, if tryPopActive succeeded before the strategy was exhausted.
+ */
+template <typename T, template <typename...> typename Container,
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+template <typename TryPop>
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::spinAndTryPop(TryPop&& tryPopActive) -> bool
+{
+  const auto strategy = consumerWaitStrategy.load(std::memory_order_relaxed);
+  if(!strategy.spins())
+  {
+    return false;
+  }
+
+  SpinWaiter waiter(strategy);
+  auto epoch = dataEpoch.load(std::memory_order_acquire);
+  while(!tryPopActive())
+  {
+    for(auto current = dataEpoch.load(std::memory_order_acquire); current == epoch;
+        current = dataEpoch.load(std::memory_order_acquire))
+    {
+      if(!waiter.wait())
+      {
+        return false;
+      }
+    }
+    epoch = dataEpoch.load(std::memory_order_acquire);
+  }
+
+  return true;
+}
+
+/**
+ * @brief  Wakes up one waiting consumer. Must be called while holding the lock.
+ * @return the awaiting pops that have been served, they have to be resumed by resumeAwaitingPops
+ *         after the lock has been released.
+ */
+template <typename T, template <typename...> typename Container,
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::notifyConsumer()
+  -> detail::AwaitingPop<value_type>*
+{
+  auto* const served = firstAwaitingPop != nullptr ? serveAwaitingPops() : nullptr;
+  dataEpoch.fetch_add(1ULL, std::memory_order_release);
+  dataCondVar.notify_one();
+  return served;
+}
+
+/**
+ * @brief  Wakes up all waiting consumers. Must be called while holding the lock.
+ * @return the awaiting pops that have been served, see notifyConsumer.
+ */
+template <typename T, template <typename...> typename Container,
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::notifyAllConsumers()
+  -> detail::AwaitingPop<value_type>*
+{
+  auto* const served = firstAwaitingPop != nullptr ? serveAwaitingPops() : nullptr;
+  dataEpoch.fetch_add(1ULL, std::memory_order_release);
+  dataCondVar.notify_all();
+  return served;
+}
+
+/**
+ * @brief  Pops the front element into an awaiting pop if there is one or the queue is stopped,
+ *         otherwise the awaiting pop is appended to the list.
+ * @return true, if the awaiting coroutine has to stay suspended.
+ */
+template <typename T, template <typename...> typename Container,
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::suspendPop(detail::AwaitingPop<value_type>& waiter) -> bool
+{
+  // ------- begin critical section ------- //
+  lock lk(dataMutex);
+  if(!isActive)
+  {
+    return false;
+  }
+  if(hasData())
+  {
+    accessor.pop(waiter.value.emplace());
+    counters.popped();
+    capacityCondVar.notify_all();
+    return false;
+  }
+
+  waiter.next = nullptr;
+  if(lastAwaitingPop != nullptr)
+  {
+    lastAwaitingPop->next = &waiter;
+  }
+  else
+  {
+    firstAwaitingPop = &waiter;
+  }
+  lastAwaitingPop = &waiter;
+  return true;
+}
+
+/**
+ * @brief  Moves elements into the awaiting pops in the order they arrived and unlinks them from
+ *         the list. Must be called while holding the lock.
+ * @return the served awaiting pops, still linked among themselves. Their coroutines are handed
+ *         over to their pools by resumeAwaitingPops once the lock is released, since posting to
+ *         a bounded pool may block.
+ */
+template <typename T, template <typename...> typename Container,
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::serveAwaitingPops()
+  -> detail::AwaitingPop<value_type>*
+{
+  auto* const                      served     = firstAwaitingPop;
+  detail::AwaitingPop<value_type>* lastServed = nullptr;
+  size_type                        numServed{};
+  while(firstAwaitingPop != nullptr && hasData())
+  {
+    lastServed       = firstAwaitingPop;
+    firstAwaitingPop = lastServed->next;
+    accessor.pop(lastServed->value.emplace());
+    ++numServed;
+  }
+  if(firstAwaitingPop == nullptr)
+  {
+    lastAwaitingPop = nullptr;
+  }
+  if(numServed == 0ULL)
+  {
+    return nullptr;
+  }
+
+  lastServed->next = nullptr;
+  counters.popped(numServed);
+  capacityCondVar.notify_all();
+  return served;
+}
+
+/**
+ * @brief  Resumes the coroutines of a list of awaiting pops on their pools. Must be called
+ *         without holding the lock.
+ * @remark Once resumed, a coroutine may destroy its awaiting pop, so the next one is read first.
+ */
+template <typename T, template <typename...> typename Container,
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+void ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::resumeAwaitingPops(detail::AwaitingPop<value_type>* waiter)
+{
+  while(waiter != nullptr)
+  {
+    auto* const next = waiter->next;
+    detail::resumeOn(waiter->executor, waiter->handle);
+    waiter = next;
+  }
+}
+
 /**
  * @brief checks whether the size of the container is below the capacity.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
-inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::sizeIsBelowCapacity() const -> bool
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::sizeIsBelowCapacity() const -> bool
 {
   return data.size() < dataCapacity;
 }
@@ -1131,8 +1966,8 @@ inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::sizeIsBelo
  * @brief checks whether the container has at least one element.
  */
 template <typename T, template <typename...> typename Container,
-          insertionPolicy InsertionPolicy, typename Compare>
-inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare>::hasData() const -> bool
+          insertionPolicy InsertionPolicy, typename Compare, metricsPolicy Metrics>
+inline auto ThreadsafeQueueT<T, Container, InsertionPolicy, Compare, Metrics>::hasData() const -> bool
 {
   return !data.empty();
 }
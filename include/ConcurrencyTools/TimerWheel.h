@@ -0,0 +1,539 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   TimerWheel.h
+ * @brief  hierarchical timing wheel serving many timers from a single thread.
+ *
+ * @author Lasse Rosenthal
+ * @date   16.10.2026
+ */
+
+#ifndef TIMERWHEEL_H_50192837465019283746501928374650192837465019283
+#define TIMERWHEEL_H_50192837465019283746501928374650192837465019283
+
+
+// includes
+#include "RAIIThread.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace cctools {
+
+
+/**
+ * @class  TimerWheel
+ * @brief  TimerWheel runs delayed and periodic callbacks on one dedicated thread.
+ *         Timers are kept in a hierarchical timing wheel of four levels with 256 slots
+ *         each. Scheduling, cancelling and kicking a timer are O(1), the wheel thread
+ *         only touches the timers expiring in the current tick and, every 256 ticks,
+ *         cascades one slot of a higher level down. Hence the firing jitter stays
+ *         within a tick even with hundreds of thousands of active timers.
+ * @remark Timers fire at the first tick boundary not earlier than the requested delay,
+ *         i.e. up to one tick late. Callbacks run on the wheel thread and should be
+ *         short; longer work is better posted to a ThreadPool. Exceptions thrown by
+ *         callbacks are swallowed. Callbacks may schedule, cancel and kick timers.
+ */
+class TimerWheel {
+
+  static constexpr std::uint32_t levelBits = 8U;
+  static constexpr std::uint32_t numSlots  = 1U << levelBits;
+  static constexpr std::uint32_t slotMask  = numSlots - 1U;
+  static constexpr std::uint32_t numLevels = 4U;
+  static constexpr std::uint32_t overflow  = numLevels * numSlots;   ///< list of timers beyond the top level
+  static constexpr std::uint32_t npos      = (std::numeric_limits<std::uint32_t>::max)();
+
+public:
+
+  // ---------------------------------------------------
+  // public types
+  using callback_type = std::function<void(void)>;
+  using clock         = std::chrono::steady_clock;
+  using duration_type = clock::duration;
+  using size_type     = std::size_t;
+  using TimerId       = std::uint64_t;   ///< 0 never identifies a timer
+
+  // ---------------------------------------------------
+  // construction
+  explicit TimerWheel   (duration_type tick = std::chrono::milliseconds(1));
+  TimerWheel            (TimerWheel const&) = delete;
+  auto operator=        (TimerWheel const&) -> TimerWheel& = delete;
+  ~TimerWheel           ();
+
+  // ---------------------------------------------------
+  // public api
+  template <typename Rep, typename Period>
+  auto scheduleAfter    (std::chrono::duration<Rep, Period> delay, callback_type callback) -> TimerId;
+  template <typename Rep, typename Period>
+  auto schedulePeriodic (std::chrono::duration<Rep, Period> period, callback_type callback) -> TimerId;
+  auto cancel           (TimerId id) -> bool;
+  auto kick             (TimerId id) -> bool;
+  auto isPending        (TimerId id) const -> bool;
+  auto size             () const -> size_type;
+  auto tickDuration     () const noexcept -> duration_type;
+
+private:
+
+  enum class timerState : char { free, pending, running };
+
+  struct Timer {
+    callback_type callback;
+    std::uint64_t expiry {0ULL};
+    std::uint64_t delay {0ULL};       ///< in ticks
+    std::uint32_t generation {1U};
+    std::uint32_t prev {npos};
+    std::uint32_t next {npos};
+    std::uint32_t slot {npos};
+    timerState    state {timerState::free};
+    bool          periodic {false};
+    bool          cancelled {false};  ///< cancelled after it expired
+    bool          kicked {false};     ///< kicked while its callback runs
+  };
+
+  // ---------------------------------------------------
+  // private methods
+  auto schedule   (duration_type delay, callback_type callback, bool periodic) -> TimerId;
+  auto find       (TimerId id) const -> std::uint32_t;
+  auto toTicks    (duration_type delay) const -> std::uint64_t;
+  auto nowTick    () const -> std::uint64_t;
+  auto dueTick    (std::uint64_t delay) const -> std::uint64_t;
+  void insert     (std::uint32_t index);
+  void unlink     (std::uint32_t index);
+  void release    (std::uint32_t index);
+  void cascade    (std::uint32_t slot);
+  void advance    (std::vector<std::pair<std::uint32_t, Timer*>>& expired);
+  void fire       (std::vector<std::pair<std::uint32_t, Timer*>>& expired, std::unique_lock<std::mutex>& lock);
+  void run        ();
+
+  // ---------------------------------------------------
+  // private data
+  const duration_type                       tick;
+  const clock::time_point                   startTime;
+  mutable std::mutex                        mut;
+  std::condition_variable                   wakeUp;
+  std::condition_variable                   callbackFinished;
+  std::deque<Timer>                         timers;      // deque keeps references stable while callbacks run
+  std::vector<std::uint32_t>                freeTimers;
+  std::array<std::uint32_t, overflow + 1U>  slots;
+  std::uint64_t                             currentTick {0ULL};
+  size_type                                 numTimers {0ULL};
+  bool                                      isActive {true};
+  std::thread::id                           wheelThreadId;
+  JoinThread                                wheelThread;
+};
+
+
+inline TimerWheel::TimerWheel(duration_type t)
+  : tick      {t > duration_type::zero() ? t : duration_type{1}}
+  , startTime {clock::now()}
+{
+  slots.fill(npos);
+  wheelThread = JoinThread([this] { run(); });
+}
+
+inline TimerWheel::~TimerWheel()
+{
+  {
+    std::lock_guard<std::mutex> lock(mut);
+    isActive = false;
+  }
+  wakeUp.notify_one();
+}
+
+/**
+ * @brief  Calls callback once after delay has expired.
+ * @return the id of the timer.
+ */
+template <typename Rep, typename Period>
+auto TimerWheel::scheduleAfter(std::chrono::duration<Rep, Period> delay, callback_type callback) -> TimerId
+{
+  return schedule(std::chrono::ceil<duration_type>(delay), std::move(callback), false);
+}
+
+/**
+ * @brief  Calls callback every period until the timer is cancelled. The next period starts
+ *         when the callback returns.
+ * @return the id of the timer.
+ */
+template <typename Rep, typename Period>
+auto TimerWheel::schedulePeriodic(std::chrono::duration<Rep, Period> period, callback_type callback) -> TimerId
+{
+  return schedule(std::chrono::ceil<duration_type>(period), std::move(callback), true);
+}
+
+/**
+ * @brief  Cancels the timer. If its callback is running on the wheel thread, the call
+ *         blocks until the callback has returned unless it is issued by the callback itself.
+ * @return false, if the timer has already fired or has been cancelled before.
+ */
+inline auto TimerWheel::cancel(TimerId id) -> bool
+{
+  std::unique_lock<std::mutex> lock(mut);
+  const auto index = find(id);
+  if(index == npos || timers[index].cancelled)
+  {
+    return false;
+  }
+
+  auto* const timer = &timers[index];
+  if(timer->state == timerState::pending)
+  {
+    unlink(index);
+    release(index);
+    return true;
+  }
+
+  timer->cancelled = true;
+  if(std::this_thread::get_id() != wheelThreadId)
+  {
+    const auto generation = timer->generation;
+    callbackFinished.wait(lock, [timer, generation] {
+      return timer->generation != generation || timer->state != timerState::running;
+    });
+  }
+  return true;
+}
+
+/**
+ * @brief  Restarts the countdown of the timer with its original delay.
+ *         A one shot timer whose callback is running is armed once more.
+ * @return false, if the timer has already fired or has been cancelled.
+ */
+inline auto TimerWheel::kick(TimerId id) -> bool
+{
+  std::lock_guard<std::mutex> lock(mut);
+  const auto index = find(id);
+  if(index == npos || timers[index].cancelled)
+  {
+    return false;
+  }
+
+  auto& timer = timers[index];
+  if(timer.state == timerState::running)
+  {
+    timer.kicked = true;
+    return true;
+  }
+
+  unlink(index);
+  timer.expiry = dueTick(timer.delay);
+  insert(index);
+  return true;
+}
+
+/**
+ * @brief Returns true, if the timer has neither fired nor been cancelled yet.
+ */
+inline auto TimerWheel::isPending(TimerId id) const -> bool
+{
+  std::lock_guard<std::mutex> lock(mut);
+  return find(id) != npos;
+}
+
+/**
+ * @brief Returns the number of active timers.
+ */
+inline auto TimerWheel::size() const -> size_type
+{
+  std::lock_guard<std::mutex> lock(mut);
+  return numTimers;
+}
+
+inline auto TimerWheel::tickDuration() const noexcept -> duration_type
+{
+  return tick;
+}
+
+inline auto TimerWheel::schedule(duration_type delay, callback_type callback, bool periodic) -> TimerId
+{
+  std::unique_lock<std::mutex> lock(mut);
+  std::uint32_t index = 0U;
+  if(freeTimers.empty())
+  {
+    index = static_cast<std::uint32_t>(timers.size());
+    timers.emplace_back();
+  }
+  else
+  {
+    index = freeTimers.back();
+    freeTimers.pop_back();
+  }
+
+  // the wheel thread does not tick while the wheel is empty
+  if(numTimers == 0ULL)
+  {
+    currentTick = nowTick();
+  }
+
+  auto& timer     = timers[index];
+  timer.callback  = std::move(callback);
+  timer.delay     = toTicks(delay);
+  timer.expiry    = dueTick(timer.delay);
+  timer.state     = timerState::pending;
+  timer.periodic  = periodic;
+  timer.cancelled = false;
+  timer.kicked    = false;
+  insert(index);
+
+  const auto wasEmpty = numTimers++ == 0ULL;
+  const auto id = (static_cast<TimerId>(timer.generation) << 32U) | index;
+  lock.unlock();
+
+  if(wasEmpty)
+  {
+    wakeUp.notify_one();
+  }
+  return id;
+}
+
+/**
+ * @brief Returns the index of the timer or npos if the id is stale.
+ */
+inline auto TimerWheel::find(TimerId id) const -> std::uint32_t
+{
+  const auto index = static_cast<std::uint32_t>(id & npos);
+  if(index >= timers.size())
+  {
+    return npos;
+  }
+  auto const& timer = timers[index];
+  if(timer.state == timerState::free || timer.generation != static_cast<std::uint32_t>(id >> 32U))
+  {
+    return npos;
+  }
+  return index;
+}
+
+inline auto TimerWheel::toTicks(duration_type delay) const -> std::uint64_t
+{
+  const auto ticks = (delay.count() + tick.count() - 1) / tick.count();
+  return ticks > 0 ? static_cast<std::uint64_t>(ticks) : 1ULL;
+}
+
+inline auto TimerWheel::nowTick() const -> std::uint64_t
+{
+  return static_cast<std::uint64_t>((clock::now() - startTime) / tick);
+}
+
+/**
+ * @brief Returns the first tick boundary at least delay ticks from now. Since the current
+ *        tick has already begun, this is one tick more than nowTick() + delay.
+ */
+inline auto TimerWheel::dueTick(std::uint64_t delay) const -> std::uint64_t
+{
+  return nowTick() + delay + 1ULL;
+}
+
+/**
+ * @brief Links the timer into the slot of the lowest level in which its expiry and the
+ *        current tick agree on all higher digits. Expired timers go to the next tick.
+ */
+inline void TimerWheel::insert(std::uint32_t index)
+{
+  auto& timer = timers[index];
+  if(timer.expiry <= currentTick)
+  {
+    timer.expiry = currentTick + 1ULL;
+  }
+
+  timer.slot = overflow;
+  const auto diff = timer.expiry ^ currentTick;
+  for(std::uint32_t level = 0U; level < numLevels; ++level)
+  {
+    if(diff < (1ULL << (levelBits * (level + 1U))))
+    {
+      timer.slot = level * numSlots + static_cast<std::uint32_t>((timer.expiry >> (levelBits * level)) & slotMask);
+      break;
+    }
+  }
+
+  timer.prev = npos;
+  timer.next = slots[timer.slot];
+  if(timer.next != npos)
+  {
+    timers[timer.next].prev = index;
+  }
+  slots[timer.slot] = index;
+}
+
+inline void TimerWheel::unlink(std::uint32_t index)
+{
+  auto& timer = timers[index];
+  if(timer.prev != npos)
+  {
+    timers[timer.prev].next = timer.next;
+  }
+  else
+  {
+    slots[timer.slot] = timer.next;
+  }
+  if(timer.next != npos)
+  {
+    timers[timer.next].prev = timer.prev;
+  }
+  timer.prev = timer.next = timer.slot = npos;
+}
+
+inline void TimerWheel::release(std::uint32_t index)
+{
+  auto& timer    = timers[index];
+  timer.callback = nullptr;
+  timer.state    = timerState::free;
+  ++timer.generation;
+  if(timer.generation == 0U)
+  {
+    timer.generation = 1U;
+  }
+  freeTimers.push_back(index);
+  --numTimers;
+}
+
+/**
+ * @brief Redistributes the timers of a slot to the lower levels.
+ */
+inline void TimerWheel::cascade(std::uint32_t slot)
+{
+  auto index = slots[slot];
+  slots[slot] = npos;
+  while(index != npos)
+  {
+    const auto next = timers[index].next;
+    insert(index);
+    index = next;
+  }
+}
+
+/**
+ * @brief Advances the wheel by one tick and collects the timers expiring in it.
+ */
+inline void TimerWheel::advance(std::vector<std::pair<std::uint32_t, Timer*>>& expired)
+{
+  ++currentTick;
+
+  if((currentTick & ((1ULL << (levelBits * numLevels)) - 1ULL)) == 0ULL)
+  {
+    cascade(overflow);
+  }
+  for(std::uint32_t level = numLevels - 1U; level > 0U; --level)
+  {
+    if((currentTick & ((1ULL << (levelBits * level)) - 1ULL)) == 0ULL)
+    {
+      cascade(level * numSlots + static_cast<std::uint32_t>((currentTick >> (levelBits * level)) & slotMask));
+    }
+  }
+
+  const auto slot = static_cast<std::uint32_t>(currentTick & slotMask);
+  for(auto index = slots[slot]; index != npos; index = timers[index].next)
+  {
+    timers[index].state = timerState::running;
+    timers[index].slot  = npos;
+    expired.emplace_back(index, &timers[index]);
+  }
+  slots[slot] = npos;
+}
+
+/**
+ * @brief Runs the callbacks of the expired timers without holding the lock and
+ *        re-arms periodic and kicked ones afterwards. Timers cancelled by an earlier
+ *        callback of the same tick or by another thread meanwhile are skipped.
+ */
+inline void TimerWheel::fire(std::vector<std::pair<std::uint32_t, Timer*>>& expired, std::unique_lock<std::mutex>& lock)
+{
+  // timers are never removed from the deque, so the pointers stay valid while other threads schedule
+  for(auto const& [index, timer] : expired)
+  {
+    if(timer->cancelled)
+    {
+      continue;
+    }
+
+    lock.unlock();
+    try
+    {
+      timer->callback();
+    }
+    catch(...)
+    {
+    }
+    lock.lock();
+  }
+
+  for(auto const& [index, timer] : expired)
+  {
+    if(!timer->cancelled && (timer->periodic || timer->kicked))
+    {
+      timer->state  = timerState::pending;
+      timer->kicked = false;
+      timer->expiry = dueTick(timer->delay);
+      insert(index);
+    }
+    else
+    {
+      release(index);
+    }
+  }
+  expired.clear();
+  callbackFinished.notify_all();
+}
+
+inline void TimerWheel::run()
+{
+  std::vector<std::pair<std::uint32_t, Timer*>> expired;
+  std::unique_lock<std::mutex> lock(mut);
+  wheelThreadId = std::this_thread::get_id();
+
+  while(isActive)
+  {
+    if(numTimers == 0ULL)
+    {
+      wakeUp.wait(lock, [this] { return !isActive || numTimers > 0ULL; });
+      continue;
+    }
+
+    wakeUp.wait_until(lock, startTime + tick * (currentTick + 1ULL), [this] { return !isActive; });
+
+    for(const auto target = nowTick(); isActive && currentTick < target;)
+    {
+      advance(expired);
+      if(!expired.empty())
+      {
+        fire(expired, lock);
+      }
+    }
+  }
+}
+
+
+/**
+ * @brief Returns the timer wheel shared by all watchdogs that do not bring their own.
+ */
+inline auto defaultTimerWheel() -> TimerWheel&
+{
+  static TimerWheel wheel;
+  return wheel;
+}
+
+
+}   // namespace cctools
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif   // TIMERWHEEL_H_50192837465019283746501928374650192837465019283
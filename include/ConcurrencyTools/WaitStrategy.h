@@ -0,0 +1,163 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   WaitStrategy.h
+ * @brief  runtime configurable spin-then-yield phase preceding a blocking wait.
+ *
+ * @author Lasse Rosenthal
+ * @date   16.10.2026
+ */
+
+#ifndef WAITSTRATEGY_H_40192837465019283746501928374650192837465019
+#define WAITSTRATEGY_H_40192837465019283746501928374650192837465019
+
+
+// includes
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#  include <immintrin.h>
+#  define CCTOOLS_HAS_MM_PAUSE
+#endif
+
+
+namespace cctools {
+
+
+/**
+ * @brief  WaitStrategy determines how a thread waits for data before it is parked.
+ *         It first polls spinCount times with exponentially growing bursts of pause
+ *         instructions, then yieldCount times with a yield of its time slice in between.
+ *         Only then it blocks on the underlying condition variable or futex.
+ * @remark Spinning trades cpu time for latency. It pays off if new data usually arrives
+ *         within a few microseconds, e.g. for bursts of short tasks.
+ */
+struct WaitStrategy {
+  std::uint32_t spinCount {0U};
+  std::uint32_t yieldCount {0U};
+
+  /// parks immediately.
+  static constexpr auto blocking() noexcept -> WaitStrategy
+  {
+    return WaitStrategy{0U, 0U};
+  }
+
+  /// spins for a few microseconds and yields a couple of times before parking.
+  static constexpr auto adaptive() noexcept -> WaitStrategy
+  {
+    return WaitStrategy{16U, 8U};
+  }
+
+  constexpr auto spins() const noexcept -> bool
+  {
+    return spinCount + yieldCount > 0U;
+  }
+};
+
+
+/**
+ * @brief Hints the processor that the calling thread is busy waiting.
+ */
+inline void cpuRelax() noexcept
+{
+#if defined(CCTOOLS_HAS_MM_PAUSE)
+  _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  asm volatile("yield");
+#else
+  std::this_thread::yield();
+#endif
+}
+
+
+/**
+ * @class SpinWaiter
+ * @brief SpinWaiter performs the busy waiting steps of a WaitStrategy one by one.
+ */
+class SpinWaiter {
+
+  static constexpr std::uint32_t maxPausesPerSpin = 64U;
+
+public:
+
+  // ---------------------------------------------------
+  // constructor
+  explicit SpinWaiter (WaitStrategy strategy) noexcept;
+
+  // ---------------------------------------------------
+  // api
+  auto wait () noexcept -> bool;
+
+private:
+
+  // ---------------------------------------------------
+  // private data
+  WaitStrategy  strategy;
+  std::uint32_t iteration {0U};
+};
+
+inline SpinWaiter::SpinWaiter(WaitStrategy s) noexcept
+  : strategy {s}
+{}
+
+/**
+ * @brief  Performs the next busy waiting step.
+ * @return false, if the strategy is exhausted and the caller should park.
+ */
+inline auto SpinWaiter::wait() noexcept -> bool
+{
+  if(iteration < strategy.spinCount)
+  {
+    const auto numPauses = (std::min)(std::uint32_t{1U} << (std::min)(iteration, 6U), maxPausesPerSpin);
+    for(std::uint32_t i = 0U; i < numPauses; ++i)
+    {
+      cpuRelax();
+    }
+  }
+  else if(iteration < strategy.spinCount + strategy.yieldCount)
+  {
+    std::this_thread::yield();
+  }
+  else
+  {
+    return false;
+  }
+
+  ++iteration;
+  return true;
+}
+
+/**
+ * @brief  Polls the passed predicate following the given strategy.
+ * @return true as soon as the predicate holds, false if the strategy is exhausted before.
+ */
+template <typename Predicate>
+auto spinUntil(WaitStrategy strategy, Predicate&& predicate) -> bool
+{
+  SpinWaiter waiter(strategy);
+  do
+  {
+    if(predicate())
+    {
+      return true;
+    }
+  } while(waiter.wait());
+
+  return false;
+}
+
+
+}   // namespace cctools
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif   // WAITSTRATEGY_H_40192837465019283746501928374650192837465019
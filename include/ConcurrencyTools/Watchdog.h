@@ -17,22 +17,26 @@
  
  
 // includes
-#include "RAIIThread.h"
+#include "TimerWheel.h"
 
 #include <chrono>
-#include <condition_variable>
-#include <exception>
 #include <functional>
-#include <mutex>
+#include <stdexcept>
 
 
 namespace cctools {
 
 
 /** 
- * @class Watchdog
- * @brief Watchdog implements a timer that calls recurrently calls
- *        a specified function after a given time out has expired.
+ * @class  Watchdog
+ * @brief  Watchdog implements a timer that recurrently calls a specified
+ *         function after a given time out has expired. kick restarts the
+ *         countdown, so the callback only fires if the watchdog is not kicked
+ *         in time.
+ * @remark A watchdog is a lightweight handle onto a TimerWheel. All watchdogs
+ *         share the thread of the wheel, by default the one of defaultTimerWheel.
+ *         The callback runs on the wheel thread. stop and the destructor wait
+ *         for a running callback to return.
  */
 class Watchdog {
 
@@ -44,41 +48,39 @@ public:
   using duration_type = std::chrono::milliseconds;
 
   // ---------------------------------------------------
-  // 
+  // construction
   template <typename Rep, typename Period>
   Watchdog(callback_type c, std::chrono::duration<Rep, Period> t,
-           bool startNow);
+           bool startNow, TimerWheel& w = defaultTimerWheel());
+  Watchdog       (Watchdog const&) = delete;
+  auto operator= (Watchdog const&) -> Watchdog& = delete;
+  ~Watchdog      ();
 
   // ---------------------------------------------------
   // public api
   void registerCallback (callback_type c);
   void start            ();
   void stop             ();
+  void kick             ();
+  auto isRunning        () const -> bool;
 
 private:
 
-  // ---------------------------------------------------
-  // private methods
-  void loop ();
-
   // ---------------------------------------------------
   // private data
-  cctools::JoinThread     watchThread;
-  callback_type           callback;
-  duration_type           timeOut;
-  mutable std::mutex      mut;
-  std::condition_variable buzzer;
-  bool                    timeOutExpired {false};
-  bool                    isActive {false};
-
+  TimerWheel*         wheel;
+  callback_type       callback;
+  duration_type       timeOut;
+  TimerWheel::TimerId timer {0ULL};
 };
 
 
 template <typename Rep, typename Period>
 Watchdog::Watchdog(callback_type c, std::chrono::duration<Rep, Period> t,
-                   bool startNow)
-  : callback {std::move(c)}
-  , timeOut  {t}
+                   bool startNow, TimerWheel& w)
+  : wheel    {&w}
+  , callback {std::move(c)}
+  , timeOut  {std::chrono::ceil<duration_type>(t)}
 {
   if(startNow)
   {
@@ -86,13 +88,26 @@ Watchdog::Watchdog(callback_type c, std::chrono::duration<Rep, Period> t,
   }
 }
 
+inline Watchdog::~Watchdog()
+{
+  stop();
+}
+
+/**
+ * @brief registers a new callback. A running watchdog is restarted with it.
+ */
 inline void Watchdog::registerCallback(callback_type c)
 {
   callback = std::move(c);
+  if(timer != 0ULL)
+  {
+    stop();
+    start();
+  }
 }
 
 /** 
- * @brief starts the 
+ * @brief starts the countdown. A running watchdog is kicked.
  */
 inline void Watchdog::start()
 {
@@ -101,27 +116,40 @@ inline void Watchdog::start()
     throw std::runtime_error("no callback registered");
   }
 
-  isActive = true;
-  watchThread = cctools::JoinThread([this] { this->loop(); });
+  if(timer == 0ULL || !wheel->kick(timer))
+  {
+    timer = wheel->schedulePeriodic(timeOut, callback);
+  }
 }
 
 /**
- * @brief stops the watchdog loop.
+ * @brief stops the watchdog.
  */
 inline void Watchdog::stop()
 {
-  isActive = false;
-  buzzer.notify_one();
+  if(timer != 0ULL)
+  {
+    wheel->cancel(timer);
+    timer = 0ULL;
+  }
 }
 
-inline void Watchdog::loop()
+/**
+ * @brief restarts the countdown of a running watchdog.
+ */
+inline void Watchdog::kick()
 {
-  while(isActive)
+  if(timer != 0ULL)
   {
-    std::unique_lock<std::mutex> lock(mut);
+    wheel->kick(timer);
   }
 }
 
+inline auto Watchdog::isRunning() const -> bool
+{
+  return timer != 0ULL;
+}
+
 
 }   // namespace cctools
 
@@ -0,0 +1,160 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   WorkStealingQueue.h
+ * @brief  implementation of a work stealing queue
+ *         based on Williams - C++ Concurrency in Action, chapter 9.1.5
+ *
+ * @author Lasse Rosenthal
+ * @date   16.10.2026
+ */
+
+#ifndef WORKSTEALINGQUEUE_H_41826390572183946012748396501827364519283
+#define WORKSTEALINGQUEUE_H_41826390572183946012748396501827364519283
+
+
+// includes
+#include <deque>
+#include <mutex>
+#include <utility>
+
+
+namespace cctools {
+
+
+/**
+ * @class WorkStealingQueue
+ * @brief WorkStealingQueue is a double ended queue that is owned by exactly one thread.
+ *        The owning thread pushes and pops elements at the front (lifo order, which keeps
+ *        recently pushed and thus cache hot data local), whereas other threads steal
+ *        elements from the back.
+ */
+template <typename T>
+class WorkStealingQueue {
+
+  // ---------------------------------------------------
+  // internal types
+  using mutex = std::mutex;
+  using lock  = std::lock_guard<mutex>;
+
+public:
+
+  // ---------------------------------------------------
+  // public types
+  using container_type = std::deque<T>;
+  using value_type     = typename container_type::value_type;
+  using size_type      = typename container_type::size_type;
+
+  // ---------------------------------------------------
+  // constructors & assignments
+  WorkStealingQueue  () = default;
+  WorkStealingQueue  (WorkStealingQueue const&) = delete;
+  WorkStealingQueue  (WorkStealingQueue&&) = delete;
+  auto operator=     (WorkStealingQueue const&) -> WorkStealingQueue& = delete;
+  auto operator=     (WorkStealingQueue&&) -> WorkStealingQueue& = delete;
+  ~WorkStealingQueue () = default;
+
+  // ---------------------------------------------------
+  // methods
+  auto empty    () const -> bool;
+  auto size     () const -> size_type;
+  void push     (value_type&& value);
+  auto tryPop   (value_type& value) -> bool;
+  auto trySteal (value_type& value) -> bool;
+
+private:
+
+  // ---------------------------------------------------
+  // members
+  container_type data;
+  mutable mutex  dataMutex;
+};
+
+
+/**
+ * @brief checks whether the queue is empty.
+ */
+template <typename T>
+inline auto WorkStealingQueue<T>::empty() const -> bool
+{
+  // ------- begin critical section ------- //
+  lock lk(dataMutex);
+  return data.empty();
+}
+
+/**
+ * @brief returns the number of elements.
+ */
+template <typename T>
+inline auto WorkStealingQueue<T>::size() const -> size_type
+{
+  // ------- begin critical section ------- //
+  lock lk(dataMutex);
+  return data.size();
+}
+
+/**
+ * @brief Moves a new element to the front of the queue. Should only be
+ *        called by the owning thread.
+ */
+template <typename T>
+inline void WorkStealingQueue<T>::push(value_type&& value)
+{
+  // ------- begin critical section ------- //
+  lock lk(dataMutex);
+  data.push_front(std::move(value));
+}
+
+/**
+ * @brief If the queue is not empty, the element at the front (i.e. the most recently pushed one)
+ *        is moved into the passed value and true is returned. Otherwise, false is returned immediately.
+ *        Should only be called by the owning thread.
+ */
+template <typename T>
+auto WorkStealingQueue<T>::tryPop(value_type& value) -> bool
+{
+  // ------- begin critical section ------- //
+  lock lk(dataMutex);
+  if(data.empty())
+  {
+    return false;
+  }
+
+  value = std::move(data.front());
+  data.pop_front();
+  return true;
+}
+
+/**
+ * @brief If the queue is not empty, the element at the back (i.e. the oldest one)
+ *        is moved into the passed value and true is returned. Otherwise, false is returned immediately.
+ *        This method is intended to be called by threads other than the owning thread.
+ */
+template <typename T>
+auto WorkStealingQueue<T>::trySteal(value_type& value) -> bool
+{
+  // ------- begin critical section ------- //
+  lock lk(dataMutex);
+  if(data.empty())
+  {
+    return false;
+  }
+
+  value = std::move(data.back());
+  data.pop_back();
+  return true;
+}
+
+
+}   // namespace cctools
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif   // WORKSTEALINGQUEUE_H_41826390572183946012748396501827364519283
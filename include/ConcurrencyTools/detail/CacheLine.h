@@ -0,0 +1,60 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    CacheLine.h
+ * @brief   constants and helpers to avoid false sharing between threads.
+ *
+ * @author  Lasse Rosenthal
+ * @date    16.10.2026
+ */
+
+#ifndef CACHELINE_H_60391827465019283746510293847561029384756102
+#define CACHELINE_H_60391827465019283746510293847561029384756102
+
+
+// includes
+#include <cstddef>
+
+
+namespace cctools {
+namespace detail {
+
+
+/// assumed size of a cache line. std::hardware_destructive_interference_size
+/// is not reliably available and would make the layout depend on compiler flags.
+inline constexpr std::size_t cacheLineSize = 64ULL;
+
+/**
+ * @brief Rounds a given value up to the next power of two.
+ */
+constexpr auto nextPowerOfTwo(std::size_t n) noexcept -> std::size_t
+{
+  std::size_t result = 1ULL;
+  while(result < n)
+  {
+    result <<= 1U;
+  }
+  return result;
+}
+
+/**
+ * @brief PaddedMutex is a mutex occupying a cache line of its own. In an array of mutexes
+ *        that are locked by different threads, neighbouring mutexes would share a line otherwise.
+ */
+template <typename Mutex>
+struct alignas(cacheLineSize) PaddedMutex : Mutex {};
+
+
+}   // namespace detail
+}   // namespace cctools
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif   // CACHELINE_H_60391827465019283746510293847561029384756102
@@ -0,0 +1,325 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   EpochDomain.h
+ * @brief  epoch based reclamation of objects that may still be accessed by readers
+ *
+ * @author Lasse Rosenthal
+ * @date   16.10.2026
+ */
+
+#ifndef EPOCHDOMAIN_H_20394857610293847561029384756102938475610293
+#define EPOCHDOMAIN_H_20394857610293847561029384756102938475610293
+
+
+// includes
+#include "CacheLine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+
+namespace cctools {
+namespace detail {
+
+
+/**
+ * @class  EpochDomain
+ * @brief  EpochDomain defers the deletion of retired objects until no reader can access them anymore.
+ *         A reader announces the global epoch in a slot of its own while it accesses shared data.
+ *         A writer first replaces the shared object and then retires the old one with the current
+ *         epoch, which is advanced at the same time. A retired object is deleted as soon as every
+ *         reader that is still active has announced a later epoch.
+ * @remark Entering and leaving is wait-free, except for the first call of a thread, which claims a slot.
+ *         Nested read-side sections of one thread are allowed.
+ * @remark There is a single domain per process, see instance. The slot of a thread is kept in a
+ *         thread local record, which could not tell several domains apart.
+ */
+class EpochDomain {
+
+  // ---------------------------------------------------
+  // private types
+  struct alignas(cacheLineSize) Slot {
+    std::atomic<std::uint64_t> epoch {std::numeric_limits<std::uint64_t>::max()};
+    std::atomic<bool>          claimed {false};
+  };
+
+  struct Retired {
+    void const*   object;
+    void          (*deleter)(void const*);
+    std::uint64_t epoch;
+  };
+
+  struct ThreadRecord {
+    ThreadRecord  (EpochDomain& domain);
+    ~ThreadRecord ();
+
+    EpochDomain& domain;
+    std::size_t  slot;
+    std::size_t  depth {0ULL};
+  };
+
+public:
+
+  // ---------------------------------------------------
+  // public constants
+  static constexpr std::size_t maxThreads       = 256ULL;
+  static constexpr std::size_t reclaimThreshold = 64ULL;
+
+  // ---------------------------------------------------
+  // special member functions
+  EpochDomain    (EpochDomain const&) = delete;
+  auto operator= (EpochDomain const&) -> EpochDomain& = delete;
+  ~EpochDomain   ();
+
+  // ---------------------------------------------------
+  // public api
+  static auto instance () -> EpochDomain&;
+
+  void enter   ();
+  void leave   () noexcept;
+  template <typename T>
+  void retire  (T const* object);
+  void reclaim ();
+
+private:
+
+  // ---------------------------------------------------
+  // private constants
+  static constexpr std::uint64_t inactive = std::numeric_limits<std::uint64_t>::max();
+
+  // ---------------------------------------------------
+  // construction by instance only
+  EpochDomain () = default;
+
+  // ---------------------------------------------------
+  // private data
+  std::atomic<std::uint64_t> globalEpoch {0ULL};
+  Slot                       slots[maxThreads];
+  std::mutex                 retiredMutex;
+  std::vector<Retired>       retired;
+
+  // ---------------------------------------------------
+  // auxiliary methods
+  auto threadRecord () -> ThreadRecord&;
+  auto claimSlot    () -> std::size_t;
+  void reclaimImpl  ();
+};
+
+
+/**
+ * @class EpochGuard
+ * @brief EpochGuard is a RAII class marking a read-side critical section of the EpochDomain.
+ */
+class EpochGuard {
+
+public:
+
+  // ---------------------------------------------------
+  // special member functions
+  EpochGuard     ();
+  EpochGuard     (EpochGuard const&) = delete;
+  auto operator= (EpochGuard const&) -> EpochGuard& = delete;
+  ~EpochGuard    ();
+
+  // ---------------------------------------------------
+  // public api
+  void unlock () noexcept;
+
+private:
+
+  bool active {true};
+};
+
+
+/**
+ * @brief Constructor. Claims a slot for the calling thread.
+ */
+inline EpochDomain::ThreadRecord::ThreadRecord(EpochDomain& domain)
+  : domain {domain}
+  , slot   {domain.claimSlot()}
+{}
+
+/**
+ * @brief Destructor. Releases the slot of the calling thread.
+ */
+inline EpochDomain::ThreadRecord::~ThreadRecord()
+{
+  domain.slots[slot].epoch.store(inactive);
+  domain.slots[slot].claimed.store(false);
+}
+
+/**
+ * @brief Destructor. Deletes all retired objects.
+ */
+inline EpochDomain::~EpochDomain()
+{
+  for(auto const& r : retired)
+  {
+    r.deleter(r.object);
+  }
+}
+
+/**
+ * @brief Returns the domain shared by all readers and writers of the process.
+ */
+inline auto EpochDomain::instance() -> EpochDomain&
+{
+  static EpochDomain domain;
+  return domain;
+}
+
+/**
+ * @brief Enters a read-side critical section by announcing the current epoch.
+ */
+inline void EpochDomain::enter()
+{
+  auto& record = threadRecord();
+  if(record.depth++ == 0ULL)
+  {
+    // the announcement must be visible before the shared data is loaded, hence sequential consistency
+    slots[record.slot].epoch.store(globalEpoch.load());
+  }
+}
+
+/**
+ * @brief Leaves a read-side critical section.
+ */
+inline void EpochDomain::leave() noexcept
+{
+  auto& record = threadRecord();
+  if(--record.depth == 0ULL)
+  {
+    slots[record.slot].epoch.store(inactive, std::memory_order_release);
+  }
+}
+
+/**
+ * @brief Hands over an object, that has already been replaced by a new version, for deletion.
+ *        The object is deleted once no reader that could have loaded it is active anymore.
+ */
+template <typename T>
+void EpochDomain::retire(T const* object)
+{
+  if(object == nullptr)
+  {
+    return;
+  }
+
+  auto const epoch = globalEpoch.fetch_add(1ULL);
+
+  // ------- begin critical section ------- //
+  std::lock_guard lck(retiredMutex);
+  retired.push_back({object, [](void const* p) { delete static_cast<T const*>(p); }, epoch});
+  if(retired.size() >= reclaimThreshold)
+  {
+    reclaimImpl();
+  }
+}
+
+/**
+ * @brief Deletes all retired objects that can't be accessed anymore.
+ */
+inline void EpochDomain::reclaim()
+{
+  // ------- begin critical section ------- //
+  std::lock_guard lck(retiredMutex);
+  reclaimImpl();
+}
+
+/**
+ * @brief Returns the record of the calling thread, which is created on the first call.
+ */
+inline auto EpochDomain::threadRecord() -> ThreadRecord&
+{
+  thread_local ThreadRecord record(*this);
+  return record;
+}
+
+/**
+ * @brief Claims a free slot.
+ * @throw std::runtime_error if more than maxThreads threads use the domain at the same time.
+ */
+inline auto EpochDomain::claimSlot() -> std::size_t
+{
+  for(std::size_t i {}; i < maxThreads; ++i)
+  {
+    bool expected = false;
+    if(slots[i].claimed.compare_exchange_strong(expected, true))
+    {
+      return i;
+    }
+  }
+
+  throw std::runtime_error("EpochDomain: no free reader slot");
+}
+
+/**
+ * @brief Deletes all retired objects whose epoch precedes the epochs of all active readers.
+ *        The mutex for the retired objects must be held by the caller.
+ */
+inline void EpochDomain::reclaimImpl()
+{
+  auto oldestActive = inactive;
+  for(auto const& slot : slots)
+  {
+    oldestActive = std::min(oldestActive, slot.epoch.load());
+  }
+
+  auto const reclaimable = std::partition(retired.begin(), retired.end(),
+                                          [oldestActive](Retired const& r) { return r.epoch >= oldestActive; });
+  for(auto r = reclaimable; r != retired.end(); ++r)
+  {
+    r->deleter(r->object);
+  }
+  retired.erase(reclaimable, retired.end());
+}
+
+
+/**
+ * @brief Constructor. Enters a read-side critical section.
+ */
+inline EpochGuard::EpochGuard()
+{
+  EpochDomain::instance().enter();
+}
+
+/**
+ * @brief Destructor. Leaves the read-side critical section.
+ */
+inline EpochGuard::~EpochGuard()
+{
+  unlock();
+}
+
+/**
+ * @brief Leaves the read-side critical section before the guard is destroyed.
+ */
+inline void EpochGuard::unlock() noexcept
+{
+  if(active)
+  {
+    EpochDomain::instance().leave();
+    active = false;
+  }
+}
+
+
+}   // namespace detail
+}   // namespace cctools
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // EPOCHDOMAIN_H_20394857610293847561029384756102938475610293
@@ -0,0 +1,153 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2026 Heidelberger Druckmaschinen AG
+ * Reproduction or disclosure of this file or its contents without the prior
+ * written consent of Heidelberger Druckmaschinen AG is prohibited.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   NodePool.h
+ * @brief  pool of nodes for node based containers
+ *
+ * @author Lasse Rosenthal
+ * @date   16.10.2026
+ */
+
+#ifndef NODEPOOL_H_50192837465019283746501928374650192837465019
+#define NODEPOOL_H_50192837465019283746501928374650192837465019
+
+
+// includes
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+
+namespace cctools {
+namespace detail {
+
+
+/**
+ * @class  NodePool
+ * @brief  NodePool hands out default constructed nodes that are allocated in chunks. Released nodes
+ *         are kept in an intrusive free list, which is linked via the member next of the nodes.
+ *         Hence acquiring a node allocates at most once per chunk.
+ * @remark A node is never destroyed before the pool is destroyed. Hence a thread may still lock
+ *         the mutex of a node that has already been released, it just has to check afterwards
+ *         whether the node is still part of the container.
+ */
+template <typename Node, template <typename...> class ThreadingPolicy,
+          typename... AdditionalPolicyArgs>
+class NodePool : public ThreadingPolicy<NodePool<Node, ThreadingPolicy, AdditionalPolicyArgs...>,
+                                        AdditionalPolicyArgs...> {
+
+  using threadingPolicy = ThreadingPolicy<NodePool<Node, ThreadingPolicy, AdditionalPolicyArgs...>,
+                                          AdditionalPolicyArgs...>;
+
+  // import the locking methods of the threading policy
+  using threadingPolicy::lock;
+
+public:
+
+  // ---------------------------------------------------
+  // public types
+  using size_type = std::size_t;
+
+  // ---------------------------------------------------
+  // public constants
+  static constexpr size_type defaultChunkSize = 64ULL;
+
+  // ---------------------------------------------------
+  // special member functions
+  explicit NodePool (size_type chunkSize = defaultChunkSize);
+  NodePool          (NodePool const&) = delete;
+  auto operator=    (NodePool const&) -> NodePool& = delete;
+  ~NodePool         () = default;
+
+  // ---------------------------------------------------
+  // public api
+  [[nodiscard]] auto acquire  () -> Node*;
+  void               release  (Node* node) noexcept;
+  [[nodiscard]] auto capacity () const -> size_type;
+
+private:
+
+  // ---------------------------------------------------
+  // private data
+  size_type                            chunkSize;
+  std::vector<std::unique_ptr<Node[]>> chunks;
+  Node*                                freeList {nullptr};
+};
+
+
+/**
+ * @brief Constructor.
+ * @param chunkSize the number of nodes allocated at once. Zero is treated as one.
+ */
+template <typename Node, template <typename...> class ThreadingPolicy,
+          typename... AdditionalPolicyArgs>
+inline NodePool<Node, ThreadingPolicy, AdditionalPolicyArgs...>::NodePool(size_type chunkSize)
+  : chunkSize {chunkSize > 0ULL ? chunkSize : 1ULL}
+{}
+
+/**
+ * @brief Returns a node of the free list. If the free list is empty, a new chunk is allocated.
+ *        The member next of the returned node is undefined.
+ * @throw std::bad_alloc
+ */
+template <typename Node, template <typename...> class ThreadingPolicy,
+          typename... AdditionalPolicyArgs>
+auto NodePool<Node, ThreadingPolicy, AdditionalPolicyArgs...>::acquire() -> Node*
+{
+  // ------- begin critical section ------- //
+  auto lck = lock();
+  if(freeList == nullptr)
+  {
+    auto chunk = std::make_unique<Node[]>(chunkSize);
+    for(size_type i {}; i < chunkSize; ++i)
+    {
+      chunk[i].next = i + 1ULL < chunkSize ? &chunk[i + 1ULL] : nullptr;
+    }
+    freeList = chunk.get();
+    chunks.push_back(std::move(chunk));
+  }
+
+  Node* const node = freeList;
+  freeList         = node->next;
+  return node;
+}
+
+/**
+ * @brief Returns a node to the free list.
+ */
+template <typename Node, template <typename...> class ThreadingPolicy,
+          typename... AdditionalPolicyArgs>
+inline void NodePool<Node, ThreadingPolicy, AdditionalPolicyArgs...>::release(Node* node) noexcept
+{
+  // ------- begin critical section ------- //
+  auto lck   = lock();
+  node->next = freeList;
+  freeList   = node;
+}
+
+/**
+ * @brief Returns the number of nodes allocated so far.
+ */
+template <typename Node, template <typename...> class ThreadingPolicy,
+          typename... AdditionalPolicyArgs>
+inline auto NodePool<Node, ThreadingPolicy, AdditionalPolicyArgs...>::capacity() const -> size_type
+{
+  // ------- begin critical section ------- //
+  auto lck = lock();
+  return chunks.size() * chunkSize;
+}
+
+
+}   // namespace detail
+}   // namespace cctools
+
+
+// *************************************************************************** //
+// ******************************* END OF FILE ******************************* //
+// *************************************************************************** //
+
+#endif // NODEPOOL_H_50192837465019283746501928374650192837465019
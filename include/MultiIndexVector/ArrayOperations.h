@@ -17,6 +17,7 @@
 
 
 // includes
+#include <ConcurrencyTools/ParallelAlgorithms.h>
 #include <MultiIndexVector/StorageOrdering.h>
 
 #include <Utils/miscellaneous.h>
@@ -24,7 +25,6 @@
 #include <algorithm>
 #include <cstddef>
 #include <execution>
-#include <future>
 #include <memory>
 #include <type_traits>
 #include <vector>
@@ -483,7 +483,7 @@ inline void matrixVectorProduct(T* dest, T const* matrix, T const* vec, std::siz
 }
 
 /**
- * @brief  a first parallel implementation of the matrix vector product.
+ * @brief  parallel implementation of the matrix vector product on the shared thread pool.
  * @remark the matrix is assumed to be stored in row major order.
  * @tparam T the type of the matrix and the vector.
  * @param  dest a pointer the destination vector.
@@ -496,44 +496,18 @@ template <typename T>
 inline void matrixVectorProductPar(T* dest, T const* matrix, T const* vec, std::size_t const m,
                                    std::size_t const n)
 {
-  static auto const hardwareThreads = static_cast<std::size_t>(std::thread::hardware_concurrency());
+  // minimal number of multiplications processed by a single task.
+  static constexpr std::size_t minBlockSize{4096ULL};
+  const auto rowsPerBlock = (std::max)(minBlockSize / (std::max)(n, std::size_t{1ULL}), std::size_t{1ULL});
 
-  static constexpr std::size_t minBlockSize{25ULL};
-
-  auto const matrixSize = m * n;
-  // matrixSize == 1 --> maxNumThreads = 1
-  // matrixSize == k*minBlockSize + 1 --> maxNumThreads = k + 1
-  const auto maxNumThreads = (std::min)((std::max)(hardwareThreads, 2ULL), (matrixSize + minBlockSize - 1ULL) / minBlockSize);
-
-  // the block size has to be a multiple of the row size.
-  auto blockSize = cpptools::alignUp(matrixSize / maxNumThreads, n);
-
-  // now we can finally determine the number of threads.
-  const auto numThreads = (matrixSize + blockSize - 1ULL) / blockSize;
-
-  const auto rowsPerThread = blockSize / n;
-  const auto end = dest + m;
-
-  std::vector<std::future<void>> futures;
-  futures.reserve(numThreads - 1ULL);
-  for(std::size_t i{}; i < numThreads - 1ULL; ++i, dest += rowsPerThread, matrix += blockSize)
-  {
-    futures.push_back(std::async(std::launch::async, [=]() { matrixVectorProduct(dest, matrix, vec, rowsPerThread, n);}));
-  }
-
-  for(; dest != end; ++dest, matrix += n)
-  {
-    simpleDotProduct(dest, matrix, vec, n);
-  }
-
-  for(auto const& f : futures)
-  {
-    f.wait();
-  }
+  cctools::parallelFor(std::size_t{0ULL}, m, rowsPerBlock, [=](std::size_t first, std::size_t last) {
+    matrixVectorProduct(dest + first, matrix + first * n, vec, last - first, n);
+  });
 }
 
 /**
- * @brief  a first sequential implementation of the matrix matrix product.
+ * @brief  parallel implementation of the matrix matrix product on the shared thread pool.
+ *         The columns of the destination matrix are computed independently.
  * @remark all matrices are assumed to be stored in column major order.
  * @tparam T the type of the matrices.
  * @param  dest a pointer the destination matrix.
@@ -547,67 +521,25 @@ template <typename T>
 void mmProdParColMaj(T* dest, T const* mat1, T const* mat2, std::size_t const m,
                      std::size_t const n, std::size_t const l)
 {
-#define MULTITHREADED 0
-
-#if MULTITHREADED
-  static auto const hardwareThreads = static_cast<std::size_t>(std::thread::hardware_concurrency());
-  // we have m * l * n multiplications
-  //  static constexpr std::size_t minBlockSize{25ULL};
-
-  const auto maxNumThreads = (std::min)((std::max)(hardwareThreads, 2ULL), l);
-  const auto numThreads = maxNumThreads;
-  std::vector<std::future<void>> futures;
-  futures.reserve(numThreads - 1ULL);
-
-  const auto sizeMat1 = m * n;
-  auto const endMat1 = mat1 + m * n;
-  auto const destEnd = dest + m * l;
-  for(std::size_t i{}; i < numThreads - 1ULL; ++i, dest += m, mat2 += n)
-  {
-    futures.push_back(std::async(std::launch::async, [=]() mutable {
-      multipleOf(dest, mat1, m, *mat2);
-      ++mat2;
-      mat1 += m;
-      for(; mat1 != endMat1; ++mat2, mat1 += m)
-      {
-        addMultipleOf(dest, mat1, m, *mat2);
-      }
-      mat1 -= sizeMat1;    
-    }));
-  }
-
-  for(; dest != destEnd; dest += m)
-  {
-    multipleOf(dest, mat1, m, *mat2);
-    ++mat2;
-    mat1 += m;
-    for(; mat1 != endMat1; ++mat2, mat1 += m)
-    {
-      addMultipleOf(dest, mat1, m, *mat2);
-    }
-    mat1 -= sizeMat1;
-  }
+  // minimal number of multiplications processed by a single task.
+  static constexpr std::size_t minBlockSize{4096ULL};
+  const auto columnsPerBlock = (std::max)(minBlockSize / (std::max)(m * n, std::size_t{1ULL}), std::size_t{1ULL});
 
-  for(auto const& f : futures)
-  {
-    f.wait();
-  }
-#else
   // m, n  x  n, l  -->  m, l
-  const auto sizeMat1 = m * n;
-  auto const endMat1 = mat1 + m * n;
-  for(auto const destEnd = dest + m * l; dest != destEnd; dest += m)
-  {
-    multipleOf(dest, mat1, m, *mat2);
-    ++mat2;
-    mat1 += m;
-    for(; mat1 != endMat1; ++mat2, mat1 += m)
+  cctools::parallelFor(std::size_t{0ULL}, l, columnsPerBlock, [=](std::size_t first, std::size_t last) {
+    auto const endMat1 = mat1 + m * n;
+    for(; first != last; ++first)
     {
-      addMultipleOf(dest, mat1, m, *mat2);
+      auto const destCol = dest + first * m;
+      auto       col2    = mat2 + first * n;
+      auto       col1    = mat1;
+      multipleOf(destCol, col1, m, *col2);
+      for(++col2, col1 += m; col1 != endMat1; ++col2, col1 += m)
+      {
+        addMultipleOf(destCol, col1, m, *col2);
+      }
     }
-    mat1 -= sizeMat1;
-  }
-#endif
+  });
 }
 
 /**
@@ -17,11 +17,11 @@
  
  
 // includes
+#include <ConcurrencyTools/ParallelAlgorithms.h>
+
 #include <algorithm>
 #include <cstddef>
 #include <execution>
-#include <future>
-#include <vector>
 
 #if __has_include(<immintrin.h>)
 #  include <immintrin.h>
@@ -32,8 +32,6 @@
 namespace linalg {
 
 
-inline auto const hardwareThreads = static_cast<std::size_t>(std::thread::hardware_concurrency());
-
 /// Enumeration to discriminate between execution policies.
 enum class executionPolicy : char {
   seq, ///< tag for sequential execution
@@ -82,36 +80,15 @@ inline void multArrValSIMD(int* arr, std::size_t const size, int fac)
  * @param  arr a pointer the first element of the array.
  * @param  size the size of the array.
  * @param  fac the factor the array is multiplied with.
- * @remark parallel implementation
+ * @remark parallel implementation on the shared thread pool.
  */
 template <typename T>
 inline void multArrValPar(T* arr, std::size_t const size, T const& fac)
 {
-  static constexpr std::size_t minBlockSize{1024ULL};
-  if(const auto numThreads = hardwareThreads < size / minBlockSize ? hardwareThreads : size / minBlockSize; numThreads > 1ULL)
-  {
-    const auto blockSize = size / numThreads;
-    auto numExtraThreads = numThreads - 1ULL;
-    std::vector<std::future<void>> futures;
-    futures.reserve(numExtraThreads);
-    for(;numExtraThreads > 0ULL; --numExtraThreads, arr += blockSize)
-    {
-      futures.emplace_back(std::async(std::launch::async, [=]() { multArrValSeq(arr, blockSize, fac); }));
-    }
-
-    multArrValSeq(arr, blockSize + size % numThreads, fac);
-    for(auto const& f : futures)
-    {
-      f.wait();
-    }
-  }
-  else
-  {
-    for(const auto end = arr + size; arr != end; ++arr)
-    {
-      *arr *= fac;
-    }
-  }
+  static constexpr std::size_t minBlockSize{16384ULL};
+  cctools::parallelFor(std::size_t{0ULL}, size, minBlockSize, [=](std::size_t first, std::size_t last) {
+    multArrValSeq(arr + first, last - first, fac);
+  });
 }
 
 template <typename T>